@@ -0,0 +1,96 @@
+/**
+ * История команд на миллион записей: открытие файла (отображение в
+ * память), построение индекса в фоне и обратный поиск подстроки —
+ * по суффиксному массиву и просмотром файла с конца. Результаты
+ * печатаются в stderr.
+ *
+ * Запуск: ./history_benchmark [число записей, по умолчанию 1000000]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "shell/history.hpp"
+
+using namespace shell;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed(Clock::time_point started) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+}
+
+// Цепочка Ctrl-R: до limit совпадений подряд; возвращает среднее время одного шага, мс
+double searchChain(const History& history, const std::string& query, size_t limit,
+                   size_t& steps) {
+    auto started = Clock::now();
+    steps = 0;
+    for (auto pos = history.search(query, history.end()); pos && steps < limit;
+         pos = history.search(query, *pos)) {
+        ++steps;
+    }
+    return elapsed(started) / static_cast<double>(std::max<size_t>(steps, 1));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t entries = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000000;
+
+    // Команды из словаря с числами: много повторов, как в настоящей истории
+    const std::vector<std::string> words = {"git",  "status", "commit", "push", "ls",   "-la",
+                                            "grep", "-rn",    "make",   "cd",   "src",  "build",
+                                            "cat",  "wc",     "-l",     "sort", "uniq", "find"};
+    std::mt19937 gen(11);
+    auto path = std::filesystem::temp_directory_path() / "shell_history_benchmark";
+    {
+        std::ofstream file(path, std::ios::binary);
+        for (size_t i = 0; i < entries; ++i) {
+            size_t count = 1 + gen() % 5;
+            for (size_t j = 0; j < count; ++j) {
+                file << words[gen() % words.size()] << ' ';
+            }
+            file << "file" << gen() % 100000 << '\n';
+        }
+    }
+    std::cerr << "entries: " << entries << ", file: " << std::filesystem::file_size(path) / 1024
+              << " KiB\n";
+
+    auto started = Clock::now();
+    auto history = std::make_unique<History>(path.string());
+    std::cerr << std::fixed << std::setprecision(3) << "open:        " << elapsed(started)
+              << " ms\n";
+
+    const std::vector<std::string> queries = {"git push file1", "file99999", "sort uniq", "-la"};
+    for (const std::string& query : queries) {
+        size_t steps = 0;
+        double scan = searchChain(*history, query, 20, steps);
+        std::cerr << "scan   '" << query << "': " << scan << " ms/step (" << steps << ")\n";
+    }
+
+    started = Clock::now();
+    history->waitForIndex();
+    std::cerr << "index build: " << elapsed(started) << " ms (after open)\n";
+
+    for (const std::string& query : queries) {
+        size_t steps = 0;
+        double indexed = searchChain(*history, query, 20, steps);
+        std::cerr << "index  '" << query << "': " << indexed << " ms/step (" << steps << ")\n";
+    }
+
+    history.reset();
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * Встроенные cat/wc по тысячам мелких файлов: открытие и чтение пачками
+ * через io_uring (IoRing) против open/read/close на каждый файл. Вывод
+ * команд отправляется в /dev/null, результаты печатаются в stderr.
+ *
+ * Запуск: ./io_ring_benchmark [число файлов, по умолчанию 4000]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "shell/io_ring.hpp"
+#include "shell/shell.hpp"
+
+using namespace shell;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(const std::string& line, size_t repeat, bool ring) {
+    IoRing::setEnabled(ring);
+    Shell shell;
+    shell.processLine(line);  // прогрев: кэш страниц и кольцо потока
+    auto started = Clock::now();
+    for (size_t i = 0; i < repeat; ++i) {
+        shell.processLine(line);
+    }
+    std::cout.flush();
+    return std::chrono::duration<double>(Clock::now() - started).count() /
+           static_cast<double>(repeat);
+}
+
+void report(const std::string& name, const std::string& line, size_t repeat, double scale,
+            const std::string& unit) {
+    double plain = seconds(line, repeat, false);
+    double ring = seconds(line, repeat, true);
+    std::cerr << std::left << std::setw(20) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << scale / plain << std::setw(12)
+              << scale / ring << "  " << unit << "  (x" << std::setprecision(2) << plain / ring
+              << ")\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t files = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 4000;
+
+    if (std::freopen("/dev/null", "w", stdout) == nullptr) {
+        std::cerr << "cannot redirect stdout\n";
+        return 1;
+    }
+    IoRing::setEnabled(true);
+    if (IoRing::local() == nullptr) {
+        std::cerr << "io_uring is not available\n";
+        return 1;
+    }
+
+    auto root = std::filesystem::temp_directory_path() / "shell_io_ring_benchmark";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "small");
+    std::string line = "The quick brown fox jumps over the lazy dog 0123456789\n";
+    for (size_t i = 0; i < files; ++i) {
+        std::ofstream stream(root / "small" / ("file" + std::to_string(i) + ".txt"));
+        for (size_t j = 0; j < 1 + i % 40; ++j) {
+            stream << line;
+        }
+    }
+    const std::string small = (root / "small").string() + "/*";
+
+    std::cerr << std::left << std::setw(20) << "case" << std::right << std::setw(12) << "read"
+              << std::setw(12) << "io_uring" << '\n';
+    report("cat " + std::to_string(files) + " files", "cat " + small, 5,
+           static_cast<double>(files), "files/s");
+    report("wc " + std::to_string(files) + " files", "wc " + small, 5,
+           static_cast<double>(files), "files/s");
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
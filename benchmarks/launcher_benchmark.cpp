@@ -0,0 +1,94 @@
+/**
+ * Стоимость запуска внешней программы в зависимости от объёма памяти shell:
+ * fork из самого процесса (spawnProcess) против процесса-запускателя
+ * (Launcher), созданного при старте.
+ *
+ * Для каждого объёма процесс выделяет и заполняет буфер, затем запускает
+ * /bin/true заданное число раз и ждёт каждый запуск. Результаты — среднее
+ * время одного запуска в микросекундах — печатаются в stderr.
+ *
+ * Запуск: ./launcher_benchmark [число запусков, по умолчанию 300] [МиБ через запятую, по
+ * умолчанию 0,256,1024,2048]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "shell/launcher.hpp"
+#include "shell/process_util.hpp"
+
+using namespace shell;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::string kProgram = "/bin/true";
+
+// Резидентная память процесса в МиБ
+size_t residentMegabytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total = 0;
+    size_t resident = 0;
+    statm >> total >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / (1024 * 1024);
+}
+
+template <typename Spawn>
+double microsecondsPerLaunch(size_t runs, Spawn spawn) {
+    auto started = Clock::now();
+    for (size_t i = 0; i < runs; ++i) {
+        SpawnedProcess process = spawn();
+        if (process.pid < 0 || waitProcess(process.pid, process.pidfd) != 0) {
+            std::cerr << "launch failed\n";
+            std::exit(1);
+        }
+    }
+    return std::chrono::duration<double, std::micro>(Clock::now() - started).count() /
+           static_cast<double>(runs);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t runs = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 300;
+    std::vector<size_t> sizes;
+    std::istringstream list(argc > 2 ? argv[2] : "0,256,1024,2048");
+    for (std::string item; std::getline(list, item, ',');) {
+        sizes.push_back(static_cast<size_t>(std::atoi(item.c_str())));
+    }
+
+    // Как и в main shell: запускатель создаётся, пока процесс мал
+    Launcher& launcher = Launcher::shared();
+    if (!launcher.start()) {
+        std::cerr << "launcher is not available\n";
+        return 1;
+    }
+
+    const std::vector<std::string> args;
+    const std::vector<std::string> env;
+    std::cerr << std::setw(10) << "RSS, MiB" << std::setw(14) << "fork, us" << std::setw(16)
+              << "launcher, us" << '\n';
+    for (size_t megabytes : sizes) {
+        std::vector<char> heap(megabytes * 1024 * 1024);
+        std::memset(heap.data(), 1, heap.size());
+
+        double forked = microsecondsPerLaunch(runs, [&] {
+            return SpawnedProcess{spawnProcess(kProgram, args, env, -1, -1), -1};
+        });
+        double launched = microsecondsPerLaunch(
+            runs, [&] { return launcher.spawn(kProgram, args, env, -1, -1); });
+        std::cerr << std::setw(10) << residentMegabytes() << std::fixed << std::setprecision(1)
+                  << std::setw(14) << forked << std::setw(16) << launched << '\n';
+    }
+    return 0;
+}
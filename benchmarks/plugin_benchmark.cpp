@@ -0,0 +1,86 @@
+/**
+ * Сравнение команды из плагина (enable -f) с той же утилитой, запущенной
+ * как внешняя программа (ExternalCommand: fork/exec и пересылка через pipe).
+ *
+ * Измеряются короткие запуски (echo hello | upcase) — стоимость создания
+ * процесса — и поток большого файла (cat FILE | upcase) — стоимость
+ * пересылки данных. Вывод команд отправляется в /dev/null, результаты
+ * печатаются в stderr.
+ *
+ * Запуск: ./plugin_benchmark [число коротких запусков, по умолчанию 200] [МиБ, по умолчанию 64]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "shell/shell.hpp"
+
+using namespace shell;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Shell& shell, const std::string& line, size_t repeat) {
+    auto started = Clock::now();
+    for (size_t i = 0; i < repeat; ++i) {
+        shell.processLine(line);
+    }
+    std::cout.flush();
+    return std::chrono::duration<double>(Clock::now() - started).count();
+}
+
+void report(const std::string& name, double plugin, double external, const std::string& unit,
+            double scale) {
+    std::cerr << std::left << std::setw(26) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(12) << scale / plugin << std::setw(12)
+              << scale / external << "  " << unit << "  (x" << std::setprecision(1)
+              << external / plugin << ")\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t runs = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 200;
+    size_t megabytes = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 64;
+
+    if (std::freopen("/dev/null", "w", stdout) == nullptr) {
+        std::cerr << "cannot redirect stdout\n";
+        return 1;
+    }
+
+    auto file = std::filesystem::temp_directory_path() / "shell_plugin_benchmark.txt";
+    {
+        std::ofstream stream(file, std::ios::binary);
+        std::string line = "The quick brown fox jumps over the lazy dog 0123456789\n";
+        for (size_t written = 0; written < megabytes * 1024 * 1024; written += line.size()) {
+            stream << line;
+        }
+    }
+
+    Shell shell;
+    if (shell.processLine(std::string("enable -f ") + TOOLS_PLUGIN_PATH + " upcase") != 0) {
+        return 1;
+    }
+    const std::string external = std::string(TOOLS_CLI_PATH) + " upcase";
+
+    std::cerr << std::left << std::setw(26) << "case" << std::right << std::setw(12) << "plugin"
+              << std::setw(12) << "external" << '\n';
+
+    double plugin = seconds(shell, "echo hello | upcase", runs);
+    double spawned = seconds(shell, "echo hello | " + external, runs);
+    report("echo hello | upcase", plugin, spawned, "runs/s", static_cast<double>(runs));
+
+    plugin = seconds(shell, "cat " + file.string() + " | upcase", 1);
+    spawned = seconds(shell, "cat " + file.string() + " | " + external, 1);
+    report("cat FILE | upcase", plugin, spawned, "MiB/s", static_cast<double>(megabytes));
+
+    std::filesystem::remove(file);
+    return 0;
+}
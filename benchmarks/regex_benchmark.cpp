@@ -0,0 +1,123 @@
+/**
+ * Сравнение Regex (ленивый DFA) с std::regex.
+ *
+ * Для каждого образца измеряется время подсчёта строк с совпадением в
+ * сгенерированном тексте; отдельно — «катастрофические» образцы, на которых
+ * backtracking-реализация std::regex деградирует экспоненциально.
+ *
+ * Запуск: ./regex_benchmark [размер текста в МиБ, по умолчанию 4]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "shell/regex.hpp"
+
+using namespace shell;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string makeText(size_t bytes) {
+    const std::vector<std::string> words = {"alpha", "beta",  "gamma", "delta", "error",
+                                            "warn",  "12345", "user",  "id=42", "ok"};
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<size_t> pick(0, words.size() - 1);
+    std::string text;
+    text.reserve(bytes + 64);
+    while (text.size() < bytes) {
+        for (int i = 0; i < 8; ++i) {
+            text += words[pick(gen)];
+            text += ' ';
+        }
+        text.back() = '\n';
+    }
+    return text;
+}
+
+size_t countOurs(const std::string& pattern, const std::string& text) {
+    RegexMatcher matcher(Regex::compile(pattern, Regex::kExtended));
+    const char* pos = text.data();
+    const char* end = pos + text.size();
+    size_t lines = 0;
+    while (pos < end) {
+        const char* hit = matcher.find(pos, end);
+        if (hit == nullptr) {
+            break;
+        }
+        lines++;
+        const void* newline = std::memchr(hit, '\n', static_cast<size_t>(end - hit));
+        pos = newline != nullptr ? static_cast<const char*>(newline) + 1 : end;
+    }
+    return lines;
+}
+
+size_t countStd(const std::string& pattern, const std::string& text) {
+    std::regex regex(pattern, std::regex::extended);
+    size_t lines = 0;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t finish = text.find('\n', start);
+        if (finish == std::string::npos) {
+            finish = text.size();
+        }
+        if (std::regex_search(text.begin() + static_cast<std::ptrdiff_t>(start),
+                              text.begin() + static_cast<std::ptrdiff_t>(finish), regex)) {
+            lines++;
+        }
+        start = finish + 1;
+    }
+    return lines;
+}
+
+template <typename F>
+double seconds(F&& run, size_t& result) {
+    auto started = Clock::now();
+    result = run();
+    return std::chrono::duration<double>(Clock::now() - started).count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 4;
+    std::string text = makeText(megabytes * 1024 * 1024);
+
+    const std::vector<std::string> patterns = {
+        "error", "^alpha.*error$", "id=[0-9]+", "(beta|gamma) (delta|warn)", "[[:digit:]]{5} user",
+    };
+
+    std::cout << std::left << std::setw(30) << "pattern" << std::setw(12) << "lines"
+              << std::setw(14) << "Regex, MB/s" << "std::regex, MB/s\n";
+    double size = static_cast<double>(text.size()) / (1024 * 1024);
+    for (const auto& pattern : patterns) {
+        size_t ours = 0;
+        size_t theirs = 0;
+        double oursTime = seconds([&]() { return countOurs(pattern, text); }, ours);
+        double stdTime = seconds([&]() { return countStd(pattern, text); }, theirs);
+        std::cout << std::setw(30) << pattern << std::setw(12) << ours << std::setw(14)
+                  << std::fixed << std::setprecision(1) << size / oursTime << size / stdTime
+                  << (ours == theirs ? "" : "  (MISMATCH)") << std::endl;
+    }
+
+    // Образцы с экспоненциальным backtracking: std::regex — на короткой строке
+    std::cout << "\nhostile patterns (Regex on 1 MiB line, std::regex on 12 bytes)\n";
+    for (const std::string& pattern : {std::string("(a*)*b"), std::string("(a|aa)*c")}) {
+        size_t result = 0;
+        std::string longLine(1024 * 1024, 'a');
+        std::string shortLine(12, 'a');
+        double oursTime = seconds([&]() { return countOurs(pattern, longLine); }, result);
+        double stdTime = seconds([&]() { return countStd(pattern, shortLine); }, result);
+        std::cout << std::setw(30) << pattern << "Regex " << std::setprecision(4) << oursTime
+                  << " s, std::regex " << stdTime << " s" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace shell {
+
+/**
+ * @brief Идентификатор встроенной команды
+ */
+enum class BuiltinId : uint8_t {
+    kEcho,
+    kCat,
+    kWc,
+    kPwd,
+    kExit,
+    kGrep,
+    kSort,
+    kUniq,
+    kCount,
+    kHead,
+    kTail,
+    kTee,
+    kFind,
+    kHash,
+    kEnable,
+    kNone  ///< Не встроенная (внешняя) команда
+};
+
+/// Число встроенных команд
+inline constexpr size_t kBuiltinCount = static_cast<size_t>(BuiltinId::kNone);
+
+namespace detail {
+
+/// Имена встроенных команд в порядке BuiltinId
+inline constexpr std::array<std::string_view, kBuiltinCount> kBuiltinNames{
+    "echo", "cat",   "wc",   "pwd",  "exit", "grep", "sort",
+    "uniq", "count", "head", "tail", "tee",  "find", "hash", "enable"};
+
+/// Размер таблицы: степень двойки, с запасом над числом имён
+inline constexpr size_t kBuiltinSlots = 32;
+
+struct BuiltinSlot {
+    std::string_view name;
+    BuiltinId id = BuiltinId::kNone;
+};
+
+constexpr uint32_t builtinHash(std::string_view name, uint32_t seed) {
+    // FNV-1a с подмешанным зерном
+    uint32_t hash = 2166136261U ^ seed;
+    for (char c : name) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;
+    }
+    return hash ^ (hash >> 15);
+}
+
+constexpr bool isPerfectSeed(uint32_t seed) {
+    std::array<bool, kBuiltinSlots> used{};
+    for (auto name : kBuiltinNames) {
+        size_t slot = builtinHash(name, seed) & (kBuiltinSlots - 1);
+        if (used[slot]) {
+            return false;
+        }
+        used[slot] = true;
+    }
+    return true;
+}
+
+/// Первое зерно, при котором имена не конфликтуют (ищется при компиляции)
+constexpr uint32_t findPerfectSeed() {
+    uint32_t seed = 0;
+    while (!isPerfectSeed(seed)) {
+        ++seed;
+    }
+    return seed;
+}
+
+inline constexpr uint32_t kBuiltinSeed = findPerfectSeed();
+
+constexpr std::array<BuiltinSlot, kBuiltinSlots> buildBuiltinSlots() {
+    std::array<BuiltinSlot, kBuiltinSlots> slots{};
+    for (size_t i = 0; i < kBuiltinCount; ++i) {
+        auto& slot = slots[builtinHash(kBuiltinNames[i], kBuiltinSeed) & (kBuiltinSlots - 1)];
+        slot.name = kBuiltinNames[i];
+        slot.id = static_cast<BuiltinId>(i);
+    }
+    return slots;
+}
+
+inline constexpr std::array<BuiltinSlot, kBuiltinSlots> kBuiltinTable = buildBuiltinSlots();
+
+}  // namespace detail
+
+/**
+ * @brief Найти встроенную команду по имени
+ *
+ * Совершенный хэш, построенный при компиляции: одно хэширование и одно
+ * сравнение строк, без обращений к памяти кучи.
+ * @return Идентификатор или BuiltinId::kNone для внешней команды
+ */
+constexpr BuiltinId lookupBuiltin(std::string_view name) {
+    const auto& slot =
+        detail::kBuiltinTable[detail::builtinHash(name, detail::kBuiltinSeed) &
+                              (detail::kBuiltinSlots - 1)];
+    // Пустые ячейки хранят kNone, поэтому проверки на пустое имя не нужно
+    return slot.name == name ? slot.id : BuiltinId::kNone;
+}
+
+/**
+ * @brief Имя встроенной команды
+ */
+constexpr std::string_view builtinName(BuiltinId id) {
+    return id == BuiltinId::kNone ? std::string_view()
+                                  : detail::kBuiltinNames[static_cast<size_t>(id)];
+}
+
+static_assert(lookupBuiltin("echo") == BuiltinId::kEcho);
+static_assert(lookupBuiltin("hash") == BuiltinId::kHash);
+static_assert(lookupBuiltin("ls") == BuiltinId::kNone && lookupBuiltin("") == BuiltinId::kNone);
+
+}  // namespace shell
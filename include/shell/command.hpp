@@ -1,11 +1,62 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "builtin_table.hpp"
+
 namespace shell {
 
+class ExternalCommand;
+class StageCommand;
+
+/**
+ * @brief Результат выполнения команды
+ *
+ * Код возврата и управляющий сигнал для исполнителя (например, запрос
+ * выхода из shell). Неявно строится из кода и приводится к нему, поэтому
+ * обычные команды по-прежнему возвращают int.
+ */
+class CommandResult {
+public:
+    /**
+     * @brief Управляющий сигнал
+     */
+    enum class Control { kNone, kExit };
+
+    CommandResult(int code = 0) : code_(code) {}  // NOLINT(google-explicit-constructor)
+
+    /**
+     * @brief Результат команды exit: завершить shell с кодом code
+     */
+    static CommandResult exit(int code) {
+        CommandResult result(code);
+        result.control_ = Control::kExit;
+        return result;
+    }
+
+    operator int() const {  // NOLINT(google-explicit-constructor)
+        return code_;
+    }
+
+    int code() const {
+        return code_;
+    }
+
+    Control control() const {
+        return control_;
+    }
+
+private:
+    int code_;
+    Control control_ = Control::kNone;
+};
+
 /**
  * @brief Базовый интерфейс для всех команд
  *
@@ -20,22 +71,113 @@ public:
      * @param inputStream Входной поток (от предыдущей команды в пайпе или stdin)
      * @param outputStream Выходной поток для результата
      * @param errorStream Поток для ошибок
-     * @return Код возврата (0 — успех)
+     * @return Код возврата (0 — успех) и управляющий сигнал
      */
-    virtual int execute(std::istream& inputStream, std::ostream& outputStream,
-                        std::ostream& errorStream) = 0;
+    virtual CommandResult execute(std::istream& inputStream, std::ostream& outputStream,
+                                  std::ostream& errorStream) = 0;
 
     /**
      * @brief Установить аргументы команды
-     * @param args Вектор аргументов
+     * @param args Вектор аргументов (команда забирает его себе)
      */
-    virtual void setArguments(const std::vector<std::string>& args) = 0;
+    virtual void setArguments(std::vector<std::string> args) = 0;
+
+    /**
+     * @brief Установить аргументы из AST
+     *
+     * По умолчанию строит новый вектор и вызывает setArguments. Команды
+     * из CommandPool присваивают аргументы поверх прежних, переиспользуя
+     * память вектора.
+     */
+    virtual void assignArguments(const std::pmr::vector<std::pmr::string>& args) {
+        setArguments(std::vector<std::string>(args.begin(), args.end()));
+    }
+
+    /**
+     * @brief Вернуть команду в исходное состояние для повторного использования
+     * @return false, если команда не поддерживает повторное использование
+     */
+    virtual bool reset() {
+        return false;
+    }
 
     /**
      * @brief Получить имя команды
      * @return Имя команды
      */
     virtual std::string getName() const = 0;
+
+    /**
+     * @brief Внешняя программа, которую исполнитель запускает сам, без потока стадии
+     * @return nullptr для команд, выполняемых в процессе shell
+     */
+    virtual ExternalCommand* asExternal() {
+        return nullptr;
+    }
+
+    /**
+     * @brief Команда-сопрограмма (см. coroutine_stage.hpp) для пайплайна в одном потоке
+     * @return nullptr, если команда выполняется только через execute()
+     */
+    virtual StageCommand* asStage() {
+        return nullptr;
+    }
+};
+
+/**
+ * @brief Удалитель команды, созданной makeCommand
+ *
+ * Без ресурса — обычный delete; иначе деструктор и возврат памяти в
+ * ресурс (для арены строки — бесплатно). Команда из пула (pooled) не
+ * удаляется, а возвращается в CommandPool текущего потока.
+ */
+struct CommandDeleter {
+    std::pmr::memory_resource* resource = nullptr;
+    size_t size = 0;
+    size_t alignment = 0;
+    BuiltinId pooled = BuiltinId::kNone;
+
+    void operator()(Command* command) const {
+        if (pooled != BuiltinId::kNone) {
+            recycle(pooled, command);
+            return;
+        }
+        if (resource == nullptr) {
+            delete command;
+            return;
+        }
+        command->~Command();
+        resource->deallocate(command, size, alignment);
+    }
+
+    /**
+     * @brief Вернуть команду в пул потока (определена в command_pool.cpp)
+     */
+    static void recycle(BuiltinId id, Command* command);
 };
 
+/**
+ * @brief Владеющий указатель на команду (в куче или в ресурсе памяти)
+ */
+using CommandPtr = std::unique_ptr<Command, CommandDeleter>;
+
+/**
+ * @brief Создать команду в ресурсе памяти
+ * @param resource Ресурс (nullptr — глобальная куча)
+ */
+template <typename T, typename... Args>
+CommandPtr makeCommand(std::pmr::memory_resource* resource, Args&&... args) {
+    if (resource == nullptr) {
+        return CommandPtr(new T(std::forward<Args>(args)...));
+    }
+    void* memory = resource->allocate(sizeof(T), alignof(T));
+    try {
+        return CommandPtr(new (memory) T(std::forward<Args>(args)...),
+                          CommandDeleter{resource, sizeof(T), alignof(T)});
+    } catch (...) {
+        resource->deallocate(memory, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
 }  // namespace shell
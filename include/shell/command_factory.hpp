@@ -1,12 +1,18 @@
 #pragma once
 
-#include <functional>
 #include <memory>
+#include <memory_resource>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
+#include "builtin_table.hpp"
 #include "command.hpp"
 #include "environment.hpp"
+#include "path_cache.hpp"
+#include "pattern_file_cache.hpp"
+#include "plugin_table.hpp"
+#include "regex_cache.hpp"
 
 namespace shell {
 
@@ -15,6 +21,9 @@ namespace shell {
  *
  * Создаёт объекты команд по имени. Для встроенных команд
  * создаёт соответствующие классы, для остальных — ExternalCommand.
+ * Имя ищется в таблице совершенного хэша (lookupBuiltin); простые
+ * встроенные команды берутся из CommandPool потока. Имена, не найденные
+ * среди встроенных, сначала ищутся среди команд плагинов (enable -f).
  */
 class CommandFactory {
 public:
@@ -31,6 +40,21 @@ public:
      */
     std::unique_ptr<Command> create(const std::string& name);
 
+    /**
+     * @brief Создать команду по имени в ресурсе памяти
+     * @param name Имя команды
+     * @param resource Ресурс для объекта команды (арена строки); nullptr — куча
+     */
+    CommandPtr create(const std::string& name, std::pmr::memory_resource* resource);
+
+    /**
+     * @brief Создать команду по уже найденному идентификатору
+     * @param id Результат lookupBuiltin(name) (BuiltinId::kNone — внешняя команда)
+     * @param name Имя команды
+     * @param resource Ресурс для объектов команд, не берущихся из пула; nullptr — куча
+     */
+    CommandPtr create(BuiltinId id, std::string_view name, std::pmr::memory_resource* resource);
+
     /**
      * @brief Проверить, является ли команда встроенной
      * @param name Имя команды
@@ -38,11 +62,45 @@ public:
      */
     bool isBuiltin(const std::string& name) const;
 
+    /**
+     * @brief Имена встроенных команд и команд плагинов (для дополнения)
+     */
+    std::vector<std::string> commandNames() const;
+
+    /**
+     * @brief Получить кэш путей внешних команд
+     */
+    PathCache& getPathCache() {
+        return pathCache_;
+    }
+
+    /**
+     * @brief Получить таблицу команд, загруженных из плагинов
+     */
+    PluginTable& getPlugins() {
+        return plugins_;
+    }
+
+    /**
+     * @brief Получить кэш скомпилированных регулярных выражений сессии
+     */
+    RegexCache& getRegexCache() {
+        return regexCache_;
+    }
+
+    /**
+     * @brief Получить кэш автоматов по файлам образцов сессии
+     */
+    PatternFileCache& getPatternFileCache() {
+        return patternFileCache_;
+    }
+
 private:
     Environment& env_;
-    std::unordered_map<std::string, std::function<std::unique_ptr<Command>()>> builtinFactories_;
-
-    void registerBuiltins();
+    PathCache pathCache_;
+    RegexCache regexCache_;
+    PatternFileCache patternFileCache_;
+    PluginTable plugins_;
 };
 
 }  // namespace shell
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "builtin_table.hpp"
+#include "command.hpp"
+
+namespace shell {
+
+/**
+ * @brief Пул повторно используемых объектов встроенных команд
+ *
+ * Свой у каждого потока (local()). Команда, созданная через пул,
+ * при удалении из пайплайна не разрушается: CommandDeleter вызывает
+ * reset() и кладёт объект обратно. Следующая строка с той же командой
+ * получает готовый объект вместе с памятью его векторов, поэтому цикл
+ * из echo/wc не обращается к куче. Команды, у которых reset() возвращает
+ * false, и избыток сверх kMaxPerBuiltin удаляются обычным delete.
+ */
+class CommandPool {
+public:
+    /// Сколько свободных объектов одной команды хранится
+    static constexpr size_t kMaxPerBuiltin = 8;
+
+    CommandPool() = default;
+    CommandPool(const CommandPool&) = delete;
+    CommandPool& operator=(const CommandPool&) = delete;
+    ~CommandPool();
+
+    /**
+     * @brief Пул текущего потока
+     */
+    static CommandPool& local();
+
+    /**
+     * @brief Взять команду из пула или создать новую
+     * @tparam T Класс встроенной команды (конструктор без параметров)
+     */
+    template <typename T>
+    CommandPtr acquire(BuiltinId id) {
+        auto& list = free_[static_cast<size_t>(id)];
+        Command* command = nullptr;
+        if (!list.empty()) {
+            command = list.back();
+            list.pop_back();
+        } else {
+            command = new T();
+        }
+        CommandDeleter deleter;
+        deleter.pooled = id;
+        return CommandPtr(command, deleter);
+    }
+
+    /**
+     * @brief Вернуть команду в пул (или удалить, если её нельзя переиспользовать)
+     */
+    void release(BuiltinId id, Command* command);
+
+    /**
+     * @brief Число свободных объектов команды (для тестов)
+     */
+    size_t available(BuiltinId id) const {
+        return free_[static_cast<size_t>(id)].size();
+    }
+
+private:
+    std::array<std::vector<Command*>, kBuiltinCount> free_;
+};
+
+}  // namespace shell
@@ -1,19 +1,24 @@
 #pragma once
 
-#include "../command.hpp"
+#include "../coroutine_stage.hpp"
 
 namespace shell {
 
 /**
  * @brief Команда cat — вывод содержимого файла
  *
- * Если аргументы не указаны, копирует входной поток в выходной.
+ * Если аргументы не указаны, копирует входной поток в выходной. Файлы
+ * читаются пачками через io_uring (IoRing), если он доступен. Стадией-
+ * сопрограммой файлы читаются блоками и отдаются по мере чтения.
  */
-class CatCommand : public Command {
+class CatCommand : public StageCommand {
 public:
-    int execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    StageTask stage(StageIO& io) override;
 
-    void setArguments(const std::vector<std::string>& args) override;
+    void setArguments(std::vector<std::string> args) override;
+    void assignArguments(const std::pmr::vector<std::pmr::string>& args) override;
+    bool reset() override;
 
     std::string getName() const override {
         return "cat";
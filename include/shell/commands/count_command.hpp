@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../command.hpp"
+#include "../line_counter.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда count — частоты строк за один проход
+ *
+ * Форма: count [-t C] [-f N] [-n K] [FILE...]. Заменяет конвейер
+ * `sort | uniq -c | sort -rn | head -n K`: строки (или поле N, с -t —
+ * по разделителю C, иначе по пробелам и табуляциям) подсчитываются в
+ * LineCounter без сортировки входа, результат выводится в формате
+ * `uniq -c` по убыванию счётчика; -n оставляет K самых частых. Без
+ * файлов читается входной поток. Код возврата: 0 — успех, 1 — ошибка.
+ */
+class CountCommand : public Command {
+public:
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+    void assignArguments(const std::pmr::vector<std::pmr::string>& args) override;
+    bool reset() override;
+
+    std::string getName() const override {
+        return "count";
+    }
+
+private:
+    std::vector<std::string> args_;
+    std::vector<std::string> filenames_;
+    size_t field_ = 0;  ///< 0 — строка целиком
+    char separator_ = '\0';
+    bool hasSeparator_ = false;
+    size_t top_ = 0;  ///< 0 — все ключи
+    bool hasTop_ = false;
+
+    bool parseArguments(std::ostream& err);
+    void countLines(const char* data, size_t size, LineCounter& counter) const;
+    std::string_view key(std::string_view line) const;
+};
+
+}  // namespace shell
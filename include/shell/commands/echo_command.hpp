@@ -1,17 +1,20 @@
 #pragma once
 
-#include "../command.hpp"
+#include "../coroutine_stage.hpp"
 
 namespace shell {
 
 /**
  * @brief Команда echo — вывод аргументов на экран
  */
-class EchoCommand : public Command {
+class EchoCommand : public StageCommand {
 public:
-    int execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    StageTask stage(StageIO& io) override;
 
-    void setArguments(const std::vector<std::string>& args) override;
+    void setArguments(std::vector<std::string> args) override;
+    void assignArguments(const std::pmr::vector<std::pmr::string>& args) override;
+    bool reset() override;
 
     std::string getName() const override {
         return "echo";
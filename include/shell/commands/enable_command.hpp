@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../command.hpp"
+#include "../plugin_table.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда enable — загрузка встроенных команд из плагинов
+ *
+ * Поддерживаемые формы:
+ * - enable                   — вывести команды, включённые из плагинов
+ * - enable -f FILE [NAME...] — загрузить плагин FILE и включить команды NAME
+ *   (без имён — все команды плагина)
+ * - enable -d NAME...        — отключить команды плагина
+ */
+class EnableCommand : public Command {
+public:
+    /**
+     * @brief Создать команду для указанной таблицы плагинов
+     * @param plugins Таблица команд плагинов фабрики
+     */
+    explicit EnableCommand(PluginTable& plugins);
+
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+
+    std::string getName() const override {
+        return "enable";
+    }
+
+private:
+    PluginTable& plugins_;
+    std::vector<std::string> args_;
+};
+
+}  // namespace shell
@@ -7,14 +7,16 @@ namespace shell {
 /**
  * @brief Команда exit — выход из интерпретатора
  *
- * Устанавливает флаг завершения. Не завершает процесс напрямую,
- * а сигнализирует главному циклу о необходимости выхода.
+ * Не завершает процесс напрямую, а возвращает CommandResult::exit —
+ * исполнитель передаёт запрос выхода главному циклу.
  */
 class ExitCommand : public Command {
 public:
-    int execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
 
-    void setArguments(const std::vector<std::string>& args) override;
+    void setArguments(std::vector<std::string> args) override;
+    void assignArguments(const std::pmr::vector<std::pmr::string>& args) override;
+    bool reset() override;
 
     std::string getName() const override {
         return "exit";
@@ -4,6 +4,8 @@
 
 #include "../command.hpp"
 #include "../environment.hpp"
+#include "../launcher.hpp"
+#include "../path_cache.hpp"
 
 namespace shell {
 
@@ -18,12 +20,28 @@ public:
      * @brief Создать внешнюю команду
      * @param programName Имя программы (или путь к ней)
      * @param env Ссылка на окружение
+     * @param pathCache Кэш путей команд (nullptr — искать в PATH при каждом запуске)
      */
-    ExternalCommand(const std::string& programName, Environment& env);
+    ExternalCommand(const std::string& programName, Environment& env,
+                    PathCache* pathCache = nullptr);
 
-    int execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
 
-    void setArguments(const std::vector<std::string>& args) override;
+    void setArguments(std::vector<std::string> args) override;
+
+    ExternalCommand* asExternal() override {
+        return this;
+    }
+
+    /**
+     * @brief Запустить программу с готовыми stdin и stdout, не дожидаясь её
+     *
+     * Дескрипторы остаются у вызывающего. При ошибке сообщение пишется в
+     * err, а failureCode получает код стадии: 127 — программа не найдена,
+     * 1 — не удалось создать процесс.
+     * @return Процесс; pid < 0 при ошибке
+     */
+    SpawnedProcess start(int stdinFd, int stdoutFd, std::ostream& err, int& failureCode);
 
     std::string getName() const override {
         return programName_;
@@ -33,9 +51,10 @@ private:
     std::string programName_;
     std::vector<std::string> args_;
     Environment& env_;
+    PathCache* pathCache_;
 
     /**
-     * @brief Найти исполняемый файл в PATH
+     * @brief Найти исполняемый файл в PATH (через кэш, если он задан)
      * @return Полный путь к исполняемому файлу или nullopt
      */
     std::optional<std::string> findExecutable() const;
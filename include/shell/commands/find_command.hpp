@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "../command.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда find — обход дерева каталогов
+ *
+ * Форма: find [PATH...] [-name GLOB] [-type C] [-size [+-]N[ckMG]]
+ * [-mtime [+-]N] [-maxdepth N] [-print0] [-unordered]. Условия
+ * объединяются по «и»; выводятся пути подходящих элементов (по
+ * умолчанию от «.»). Символические ссылки не разыменовываются.
+ *
+ * Каждый каталог читается отдельной задачей на общем пуле потоков
+ * (на Linux — системным вызовом getdents64 большими блоками). Тип
+ * элемента берётся из d_type; stat выполняется, только если тип
+ * неизвестен или нужен -size/-mtime. По умолчанию элементы каталога
+ * сортируются по имени и вывод идёт в порядке обхода в глубину — он не
+ * зависит от числа потоков и выдаётся по мере готовности префикса;
+ * -unordered выводит результаты каталогов в порядке завершения задач.
+ * Код возврата: 0 — успех, 1 — ошибка (недоступный каталог и т. п.).
+ */
+class FindCommand : public Command {
+public:
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+
+    std::string getName() const override {
+        return "find";
+    }
+
+    /**
+     * @brief Сравнение для -size/-mtime: +N — больше, -N — меньше, N — равно
+     */
+    struct Comparison {
+        int sign = 0;
+        uint64_t value = 0;
+        uint64_t unit = 1;  ///< Единица -size в байтах
+
+        bool matches(uint64_t actual) const {
+            return sign > 0 ? actual > value : sign < 0 ? actual < value : actual == value;
+        }
+    };
+
+    /**
+     * @brief Условия отбора
+     */
+    struct Filter {
+        std::vector<std::string> names;  ///< -name (все должны совпасть)
+        char type = '\0';                ///< -type: f, d, l, b, c, p, s
+        std::vector<Comparison> sizes;   ///< -size (в единицах unit)
+        std::vector<Comparison> mtimes;  ///< -mtime (в сутках)
+        size_t maxDepth = SIZE_MAX;
+        char terminator = '\n';
+        bool unordered = false;
+        std::time_t now = 0;
+
+        /// Нужен ли stat для проверки условий (кроме неизвестного типа)
+        bool needsStat() const {
+            return !sizes.empty() || !mtimes.empty();
+        }
+    };
+
+private:
+    std::vector<std::string> args_;
+    std::vector<std::string> roots_;
+    Filter filter_;
+
+    bool parseArguments(std::ostream& err);
+};
+
+}  // namespace shell
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../command.hpp"
+#include "../literal_searcher.hpp"
+#include "../multi_literal_searcher.hpp"
+#include "../pattern_file_cache.hpp"
+#include "../regex_cache.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда grep — поиск строк, содержащих образец
+ *
+ * Форма: grep [-cvinlrEF] [-e PATTERN]... [-f FILE]... [PATTERN] [FILE...].
+ * Флаги: -c — число подходящих строк, -v — строки без образца,
+ * -i — без учёта регистра, -n — номера строк, -l — только имена файлов,
+ * -r — рекурсивный обход каталогов, -E — расширенные регулярные
+ * выражения, -F — образцы всегда строки, -e — образец, -f — файл
+ * образцов (по одному на строку). Строка подходит, если содержит любой
+ * из образцов.
+ *
+ * Образец без метасимволов ищется как строка (LiteralSearcher), набор
+ * таких образцов — автоматом Ахо–Корасик (MultiLiteralSearcher, для
+ * единственного файла одних строк — из кэша сессии). Образцы с
+ * метасимволами объединяются в альтернативы ограниченного размера
+ * (Regex, единственная — из кэша сессии); строка подходит, если
+ * совпадает автомат или любая из альтернатив. Обычные файлы
+ * отображаются в память, поток читается блоками. Несколько файлов
+ * просматриваются параллельно на общем пуле потоков, вывод — в порядке
+ * их перечисления. Код возврата: 0 — строки найдены, 1 — не найдены,
+ * 2 — ошибка.
+ */
+class GrepCommand : public Command {
+public:
+    /**
+     * @brief Создать команду
+     * @param regexCache Кэш скомпилированных выражений (nullptr — компилировать каждый раз)
+     * @param patternCache Кэш автоматов по файлам образцов (nullptr — строить каждый раз)
+     */
+    explicit GrepCommand(RegexCache* regexCache = nullptr,
+                         PatternFileCache* patternCache = nullptr);
+
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+
+    std::string getName() const override {
+        return "grep";
+    }
+
+private:
+    /**
+     * @brief Разобранные флаги
+     */
+    struct Options {
+        bool count = false;
+        bool invert = false;
+        bool ignoreCase = false;
+        bool lineNumbers = false;
+        bool filesOnly = false;
+        bool recursive = false;
+        bool extended = false;
+        bool fixed = false;
+        bool withNames = false;
+    };
+
+    /**
+     * @brief Состояние просмотра одного входа
+     */
+    struct ScanState {
+        std::string prefix;  ///< "имя:" при выводе нескольких файлов
+        size_t lineNumber = 0;
+        size_t matches = 0;
+        bool done = false;  ///< Для -l достаточно первого совпадения
+    };
+
+    /**
+     * @brief Результат просмотра одного файла (error пуст при успехе)
+     */
+    struct FileResult {
+        std::string output;
+        size_t matches = 0;
+        std::string error;
+    };
+
+    class LineFinder;
+
+    RegexCache* regexCache_;
+    PatternFileCache* patternCache_;
+    std::vector<std::string> args_;
+    Options options_;
+    std::vector<std::string> patterns_;      ///< Из -e или первого аргумента
+    std::vector<std::string> patternFiles_;  ///< Из -f
+    std::vector<std::string> filenames_;
+    std::unique_ptr<LiteralSearcher> literal_;
+    std::shared_ptr<const MultiLiteralSearcher> multi_;
+    std::vector<std::shared_ptr<const Regex>> regexes_;
+
+    bool parseArguments(std::ostream& err);
+    std::vector<std::string> collectFiles() const;
+
+    bool preparePattern(std::ostream& err);
+    bool prepareRegex(const std::vector<std::string>& patterns, std::ostream& err);
+    bool compileGroup(const std::vector<std::string>& patterns, size_t from, size_t to,
+                      bool cached, std::string& error);
+    void scan(LineFinder& finder, const char* data, size_t size, ScanState& state,
+              std::string& output) const;
+    void emitLine(const char* begin, const char* end, const ScanState& state,
+                  std::string& output) const;
+    void finish(const std::string& name, const ScanState& state, std::string& output) const;
+
+    FileResult searchFile(const std::string& filename) const;
+    size_t searchStream(std::istream& in, std::ostream& out) const;
+};
+
+}  // namespace shell
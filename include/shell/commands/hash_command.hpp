@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../command.hpp"
+#include "../path_cache.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда hash — просмотр и управление кэшем путей команд
+ *
+ * Без аргументов выводит запомненные команды и число обращений к ним.
+ * Поддерживаемые формы:
+ * - hash NAME...       — найти команды в PATH и запомнить их
+ * - hash -r            — очистить кэш
+ * - hash -d NAME...    — забыть указанные команды
+ * - hash -p PATH NAME  — запомнить NAME с явно заданным путём
+ * - hash -t NAME...    — вывести запомненные пути
+ */
+class HashCommand : public Command {
+public:
+    /**
+     * @brief Создать команду для указанного кэша
+     * @param cache Кэш путей, которым управляет команда
+     */
+    explicit HashCommand(PathCache& cache);
+
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+
+    std::string getName() const override {
+        return "hash";
+    }
+
+private:
+    PathCache& cache_;
+    std::vector<std::string> args_;
+
+    void printTable(std::ostream& out) const;
+};
+
+}  // namespace shell
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../command.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда head — первые строки входа
+ *
+ * Форма: head [-n N | -N] [FILE...], по умолчанию 10 строк. При
+ * нескольких файлах вывод каждого предваряется заголовком
+ * `==> FILE <==`. Вход читается блоками только до N-й строки: в
+ * пайплайне после выхода head предыдущая стадия получает ошибку
+ * записи и останавливается. Код возврата: 0 — успех, 1 — ошибка.
+ */
+class HeadCommand : public Command {
+public:
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+    void assignArguments(const std::pmr::vector<std::pmr::string>& args) override;
+    bool reset() override;
+
+    std::string getName() const override {
+        return "head";
+    }
+
+private:
+    std::vector<std::string> args_;
+    std::vector<std::string> filenames_;
+    size_t lines_ = 10;
+
+    bool parseArguments(std::ostream& err);
+
+    /**
+     * @brief Скопировать первые lines_ строк
+     * @param read Чтение очередного блока (число байт, 0 при EOF, -1 при ошибке)
+     * @return false при ошибке чтения
+     */
+    template <typename Read>
+    bool copyLines(Read read, std::ostream& out) const;
+};
+
+}  // namespace shell
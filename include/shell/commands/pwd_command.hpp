@@ -9,9 +9,11 @@ namespace shell {
  */
 class PwdCommand : public Command {
 public:
-    int execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
 
-    void setArguments(const std::vector<std::string>& args) override;
+    void setArguments(std::vector<std::string> args) override;
+    void assignArguments(const std::pmr::vector<std::pmr::string>& args) override;
+    bool reset() override;
 
     std::string getName() const override {
         return "pwd";
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../command.hpp"
+#include "../external_sorter.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда sort — сортировка строк
+ *
+ * Форма: sort [-nru] [-t C] [-k POS1[,POS2]]... [-S SIZE] [-T DIR] [FILE...].
+ * Флаги: -n — числовое сравнение, -r — обратный порядок, -u — только
+ * первая из строк с равными ключами, -t — разделитель полей, -k — ключ
+ * (POS = F[.C][nr]), -S — бюджет памяти (K, M, G; без суффикса — КиБ),
+ * -T — каталог временных файлов (по умолчанию $TMPDIR или /tmp).
+ * Строки сравниваются побайтно (локаль C).
+ *
+ * Сортировка выполняется ExternalSorter: куски сортируются параллельно
+ * на общем пуле потоков, при нехватке памяти сбрасываются во временные
+ * файлы и сливаются. Без файлов читается входной поток. Код возврата:
+ * 0 — успех, 2 — ошибка.
+ */
+class SortCommand : public Command {
+public:
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+
+    std::string getName() const override {
+        return "sort";
+    }
+
+private:
+    std::vector<std::string> args_;
+    SortOptions options_;
+    size_t memoryBudget_ = 0;
+    std::string tempDir_;
+    std::vector<std::string> filenames_;
+
+    bool parseArguments(std::ostream& err);
+    static bool parseKey(const std::string& spec, SortKey& key);
+    static bool parseSize(const std::string& text, size_t& size);
+};
+
+}  // namespace shell
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../command.hpp"
+#include "../input_file.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда tail — последние строки входа
+ *
+ * Форма: tail [-f | -F] [-n N | -N] [FILE...], по умолчанию 10 строк.
+ * При нескольких файлах вывод каждого предваряется заголовком
+ * `==> FILE <==`. Обычный файл читается блоками с конца, пока не
+ * найдено N строк, поэтому время не зависит от размера файла. Поток
+ * читается целиком, но в памяти остаются только блоки, содержащие
+ * последние N строк.
+ *
+ * -f — после вывода ждать дописывания файлов и выводить новые данные;
+ * -F — то же, но следить за именем: при ротации (файл по имени сменил
+ * inode) или появлении файла он открывается заново. Ожидание — через
+ * inotify (вне Linux — периодическая проверка), читается только
+ * дописанный диапазон байт. Слежение прекращается по Ctrl-C
+ * (Interrupt) или когда вывод больше не принимается. Код возврата:
+ * 0 — успех, 1 — ошибка, 130 — прервано.
+ */
+class TailCommand : public Command {
+public:
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+
+    std::string getName() const override {
+        return "tail";
+    }
+
+private:
+    std::vector<std::string> args_;
+    std::vector<std::string> filenames_;
+    size_t lines_ = 10;
+    bool follow_ = false;
+    bool followName_ = false;  ///< -F: следить за именем, а не за дескриптором
+
+    /**
+     * @brief Файл, за которым следит -f/-F
+     */
+    struct Followed {
+        std::string name;
+        InputFile file;
+        uint64_t device = 0;
+        uint64_t inode = 0;
+        uint64_t offset = 0;  ///< Сколько байт уже выведено
+        int watch = -1;       ///< Дескриптор наблюдения inotify
+    };
+
+    bool parseArguments(std::ostream& err);
+    bool tailFile(InputFile& file, std::ostream& out, uint64_t& shown) const;
+    void tailStream(std::istream& in, std::ostream& out) const;
+    int followFiles(std::vector<Followed>& files, std::ostream& out, std::ostream& err) const;
+    bool reopen(Followed& followed, std::ostream& err) const;
+};
+
+}  // namespace shell
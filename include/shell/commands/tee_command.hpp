@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "../command.hpp"
+#include "../environment.hpp"
+#include "../path_cache.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда tee — копирование входа в выход, файлы и программы
+ *
+ * Форма: tee [-a] [FILE | >(PROGRAM ARGS...)]... Вход копируется в
+ * выходной поток и в каждый FILE (-a — дописывать, а не перезаписывать);
+ * для `>(PROGRAM ARGS...)` запускается программа, которая получает
+ * копию на stdin, а её stdout совпадает со stdout shell.
+ *
+ * Каждый прочитанный блок хранится в одном буфере и пишется во все
+ * приёмники. На Linux при двух и более приёмниках-дескрипторах блок
+ * копируется в ядро один раз — во внутренний канал, — а приёмникам
+ * раздаётся через tee(2) и splice(2) без повторного копирования из
+ * памяти процесса; блок тогда не больше ёмкости внутренних каналов.
+ * Код возврата: 0 — успех, 1 — ошибка открытия или записи, иначе код
+ * завершения программы-приёмника.
+ */
+class TeeCommand : public Command {
+public:
+    /**
+     * @param env Окружение для запускаемых программ (nullptr — `>(...)` недоступно)
+     * @param pathCache Кэш путей команд (nullptr — искать в PATH при каждом запуске)
+     */
+    explicit TeeCommand(Environment* env = nullptr, PathCache* pathCache = nullptr);
+
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+
+    std::string getName() const override {
+        return "tee";
+    }
+
+private:
+    /**
+     * @brief Приёмник копии: файл или канал на stdin программы
+     */
+    struct Sink {
+        std::string name;
+        int fd = -1;
+        pid_t pid = -1;          ///< Процесс программы-приёмника
+        bool spliceable = true;  ///< Поддерживает ли приёмник splice
+    };
+
+    Environment* env_;
+    PathCache* pathCache_;
+    std::vector<std::string> args_;
+    std::vector<Sink> sinks_;
+    int exitCode_ = 0;
+    int block_[2] = {-1, -1};  ///< Внутренний канал с очередным блоком (Linux)
+    int copy_[2] = {-1, -1};   ///< Канал для копии блока, передаваемой приёмнику
+
+    bool openSinks(std::ostream& err);
+    bool startProgram(const std::vector<std::string>& words, std::ostream& err);
+    void fanOut(const char* data, size_t size, std::ostream& err);
+    bool spliceBlock(Sink& sink, const char* data, size_t size, bool last);
+    void fail(Sink& sink, std::ostream& err);
+    void closePipes();
+    void closeAll();
+};
+
+}  // namespace shell
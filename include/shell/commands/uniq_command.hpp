@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../command.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команда uniq — схлопывание соседних повторяющихся строк
+ *
+ * Форма: uniq [-cdu] [FILE]. Флаги: -c — предварять строку числом
+ * повторов, -d — выводить только повторявшиеся строки, -u — только
+ * неповторявшиеся. Сравниваются соседние строки, как в POSIX uniq;
+ * подсчёт без предварительной сортировки выполняет count. Вход
+ * обрабатывается потоково. Код возврата: 0 — успех, 1 — ошибка.
+ */
+class UniqCommand : public Command {
+public:
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+
+    void setArguments(std::vector<std::string> args) override;
+    void assignArguments(const std::pmr::vector<std::pmr::string>& args) override;
+    bool reset() override;
+
+    std::string getName() const override {
+        return "uniq";
+    }
+
+private:
+    std::vector<std::string> args_;
+    bool count_ = false;
+    bool repeatedOnly_ = false;
+    bool uniqueOnly_ = false;
+};
+
+}  // namespace shell
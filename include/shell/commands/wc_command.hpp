@@ -1,33 +1,67 @@
 #pragma once
 
-#include "../command.hpp"
+#include "../coroutine_stage.hpp"
+#include "../text_counter.hpp"
 
 namespace shell {
 
+class IoRing;
+
 /**
- * @brief Команда wc — подсчёт строк, слов и байт
+ * @brief Команда wc — подсчёт строк, слов, символов и байт
+ *
+ * Флаги -l, -w, -m, -c ограничивают вывод соответствующими счётчиками
+ * (по умолчанию выводятся строки, слова и байты). Символы и пробелы
+ * Unicode для -w определяются по UTF-8; --check-utf8 дополнительно
+ * сообщает о некорректных последовательностях (код возврата 1). Данные читаются блоками
+ * фиксированного размера, обычные файлы отображаются в память,
+ * а для одного -c по обычному файлу используется размер из fstat.
+ *
+ * Несколько файлов считаются параллельно на общем пуле потоков (вывод —
+ * в порядке аргументов), большой обычный файл делится на куски,
+ * которые также считаются параллельно. Если файлов много, они
+ * открываются и читаются пачками через io_uring (IoRing) и считаются
+ * по мере чтения.
+ *
+ * Стадией-сопрограммой wc считает вход по кускам; файлы считаются так
+ * же, как в execute(). С аргументом "-" (вход среди файлов) команда
+ * стадией не работает.
  */
-class WcCommand : public Command {
+class WcCommand : public StageCommand {
 public:
-    int execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    CommandResult execute(std::istream& in, std::ostream& out, std::ostream& err) override;
+    StageTask stage(StageIO& io) override;
+    StageCommand* asStage() override;
 
-    void setArguments(const std::vector<std::string>& args) override;
+    void setArguments(std::vector<std::string> args) override;
+    void assignArguments(const std::pmr::vector<std::pmr::string>& args) override;
+    bool reset() override;
 
     std::string getName() const override {
         return "wc";
     }
 
 private:
+    using Counts = TextCounter::Counts;
+
+    std::vector<std::string> args_;
     std::vector<std::string> filenames_;
+    unsigned mode_ = TextCounter::kAll;
 
-    struct Counts {
-        size_t lines = 0;
-        size_t words = 0;
-        size_t bytes = 0;
+    /**
+     * @brief Результат подсчёта одного файла (error пуст при успехе)
+     */
+    struct FileResult {
+        Counts counts;
+        std::string error;
     };
 
+    bool parseArguments(std::ostream& err);
     Counts countStream(std::istream& stream);
+    FileResult countFile(const std::string& filename) const;
+    int countFilesInRing(IoRing& ring, std::ostream& out, std::ostream& err);
     void printCounts(std::ostream& out, const Counts& counts, const std::string& filename = "");
+    static bool reportInvalid(std::ostream& err, const Counts& counts, const std::string& name);
 };
 
 }  // namespace shell
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "environment.hpp"
+#include "path_cache.hpp"
+
+namespace shell {
+
+class CommandFactory;
+
+/**
+ * @brief Префиксное дерево имён с подсчётом повторов
+ *
+ * Одно имя может быть добавлено несколько раз (например, программа с
+ * тем же именем в двух каталогах PATH) и остаётся в дереве, пока не
+ * удалено столько же раз. Имена с префиксом перечисляются в
+ * лексикографическом порядке без полного перебора.
+ */
+class NameTrie {
+public:
+    NameTrie();
+
+    void insert(std::string_view name);
+
+    /**
+     * @brief Удалить одно вхождение имени (отсутствующее имя игнорируется)
+     */
+    void erase(std::string_view name);
+
+    /**
+     * @brief Различные имена с префиксом prefix по порядку, не больше limit
+     */
+    std::vector<std::string> withPrefix(std::string_view prefix, size_t limit = SIZE_MAX) const;
+
+    /**
+     * @brief Число различных имён
+     */
+    size_t size() const {
+        return nodes_[0].names;
+    }
+
+private:
+    struct Node {
+        std::vector<std::pair<char, uint32_t>> children;  ///< По возрастанию символа
+        uint32_t count = 0;                               ///< Сколько раз добавлено имя узла
+        size_t names = 0;  ///< Различных имён в поддереве
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_;
+
+    uint32_t child(uint32_t node, char c) const;
+    void collect(uint32_t node, std::string& name, size_t limit,
+                 std::vector<std::string>& out) const;
+};
+
+/**
+ * @brief Имена исполняемых файлов из каталогов PATH
+ *
+ * Каталоги читаются в фоне (getdents64), имена собираются в NameTrie.
+ * Список каталогов и признак изменения берутся из PathCache
+ * (directoryStamps: inotify, без него — mtime), поэтому индекс и кэш
+ * путей одинаково видят PATH. Каждое обращение (refresh) не блокируется:
+ * запускает чтение только тех каталогов, чья отметка изменилась, а
+ * готовые результаты заменяют в дереве имена своего каталога. Пока
+ * каталог читается, в дереве остаются его прежние имена.
+ *
+ * Чтение идёт в отдельном потоке, а не на ThreadPool::shared(): индекс
+ * заполняется при старте shell, и пул создавался бы раньше, чем
+ * пользователь успеет задать SHELL_THREADS.
+ */
+class ExecutableIndex {
+public:
+    explicit ExecutableIndex(PathCache& paths);
+
+    /**
+     * @brief Учесть готовые чтения и запустить нужные (не ждёт)
+     */
+    void refresh();
+
+    /**
+     * @brief Имена с префиксом (после refresh)
+     */
+    std::vector<std::string> complete(std::string_view prefix, size_t limit = SIZE_MAX);
+
+    /**
+     * @brief Дождаться всех запущенных чтений (для тестов)
+     */
+    void waitForScans();
+
+    /**
+     * @brief Сколько раз каталоги были прочитаны (для тестов)
+     */
+    size_t scanCount() const {
+        return scans_;
+    }
+
+private:
+    struct Directory {
+        uint64_t stamp = 0;  ///< Отметка PathCache, с которой запущено чтение; 0 — не читался
+        std::vector<std::string> names;
+        std::future<std::vector<std::string>> pending;
+    };
+
+    PathCache& paths_;
+    std::vector<std::string> order_;  ///< Каталоги PATH без повторов
+    std::unordered_map<std::string, Directory> dirs_;
+    NameTrie trie_;
+    size_t scans_ = 0;
+
+    void apply(Directory& dir, std::vector<std::string> names);
+    static std::vector<std::string> scan(const std::string& path);
+};
+
+/**
+ * @brief Дополнение слова под курсором по Tab
+ *
+ * Первое слово команды (в начале строки, после '|' или после
+ * присваиваний) дополняется именами встроенных команд, команд плагинов
+ * и программ из PATH (ExecutableIndex); слово с '/' — путём. Слово,
+ * начинающееся с '$', дополняется именем переменной, остальные — путём
+ * к файлу (каталоги получают '/', "~/" — домашний каталог).
+ */
+class Completer {
+public:
+    /**
+     * @brief Варианты замены слова line[start, cursor)
+     */
+    struct Result {
+        size_t start = 0;
+        std::vector<std::string> candidates;  ///< По порядку, без повторов
+    };
+
+    Completer(const Environment& env, CommandFactory& factory);
+
+    /**
+     * @brief Начать чтение каталогов PATH в фоне (до первого Tab)
+     */
+    void prefetch();
+
+    Result complete(std::string_view line, size_t cursor);
+
+    /**
+     * @brief Индекс программ из PATH (для тестов)
+     */
+    ExecutableIndex& executables() {
+        return executables_;
+    }
+
+    /**
+     * @brief Общий префикс всех вариантов
+     */
+    static std::string commonPrefix(const std::vector<std::string>& candidates);
+
+private:
+    const Environment& env_;
+    const CommandFactory& factory_;
+    ExecutableIndex executables_;
+
+    std::vector<std::string> completeCommand(std::string_view word);
+    std::vector<std::string> completeVariable(std::string_view word) const;
+    std::vector<std::string> completePath(std::string_view word, bool commandsOnly) const;
+};
+
+}  // namespace shell
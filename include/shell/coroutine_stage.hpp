@@ -0,0 +1,244 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "command.hpp"
+
+namespace shell {
+
+/**
+ * @brief Канал между стадиями-сопрограммами с ограниченным буфером
+ */
+struct StageChannel {
+    /// Сколько байт писатель копит, прежде чем уступить читателю
+    static constexpr size_t kLimit = 64 * 1024;
+
+    std::string data;
+    bool closed = false;     ///< Писатель завершился
+    bool abandoned = false;  ///< Читатель завершился: запись бесполезна
+};
+
+/**
+ * @brief Вход, вывод ошибок и состояние ожидания одной стадии
+ *
+ * Тело стадии читает вход через `co_await io.read()` и отдаёт вывод
+ * через `co_yield`. Всё, что нужно планировщику, хранится здесь.
+ */
+class StageIO {
+public:
+    /// Чего ждёт приостановленная стадия
+    enum class Wait { kStart, kInput, kOutput, kNone };
+
+    StageIO(StageChannel& input, StageChannel& output, std::ostream& errors)
+        : err(errors), input_(input), output_(output) {}
+
+    std::ostream& err;
+
+    /**
+     * @brief Ожидание очередного куска входа
+     *
+     * Результат `co_await` — всё накопленное во входном канале; пустой
+     * кусок означает конец входа. Кусок действителен до следующего read().
+     */
+    class ReadAwaiter {
+    public:
+        explicit ReadAwaiter(StageIO& io) : io_(io) {}
+
+        bool await_ready() const noexcept {
+            return !io_.input_.data.empty() || io_.input_.closed;
+        }
+
+        void await_suspend(std::coroutine_handle<>) noexcept {
+            io_.wait_ = Wait::kInput;
+        }
+
+        std::string_view await_resume() noexcept {
+            io_.wait_ = Wait::kNone;
+            io_.chunk_.clear();
+            io_.chunk_.swap(io_.input_.data);
+            return io_.chunk_;
+        }
+
+    private:
+        StageIO& io_;
+    };
+
+    ReadAwaiter read() {
+        return ReadAwaiter(*this);
+    }
+
+    Wait waiting() const {
+        return wait_;
+    }
+
+    /**
+     * @brief Может ли стадия продолжить работу
+     */
+    bool ready() const {
+        switch (wait_) {
+            case Wait::kStart:
+                return true;
+            case Wait::kInput:
+                return !input_.data.empty() || input_.closed;
+            case Wait::kOutput:
+                return output_.data.size() < StageChannel::kLimit || output_.abandoned;
+            case Wait::kNone:
+                break;
+        }
+        return false;
+    }
+
+private:
+    friend class StageTask;
+
+    StageChannel& input_;
+    StageChannel& output_;
+    std::string chunk_;
+    Wait wait_ = Wait::kStart;
+};
+
+/**
+ * @brief Стадия пайплайна, написанная как сопрограмма C++20
+ *
+ * Сопрограмма создаётся приостановленной и продолжается планировщиком
+ * runStages. `co_yield` копирует кусок в выходной канал и уступает
+ * управление, только если канал заполнен; его значение — false, когда
+ * следующая стадия больше не читает (`if (!(co_yield chunk))`).
+ * `co_return` задаёт код возврата.
+ */
+class StageTask {
+public:
+    class promise_type {
+    public:
+        /// StageIO — первый параметр сопрограммы (у метода — после самого объекта)
+        template <typename Self, typename... Args>
+        promise_type(Self&, StageIO& io, Args&&...) : io_(io) {}
+
+        template <typename... Args>
+        explicit promise_type(StageIO& io, Args&&...) : io_(io) {}
+
+        StageTask get_return_object() {
+            return StageTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        void return_value(int code) {
+            code_ = code;
+        }
+
+        void unhandled_exception() {
+            exception_ = std::current_exception();
+        }
+
+        class YieldAwaiter {
+        public:
+            explicit YieldAwaiter(StageIO& io) : io_(io) {}
+
+            bool await_ready() const noexcept {
+                return io_.output_.data.size() < StageChannel::kLimit || io_.output_.abandoned;
+            }
+
+            void await_suspend(std::coroutine_handle<>) noexcept {
+                io_.wait_ = Wait::kOutput;
+            }
+
+            bool await_resume() noexcept {
+                io_.wait_ = Wait::kNone;
+                return !io_.output_.abandoned;
+            }
+
+        private:
+            using Wait = StageIO::Wait;
+            StageIO& io_;
+        };
+
+        YieldAwaiter yield_value(std::string_view chunk) {
+            if (!io_.output_.abandoned) {
+                io_.output_.data.append(chunk);
+            }
+            return YieldAwaiter(io_);
+        }
+
+    private:
+        friend class StageTask;
+
+        StageIO& io_;
+        int code_ = 0;
+        std::exception_ptr exception_;
+    };
+
+    StageTask(StageTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    StageTask& operator=(StageTask&& other) noexcept;
+    StageTask(const StageTask&) = delete;
+    StageTask& operator=(const StageTask&) = delete;
+    ~StageTask();
+
+    bool done() const {
+        return handle_.done();
+    }
+
+    /**
+     * @brief Продолжить стадию до следующей приостановки
+     */
+    void resume() {
+        handle_.resume();
+    }
+
+    StageIO& io() const {
+        return handle_.promise().io_;
+    }
+
+    /**
+     * @brief Код возврата завершившейся стадии; исключение из тела пробрасывается
+     */
+    int result() const;
+
+private:
+    explicit StageTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Встроенная команда, которая может работать стадией-сопрограммой
+ */
+class StageCommand : public Command {
+public:
+    /**
+     * @brief Тело стадии; io живёт дольше сопрограммы
+     */
+    virtual StageTask stage(StageIO& io) = 0;
+
+    StageCommand* asStage() override {
+        return this;
+    }
+};
+
+/**
+ * @brief Выполнить стадии в одном потоке, чередуя их по готовности
+ *
+ * channels содержит stages.size() + 1 каналов: channels[i] — вход
+ * стадии i, последний — её выход. Вход первой стадии подкачивается из
+ * in (nullptr — пустой вход), вывод последней сразу пишется в out.
+ * Стадии продолжаются от последней к первой, чтобы данные уходили
+ * дальше, прежде чем производители наполнят каналы снова.
+ * @return Коды возврата стадий (исключение стадии — сообщение в err и код 1)
+ */
+std::vector<CommandResult> runStages(std::vector<StageTask>& stages,
+                                     std::vector<StageChannel>& channels, std::istream* in,
+                                     std::ostream& out, std::ostream& err);
+
+}  // namespace shell
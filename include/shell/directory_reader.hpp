@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace shell {
+
+/**
+ * @brief Элемент каталога: имя и тип из d_type
+ *
+ * Если файловая система не сообщает тип, type равен DT_UNKNOWN и
+ * вызывающий код сам выполняет stat.
+ */
+struct DirEntry {
+    std::string name;
+    unsigned char type;
+};
+
+/**
+ * @brief Прочитать все элементы открытого каталога, кроме «.» и «..»
+ *
+ * На Linux записи читаются системным вызовом getdents64 блоками по
+ * 64 КиБ (буфер на поток), на других системах — через readdir.
+ * @param fd Дескриптор каталога (не закрывается)
+ * @param entries Сюда добавляются элементы в порядке каталога
+ * @return false при ошибке чтения (errno сохраняется)
+ */
+bool readDirectory(int fd, std::vector<DirEntry>& entries);
+
+}  // namespace shell
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -50,13 +51,30 @@ public:
      */
     std::vector<std::string> toEnvp() const;
 
+    /**
+     * @brief Имена всех определённых переменных
+     */
+    std::vector<std::string> names() const;
+
     /**
      * @brief Инициализировать из системного окружения
      */
     void initFromSystem();
 
+    /**
+     * @brief Получить номер версии окружения
+     *
+     * Увеличивается при каждом изменении переменных. Позволяет кэшам,
+     * зависящим от окружения (например, PathCache), дёшево проверять
+     * актуальность без сравнения значений.
+     */
+    uint64_t getVersion() const {
+        return version_;
+    }
+
 private:
     std::unordered_map<std::string, std::string> variables_;
+    uint64_t version_ = 0;
 };
 
 }  // namespace shell
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "environment.hpp"
 #include "parsed_command.hpp"
 #include "pipeline.hpp"
@@ -53,8 +55,40 @@ private:
     bool exitRequested_ = false;
     int exitCode_ = 0;
 
+    /**
+     * @brief Обработать управляющий сигнал результата команды
+     * @return true, если сигнал был (например, запрошен выход)
+     */
+    bool handleControl(const CommandResult& result);
+
     int executeSingleCommand(Command& cmd);
     int executePipeline(Pipeline& pipeline);
+
+    /**
+     * @brief Выполнить пайплайн из команд-сопрограмм в вызывающем потоке
+     *
+     * Стадии чередуются планировщиком runStages и обмениваются данными
+     * через ограниченные буферы; потоки не создаются.
+     */
+    int executeStages(Pipeline& pipeline);
+
+#ifdef __linux__
+    /**
+     * @brief Выполнить пайплайн с внешними программами в цикле событий
+     *
+     * Программы запускаются без потоков: их каналы, pidfd и дескриптор
+     * прерывания обслуживает один Reactor в потоке исполнителя, данные
+     * между программами и встроенными стадиями пересылаются неблокирующим
+     * вводом-выводом. Потоки создаются только для встроенных стадий.
+     */
+    int executeWithReactor(Pipeline& pipeline);
+#endif
+
+    /**
+     * @brief Обработать управляющие сигналы стадий и обновить $?
+     * @return Код возврата последней стадии
+     */
+    int finishPipeline(const std::vector<CommandResult>& results);
 };
 
 }  // namespace shell
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace shell {
+
+class ThreadPool;
+
+/**
+ * @brief Ключ сортировки (-k F1[.C1][,F2[.C2]])
+ *
+ * Поля нумеруются с 1. Без разделителя поле — это пробельные символы
+ * и следующие за ними непробельные (ведущие пробелы входят в поле).
+ */
+struct SortKey {
+    size_t startField = 1;
+    size_t startChar = 0;  ///< 0 — с начала поля
+    size_t endField = 0;   ///< 0 — до конца строки
+    size_t endChar = 0;    ///< 0 — до конца поля endField
+    bool numeric = false;
+    bool reverse = false;
+};
+
+/**
+ * @brief Параметры сортировки строк
+ */
+struct SortOptions {
+    std::vector<SortKey> keys;  ///< Пусто — вся строка
+    char separator = '\0';
+    bool hasSeparator = false;
+    bool numeric = false;  ///< -n для ключей без собственных флагов
+    bool reverse = false;  ///< -r для ключей без собственных флагов и сравнения строк целиком
+    bool unique = false;
+};
+
+/**
+ * @brief Сравнение строк по ключам сортировки
+ *
+ * При равенстве ключей строки сравниваются целиком побайтно (кроме
+ * режима unique, где равенство ключей означает равенство строк).
+ * Для быстрой сортировки строке сопоставляется 64-битный префикс
+ * первого ключа: из prefix(a) < prefix(b) следует a < b, при равных
+ * префиксах нужно полное сравнение.
+ */
+class LineComparator {
+public:
+    explicit LineComparator(const SortOptions& options);
+
+    /**
+     * @brief Сравнить строки (без перевода строки)
+     * @return Отрицательное, ноль или положительное число
+     */
+    int compare(std::string_view a, std::string_view b) const;
+
+    /**
+     * @brief Порядковый префикс первого ключа
+     * @param offset Смещение в ключе (для ключа-строки: следующие 8 байт)
+     */
+    uint64_t prefix(std::string_view line, size_t offset = 0) const;
+
+    /**
+     * @brief Первый ключ строки
+     */
+    std::string_view firstKey(std::string_view line) const;
+
+    /**
+     * @brief Определяется ли порядок только байтами первого ключа
+     *
+     * Тогда строки с равными ключами равны, а упорядочить их можно
+     * поразрядно по префиксам с возрастающим смещением.
+     */
+    bool bytesDecide() const;
+
+    /**
+     * @brief Числовое сравнение (-n): необязательный минус, цифры, дробная часть
+     */
+    static int compareNumeric(std::string_view a, std::string_view b);
+
+private:
+    std::vector<SortKey> keys_;
+    char separator_;
+    bool hasSeparator_;
+    bool reverse_;
+    bool lastResort_;  ///< Сравнивать строки целиком при равных ключах
+
+    std::string_view extract(std::string_view line, const SortKey& key) const;
+    const char* fieldStart(const char* begin, const char* end, size_t field) const;
+    const char* fieldEnd(const char* pos, const char* end) const;
+};
+
+/**
+ * @brief Внешняя сортировка строк с ограничением памяти
+ *
+ * Данные подаются блоками через write(). Они копируются в куски
+ * фиксированного размера; каждый кусок сортируется задачей на пуле
+ * потоков (массив смещений строк упорядочивается поразрядно по
+ * префиксу ключа, строки с равными префиксами — сравнением). Пока
+ * прочитанное помещается в бюджет памяти, отсортированные куски
+ * остаются в памяти, иначе записываются во временные файлы.
+ * finish() сливает куски многопутевым слиянием на дереве
+ * проигравших; при большом числе файлов они предварительно сливаются
+ * группами.
+ */
+class ExternalSorter {
+public:
+    /**
+     * @brief Создать сортировщик
+     * @param options Параметры сравнения
+     * @param memoryBudget Бюджет памяти на данные и индексы кусков, байт
+     * @param tempDir Каталог временных файлов
+     * @param pool Пул, на котором сортируются куски
+     * @param chunkSize Размер куска (0 — chunkSizeFor(memoryBudget, pool.size()))
+     */
+    ExternalSorter(const SortOptions& options, size_t memoryBudget, std::string tempDir,
+                   ThreadPool& pool, size_t chunkSize = 0);
+    ~ExternalSorter();
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    /**
+     * @brief Добавить данные (строки разделены '\\n', последняя может быть без него)
+     * @return false при ошибке записи временного файла (см. error())
+     */
+    bool write(const char* data, size_t size);
+
+    /**
+     * @brief Отсортировать всё добавленное и вывести в out
+     * @return false при ошибке (см. error())
+     */
+    bool finish(std::ostream& out);
+
+    /**
+     * @brief Описание последней ошибки
+     */
+    const std::string& error() const {
+        return error_;
+    }
+
+    /**
+     * @brief Сколько кусков было записано во временные файлы
+     */
+    size_t spilledRuns() const {
+        return spilled_;
+    }
+
+    /**
+     * @brief Размер куска по умолчанию для бюджета и числа потоков
+     */
+    static size_t chunkSizeFor(size_t memoryBudget, size_t threads);
+
+    struct Run;
+
+private:
+    LineComparator comparator_;
+    bool unique_;
+    size_t memoryBudget_;
+    std::string tempDir_;
+    ThreadPool& pool_;
+    size_t chunkSize_;
+    std::string current_;
+    std::deque<std::future<std::unique_ptr<Run>>> pending_;
+    std::vector<std::unique_ptr<Run>> runs_;
+    size_t bytesQueued_ = 0;  ///< Данные всех кусков, отданных на сортировку
+    bool spilling_ = false;
+    size_t spilled_ = 0;
+    std::string error_;
+
+    bool dispatch(std::string chunk);
+    bool collect(std::unique_ptr<Run> run);
+    bool startSpilling();
+    bool mergeFileRuns(size_t count);
+};
+
+}  // namespace shell
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "directory_reader.hpp"
+#include "token.hpp"
+
+namespace shell {
+
+/**
+ * @brief Скомпилированный шаблон одного компонента пути
+ *
+ * Поддерживает *, ?, классы [abc], [a-z], [!x] / [^x] и экранирование
+ * '\\'. Шаблон разбирается один раз в последовательность элементов;
+ * сопоставление — жадный проход с возвратом к последней *, без
+ * построения промежуточных строк.
+ */
+class GlobPattern {
+public:
+    explicit GlobPattern(std::string_view pattern);
+
+    /**
+     * @brief Проверить, подходит ли имя под шаблон
+     */
+    bool matches(std::string_view name) const;
+
+    /**
+     * @brief Шаблон без метасимволов (сравнение по равенству)
+     */
+    bool isLiteral() const {
+        return literal_;
+    }
+
+    /**
+     * @brief Текст литерального шаблона без экранирования
+     */
+    const std::string& text() const {
+        return text_;
+    }
+
+    /**
+     * @brief Может ли шаблон совпасть со скрытым именем (начинается с '.')
+     */
+    bool matchesHidden() const {
+        return !text_.empty() && text_[0] == '.';
+    }
+
+private:
+    enum class Kind { kLiteral, kAny, kClass, kStar };
+
+    struct Element {
+        Kind kind;
+        std::string text;      ///< kLiteral
+        std::bitset<256> set;  ///< kClass
+    };
+
+    std::vector<Element> elements_;
+    std::string text_;  ///< Литеральный префикс шаблона
+    bool literal_ = true;
+
+    void appendLiteral(char c);
+};
+
+/**
+ * @brief Раскрытие шаблонов путей (*, ?, [...], **) в словах командной строки
+ *
+ * Работает после лексера: слово с непустым Token::pattern заменяется
+ * отсортированным списком подходящих путей; если совпадений нет, слово
+ * остаётся как есть. Присваивания в начале строки не раскрываются.
+ * Скрытые имена совпадают, только если компонент шаблона начинается с
+ * '.'; ** — любое число каталогов (символические ссылки не обходятся).
+ *
+ * Каталоги читаются через readDirectory (getdents64) и кэшируются. В
+ * пределах одного вызова expand() листинг используется без проверок;
+ * между вызовами — пока mtime каталога не изменился. Листинг, снятый
+ * меньше секунды спустя после изменения каталога, перечитывается: за
+ * это время каталог мог измениться без смены mtime.
+ */
+class GlobExpander {
+public:
+    /**
+     * @brief Раскрыть шаблоны в токенах строки
+     */
+    void expand(std::pmr::vector<Token>& tokens);
+
+    /**
+     * @brief Раскрыть один шаблон
+     * @return Отсортированные пути; пусто, если совпадений нет
+     */
+    std::vector<std::string> expandPattern(std::string_view pattern);
+
+    /**
+     * @brief Число каталогов в кэше (для тестов)
+     */
+    size_t cachedDirectories() const {
+        return cache_.size();
+    }
+
+private:
+    struct Listing {
+        std::vector<DirEntry> entries;
+        bool ok = false;
+        int64_t mtime = 0;     ///< mtime каталога, нс
+        int64_t listedAt = 0;  ///< Время чтения, нс
+        uint64_t generation = 0;
+    };
+
+    struct Segment {
+        GlobPattern pattern;
+        bool recursive;  ///< **
+    };
+
+    struct Query {
+        std::vector<Segment> segments;
+        bool directoriesOnly = false;  ///< Шаблон заканчивается на '/'
+        std::vector<std::string> matches;
+    };
+
+    std::unordered_map<std::string, Listing> cache_;
+    uint64_t generation_ = 0;
+    std::string cwd_;
+
+    void beginGeneration();
+    const Listing* list(const std::string& prefix);
+    void walk(Query& query, std::string& prefix, size_t index);
+};
+
+}  // namespace shell
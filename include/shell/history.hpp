@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "input_file.hpp"
+
+namespace shell {
+
+/**
+ * @brief История команд в файле, дописываемом в конец
+ *
+ * При открытии файл отображается в память и не разбирается: записи
+ * (строки файла) находятся по переводам строк при навигации. Новые
+ * записи дописываются в файл одним write и хранятся в памяти сессии.
+ *
+ * Записи адресуются позициями: смещение начала записи в файле, для
+ * записей сессии — размер файла плюс смещение в сессии. Чем больше
+ * позиция, тем новее запись; end() — позиция за последней записью.
+ *
+ * Для поиска подстроки по файлу в фоновом потоке строится индекс:
+ * суффиксный массив по различным записям в порядке их последнего
+ * появления. Пока индекс не готов, файл просматривается с конца.
+ */
+class History {
+public:
+    /**
+     * @brief Открыть историю
+     * @param path Путь к файлу истории (создаётся при первой записи)
+     */
+    explicit History(const std::string& path);
+    ~History();
+
+    History(const History&) = delete;
+    History& operator=(const History&) = delete;
+
+    /**
+     * @brief Добавить запись в конец файла и сессии
+     */
+    void add(std::string_view line);
+
+    /**
+     * @brief Позиция за последней записью
+     */
+    size_t end() const {
+        return mapped_.size() + session_.size();
+    }
+
+    /**
+     * @brief Текст записи по позиции её начала
+     */
+    std::string_view entry(size_t pos) const;
+
+    /**
+     * @brief Позиция записи, предшествующей pos (nullopt — pos первая)
+     */
+    std::optional<size_t> previous(size_t pos) const;
+
+    /**
+     * @brief Позиция записи, следующей за pos (end() после последней)
+     */
+    std::optional<size_t> next(size_t pos) const;
+
+    /**
+     * @brief Найти самую новую запись, начинающуюся раньше before и содержащую query
+     * @return Позиция записи или nullopt
+     */
+    std::optional<size_t> search(std::string_view query, size_t before) const;
+
+    /**
+     * @brief Дождаться построения индекса (для тестов)
+     */
+    void waitForIndex() const;
+
+private:
+    /**
+     * @brief Суффиксный массив по различным записям файла
+     */
+    struct Index {
+        std::string text;                ///< Записи через '\n', от старых к новым
+        std::vector<uint32_t> starts;    ///< Начало каждой записи в text
+        std::vector<uint64_t> offsets;   ///< Последнее появление записи в файле
+        std::vector<uint32_t> suffixes;  ///< Суффиксы text в лексикографическом порядке
+
+        std::optional<size_t> search(std::string_view query, uint64_t lastEntry) const;
+    };
+
+    static Index buildIndex(std::string_view data);
+
+    std::shared_ptr<InputFile> file_;  ///< Разделяется с потоком, строящим индекс
+    std::shared_ptr<const std::string> loaded_;  ///< Содержимое, прочитанное без отображения
+    std::string_view mapped_;
+    std::string session_;  ///< Записи сессии, каждая с '\n'
+    int appendFd_ = -1;
+    mutable std::future<Index> pending_;
+    mutable std::unique_ptr<Index> index_;
+
+    const Index* readyIndex() const;
+};
+
+}  // namespace shell
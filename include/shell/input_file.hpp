@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <sys/types.h>
+
+namespace shell {
+
+/**
+ * @brief Файл, открытый для чтения встроенной командой
+ *
+ * Владеет файловым дескриптором и (при необходимости) отображением
+ * файла в память. Позволяет командам выбирать способ чтения:
+ * размер из fstat, mmap для обычных файлов или блочное чтение.
+ */
+class InputFile {
+public:
+    InputFile() = default;
+
+    /**
+     * @brief Открыть файл
+     * @param path Путь к файлу
+     */
+    explicit InputFile(const std::string& path);
+    ~InputFile();
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+    InputFile(InputFile&& other) noexcept;
+    InputFile& operator=(InputFile&& other) noexcept;
+
+    /**
+     * @brief Проверить, удалось ли открыть файл
+     */
+    bool isOpen() const {
+        return fd_ >= 0;
+    }
+
+    /**
+     * @brief Описание ошибки открытия (strerror) для сообщений команд
+     */
+    std::string errorMessage() const;
+
+    /**
+     * @brief Файловый дескриптор
+     */
+    int fd() const {
+        return fd_;
+    }
+
+    /**
+     * @brief Является ли файл обычным (размер известен заранее)
+     */
+    bool isRegular() const {
+        return regular_;
+    }
+
+    /**
+     * @brief Является ли файл директорией
+     */
+    bool isDirectory() const {
+        return directory_;
+    }
+
+    /**
+     * @brief Размер файла по данным fstat
+     */
+    uint64_t size() const {
+        return size_;
+    }
+
+    /**
+     * @brief Файлы меньше этого размера не отображаются: read не медленнее
+     */
+    static constexpr uint64_t kMinMapSize = 128 * 1024;
+
+    /**
+     * @brief Сколько секунд файл не должен меняться, чтобы его отобразить
+     */
+    static constexpr int64_t kSettleSeconds = 5;
+
+    /**
+     * @brief Отобразить обычный файл в память целиком
+     *
+     * Если другой процесс обрежет отображённый файл, обращение к
+     * пропавшим страницам завершит shell сигналом SIGBUS. Поэтому
+     * отображаются только файлы не меньше kMinMapSize, не менявшиеся
+     * последние kSettleSeconds секунд: дописываемые журналы и только что
+     * перезаписанные файлы читаются через read(). Файл, давно не
+     * менявшийся, но обрезанный во время просмотра, по-прежнему приводит
+     * к SIGBUS.
+     *
+     * @return Содержимое файла; пустое, если файл пуст, не подходит для
+     *         отображения или mmap невозможен — тогда читать блоками (read)
+     */
+    std::string_view map();
+
+    /**
+     * @brief Прочитать очередной блок данных
+     * @param buffer Буфер
+     * @param capacity Размер буфера
+     * @return Число прочитанных байт, 0 при EOF, -1 при ошибке
+     */
+    ssize_t read(char* buffer, size_t capacity);
+
+private:
+    int fd_ = -1;
+    int error_ = 0;
+    bool regular_ = false;
+    bool directory_ = false;
+    uint64_t size_ = 0;
+    int64_t mtimeSec_ = 0;
+    void* mapping_ = nullptr;
+    size_t mappingSize_ = 0;
+
+    void reset() noexcept;
+};
+
+}  // namespace shell
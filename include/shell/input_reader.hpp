@@ -1,11 +1,16 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <string>
 
 namespace shell {
 
+class Completer;
+class History;
+class LineEditor;
+
 /**
  * @brief Чтение пользовательского ввода
  */
@@ -16,6 +21,15 @@ public:
      * @param input Входной поток (по умолчанию stdin)
      */
     explicit InputReader(std::istream& input = std::cin);
+    ~InputReader();
+
+    /**
+     * @brief Читать stdin через LineEditor с историей в файле
+     *        (вызывается, когда stdin — терминал)
+     * @param historyPath Файл истории
+     * @param completer Дополнение по Tab; nullptr — без дополнения
+     */
+    void enableEditing(const std::string& historyPath, Completer* completer = nullptr);
 
     /**
      * @brief Прочитать строку
@@ -23,6 +37,13 @@ public:
      */
     std::optional<std::string> readLine();
 
+    /**
+     * @brief Прочитать строку в существующий буфер (без выделения памяти
+     *        для строк, не длиннее уже прочитанных)
+     * @return false при EOF
+     */
+    bool readLine(std::string& line);
+
     /**
      * @brief Установить приглашение командной строки
      * @param prompt Строка приглашения
@@ -39,6 +60,8 @@ private:
     std::istream& input_;
     std::string prompt_ = "> ";
     bool showPrompt_ = true;
+    std::unique_ptr<History> history_;
+    std::unique_ptr<LineEditor> editor_;
 };
 
 }  // namespace shell
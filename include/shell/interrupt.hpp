@@ -0,0 +1,43 @@
+#pragma once
+
+namespace shell {
+
+/**
+ * @brief Прерывание выполняющейся команды (Ctrl-C)
+ *
+ * Обработчик SIGINT не завершает shell, а отмечает запрос прерывания
+ * и делает читаемым дескриптор fd() (self-pipe). Долго работающие
+ * встроенные команды ждут в poll() и на своих данных, и на этом
+ * дескрипторе, поэтому Ctrl-C останавливает их сразу. Внешние
+ * программы получают SIGINT от терминала сами: после execve
+ * обработчик сбрасывается к действию по умолчанию.
+ */
+class Interrupt {
+public:
+    /**
+     * @brief Установить обработчик SIGINT (вызывается REPL один раз)
+     */
+    static void install();
+
+    /**
+     * @brief Было ли запрошено прерывание после последнего clear()
+     */
+    static bool requested();
+
+    /**
+     * @brief Дескриптор, читаемый, пока прерывание не сброшено
+     */
+    static int fd();
+
+    /**
+     * @brief Запросить прерывание (то же, что делает обработчик SIGINT)
+     */
+    static void request();
+
+    /**
+     * @brief Сбросить запрос (перед выполнением очередной строки)
+     */
+    static void clear();
+};
+
+}  // namespace shell
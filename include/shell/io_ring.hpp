@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace shell {
+
+/**
+ * @brief Получатель содержимого файлов из IoRing::readFiles
+ *
+ * Вызовы идут строго в порядке файлов: все блоки файла, затем его end().
+ */
+class FileConsumer {
+public:
+    virtual ~FileConsumer() = default;
+
+    /// Очередной блок файла index; false — данные больше не нужны (вывод закрыт)
+    virtual bool data(size_t index, const char* data, size_t size) = 0;
+
+    /// Файл index закончился; error — errno открытия или чтения, 0 при успехе
+    virtual void end(size_t index, int error) = 0;
+};
+
+/**
+ * @brief Кольцо io_uring с зарегистрированными буферами (Linux)
+ *
+ * Своё у каждого потока исполнителя (local()); при завершении потока
+ * кольцо возвращается в общий запас и достаётся следующему потоку,
+ * поэтому стадии пайплайна не создают кольцо на каждую строку.
+ * Поддержка проверяется при первом обращении: без io_uring (не Linux,
+ * старое ядро, запрет в sysctl или seccomp), а также при SHELL_IO_URING=0
+ * local() возвращает nullptr, и команды читают обычным read.
+ */
+class IoRing {
+public:
+    /// Размер зарегистрированного буфера
+    static constexpr size_t kBufferSize = 64 * 1024;
+    /// Число буферов — столько файлов readFiles читает одновременно
+    static constexpr size_t kBufferCount = 16;
+
+    ~IoRing();
+
+    IoRing(const IoRing&) = delete;
+    IoRing& operator=(const IoRing&) = delete;
+
+    /**
+     * @brief Кольцо текущего потока или nullptr, если io_uring недоступен
+     */
+    static IoRing* local();
+
+    /**
+     * @brief Разрешить или запретить io_uring (для сравнения в тестах и бенчмарках)
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief Прочитать файлы целиком, передавая содержимое по порядку
+     *
+     * Открытие, чтение и закрытие до kBufferCount файлов идут в кольце
+     * одновременно: на пачку мелких файлов приходится несколько вызовов
+     * io_uring_enter вместо open/read/read/close на каждый. Данные файла,
+     * до которого не дошла очередь, копятся в его буфере. Если получатель
+     * отказался от данных, операции в кольце отменяются, открытые файлы
+     * закрываются, end() больше не вызывается.
+     */
+    void readFiles(const std::vector<std::string>& paths, FileConsumer& consumer);
+
+private:
+    struct Completion {
+        uint64_t tag;
+        int32_t result;
+    };
+
+    IoRing() = default;
+
+    static std::unique_ptr<IoRing> create();
+
+    bool init();
+    char* buffer(size_t index) const;
+
+    void* acquireSqe();
+
+    // Заполнение SQE; адреса и длины остаются действительными до завершения
+    void prepareOpen(const char* path, uint64_t tag);
+    void prepareRead(int fd, size_t bufferIndex, size_t offset, size_t length, uint64_t tag);
+    void prepareClose(int fd);
+    void prepareCancel(uint64_t tag);
+
+    // Отправить подготовленные SQE; ждать хотя бы одного завершения, если wait
+    void submit(bool wait);
+    bool pop(Completion& completion);
+    Completion next();
+
+    int fd_ = -1;
+    void* sqRing_ = nullptr;
+    size_t sqRingSize_ = 0;
+    void* cqRing_ = nullptr;
+    size_t cqRingSize_ = 0;
+    void* sqes_ = nullptr;
+    size_t sqesSize_ = 0;
+
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned sqEntries_ = 0;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    void* cqes_ = nullptr;
+    unsigned cqMask_ = 0;
+
+    std::unique_ptr<char[]> buffers_;
+    char* aligned_ = nullptr;
+    bool fixed_ = false;  // буферы зарегистрированы: READ_FIXED
+    size_t closes_ = 0;   // незавершённые IORING_OP_CLOSE
+
+    friend struct IoRingLease;
+};
+
+}  // namespace shell
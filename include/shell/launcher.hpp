@@ -0,0 +1,90 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace shell {
+
+/**
+ * @brief Запущенный процесс
+ */
+struct SpawnedProcess {
+    pid_t pid = -1;  ///< -1 при ошибке запуска
+    int pidfd = -1;  ///< pidfd процесса или -1, если он недоступен
+};
+
+/**
+ * @brief Процесс-запускатель (zygote) для внешних команд
+ *
+ * fork копирует таблицы страниц вызывающего процесса, поэтому его
+ * стоимость растёт с объёмом памяти shell. Запускатель — маленький
+ * процесс, созданный при старте, пока куча shell почти пуста; он
+ * получает запросы (путь, аргументы, окружение, текущий каталог и
+ * дескрипторы stdin/stdout через SCM_RIGHTS) по socketpair и создаёт
+ * программы у себя, а обратно отправляет pidfd.
+ *
+ * Программа создаётся с CLONE_PARENT и становится дочерним процессом
+ * самого shell: её код возврата ждёт waitProcess, как и после fork.
+ * Если запускатель не работает (не вызван start(), не Linux, ядро без
+ * clone3 или запрос не поместился в сообщение), spawn() запускает
+ * программу обычным fork через spawnProcess. Отказ clone3, который
+ * повторится при любом запросе (ENOSYS, EPERM, EINVAL), останавливает
+ * запускатель.
+ */
+class Launcher {
+public:
+    Launcher() = default;
+    ~Launcher();
+
+    Launcher(const Launcher&) = delete;
+    Launcher& operator=(const Launcher&) = delete;
+
+    /**
+     * @brief Общий запускатель процесса; его запускает main до создания Shell
+     */
+    static Launcher& shared();
+
+    /**
+     * @brief Создать процесс-запускатель
+     *
+     * Вызывать как можно раньше: запускатель наследует память вызывающего
+     * процесса на момент вызова.
+     * @return false, если запускатель недоступен (тогда spawn() использует fork)
+     */
+    bool start();
+
+    /**
+     * @brief Остановить запускатель; уже запущенные программы продолжают работу
+     */
+    void stop();
+
+    /**
+     * @brief Работает ли запускатель
+     */
+    bool running() const;
+
+    /**
+     * @brief Запустить программу (параметры как у spawnProcess)
+     *
+     * Безопасен для одновременного вызова из стадий пайплайна.
+     */
+    SpawnedProcess spawn(const std::string& path, const std::vector<std::string>& args,
+                         const std::vector<std::string>& env, int stdinFd, int stdoutFd);
+
+private:
+    // Отправить запрос запускателю; false — запустить программу обычным fork
+    bool request(const std::string& path, const std::vector<std::string>& args,
+                 const std::vector<std::string>& env, int stdinFd, int stdoutFd,
+                 SpawnedProcess& process);
+    // stop() под уже захваченным mutex_
+    void stopLocked();
+
+    mutable std::mutex mutex_;
+    int socket_ = -1;
+    pid_t pid_ = -1;
+};
+
+}  // namespace shell
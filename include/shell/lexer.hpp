@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "token.hpp"
@@ -14,23 +16,29 @@ namespace shell {
  * - Кавычек (одинарных и двойных)
  * - Специальных символов (|, =)
  * - Пробелов как разделителей
+ *
+ * Для слов с метасимволами *, ?, [ вне кавычек заполняет Token::pattern
+ * (см. GlobExpander).
  */
 class Lexer {
 public:
     /**
      * @brief Создать лексер для входной строки
      * @param input Строка для анализа
+     * @param resource Ресурс памяти для токенов (арена строки)
      */
-    explicit Lexer(const std::string& input);
+    explicit Lexer(std::string_view input,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Выполнить токенизацию
-     * @return Вектор токенов
+     * @return Вектор токенов в ресурсе лексера
      */
-    std::vector<Token> tokenize();
+    std::pmr::vector<Token> tokenize();
 
 private:
-    std::string input_;
+    std::pmr::memory_resource* resource_;
+    std::pmr::string input_;
     size_t position_;
 
     char peek() const;
@@ -40,6 +48,7 @@ private:
     Token readQuotedString(char quote);
     bool isSpecialChar(char c) const;
     bool isWordChar(char c) const;
+    bool isGlobChar(char c) const;
 };
 
 }  // namespace shell
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace shell {
+
+/**
+ * @brief Арена памяти для обработки одной строки команды
+ *
+ * Монотонный ресурс (std::pmr::monotonic_buffer_resource) поверх
+ * заранее выделенного буфера: токены, AST, пайплайн и объекты команд
+ * строки берут память из него, освобождение отдельных блоков ничего не
+ * стоит. После выполнения строки reset() освобождает всё сразу. Если
+ * строке не хватило буфера, при reset() буфер увеличивается до
+ * использованного объёма, поэтому в установившемся режиме строки не
+ * обращаются к глобальной куче.
+ *
+ * Не потокобезопасна: используется только потоком REPL.
+ */
+class LineArena {
+public:
+    /**
+     * @brief Создать арену
+     * @param initialSize Начальный размер буфера, байт
+     */
+    explicit LineArena(size_t initialSize = 16 * 1024);
+
+    LineArena(const LineArena&) = delete;
+    LineArena& operator=(const LineArena&) = delete;
+
+    /**
+     * @brief Ресурс памяти для контейнеров строки
+     */
+    std::pmr::memory_resource* resource() {
+        return &*resource_;
+    }
+
+    /**
+     * @brief Освободить всю память строки (объекты должны быть уже разрушены)
+     */
+    void reset();
+
+    /**
+     * @brief Текущий размер буфера, байт
+     */
+    size_t capacity() const {
+        return size_;
+    }
+
+private:
+    /**
+     * @brief Вышестоящий ресурс: глобальная куча с подсчётом выделенного
+     */
+    class Overflow : public std::pmr::memory_resource {
+    public:
+        size_t allocated = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    Overflow overflow_;
+    size_t size_;
+    std::unique_ptr<std::byte[]> buffer_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+};
+
+}  // namespace shell
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace shell {
+
+/**
+ * @brief Подсчёт повторений строк (ключей) в хеш-таблице
+ *
+ * Таблица с открытой адресацией и линейным пробированием; в ячейке
+ * хранятся хеш, указатель на ключ и счётчик. Ключи копируются в арену —
+ * крупные блоки, которые освобождаются вместе с объектом, поэтому на
+ * каждый новый ключ нет отдельного выделения памяти. Таблица растёт
+ * вдвое при заполнении наполовину.
+ */
+class LineCounter {
+public:
+    /**
+     * @brief Ключ и число его повторений
+     */
+    struct Entry {
+        std::string_view key;
+        uint64_t count;
+    };
+
+    LineCounter();
+
+    LineCounter(const LineCounter&) = delete;
+    LineCounter& operator=(const LineCounter&) = delete;
+
+    /**
+     * @brief Учесть ключ count раз
+     */
+    void add(std::string_view key, uint64_t count = 1);
+
+    /**
+     * @brief Число различных ключей
+     */
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+     * @brief Все ключи по убыванию счётчика (при равенстве — по возрастанию ключа)
+     */
+    std::vector<Entry> sorted() const;
+
+    /**
+     * @brief Не более k ключей с наибольшими счётчиками, в порядке sorted()
+     *
+     * Выбираются кучей размера k за O(n log k).
+     */
+    std::vector<Entry> top(size_t k) const;
+
+private:
+    struct Slot {
+        uint64_t hash;
+        const char* key;
+        size_t length;
+        uint64_t count;  ///< 0 — ячейка пуста
+    };
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* arenaPos_ = nullptr;
+    size_t arenaLeft_ = 0;
+
+    const char* store(std::string_view key);
+    void grow();
+};
+
+}  // namespace shell
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "history.hpp"
+
+namespace shell {
+
+class Completer;
+
+/**
+ * @brief Редактирование строки ввода в терминале
+ *
+ * На время чтения строки терминал переводится в неканонический режим
+ * без эха; если вход — не терминал, режим не меняется, а байты
+ * разбираются так же (на этом построены тесты).
+ *
+ * Клавиши: стрелки, Home/End, Ctrl-A/E/B/F — перемещение; Backspace,
+ * Delete, Ctrl-D (на пустой строке — конец ввода), Ctrl-K/U/W —
+ * удаление; Up/Down, Ctrl-P/N — история; Ctrl-R — обратный поиск
+ * подстроки по истории (Ctrl-R — следующее совпадение, Ctrl-G —
+ * отмена); Tab — дополнение слова (Completer; повторный Tab выводит
+ * варианты); Ctrl-C — сброс строки; Ctrl-L — очистка экрана.
+ * Курсор перемещается по символам UTF-8.
+ */
+class LineEditor {
+public:
+    /**
+     * @brief Создать редактор
+     * @param inputFd Дескриптор ввода (обычно STDIN_FILENO)
+     * @param output Поток для эха и перерисовки строки
+     * @param history История, в которую попадают введённые строки
+     */
+    LineEditor(int inputFd, std::ostream& output, History& history);
+
+    /**
+     * @brief Прочитать строку
+     * @param prompt Приглашение
+     * @param line Прочитанная строка
+     * @return false при конце ввода
+     */
+    bool readLine(const std::string& prompt, std::string& line);
+
+    /**
+     * @brief Подключить дополнение по Tab (nullptr — Tab игнорируется)
+     */
+    void setCompleter(Completer* completer) {
+        completer_ = completer;
+    }
+
+private:
+    int fd_;
+    std::ostream& out_;
+    History& history_;
+    std::string prompt_;
+    std::string buffer_;
+    size_t cursor_ = 0;
+    Completer* completer_ = nullptr;
+
+    /// Чтение байта; -1 — конец ввода
+    int readByte();
+    /// Разбор ESC-последовательности в код клавиши
+    int readEscape();
+    /// Обратный поиск; возвращает клавишу, завершившую поиск
+    int reverseSearch();
+
+    void setBuffer(std::string_view text);
+    void historyStep(bool older);
+    /// Дополнение слова под курсором; list — показать варианты
+    void complete(bool list);
+    void refresh();
+
+    size_t historyPos_ = 0;
+    std::string draft_;  ///< Строка, которую вводили до перехода по истории
+};
+
+}  // namespace shell
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace shell {
+
+/**
+ * @brief Поиск подстроки в буфере
+ *
+ * Кандидаты отбираются векторным фильтром по первому и последнему байту
+ * образца (AVX2/SSE2 на x86-64, выбор при первом обращении) и
+ * проверяются сравнением средней части; для однобайтного образца
+ * используется memchr. Без учёта регистра сравниваются только латинские
+ * буквы ASCII.
+ */
+class LiteralSearcher {
+public:
+    /**
+     * @brief Подготовить образец
+     * @param needle Искомая строка
+     * @param ignoreCase Не учитывать регистр ASCII-букв
+     */
+    explicit LiteralSearcher(std::string needle, bool ignoreCase = false);
+
+    /**
+     * @brief Найти первое вхождение образца
+     * @return Указатель на начало вхождения или end, если его нет
+     */
+    const char* find(const char* begin, const char* end) const;
+
+    /**
+     * @brief Длина образца
+     */
+    size_t size() const {
+        return needle_.size();
+    }
+
+private:
+    std::string needle_;  ///< При ignoreCase — в нижнем регистре
+    bool ignoreCase_;
+};
+
+}  // namespace shell
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace shell {
+
+/**
+ * @brief Поиск любой из множества строк в буфере
+ *
+ * По образцам строится автомат Ахо–Корасик над классами байт: состояния
+ * малой глубины и с большим числом переходов хранят полную строку
+ * переходов, остальные — список переходов и ссылку неудачи. Для небольших
+ * наборов (до 32 образцов) на x86-64 с SSSE3/AVX2 кандидаты сначала
+ * отбираются векторным фильтром Teddy по первым байтам образцов, а
+ * проверяются сравнением. Без учёта регистра сравниваются только
+ * латинские буквы ASCII. Объект неизменяем после построения и может
+ * использоваться из нескольких потоков.
+ */
+class MultiLiteralSearcher {
+public:
+    /**
+     * @brief Построить автомат
+     * @param patterns Искомые строки (пустая строка совпадает в любой позиции)
+     * @param ignoreCase Не учитывать регистр ASCII-букв
+     */
+    explicit MultiLiteralSearcher(std::vector<std::string> patterns, bool ignoreCase = false);
+    ~MultiLiteralSearcher();
+
+    MultiLiteralSearcher(const MultiLiteralSearcher&) = delete;
+    MultiLiteralSearcher& operator=(const MultiLiteralSearcher&) = delete;
+
+    /**
+     * @brief Найти вхождение одного из образцов
+     * @return Указатель на начало вхождения или end, если вхождений нет.
+     *         Из нескольких перекрывающихся вхождений возвращается одно из
+     *         самых левых (по началу или по концу — зависит от алгоритма)
+     */
+    const char* find(const char* begin, const char* end) const;
+
+    /**
+     * @brief Образцы в исходном виде
+     */
+    const std::vector<std::string>& patterns() const {
+        return patterns_;
+    }
+
+    /**
+     * @brief Число состояний автомата
+     */
+    size_t stateCount() const {
+        return nodes_.size();
+    }
+
+    /**
+     * @brief Используется ли векторный фильтр Teddy
+     */
+    bool usesTeddy() const;
+
+private:
+    struct Teddy;
+
+    /**
+     * @brief Состояние автомата
+     */
+    struct Node {
+        uint32_t fail = 0;       ///< Ссылка неудачи
+        uint32_t edges = 0;      ///< Первый переход в edgeClass_/edgeTarget_
+        uint32_t edgeCount = 0;  ///< Число переходов
+        uint32_t row = kNoRow;   ///< Номер полной строки переходов в rows_
+        uint32_t match = 0;      ///< Длина образца, оканчивающегося здесь (0 — нет)
+    };
+
+    static constexpr uint32_t kNoRow = UINT32_MAX;
+
+    std::vector<std::string> patterns_;
+    bool matchesEmpty_ = false;
+    std::array<uint8_t, 256> byteClass_{};  ///< 0 — байт не встречается в образцах
+    size_t classCount_ = 1;
+    std::vector<Node> nodes_;
+    std::vector<uint8_t> edgeClass_;
+    std::vector<uint32_t> edgeTarget_;
+    std::vector<uint32_t> rows_;
+    std::unique_ptr<Teddy> teddy_;
+
+    void build(std::vector<std::string> folded);
+    uint32_t next(uint32_t state, uint8_t cls) const;
+    const char* findAutomaton(const char* begin, const char* end) const;
+};
+
+}  // namespace shell
@@ -1,51 +1,30 @@
 #pragma once
 
-#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <vector>
 
-namespace shell {
+#include "builtin_table.hpp"
 
-/**
- * @brief Базовый класс для узлов AST
- */
-class ParsedCommand {
-public:
-    virtual ~ParsedCommand() = default;
-    virtual bool isAssignment() const {
-        return false;
-    }
-    virtual bool isPipeline() const {
-        return false;
-    }
-    virtual bool isEmpty() const {
-        return false;
-    }
-};
+namespace shell {
 
 /**
  * @brief Пустая команда (пустая строка или только пробелы)
  */
-class ParsedEmpty : public ParsedCommand {
-public:
-    bool isEmpty() const override {
-        return true;
-    }
-};
+class ParsedEmpty {};
 
 /**
  * @brief Присваивание переменной: VAR=VALUE
  */
-class ParsedAssignment : public ParsedCommand {
+class ParsedAssignment {
 public:
-    std::string variableName;
-    std::string value;
-
-    ParsedAssignment(std::string name, std::string val);
+    std::pmr::string variableName;
+    std::pmr::string value;
 
-    bool isAssignment() const override {
-        return true;
-    }
+    ParsedAssignment(std::string_view name, std::string_view val,
+                     std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 };
 
 /**
@@ -53,23 +32,24 @@ public:
  */
 class ParsedSimpleCommand {
 public:
-    std::string commandName;
-    std::vector<std::string> arguments;
+    std::pmr::string commandName;
+    std::pmr::vector<std::pmr::string> arguments;
+    BuiltinId builtin = BuiltinId::kNone;  ///< lookupBuiltin(commandName), ищется один раз
 
     ParsedSimpleCommand() = default;
-    ParsedSimpleCommand(std::string name, std::vector<std::string> args);
+    explicit ParsedSimpleCommand(std::pmr::memory_resource* resource);
+    ParsedSimpleCommand(std::string_view name, std::pmr::vector<std::pmr::string> args);
 };
 
 /**
  * @brief Пайплайн: CMD1 | CMD2 | CMD3
  */
-class ParsedPipeline : public ParsedCommand {
+class ParsedPipeline {
 public:
-    std::vector<ParsedSimpleCommand> commands;
+    std::pmr::vector<ParsedSimpleCommand> commands;
 
-    bool isPipeline() const override {
-        return true;
-    }
+    explicit ParsedPipeline(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     void addCommand(ParsedSimpleCommand cmd);
 };
@@ -77,15 +57,24 @@ public:
 /**
  * @brief Список присваиваний (x=1 y=2)
  */
-class ParsedAssignmentList : public ParsedCommand {
+class ParsedAssignmentList {
 public:
-    std::vector<ParsedAssignment> assignments;
+    std::pmr::vector<ParsedAssignment> assignments;
 
-    bool isAssignment() const override {
-        return true;
-    }
+    explicit ParsedAssignmentList(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     void addAssignment(ParsedAssignment assignment);
 };
 
+/**
+ * @brief Разобранная строка — один из узлов AST
+ *
+ * Хранится по значению: корень не выделяется в куче, а строки и списки
+ * узлов размещаются в ресурсе памяти, переданном парсеру (в REPL — в
+ * арене строки). Тип узла определяется через std::visit.
+ */
+using ParsedCommand =
+    std::variant<ParsedEmpty, ParsedAssignment, ParsedAssignmentList, ParsedPipeline>;
+
 }  // namespace shell
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include "parsed_command.hpp"
@@ -17,18 +17,19 @@ class Parser {
 public:
     /**
      * @brief Создать парсер для списка токенов
-     * @param tokens Вектор токенов
+     * @param tokens Вектор токенов; строки AST размещаются в его ресурсе памяти
      */
-    explicit Parser(std::vector<Token> tokens);
+    explicit Parser(std::pmr::vector<Token> tokens);
 
     /**
      * @brief Выполнить парсинг
-     * @return Указатель на корневой узел AST
+     * @return Корневой узел AST (по значению)
      */
-    std::unique_ptr<ParsedCommand> parse();
+    ParsedCommand parse();
 
 private:
-    std::vector<Token> tokens_;
+    std::pmr::vector<Token> tokens_;
+    std::pmr::memory_resource* resource_;
     size_t position_;
 
     const Token& current() const;
@@ -37,7 +38,7 @@ private:
     bool check(TokenType type) const;
     bool match(TokenType type);
 
-    std::unique_ptr<ParsedCommand> parseCommandLine();
+    ParsedCommand parseCommandLine();
     ParsedSimpleCommand parseSimpleCommand();
     bool isAssignmentToken(const Token& token) const;
 };
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "environment.hpp"
+
+namespace shell {
+
+/**
+ * @brief Кэш разрешения имён команд в пути к исполняемым файлам
+ *
+ * Запоминает результат поиска по PATH (в том числе отрицательный —
+ * «команда не найдена»), чтобы не выполнять access() для каждой
+ * директории при каждом запуске внешней программы.
+ *
+ * Инвалидация:
+ * - при изменении PATH в Environment кэш полностью сбрасывается;
+ * - при изменении содержимого директории из PATH сбрасываются только
+ *   записи, при поиске которых эта директория просматривалась.
+ *   На Linux изменения отслеживаются через inotify (одно неблокирующее
+ *   чтение на обращение), для остальных случаев — ленивая проверка mtime.
+ *
+ * Записи, добавленные явно через seed() (hash -p), не проверяются.
+ */
+class PathCache {
+public:
+    /**
+     * @brief Запись кэша для вывода командой hash
+     */
+    struct Entry {
+        std::string name;
+        std::string path;
+        size_t hits = 0;
+    };
+
+    /**
+     * @brief Директория PATH и отметка её последнего изменения
+     */
+    struct DirectoryStamp {
+        std::string path;
+        uint64_t stamp = 0;  ///< Меняется при каждом замеченном изменении содержимого
+    };
+
+    /**
+     * @brief Создать кэш, привязанный к окружению
+     * @param env Окружение, из которого берётся PATH
+     */
+    explicit PathCache(const Environment& env);
+    ~PathCache();
+
+    PathCache(const PathCache&) = delete;
+    PathCache& operator=(const PathCache&) = delete;
+
+    /**
+     * @brief Найти исполняемый файл с учётом кэша
+     * @param name Имя команды (без '/')
+     * @return Полный путь или nullopt, если команда не найдена
+     */
+    std::optional<std::string> lookup(const std::string& name);
+
+    /**
+     * @brief Разрешить имя и запомнить результат без учёта обращения
+     * @param name Имя команды
+     * @return true, если команда найдена
+     */
+    bool remember(const std::string& name);
+
+    /**
+     * @brief Явно задать путь для команды (hash -p)
+     * @param name Имя команды
+     * @param path Путь к исполняемому файлу
+     */
+    void seed(const std::string& name, const std::string& path);
+
+    /**
+     * @brief Получить путь из кэша без поиска
+     * @param name Имя команды
+     * @return Путь, если для имени есть положительная запись
+     */
+    std::optional<std::string> peek(const std::string& name) const;
+
+    /**
+     * @brief Удалить запись
+     * @return true, если запись существовала
+     */
+    bool remove(const std::string& name);
+
+    /**
+     * @brief Очистить кэш (hash -r)
+     */
+    void clear();
+
+    /**
+     * @brief Получить положительные записи, упорядоченные по имени
+     */
+    std::vector<Entry> entries() const;
+
+    /**
+     * @brief Директории PATH с отметками изменений (для кэшей их содержимого)
+     *
+     * Отметка директории меняется, когда кэш замечает изменение её
+     * содержимого (событие inotify или новый mtime), и при смене PATH.
+     * Другие кэши сверяются с ней и поэтому не расходятся с PathCache.
+     */
+    std::vector<DirectoryStamp> directoryStamps();
+
+    /**
+     * @brief Найти исполняемый файл в списке директорий без кэша
+     * @param name Имя команды
+     * @param pathVar Значение PATH (пустое — стандартные пути)
+     * @return Полный путь или nullopt
+     */
+    static std::optional<std::string> resolve(const std::string& name, const std::string& pathVar);
+
+private:
+    struct DirState {
+        std::string path;
+        int watch = -1;  ///< Дескриптор inotify или -1, если используется mtime
+        bool known = false;
+        bool exists = false;
+        int64_t mtimeSec = 0;
+        int64_t mtimeNsec = 0;
+        uint64_t stamp = 0;  ///< Отметка последнего изменения (directoryStamps)
+    };
+
+    struct CacheEntry {
+        std::string path;        ///< Пустой для отрицательной записи
+        size_t scannedDirs = 0;  ///< Сколько директорий PATH просмотрено при поиске
+        size_t hits = 0;
+        bool pinned = false;  ///< Добавлена через seed(), не проверяется
+    };
+
+    const Environment& env_;
+    uint64_t seenVersion_ = 0;
+    bool initialized_ = false;
+    std::string pathVar_;
+    std::vector<DirState> dirs_;
+    std::unordered_map<std::string, CacheEntry> entries_;
+    int inotifyFd_ = -1;
+    uint64_t lastStamp_ = 0;
+    mutable std::mutex mutex_;
+
+    void syncWithEnvironment();
+    void rebuildDirs();
+    void closeWatches();
+    void drainEvents();
+    void invalidateFrom(size_t dirIndex);
+    bool refreshDirState(DirState& dir);
+    CacheEntry resolveEntry(const std::string& name);
+};
+
+}  // namespace shell
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "multi_literal_searcher.hpp"
+
+namespace shell {
+
+/**
+ * @brief Кэш автоматов по файлам образцов (grep -F -f) в пределах сессии
+ *
+ * Ключ — устройство, inode, время изменения и размер файла (а также
+ * учёт регистра), поэтому изменённый или заменённый файл читается и
+ * строится заново. Автомат строится и хранится, только если все образцы
+ * файла — строки; файл с регулярными выражениями просто читается.
+ * Хранит не более capacity автоматов, вытесняя давно не использованные.
+ * Потокобезопасен.
+ */
+class PatternFileCache {
+public:
+    /**
+     * @brief Создать кэш
+     * @param capacity Максимальное число автоматов
+     */
+    explicit PatternFileCache(size_t capacity = 8);
+
+    /**
+     * @brief Является ли образец строкой (а не регулярным выражением)
+     */
+    using LiteralTest = std::function<bool(const std::string&)>;
+
+    /**
+     * @brief Получить автомат по файлу образцов (строится при первом запросе)
+     *
+     * Если хотя бы один образец не строка, автомат не строится и не
+     * кэшируется, а образцы файла записываются в patterns.
+     *
+     * @param path Путь к файлу: по образцу на строку
+     * @param ignoreCase Не учитывать регистр ASCII-букв
+     * @param literal Проверка образца
+     * @param patterns Куда записать образцы, если среди них есть не строки
+     * @param error Куда записать описание ошибки ("путь: причина")
+     * @return Автомат или nullptr: patterns заполнен либо файл не удалось прочитать
+     */
+    std::shared_ptr<const MultiLiteralSearcher> get(const std::string& path, bool ignoreCase,
+                                                    const LiteralTest& literal,
+                                                    std::vector<std::string>& patterns,
+                                                    std::string* error = nullptr);
+
+    /**
+     * @brief Прочитать образцы из файла (по одному на строку) без кэширования
+     * @return false, если файл не удалось прочитать
+     */
+    static bool readPatterns(const std::string& path, std::vector<std::string>& patterns,
+                             std::string* error = nullptr);
+
+    /**
+     * @brief Число автоматов в кэше
+     */
+    size_t size() const;
+
+    /**
+     * @brief Сколько запросов обслужено без построения
+     */
+    size_t hits() const;
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const MultiLiteralSearcher>>;
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  ///< От недавних к давним
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    size_t hits_ = 0;
+};
+
+}  // namespace shell
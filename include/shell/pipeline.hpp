@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include "command.hpp"
@@ -14,7 +15,11 @@ namespace shell {
  */
 class Pipeline {
 public:
-    Pipeline() = default;
+    /**
+     * @brief Создать пустой пайплайн
+     * @param resource Ресурс памяти для списка команд (арена строки)
+     */
+    explicit Pipeline(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Добавить команду в конец пайплайна
@@ -22,6 +27,11 @@ public:
      */
     void addCommand(std::unique_ptr<Command> command);
 
+    /**
+     * @brief Добавить команду, созданную в ресурсе памяти
+     */
+    void addCommand(CommandPtr command);
+
     /**
      * @brief Получить количество команд
      */
@@ -50,7 +60,7 @@ public:
     }
 
 private:
-    std::vector<std::unique_ptr<Command>> commands_;
+    std::pmr::vector<CommandPtr> commands_;
 };
 
 }  // namespace shell
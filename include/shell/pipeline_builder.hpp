@@ -22,9 +22,11 @@ public:
     /**
      * @brief Построить Pipeline из ParsedPipeline
      * @param parsed AST пайплайна
+     * @param resource Ресурс памяти для пайплайна и объектов команд (арена строки)
      * @return Готовый Pipeline
      */
-    Pipeline build(const ParsedPipeline& parsed);
+    Pipeline build(const ParsedPipeline& parsed,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 private:
     CommandFactory& factory_;
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "command.hpp"
+
+namespace shell {
+
+/**
+ * @brief Версия ABI плагинов
+ *
+ * Увеличивается при любом изменении Command, CommandResult или
+ * PluginRegistrar, несовместимом на уровне бинарного кода. Плагин,
+ * собранный с другой версией, не загружается. Плагин должен быть собран
+ * тем же компилятором и стандартной библиотекой C++, что и shell.
+ * Новые виртуальные методы Command добавляются в конец класса.
+ *
+ * 2 — Command::asExternal; 3 — Command::asStage.
+ */
+inline constexpr int kPluginAbiVersion = 3;
+
+/**
+ * @brief Интерфейс, через который плагин регистрирует свои команды
+ */
+class PluginRegistrar {
+public:
+    /**
+     * @brief Функция создания команды: объект создаётся new и удаляется delete
+     */
+    using Factory = Command* (*)();
+
+    virtual ~PluginRegistrar() = default;
+
+    /**
+     * @brief Зарегистрировать команду
+     * @param name Имя, под которым команда доступна в shell
+     * @param factory Функция создания объекта команды
+     */
+    virtual void add(const char* name, Factory factory) = 0;
+};
+
+}  // namespace shell
+
+/**
+ * Точки входа, которые экспортирует плагин (ищутся через dlsym):
+ * - shell_plugin_abi_version() возвращает kPluginAbiVersion, с которой собран плагин;
+ * - shell_plugin_register() регистрирует команды плагина.
+ */
+extern "C" {
+int shell_plugin_abi_version();
+void shell_plugin_register(shell::PluginRegistrar* registrar);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "command.hpp"
+#include "plugin.hpp"
+
+namespace shell {
+
+/**
+ * @brief Команды, загруженные из плагинов (enable -f)
+ *
+ * Загружает разделяемые библиотеки через dlopen, проверяет версию ABI и
+ * хранит функции создания включённых команд. Такие команды выполняются
+ * в процессе shell, как встроенные: без fork/exec и без пересылки данных
+ * через каналы ОС.
+ *
+ * Библиотеки выгружаются только в деструкторе: код команды может ещё
+ * выполняться в пайплайне, из которого её отключили (enable -d).
+ * Объекты команд плагинов не должны переживать таблицу.
+ */
+class PluginTable {
+public:
+    /**
+     * @brief Включённая команда плагина
+     */
+    struct Entry {
+        std::string name;
+        std::string path;  ///< Файл библиотеки
+        PluginRegistrar::Factory factory = nullptr;
+    };
+
+    PluginTable() = default;
+    ~PluginTable();
+
+    PluginTable(const PluginTable&) = delete;
+    PluginTable& operator=(const PluginTable&) = delete;
+
+    /**
+     * @brief Загрузить библиотеку и включить её команды
+     * @param path Путь к библиотеке (без '/' — поиск по правилам dlopen)
+     * @param names Имена включаемых команд; пусто — все команды плагина
+     * @param error Текст ошибки при неудаче
+     * @return true, если все запрошенные команды включены
+     */
+    bool load(const std::string& path, const std::vector<std::string>& names,
+              std::string& error);
+
+    /**
+     * @brief Отключить команду
+     * @return false, если такой команды нет
+     */
+    bool remove(const std::string& name);
+
+    /**
+     * @brief Создать команду плагина
+     * @return nullptr, если команды с таким именем нет
+     */
+    CommandPtr create(std::string_view name) const;
+
+    /**
+     * @brief Есть ли включённая команда с таким именем
+     */
+    bool contains(std::string_view name) const {
+        return commands_.find(name) != commands_.end();
+    }
+
+    /**
+     * @brief Нет ни одной включённой команды
+     */
+    bool empty() const {
+        return commands_.empty();
+    }
+
+    /**
+     * @brief Включённые команды в порядке имён
+     */
+    std::vector<Entry> entries() const;
+
+private:
+    std::map<std::string, Entry, std::less<>> commands_;
+    std::vector<void*> libraries_;
+};
+
+}  // namespace shell
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace shell {
+
+/**
+ * @brief Создать канал с флагом close-on-exec на обоих концах
+ *
+ * Программы, запущенные одновременно другими стадиями пайплайна, не
+ * должны унаследовать чужие концы каналов — иначе читатель не увидит EOF.
+ */
+bool openPipe(int fds[2]);
+
+/**
+ * @brief Записать все данные (повтор при частичной записи и EINTR)
+ * @return false при ошибке (errno сохраняется)
+ */
+bool writeAll(int fd, const char* data, size_t size);
+
+/**
+ * @brief Игнорировать SIGPIPE в shell (однократно)
+ *
+ * Запись в канал завершившейся программы должна давать EPIPE, а не
+ * завершать shell.
+ */
+void ignoreSigpipe();
+
+/**
+ * @brief Запустить программу в дочернем процессе
+ *
+ * Массивы аргументов и окружения строятся до fork: в процессе работают
+ * другие потоки, и выделять память в дочернем процессе нельзя. В
+ * дочернем процессе восстанавливается обработка SIGPIPE по умолчанию.
+ * @param path Путь к исполняемому файлу
+ * @param args Аргументы (без имени программы)
+ * @param env Окружение в виде строк "NAME=value"
+ * @param stdinFd Дескриптор для stdin (-1 — унаследовать)
+ * @param stdoutFd Дескриптор для stdout (-1 — унаследовать)
+ * @return pid дочернего процесса или -1 при ошибке fork
+ */
+pid_t spawnProcess(const std::string& path, const std::vector<std::string>& args,
+                   const std::vector<std::string>& env, int stdinFd, int stdoutFd);
+
+/**
+ * @brief Дождаться завершения процесса
+ * @return Код возврата; 128 + номер сигнала, если процесс завершён сигналом
+ */
+int waitProcess(pid_t pid);
+
+/**
+ * @brief Дождаться завершения процесса через его pidfd и закрыть pidfd
+ *
+ * Без pidfd (-1) или на ядре без waitid(P_PIDFD) ожидание идёт по pid.
+ */
+int waitProcess(pid_t pid, int pidfd);
+
+}  // namespace shell
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace shell {
+
+/**
+ * @brief Однопоточный цикл событий на epoll (Linux)
+ *
+ * Дескрипторы регистрируются вместе с обработчиком; run() ждёт событий
+ * и вызывает обработчики, пока зарегистрирован хотя бы один дескриптор.
+ * Обработчик может добавлять и удалять дескрипторы, в том числе свой.
+ * Обрыв (EPOLLHUP/EPOLLERR) передаётся как kReadable | kWritable: при
+ * следующей операции обработчик получит EOF или EPIPE.
+ */
+class Reactor {
+public:
+    /// Маски событий (совпадают с EPOLLIN и EPOLLOUT)
+    static constexpr uint32_t kReadable = 0x001;
+    static constexpr uint32_t kWritable = 0x004;
+
+    using Handler = std::function<void(uint32_t events)>;
+
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /**
+     * @brief Удалось ли создать epoll
+     */
+    bool valid() const {
+        return epoll_ >= 0;
+    }
+
+    /**
+     * @brief Зарегистрировать дескриптор (уровневое срабатывание)
+     * @return false, если epoll отказал (например, обычный файл)
+     */
+    bool add(int fd, uint32_t events, Handler handler);
+
+    /**
+     * @brief Изменить ожидаемые события; 0 — временно не ждать ничего
+     */
+    void modify(int fd, uint32_t events);
+
+    /**
+     * @brief Снять дескриптор с учёта (до его закрытия)
+     */
+    void remove(int fd);
+
+    /**
+     * @brief Обрабатывать события, пока есть зарегистрированные дескрипторы
+     */
+    void run();
+
+private:
+    int epoll_ = -1;
+    // Адрес обработчика не меняется, пока он выполняется и снимает сам себя
+    std::unordered_map<int, std::unique_ptr<Handler>> handlers_;
+    std::vector<std::unique_ptr<Handler>> retired_;
+};
+
+}  // namespace shell
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "literal_searcher.hpp"
+
+namespace shell {
+
+/**
+ * @brief Скомпилированное регулярное выражение (POSIX BRE/ERE)
+ *
+ * Образец разбирается в дерево и компилируется в программу NFA Томпсона;
+ * сопоставление выполняет RegexMatcher ленивым DFA. Объект неизменяем
+ * и может использоваться из нескольких потоков одновременно.
+ *
+ * Поддерживаются: литералы, '.', скобочные выражения с диапазонами и
+ * классами [:alpha:] и др., якоря ^ и $ (относительно строк), группы,
+ * альтернатива, квантификаторы *, +, ?, {m,n}, а также \\w, \\W, \\s, \\S.
+ * '.' и отрицательные скобочные выражения совпадают с целым символом
+ * UTF-8. Обратные ссылки и границы слов не поддерживаются: сопоставление
+ * всегда линейно по длине входа.
+ */
+class Regex {
+public:
+    /**
+     * @brief Флаги компиляции
+     */
+    enum Flags : unsigned {
+        kBasic = 0,               ///< BRE: \\( \\) \\{ \\} \\| \\+ \\?
+        kExtended = 1U << 0,      ///< ERE: ( ) { } | + ?
+        kIgnoreCase = 1U << 1,    ///< Без учёта регистра ASCII-букв
+    };
+
+    /**
+     * @brief Скомпилировать образец
+     * @param pattern Регулярное выражение
+     * @param flags Флаги компиляции
+     * @param error Куда записать описание ошибки (может быть nullptr)
+     * @return Выражение или nullptr, если образец некорректен
+     */
+    static std::shared_ptr<const Regex> compile(const std::string& pattern, unsigned flags,
+                                                std::string* error = nullptr);
+
+    const std::string& pattern() const {
+        return pattern_;
+    }
+
+    unsigned flags() const {
+        return flags_;
+    }
+
+    /**
+     * @brief Строка, с которой начинается любое совпадение (может быть пустой)
+     */
+    const std::string& literalPrefix() const {
+        return prefix_;
+    }
+
+    /**
+     * @brief Число инструкций программы NFA
+     */
+    size_t programSize() const {
+        return program_.size();
+    }
+
+private:
+    friend class RegexMatcher;
+    friend class RegexCompiler;
+
+    enum class Op : uint8_t { kByteSet, kSplit, kJmp, kBol, kEol, kMatch };
+
+    struct Inst {
+        Op op;
+        uint32_t out = 0;
+        uint32_t out1 = 0;  ///< Вторая ветвь kSplit
+        uint32_t set = 0;   ///< Индекс в sets_ для kByteSet
+    };
+
+    using ByteSet = std::array<uint64_t, 4>;
+
+    std::string pattern_;
+    unsigned flags_ = 0;
+    std::vector<Inst> program_;
+    std::vector<ByteSet> sets_;
+    uint32_t start_ = 0;
+
+    /// Классы эквивалентности байт: байты одного класса неразличимы для программы
+    std::array<uint8_t, 256> byteClass_{};
+    std::vector<uint8_t> classRepresentative_;
+
+    std::string prefix_;
+    std::unique_ptr<LiteralSearcher> prefixSearcher_;
+
+    Regex() = default;
+    void computeByteClasses();
+};
+
+/**
+ * @brief Поиск совпадений регулярного выражения ленивым DFA
+ *
+ * Состояния DFA (множества инструкций NFA) строятся по мере
+ * необходимости и кэшируются вместе с переходами; при превышении
+ * бюджета памяти кэш сбрасывается. Каждый байт входа обрабатывается
+ * за O(размер программы) в худшем случае, поэтому время поиска линейно.
+ *
+ * Объект хранит изменяемый кэш и не должен использоваться из нескольких
+ * потоков одновременно: каждому потоку — свой RegexMatcher.
+ */
+class RegexMatcher {
+public:
+    /**
+     * @brief Создать поисковик
+     * @param regex Скомпилированное выражение
+     * @param cacheBudget Предельный размер таблицы переходов DFA в байтах
+     */
+    explicit RegexMatcher(std::shared_ptr<const Regex> regex,
+                          size_t cacheBudget = 8 * 1024 * 1024);
+
+    /**
+     * @brief Найти первое совпадение в буфере
+     *
+     * Начало буфера считается началом строки, '\\n' разделяет строки;
+     * совпадения не пересекают границ строк. Завершающий '\\n' закрывает
+     * последнюю строку: пустой строки за ним нет.
+     *
+     * @return Позиция конца самого раннего (по концу) совпадения или nullptr
+     */
+    const char* find(const char* begin, const char* end);
+
+    /**
+     * @brief Есть ли в тексте совпадение
+     */
+    bool search(std::string_view text) {
+        return find(text.data(), text.data() + text.size()) != nullptr;
+    }
+
+    /**
+     * @brief Число состояний DFA в кэше
+     */
+    size_t stateCount() const {
+        return sets_.size();
+    }
+
+    /**
+     * @brief Сколько раз кэш DFA сбрасывался из-за бюджета памяти
+     */
+    size_t flushCount() const {
+        return flushes_;
+    }
+
+private:
+    enum AcceptFlags : uint8_t {
+        kAccepting = 1U << 0,       ///< Совпадение завершилось
+        kAcceptingAtEol = 1U << 1,  ///< Завершится, если дальше конец строки
+    };
+
+    std::shared_ptr<const Regex> regex_;
+    size_t classCount_;
+    size_t cacheBudget_;
+
+    std::vector<std::vector<uint32_t>> sets_;  ///< Инструкции NFA каждого состояния
+    std::vector<uint8_t> accept_;
+    /// sets_.size() × classCount_: смещение строки цели (у принимающих — -смещение-2)
+    std::vector<int32_t> transitions_;
+    std::unordered_map<std::string, int32_t> index_;
+    int32_t start_ = -1;
+    size_t flushes_ = 0;
+
+    std::vector<uint32_t> visited_;
+    uint32_t generation_ = 0;
+    std::vector<uint32_t> stack_;
+
+    static constexpr int32_t kUnknown = -1;  ///< Переход ещё не вычислен
+
+    const char* scan(const char* begin, const char* stop, const char* end);
+    int32_t encode(int32_t state) const;
+    int32_t startState();
+    int32_t transition(int32_t state, uint8_t byteClass);
+    int32_t intern(std::vector<uint32_t>& insts);
+    void addClosure(uint32_t pc, bool atLineStart, std::vector<uint32_t>& out);
+    void clearCache();
+};
+
+}  // namespace shell
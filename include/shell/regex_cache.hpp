@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "regex.hpp"
+
+namespace shell {
+
+/**
+ * @brief Кэш скомпилированных регулярных выражений сессии
+ *
+ * Ключ — образец и флаги компиляции. Хранит не более capacity
+ * выражений, вытесняя давно не использованные. Потокобезопасен.
+ */
+class RegexCache {
+public:
+    /**
+     * @brief Создать кэш
+     * @param capacity Максимальное число выражений
+     */
+    explicit RegexCache(size_t capacity = 64);
+
+    /**
+     * @brief Получить скомпилированное выражение (компилируется при первом запросе)
+     * @param pattern Образец
+     * @param flags Флаги Regex::Flags
+     * @param error Куда записать описание ошибки компиляции
+     * @return Выражение или nullptr при ошибке (ошибки не кэшируются)
+     */
+    std::shared_ptr<const Regex> get(const std::string& pattern, unsigned flags,
+                                     std::string* error = nullptr);
+
+    /**
+     * @brief Число выражений в кэше
+     */
+    size_t size() const;
+
+    /**
+     * @brief Сколько запросов обслужено без компиляции
+     */
+    size_t hits() const;
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const Regex>>;
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  ///< От недавних к давним
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    size_t hits_ = 0;
+};
+
+}  // namespace shell
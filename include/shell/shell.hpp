@@ -3,9 +3,12 @@
 #include <memory>
 
 #include "command_factory.hpp"
+#include "completion.hpp"
 #include "environment.hpp"
 #include "executor.hpp"
+#include "glob_expander.hpp"
 #include "input_reader.hpp"
+#include "line_arena.hpp"
 #include "lexer.hpp"
 #include "parser.hpp"
 #include "pipeline_builder.hpp"
@@ -35,6 +38,13 @@ public:
      */
     int processLine(const std::string& line);
 
+    /**
+     * @brief Арена памяти строки (для тестов)
+     */
+    const LineArena& getArena() const {
+        return arena_;
+    }
+
     /**
      * @brief Получить ссылку на окружение (для тестов)
      */
@@ -57,12 +67,17 @@ public:
     }
 
 private:
+    LineArena arena_;
     Environment environment_;
     InputReader inputReader_;
     Substitutor substitutor_;
+    GlobExpander globExpander_;
     CommandFactory commandFactory_;
+    Completer completer_;
     PipelineBuilder pipelineBuilder_;
     Executor executor_;
+
+    int executeLine(const std::string& line);
 };
 
 }  // namespace shell
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <vector>
+
+namespace shell {
+
+/**
+ * @brief Канал байтов между стадиями пайплайна в одном процессе
+ *
+ * Кольцевой буфер ограниченного размера: писатель ждёт, пока в буфере
+ * есть место, читатель — пока есть данные. Закрытие со стороны
+ * читателя (стадия завершилась, не дочитав вход) работает как закрытие
+ * pipe: запись после него завершается ошибкой, и предыдущая стадия
+ * прекращает работу, не дожидаясь конца своего входа.
+ */
+class StreamPipe {
+public:
+    /**
+     * @brief Создать канал
+     * @param capacity Размер буфера, байт
+     */
+    explicit StreamPipe(size_t capacity = 256 * 1024);
+
+    StreamPipe(const StreamPipe&) = delete;
+    StreamPipe& operator=(const StreamPipe&) = delete;
+
+    /**
+     * @brief Записать данные (ждёт свободного места)
+     * @return false, если читатель закрыл канал
+     */
+    bool write(const char* data, size_t size);
+
+    /**
+     * @brief Прочитать доступные данные (ждёт хотя бы одного байта)
+     * @return Число прочитанных байт, 0 — писатель закрыл канал и данных нет
+     */
+    size_t read(char* buffer, size_t capacity);
+
+    /**
+     * @brief Записать без ожидания столько, сколько помещается
+     * @param closed true, если читатель закрыл канал
+     * @return Число записанных байт
+     */
+    size_t tryWrite(const char* data, size_t size, bool& closed);
+
+    /**
+     * @brief Прочитать без ожидания
+     * @param eof true, если данных больше не будет (писатель или читатель закрыл канал)
+     * @return Число прочитанных байт; 0 без eof — данных пока нет
+     */
+    size_t tryRead(char* buffer, size_t capacity, bool& eof);
+
+    /**
+     * @brief Сообщать о новых данных и закрытии писателем записью в fd (eventfd)
+     *
+     * Так цикл событий, читающий канал через tryRead, ждёт его вместе с
+     * дескрипторами программ. Сигнал приходит, только если последний
+     * tryRead ничего не прочитал.
+     */
+    void notifyReader(int fd);
+
+    /**
+     * @brief Сообщать об освободившемся месте и закрытии читателем записью в fd
+     *
+     * Место сообщается, только если последний tryWrite записал не всё.
+     */
+    void notifyWriter(int fd);
+
+    /**
+     * @brief Писатель закончил: после чтения остатка читатель получит EOF
+     */
+    void closeWrite();
+
+    /**
+     * @brief Читатель закончил: данные отбрасываются, запись завершается ошибкой
+     */
+    void closeRead();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable readable_;
+    std::condition_variable writable_;
+    std::vector<char> ring_;
+    size_t head_ = 0;  ///< Позиция первого непрочитанного байта
+    size_t size_ = 0;  ///< Сколько байт в буфере
+    bool writeClosed_ = false;
+    bool readClosed_ = false;
+    int readerNotify_ = -1;
+    int writerNotify_ = -1;
+    // Сторона с notify-дескриптором ждёт: tryRead/tryWrite не продвинулись.
+    // Пока она не ждёт, eventfd не трогаем — не по системному вызову на каждый блок
+    bool readerWaiting_ = false;
+    bool writerWaiting_ = false;
+
+    // Под mutex_: скопировать в кольцо или из него, разбудить другую сторону
+    size_t put(const char* data, size_t size);
+    size_t take(char* buffer, size_t capacity);
+    static void signal(int fd);
+};
+
+/**
+ * @brief Буфер std::istream, читающий из StreamPipe
+ */
+class PipeReadBuffer : public std::streambuf {
+public:
+    explicit PipeReadBuffer(StreamPipe& pipe);
+
+protected:
+    int_type underflow() override;
+
+private:
+    StreamPipe& pipe_;
+    std::unique_ptr<char[]> buffer_;
+};
+
+/**
+ * @brief Буфер std::ostream, пишущий в StreamPipe
+ *
+ * Если читатель закрыл канал, запись завершается ошибкой и поток
+ * переходит в состояние bad — так стадия узнаёт, что её вывод больше
+ * не нужен.
+ */
+class PipeWriteBuffer : public std::streambuf {
+public:
+    explicit PipeWriteBuffer(StreamPipe& pipe);
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* data, std::streamsize size) override;
+    int sync() override;
+
+private:
+    StreamPipe& pipe_;
+    std::unique_ptr<char[]> buffer_;
+    bool broken_ = false;
+
+    bool flush();
+};
+
+/**
+ * @brief Прочитать то, что уже доступно во входном потоке
+ *
+ * Ждёт хотя бы одного байта, но не заполнения всего буфера, поэтому
+ * данные из канала передаются дальше по мере поступления.
+ * @return Число прочитанных байт, 0 при EOF
+ */
+size_t readAvailable(std::istream& in, char* buffer, size_t capacity);
+
+}  // namespace shell
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 #include "environment.hpp"
 
@@ -29,11 +31,21 @@ public:
      */
     std::string substitute(const std::string& input) const;
 
+    /**
+     * @brief Выполнить подстановку, разместив результат в ресурсе памяти
+     * @param input Входная строка
+     * @param resource Ресурс памяти (арена строки)
+     */
+    std::pmr::string substitute(std::string_view input, std::pmr::memory_resource* resource) const;
+
 private:
     Environment& env_;
 
     bool isValidVarChar(char c) const;
     bool isValidVarStartChar(char c) const;
+
+    template <typename String>
+    void substituteInto(std::string_view input, String& result) const;
 };
 
 }  // namespace shell
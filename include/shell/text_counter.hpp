@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace shell {
+
+class ThreadPool;
+
+/**
+ * @brief Потоковый подсчёт строк, слов, символов и байт
+ *
+ * Данные подаются блоками произвольного размера через update();
+ * состояние «внутри слова» переносится между блоками, поэтому память
+ * не зависит от размера входа. Подсчёт переводов строк и начал слов
+ * выполняется векторными ядрами (AVX2/SSE2 на x86-64, выбор при первом
+ * обращении по возможностям процессора) со скалярным вариантом для
+ * остальных платформ.
+ *
+ * Словом считается максимальная последовательность символов, не являющихся
+ * пробельными: ASCII (' ', '\\t', '\\n', '\\v', '\\f', '\\r') и пробелы
+ * Unicode в UTF-8 (U+0085, U+1680, U+2000–U+2006, U+2008–U+200A, U+2028,
+ * U+2029, U+205F, U+3000; неразрывные пробелы словом не разделяются).
+ * Символы — это кодовые точки UTF-8: считаются байты, не являющиеся
+ * продолжением последовательности. При kValidate дополнительно
+ * проверяется корректность UTF-8.
+ */
+class TextCounter {
+public:
+    /**
+     * @brief Результат подсчёта
+     */
+    struct Counts {
+        size_t lines = 0;
+        size_t words = 0;
+        size_t chars = 0;
+        size_t bytes = 0;
+        size_t invalid = 0;       ///< Число некорректных последовательностей UTF-8
+        size_t firstInvalid = 0;  ///< Смещение первой из них (если invalid > 0)
+    };
+
+    /**
+     * @brief Состояние подсчёта слов между блоками
+     *
+     * Кроме признака «предыдущий символ — пробел» хранит начатую, но ещё
+     * не завершённую многобайтную последовательность, которая может
+     * оказаться пробелом Unicode.
+     */
+    struct WordState {
+        bool prevIsSpace = true;
+        uint8_t pendingSize = 0;
+        unsigned char pending[2] = {};
+    };
+
+    /**
+     * @brief Что именно подсчитывать (битовая маска)
+     */
+    enum Mode : unsigned {
+        kLines = 1U << 0,
+        kWords = 1U << 1,
+        kBytes = 1U << 2,
+        kChars = 1U << 3,
+        kValidate = 1U << 4,
+        kAll = kLines | kWords | kBytes,
+    };
+
+    /**
+     * @brief Создать счётчик
+     * @param mode Набор подсчитываемых величин; ненужные ядра не запускаются
+     */
+    explicit TextCounter(unsigned mode = kAll);
+
+    /**
+     * @brief Обработать очередной блок данных
+     */
+    void update(const char* data, size_t size);
+
+    /**
+     * @brief Учесть данные, непосредственно предшествующие первому блоку
+     *
+     * Нужен при подсчёте куска из середины данных: слово, начатое до
+     * границы куска, не должно считаться повторно. Достаточно последних
+     * трёх байт перед границей, выровненной по началу символа.
+     */
+    void setPrecedingData(const char* data, size_t size);
+
+    /**
+     * @brief Текущие значения счётчиков
+     *
+     * Незавершённая в конце данных последовательность UTF-8 учитывается
+     * как непробельный символ (и как ошибка при kValidate).
+     */
+    Counts counts() const;
+
+    /**
+     * @brief Подсчитать символы '\\n' в буфере
+     */
+    static size_t countNewlines(const char* data, size_t size);
+
+    /**
+     * @brief Подсчитать начала слов в буфере
+     * @param prevIsSpace Был ли пробельным байт, предшествующий буферу
+     *        (для начала данных — true)
+     */
+    static size_t countWordStarts(const char* data, size_t size, bool prevIsSpace);
+
+    /**
+     * @brief Подсчитать начала слов, продолжая состояние предыдущего блока
+     */
+    static size_t countWordStarts(const char* data, size_t size, WordState& state);
+
+    /**
+     * @brief Подсчитать символы UTF-8 (байты, не являющиеся продолжением)
+     */
+    static size_t countChars(const char* data, size_t size);
+
+    /**
+     * @brief Подсчитать буфер в памяти по кускам на пуле потоков
+     * @param data Данные (например, отображённый файл)
+     * @param size Размер данных
+     * @param mode Набор подсчитываемых величин
+     * @param pool Пул, на котором считаются куски
+     * @param chunkSize Размер куска (границы сдвигаются к началу символа)
+     * @return Сумма счётчиков по всем кускам
+     */
+    static Counts countParallel(const char* data, size_t size, unsigned mode, ThreadPool& pool,
+                                size_t chunkSize);
+
+    /**
+     * @brief Является ли байт пробельным
+     */
+    static bool isSpace(unsigned char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+private:
+    /**
+     * @brief Состояние проверки UTF-8 между блоками
+     */
+    struct Utf8State {
+        uint8_t need = 0;  ///< Сколько байт продолжения ещё ожидается
+        unsigned char lower = 0x80;
+        unsigned char upper = 0xBF;
+        size_t start = 0;  ///< Смещение начала текущей последовательности
+    };
+
+    unsigned mode_;
+    Counts counts_;
+    WordState words_;
+    Utf8State utf8_;
+
+    void validate(const unsigned char* data, size_t size, size_t base);
+
+    static bool isContinuation(char c) {
+        return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+    }
+};
+
+}  // namespace shell
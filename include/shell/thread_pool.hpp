@@ -0,0 +1,194 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "environment.hpp"
+
+namespace shell {
+
+/**
+ * @brief Общий пул рабочих потоков с перехватом задач (work stealing)
+ *
+ * У каждого работника своя очередь. Задача, поставленная из работника,
+ * попадает в его очередь, поставленная извне — в очереди по кругу.
+ * Работник берёт самую старую задачу своей очереди, а когда она пуста —
+ * перехватывает самую старую задачу другого работника. Поэтому задачи
+ * выполняются примерно в порядке поступления, на что рассчитывают
+ * команды, выводящие результаты по порядку.
+ *
+ * Ожидание результата через wait() и parallelFor() не занимает поток
+ * впустую: пока результата нет, ожидающий выполняет задачи из очередей.
+ * Так задача пула может сама распараллеливать свою работу. Прямой
+ * future::get() внутри задачи по-прежнему может заблокировать пул.
+ *
+ * Общий пул (shared()) создаётся при первом обращении; размер — из
+ * переменной SHELL_THREADS окружения shell (configureShared), иначе по
+ * доступным процессу ядрам с учётом квоты CPU cgroup.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Счётчики пула для диагностики
+     */
+    struct Stats {
+        size_t threads = 0;
+        size_t queued = 0;           ///< Задач в очередях сейчас
+        std::vector<size_t> depths;  ///< Длина очереди каждого работника
+        uint64_t executed = 0;       ///< Выполнено задач
+        uint64_t steals = 0;         ///< Из них взято из чужой очереди
+    };
+
+    /**
+     * @brief Создать пул
+     * @param threads Число рабочих потоков (не меньше 1)
+     */
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Поставить задачу в очередь
+     * @param task Вызываемый объект без аргументов
+     * @return future с результатом задачи (исключения пробрасываются через него)
+     */
+    template <typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return result;
+    }
+
+    /**
+     * @brief Дождаться результата, выполняя тем временем чужие задачи
+     */
+    template <typename T>
+    T wait(std::future<T>& future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (!runPending()) {
+                future.wait_for(std::chrono::milliseconds(1));
+            }
+        }
+        return future.get();
+    }
+
+    /**
+     * @brief Выполнить body(from, to) для кусков [begin, end) по grain байт
+     *
+     * Первый кусок выполняет вызывающий поток, остальные — пул; возврат
+     * после завершения всех кусков. Первое исключение пробрасывается.
+     */
+    template <typename Body>
+    void parallelFor(size_t begin, size_t end, size_t grain, Body&& body) {
+        if (grain == 0) {
+            grain = 1;
+        }
+        std::vector<std::future<void>> parts;
+        for (size_t from = begin + grain; from < end; from += grain) {
+            size_t to = end - from > grain ? from + grain : end;
+            parts.push_back(submit([&body, from, to]() { body(from, to); }));
+        }
+        std::exception_ptr error;
+        try {
+            if (begin < end) {
+                body(begin, end - begin > grain ? begin + grain : end);
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto& part : parts) {
+            try {
+                wait(part);
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief Выполнить одну задачу из очередей в текущем потоке
+     * @return false, если очереди пусты
+     */
+    bool runPending();
+
+    /**
+     * @brief Число рабочих потоков
+     */
+    size_t size() const {
+        return workers_.size();
+    }
+
+    /**
+     * @brief Снимок очередей и счётчиков
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Общий пул интерпретатора (создаётся при первом обращении)
+     */
+    static ThreadPool& shared();
+
+    /**
+     * @brief Взять SHELL_THREADS для общего пула из окружения shell
+     *
+     * Вызывается исполнителем перед каждым пайплайном; действует, пока
+     * общий пул не создан. Поэтому SHELL_THREADS, присвоенная в shell до
+     * первой параллельной команды, задаёт размер пула, а после — нет.
+     */
+    static void configureShared(const Environment& env);
+
+    /**
+     * @brief Размер общего пула по SHELL_THREADS окружения процесса
+     */
+    static size_t defaultSize();
+
+    /**
+     * @brief Размер пула по значению SHELL_THREADS
+     * @param value Значение; при nullptr, пустом или некорректном — число
+     *        доступных ядер с учётом квоты cgroup
+     */
+    static size_t sizeFor(const char* value);
+
+private:
+    struct Worker {
+        mutable std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex sleepMutex_;
+    std::condition_variable available_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> nextWorker_{0};
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> steals_{0};
+    bool stopping_ = false;
+
+    void enqueue(std::function<void()> task);
+    bool take(size_t self, std::function<void()>& task);
+    void workerLoop(size_t index);
+};
+
+}  // namespace shell
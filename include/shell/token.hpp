@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 namespace shell {
 
@@ -16,13 +18,20 @@ enum class TokenType {
 
 /**
  * @brief Токен - минимальная лексическая единица
+ *
+ * Строки токена размещаются в переданном ресурсе памяти (в REPL — в
+ * арене строки, см. LineArena).
  */
 class Token {
 public:
     TokenType type;
-    std::string value;
+    std::pmr::string value;
+    /// Шаблон пути для раскрытия (*, ?, [...] вне кавычек; символы из кавычек
+    /// экранированы обратной косой чертой); пусто, если слово не нужно раскрывать
+    std::pmr::string pattern;
 
-    Token(TokenType type, std::string value = "");
+    Token(TokenType type, std::string_view value = "",
+          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     bool operator==(const Token& other) const;
     bool operator!=(const Token& other) const;
@@ -0,0 +1,72 @@
+#include "text_tools.hpp"
+
+#include <array>
+
+namespace tools {
+
+namespace {
+
+using Table = std::array<char, 256>;
+
+Table identity() {
+    Table table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = static_cast<char>(i);
+    }
+    return table;
+}
+
+const Table& upcaseTable() {
+    static const Table table = [] {
+        Table result = identity();
+        for (char c = 'a'; c <= 'z'; ++c) {
+            result[static_cast<unsigned char>(c)] = static_cast<char>(c - 'a' + 'A');
+        }
+        return result;
+    }();
+    return table;
+}
+
+const Table& rot13Table() {
+    static const Table table = [] {
+        Table result = identity();
+        for (int i = 0; i < 26; ++i) {
+            result[static_cast<size_t>('a' + i)] = static_cast<char>('a' + (i + 13) % 26);
+            result[static_cast<size_t>('A' + i)] = static_cast<char>('A' + (i + 13) % 26);
+        }
+        return result;
+    }();
+    return table;
+}
+
+}  // namespace
+
+bool transform(std::string_view name, std::istream& in, std::ostream& out) {
+    const Table* table = nullptr;
+    if (name == "upcase") {
+        table = &upcaseTable();
+    } else if (name == "rot13") {
+        table = &rot13Table();
+    } else {
+        return false;
+    }
+
+    // Блоками напрямую через streambuf, без построчного разбора
+    std::array<char, 64 * 1024> buffer{};
+    std::streambuf* source = in.rdbuf();
+    while (out) {
+        std::streamsize count =
+            source->sgetn(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (count <= 0) {
+            break;
+        }
+        for (std::streamsize i = 0; i < count; ++i) {
+            auto index = static_cast<size_t>(i);
+            buffer[index] = (*table)[static_cast<unsigned char>(buffer[index])];
+        }
+        out.write(buffer.data(), count);
+    }
+    return true;
+}
+
+}  // namespace tools
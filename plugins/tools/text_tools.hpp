@@ -0,0 +1,17 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <string_view>
+
+namespace tools {
+
+/**
+ * @brief Преобразование байтов потока (общий код плагина и утилиты tools_cli)
+ * @param name Имя преобразования: "upcase" — латиница в верхний регистр,
+ *             "rot13" — ROT13 для латиницы
+ * @return false, если преобразование неизвестно
+ */
+bool transform(std::string_view name, std::istream& in, std::ostream& out);
+
+}  // namespace tools
@@ -0,0 +1,19 @@
+/**
+ * Те же преобразования, что в плагине tools, в виде отдельной программы —
+ * для сравнения с запуском через ExternalCommand (plugin_benchmark).
+ *
+ * Запуск: tools_cli upcase|rot13 < input > output
+ */
+
+#include <iostream>
+
+#include "text_tools.hpp"
+
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+    if (argc != 2 || !tools::transform(argv[1], std::cin, std::cout)) {
+        std::cerr << "usage: tools_cli upcase|rot13\n";
+        return 2;
+    }
+    return 0;
+}
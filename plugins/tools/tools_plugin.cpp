@@ -0,0 +1,52 @@
+/**
+ * Пример плагина shell: команды upcase и rot13.
+ *
+ * Сборка: цель tools (libtools.so). Загрузка в shell:
+ *   enable -f /path/to/libtools.so upcase rot13
+ */
+
+#include <string>
+#include <vector>
+
+#include "shell/plugin.hpp"
+#include "text_tools.hpp"
+
+namespace {
+
+class TransformCommand : public shell::Command {
+public:
+    explicit TransformCommand(const char* name) : name_(name) {}
+
+    shell::CommandResult execute(std::istream& in, std::ostream& out,
+                                 std::ostream& err) override {
+        if (!args_.empty()) {
+            err << name_ << ": extra operand '" << args_[0] << "'\n";
+            return 1;
+        }
+        tools::transform(name_, in, out);
+        return 0;
+    }
+
+    void setArguments(std::vector<std::string> args) override {
+        args_ = std::move(args);
+    }
+
+    std::string getName() const override {
+        return name_;
+    }
+
+private:
+    std::string name_;
+    std::vector<std::string> args_;
+};
+
+}  // namespace
+
+extern "C" int shell_plugin_abi_version() {
+    return shell::kPluginAbiVersion;
+}
+
+extern "C" void shell_plugin_register(shell::PluginRegistrar* registrar) {
+    registrar->add("upcase", []() -> shell::Command* { return new TransformCommand("upcase"); });
+    registrar->add("rot13", []() -> shell::Command* { return new TransformCommand("rot13"); });
+}
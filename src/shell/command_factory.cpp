@@ -1,42 +1,94 @@
 #include "shell/command_factory.hpp"
 
+#include "shell/command_pool.hpp"
 #include "shell/commands/cat_command.hpp"
+#include "shell/commands/count_command.hpp"
 #include "shell/commands/echo_command.hpp"
+#include "shell/commands/enable_command.hpp"
 #include "shell/commands/exit_command.hpp"
 #include "shell/commands/external_command.hpp"
+#include "shell/commands/find_command.hpp"
+#include "shell/commands/grep_command.hpp"
+#include "shell/commands/hash_command.hpp"
+#include "shell/commands/head_command.hpp"
 #include "shell/commands/pwd_command.hpp"
+#include "shell/commands/sort_command.hpp"
+#include "shell/commands/tail_command.hpp"
+#include "shell/commands/tee_command.hpp"
+#include "shell/commands/uniq_command.hpp"
 #include "shell/commands/wc_command.hpp"
 
 namespace shell {
 
-CommandFactory::CommandFactory(Environment& env) : env_(env) {
-    registerBuiltins();
-}
+CommandFactory::CommandFactory(Environment& env) : env_(env), pathCache_(env) {}
 
 std::unique_ptr<Command> CommandFactory::create(const std::string& name) {
-    auto it = builtinFactories_.find(name);
-    if (it != builtinFactories_.end()) {
-        return it->second();
-    }
-
-    // Внешняя команда
-    return std::make_unique<ExternalCommand>(name, env_);
+    return std::unique_ptr<Command>(create(name, nullptr).release());
 }
 
-bool CommandFactory::isBuiltin(const std::string& name) const {
-    return builtinFactories_.find(name) != builtinFactories_.end();
+CommandPtr CommandFactory::create(const std::string& name, std::pmr::memory_resource* resource) {
+    return create(lookupBuiltin(name), name, resource);
 }
 
-void CommandFactory::registerBuiltins() {
-    builtinFactories_["echo"] = []() { return std::make_unique<EchoCommand>(); };
+CommandPtr CommandFactory::create(BuiltinId id, std::string_view name,
+                                  std::pmr::memory_resource* resource) {
+    CommandPool& pool = CommandPool::local();
+    switch (id) {
+        case BuiltinId::kEcho:
+            return pool.acquire<EchoCommand>(id);
+        case BuiltinId::kCat:
+            return pool.acquire<CatCommand>(id);
+        case BuiltinId::kWc:
+            return pool.acquire<WcCommand>(id);
+        case BuiltinId::kPwd:
+            return pool.acquire<PwdCommand>(id);
+        case BuiltinId::kExit:
+            return pool.acquire<ExitCommand>(id);
+        case BuiltinId::kGrep:
+            return makeCommand<GrepCommand>(resource, &regexCache_, &patternFileCache_);
+        case BuiltinId::kSort:
+            return makeCommand<SortCommand>(resource);
+        case BuiltinId::kUniq:
+            return pool.acquire<UniqCommand>(id);
+        case BuiltinId::kCount:
+            return pool.acquire<CountCommand>(id);
+        case BuiltinId::kHead:
+            return pool.acquire<HeadCommand>(id);
+        case BuiltinId::kTail:
+            return makeCommand<TailCommand>(resource);
+        case BuiltinId::kTee:
+            return makeCommand<TeeCommand>(resource, &env_, &pathCache_);
+        case BuiltinId::kFind:
+            return makeCommand<FindCommand>(resource);
+        case BuiltinId::kHash:
+            return makeCommand<HashCommand>(resource, pathCache_);
+        case BuiltinId::kEnable:
+            return makeCommand<EnableCommand>(resource, plugins_);
+        case BuiltinId::kNone:
+            break;
+    }
 
-    builtinFactories_["cat"] = []() { return std::make_unique<CatCommand>(); };
+    // Команда плагина
+    if (!plugins_.empty()) {
+        if (auto command = plugins_.create(name)) {
+            return command;
+        }
+    }
 
-    builtinFactories_["wc"] = []() { return std::make_unique<WcCommand>(); };
+    // Внешняя команда
+    return makeCommand<ExternalCommand>(resource, std::string(name), env_, &pathCache_);
+}
 
-    builtinFactories_["pwd"] = []() { return std::make_unique<PwdCommand>(); };
+bool CommandFactory::isBuiltin(const std::string& name) const {
+    return lookupBuiltin(name) != BuiltinId::kNone || plugins_.contains(name);
+}
 
-    builtinFactories_["exit"] = []() { return std::make_unique<ExitCommand>(); };
+std::vector<std::string> CommandFactory::commandNames() const {
+    std::vector<std::string> names(detail::kBuiltinNames.begin(), detail::kBuiltinNames.end());
+    for (const auto& entry : plugins_.entries()) {
+        names.push_back(entry.name);
+    }
+    return names;
 }
 
 }  // namespace shell
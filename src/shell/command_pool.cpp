@@ -0,0 +1,34 @@
+#include "shell/command_pool.hpp"
+
+namespace shell {
+
+CommandPool::~CommandPool() {
+    for (auto& list : free_) {
+        for (Command* command : list) {
+            delete command;
+        }
+    }
+}
+
+CommandPool& CommandPool::local() {
+    thread_local CommandPool pool;
+    return pool;
+}
+
+void CommandPool::release(BuiltinId id, Command* command) {
+    auto& list = free_[static_cast<size_t>(id)];
+    if (list.size() >= kMaxPerBuiltin || !command->reset()) {
+        delete command;
+        return;
+    }
+    if (list.capacity() == 0) {
+        list.reserve(kMaxPerBuiltin);
+    }
+    list.push_back(command);
+}
+
+void CommandDeleter::recycle(BuiltinId id, Command* command) {
+    CommandPool::local().release(id, command);
+}
+
+}  // namespace shell
@@ -1,15 +1,66 @@
 #include "shell/commands/cat_command.hpp"
 
+#include <cstring>
 #include <fstream>
+#include <memory>
+
+#include "shell/input_file.hpp"
+#include "shell/io_ring.hpp"
 
 namespace shell {
 
-int CatCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+namespace {
+
+// Размер блока при чтении файла стадией-сопрограммой
+constexpr size_t kBlockSize = 128 * 1024;
+
+// Вывод файлов, прочитанных через io_uring, в порядке аргументов
+class CatConsumer : public FileConsumer {
+public:
+    CatConsumer(const std::vector<std::string>& filenames, std::ostream& out, std::ostream& err)
+        : filenames_(filenames), out_(out), err_(err) {}
+
+    bool data(size_t, const char* data, size_t size) override {
+        // Ошибка записи (читатель канала вышел) останавливает чтение файлов
+        return static_cast<bool>(out_.write(data, static_cast<std::streamsize>(size)));
+    }
+
+    void end(size_t index, int error) override {
+        if (error != 0) {
+            err_ << "cat: " << filenames_[index] << ": " << std::strerror(error) << "\n";
+            exitCode = 1;
+        }
+    }
+
+    int exitCode = 0;
+
+private:
+    const std::vector<std::string>& filenames_;
+    std::ostream& out_;
+    std::ostream& err_;
+};
+
+// Пустой источник не копируется: operator<< без единого символа ставит failbit на out
+void copyStream(std::streambuf* from, std::ostream& out) {
+    if (from->sgetc() != std::char_traits<char>::eof()) {
+        out << from;
+    }
+}
+
+}  // namespace
+
+CommandResult CatCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
     if (filenames_.empty()) {
-        out << in.rdbuf();
+        copyStream(in.rdbuf(), out);
         return 0;
     }
 
+    if (IoRing* ring = IoRing::local()) {
+        CatConsumer consumer(filenames_, out, err);
+        ring->readFiles(filenames_, consumer);
+        return consumer.exitCode;
+    }
+
     int exitCode = 0;
 
     for (const auto& filename : filenames_) {
@@ -21,14 +72,54 @@ int CatCommand::execute(std::istream& in, std::ostream& out, std::ostream& err)
             continue;
         }
 
-        out << file.rdbuf();
+        copyStream(file.rdbuf(), out);
     }
 
     return exitCode;
 }
 
-void CatCommand::setArguments(const std::vector<std::string>& args) {
-    filenames_ = args;
+StageTask CatCommand::stage(StageIO& io) {
+    if (filenames_.empty()) {
+        for (std::string_view chunk; !(chunk = co_await io.read()).empty();) {
+            if (!(co_yield chunk)) {
+                break;
+            }
+        }
+        co_return 0;
+    }
+
+    // Кольцо io_uring читает пачку файлов целиком за один вызов и не
+    // уступает управление, поэтому здесь файлы читаются блоками
+    int exitCode = 0;
+    auto buffer = std::make_unique<char[]>(kBlockSize);
+    for (const auto& filename : filenames_) {
+        InputFile file(filename);
+        if (!file.isOpen() || file.isDirectory()) {
+            io.err << "cat: " << filename << ": " << file.errorMessage() << "\n";
+            exitCode = 1;
+            continue;
+        }
+        ssize_t size = 0;
+        while ((size = file.read(buffer.get(), kBlockSize)) > 0) {
+            if (!(co_yield std::string_view(buffer.get(), static_cast<size_t>(size)))) {
+                co_return exitCode;
+            }
+        }
+    }
+    co_return exitCode;
+}
+
+void CatCommand::setArguments(std::vector<std::string> args) {
+    filenames_ = std::move(args);
+}
+
+void CatCommand::assignArguments(const std::pmr::vector<std::pmr::string>& args) {
+    filenames_.assign(args.begin(), args.end());
+}
+
+bool CatCommand::reset() {
+    filenames_.clear();
+    return true;
 }
 
 }  // namespace shell
@@ -0,0 +1,229 @@
+#include "shell/commands/count_command.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include "shell/input_file.hpp"
+
+namespace shell {
+
+namespace {
+
+// Размер блока чтения входа
+constexpr size_t kBlockSize = 128 * 1024;
+
+// Читает блоками и передаёт scan только целые строки (последняя — при EOF)
+template <typename Read, typename Scan>
+bool scanBlocks(Read read, Scan scan) {
+    std::string pending;
+    auto block = std::make_unique<char[]>(kBlockSize);
+
+    while (true) {
+        auto bytesRead = read(block.get(), kBlockSize);
+        if (bytesRead < 0) {
+            return false;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        pending.append(block.get(), static_cast<size_t>(bytesRead));
+
+        size_t cut = pending.rfind('\n');
+        if (cut != std::string::npos) {
+            scan(pending.data(), cut + 1);
+            pending.erase(0, cut + 1);
+        }
+    }
+
+    if (!pending.empty()) {
+        scan(pending.data(), pending.size());
+    }
+    return true;
+}
+
+bool parseNumber(const std::string& text, size_t& value) {
+    if (text.empty() || text.size() > 18) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+}  // namespace
+
+CommandResult CountCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    if (!parseArguments(err)) {
+        return 1;
+    }
+
+    LineCounter counter;
+    if (filenames_.empty()) {
+        scanBlocks(
+            [&in](char* buffer, size_t capacity) {
+                in.read(buffer, static_cast<std::streamsize>(capacity));
+                return in.gcount();
+            },
+            [&](const char* data, size_t size) { countLines(data, size, counter); });
+    }
+
+    int exitCode = 0;
+    for (const auto& filename : filenames_) {
+        InputFile file(filename);
+        if (!file.isOpen() || file.isDirectory()) {
+            err << "count: " << filename << ": " << file.errorMessage() << "\n";
+            exitCode = 1;
+            continue;
+        }
+        std::string_view mapped = file.map();
+        if (!mapped.empty()) {
+            countLines(mapped.data(), mapped.size(), counter);
+            continue;
+        }
+        bool ok = scanBlocks(
+            [&file](char* buffer, size_t capacity) { return file.read(buffer, capacity); },
+            [&](const char* data, size_t size) { countLines(data, size, counter); });
+        if (!ok) {
+            err << "count: " << filename << ": read error\n";
+            exitCode = 1;
+        }
+    }
+
+    std::vector<LineCounter::Entry> entries = hasTop_ ? counter.top(top_) : counter.sorted();
+    std::string output;
+    char number[32];
+    for (const auto& entry : entries) {
+        int length = std::snprintf(number, sizeof(number), "%7llu ",
+                                   static_cast<unsigned long long>(entry.count));
+        output.append(number, static_cast<size_t>(length));
+        output.append(entry.key);
+        output += '\n';
+    }
+    out << output;
+    return exitCode;
+}
+
+void CountCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+bool CountCommand::parseArguments(std::ostream& err) {
+    filenames_.clear();
+    field_ = 0;
+    hasSeparator_ = false;
+    hasTop_ = false;
+    bool optionsDone = false;
+
+    for (size_t i = 0; i < args_.size(); ++i) {
+        const std::string& arg = args_[i];
+        if (optionsDone || arg.size() < 2 || arg[0] != '-') {
+            filenames_.push_back(arg);
+            continue;
+        }
+        if (arg == "--") {
+            optionsDone = true;
+            continue;
+        }
+        char flag = arg[1];
+        if (flag != 't' && flag != 'f' && flag != 'n') {
+            err << "count: invalid option -- '" << flag << "'\n";
+            return false;
+        }
+        // Значение — остаток аргумента или следующий аргумент
+        std::string value;
+        if (arg.size() > 2) {
+            value = arg.substr(2);
+        } else if (i + 1 < args_.size()) {
+            value = args_[++i];
+        } else {
+            err << "count: option requires an argument -- '" << flag << "'\n";
+            return false;
+        }
+
+        if (flag == 't') {
+            if (value.size() != 1) {
+                err << "count: multi-character separator '" << value << "'\n";
+                return false;
+            }
+            separator_ = value[0];
+            hasSeparator_ = true;
+        } else if (flag == 'f') {
+            if (!parseNumber(value, field_) || field_ == 0) {
+                err << "count: invalid field number: '" << value << "'\n";
+                return false;
+            }
+        } else {
+            if (!parseNumber(value, top_)) {
+                err << "count: invalid number of lines: '" << value << "'\n";
+                return false;
+            }
+            hasTop_ = true;
+        }
+    }
+    return true;
+}
+
+void CountCommand::countLines(const char* data, size_t size, LineCounter& counter) const {
+    const char* end = data + size;
+    while (data < end) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(data, '\n', static_cast<size_t>(end - data)));
+        const char* lineEnd = newline != nullptr ? newline : end;
+        counter.add(key(std::string_view(data, static_cast<size_t>(lineEnd - data))));
+        data = lineEnd + 1;
+    }
+}
+
+std::string_view CountCommand::key(std::string_view line) const {
+    if (field_ == 0) {
+        return line;
+    }
+    size_t pos = 0;
+    for (size_t field = 1;; ++field) {
+        size_t start = pos;
+        size_t stop = pos;
+        if (hasSeparator_) {
+            stop = line.find(separator_, pos);
+            if (stop == std::string_view::npos) {
+                stop = line.size();
+            }
+            pos = stop + 1;
+        } else {
+            while (start < line.size() && isBlank(line[start])) {
+                ++start;
+            }
+            stop = start;
+            while (stop < line.size() && !isBlank(line[stop])) {
+                ++stop;
+            }
+            pos = stop;
+        }
+        if (field == field_) {
+            return line.substr(start, stop - start);
+        }
+        if (pos >= line.size()) {
+            return std::string_view();
+        }
+    }
+}
+
+void CountCommand::assignArguments(const std::pmr::vector<std::pmr::string>& args) {
+    args_.assign(args.begin(), args.end());
+}
+
+bool CountCommand::reset() {
+    args_.clear();
+    return true;
+}
+
+}  // namespace shell
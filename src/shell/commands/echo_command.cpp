@@ -2,8 +2,8 @@
 
 namespace shell {
 
-int EchoCommand::execute(std::istream& /*in*/, std::ostream& out, std::ostream& /*err*/
-) {
+CommandResult EchoCommand::execute(std::istream& /*in*/, std::ostream& out,
+                                   std::ostream& /*err*/) {
     for (size_t i = 0; i < args_.size(); ++i) {
         if (i > 0) {
             out << ' ';
@@ -14,8 +14,30 @@ int EchoCommand::execute(std::istream& /*in*/, std::ostream& out, std::ostream&
     return 0;
 }
 
-void EchoCommand::setArguments(const std::vector<std::string>& args) {
-    args_ = args;
+StageTask EchoCommand::stage(StageIO& /*io*/) {
+    std::string line;
+    for (size_t i = 0; i < args_.size(); ++i) {
+        if (i > 0) {
+            line += ' ';
+        }
+        line += args_[i];
+    }
+    line += '\n';
+    co_yield line;
+    co_return 0;
+}
+
+void EchoCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+void EchoCommand::assignArguments(const std::pmr::vector<std::pmr::string>& args) {
+    args_.assign(args.begin(), args.end());
+}
+
+bool EchoCommand::reset() {
+    args_.clear();
+    return true;
 }
 
 }  // namespace shell
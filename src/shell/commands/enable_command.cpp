@@ -0,0 +1,50 @@
+#include "shell/commands/enable_command.hpp"
+
+namespace shell {
+
+EnableCommand::EnableCommand(PluginTable& plugins) : plugins_(plugins) {}
+
+CommandResult EnableCommand::execute(std::istream& /*in*/, std::ostream& out, std::ostream& err) {
+    if (args_.empty()) {
+        for (const auto& entry : plugins_.entries()) {
+            out << "enable -f " << entry.path << ' ' << entry.name << '\n';
+        }
+        return 0;
+    }
+
+    const std::string& option = args_[0];
+    if (option == "-f") {
+        if (args_.size() < 2) {
+            err << "enable: -f: option requires an argument\n";
+            return 2;
+        }
+        std::vector<std::string> names(args_.begin() + 2, args_.end());
+        std::string error;
+        if (!plugins_.load(args_[1], names, error)) {
+            err << "enable: " << error << '\n';
+            return 1;
+        }
+        return 0;
+    }
+
+    if (option == "-d") {
+        int exitCode = 0;
+        for (size_t i = 1; i < args_.size(); ++i) {
+            if (!plugins_.remove(args_[i])) {
+                err << "enable: " << args_[i] << ": not a dynamically loaded builtin\n";
+                exitCode = 1;
+            }
+        }
+        return exitCode;
+    }
+
+    err << "enable: " << option << ": invalid option\n"
+        << "enable: usage: enable [-f FILE [NAME...]] [-d NAME...]\n";
+    return 2;
+}
+
+void EnableCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+}  // namespace shell
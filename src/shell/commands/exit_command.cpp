@@ -4,8 +4,8 @@
 
 namespace shell {
 
-int ExitCommand::execute(std::istream& /*in*/, std::ostream& /*out*/, std::ostream& /*err*/
-) {
+CommandResult ExitCommand::execute(std::istream& /*in*/, std::ostream& /*out*/,
+                                   std::ostream& /*err*/) {
     exitRequested_ = true;
 
     if (!args_.empty()) {
@@ -18,11 +18,22 @@ int ExitCommand::execute(std::istream& /*in*/, std::ostream& /*out*/, std::ostre
         exitCode_ = 0;
     }
 
-    return exitCode_;
+    return CommandResult::exit(exitCode_);
 }
 
-void ExitCommand::setArguments(const std::vector<std::string>& args) {
-    args_ = args;
+void ExitCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+void ExitCommand::assignArguments(const std::pmr::vector<std::pmr::string>& args) {
+    args_.assign(args.begin(), args.end());
+}
+
+bool ExitCommand::reset() {
+    args_.clear();
+    exitRequested_ = false;
+    exitCode_ = 0;
+    return true;
 }
 
 }  // namespace shell
@@ -1,74 +1,71 @@
 #include "shell/commands/external_command.hpp"
 
-#include <cstring>
-#include <sstream>
+#include <cerrno>
+#include <thread>
 
-#include <sys/wait.h>
 #include <unistd.h>
 
+#include "shell/launcher.hpp"
+#include "shell/process_util.hpp"
+#include "shell/stream_pipe.hpp"
+
 namespace shell {
 
-ExternalCommand::ExternalCommand(const std::string& programName, Environment& env)
-    : programName_(programName), env_(env) {}
+namespace {
+
+constexpr size_t kIoBufferSize = 64 * 1024;
+
+}  // namespace
 
-int ExternalCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+ExternalCommand::ExternalCommand(const std::string& programName, Environment& env,
+                                 PathCache* pathCache)
+    : programName_(programName), env_(env), pathCache_(pathCache) {}
+
+SpawnedProcess ExternalCommand::start(int stdinFd, int stdoutFd, std::ostream& err,
+                                      int& failureCode) {
     // Ищем исполняемый файл
     auto execPath = findExecutable();
     if (!execPath) {
         err << programName_ << ": command not found\n";
-        return 127;
+        failureCode = 127;
+        return {};
     }
 
+    SpawnedProcess process =
+        Launcher::shared().spawn(*execPath, args_, env_.toEnvp(), stdinFd, stdoutFd);
+    if (process.pid < 0) {
+        err << programName_ << ": fork failed\n";
+        failureCode = 1;
+    }
+    return process;
+}
+
+CommandResult ExternalCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    ignoreSigpipe();
+
     // Создаём каналы для stdin и stdout
     int stdinPipe[2];
     int stdoutPipe[2];
 
-    if (pipe(stdinPipe) < 0 || pipe(stdoutPipe) < 0) {
+    if (!openPipe(stdinPipe)) {
         err << programName_ << ": pipe creation failed\n";
         return 1;
     }
-
-    pid_t pid = fork();
-
-    if (pid < 0) {
-        err << programName_ << ": fork failed\n";
+    if (!openPipe(stdoutPipe)) {
+        close(stdinPipe[0]);
+        close(stdinPipe[1]);
+        err << programName_ << ": pipe creation failed\n";
         return 1;
     }
 
-    if (pid == 0) {
-        // Дочерний процесс
-
-        // Перенаправляем stdin
-        close(stdinPipe[1]);
-        dup2(stdinPipe[0], STDIN_FILENO);
-        close(stdinPipe[0]);
-
-        // Перенаправляем stdout
-        close(stdoutPipe[0]);
-        dup2(stdoutPipe[1], STDOUT_FILENO);
-        close(stdoutPipe[1]);
-
-        // Формируем массив аргументов
-        std::vector<char*> argv;
-        argv.push_back(const_cast<char*>(execPath->c_str()));
-        for (const auto& arg : args_) {
-            argv.push_back(const_cast<char*>(arg.c_str()));
-        }
-        argv.push_back(nullptr);
+    int failureCode = 0;
+    SpawnedProcess process = start(stdinPipe[0], stdoutPipe[1], err, failureCode);
 
-        // Формируем окружение
-        std::vector<std::string> envStrings = env_.toEnvp();
-        std::vector<char*> envp;
-        for (auto& s : envStrings) {
-            envp.push_back(const_cast<char*>(s.c_str()));
+    if (process.pid < 0) {
+        for (int fd : {stdinPipe[0], stdinPipe[1], stdoutPipe[0], stdoutPipe[1]}) {
+            close(fd);
         }
-        envp.push_back(nullptr);
-
-        // Запускаем программу
-        execve(execPath->c_str(), argv.data(), envp.data());
-
-        // Если execve вернулся — ошибка
-        _exit(127);
+        return failureCode;
     }
 
     // Родительский процесс
@@ -77,40 +74,44 @@ int ExternalCommand::execute(std::istream& in, std::ostream& out, std::ostream&
     close(stdinPipe[0]);
     close(stdoutPipe[1]);
 
-    // Отправляем входные данные
-    std::stringstream inputBuffer;
-    inputBuffer << in.rdbuf();
-    std::string inputData = inputBuffer.str();
-
-    if (!inputData.empty()) {
-        ssize_t written = write(stdinPipe[1], inputData.c_str(), inputData.size());
-        (void)written;  // Игнорируем возможные ошибки записи
-    }
-    close(stdinPipe[1]);
+    // Вход передаётся отдельным потоком по мере поступления, чтобы
+    // программа могла одновременно писать вывод
+    std::thread feeder([&in, fd = stdinPipe[1]] {
+        char buffer[kIoBufferSize];
+        size_t size = 0;
+        while ((size = readAvailable(in, buffer, sizeof(buffer))) > 0) {
+            if (!writeAll(fd, buffer, size)) {
+                break;  // Программа закрыла stdin или завершилась
+            }
+        }
+        close(fd);
+    });
 
-    // Читаем вывод
-    char buffer[4096];
+    // Читаем вывод; если следующая стадия его больше не принимает,
+    // закрываем канал — программа получит SIGPIPE при следующей записи
+    char buffer[kIoBufferSize];
     ssize_t bytesRead;
-    while ((bytesRead = read(stdoutPipe[0], buffer, sizeof(buffer))) > 0) {
-        out.write(buffer, bytesRead);
+    while ((bytesRead = read(stdoutPipe[0], buffer, sizeof(buffer))) != 0) {
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (!out.write(buffer, bytesRead)) {
+            break;
+        }
     }
     close(stdoutPipe[0]);
 
     // Ожидаем завершения дочернего процесса
-    int status;
-    waitpid(pid, &status, 0);
-
-    if (WIFEXITED(status)) {
-        return WEXITSTATUS(status);
-    } else if (WIFSIGNALED(status)) {
-        return 128 + WTERMSIG(status);
-    }
-
-    return 1;
+    int returnCode = waitProcess(process.pid, process.pidfd);
+    feeder.join();
+    return returnCode;
 }
 
-void ExternalCommand::setArguments(const std::vector<std::string>& args) {
-    args_ = args;
+void ExternalCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
 }
 
 std::optional<std::string> ExternalCommand::findExecutable() const {
@@ -123,23 +124,10 @@ std::optional<std::string> ExternalCommand::findExecutable() const {
     }
 
     // Ищем в PATH
-    std::string pathVar = env_.get("PATH");
-    if (pathVar.empty()) {
-        // Стандартные пути
-        pathVar = "/usr/local/bin:/usr/bin:/bin";
+    if (pathCache_ != nullptr) {
+        return pathCache_->lookup(programName_);
     }
-
-    std::stringstream ss(pathVar);
-    std::string dir;
-
-    while (std::getline(ss, dir, ':')) {
-        std::string fullPath = dir + "/" + programName_;
-        if (access(fullPath.c_str(), X_OK) == 0) {
-            return fullPath;
-        }
-    }
-
-    return std::nullopt;
+    return PathCache::resolve(programName_, env_.get("PATH"));
 }
 
 }  // namespace shell
@@ -0,0 +1,482 @@
+#include "shell/commands/find_command.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "shell/directory_reader.hpp"
+#include "shell/interrupt.hpp"
+#include "shell/thread_pool.hpp"
+
+namespace shell {
+
+namespace {
+
+/**
+ * Элемент каталога; stat выполняется при первой необходимости
+ */
+struct Entry {
+    std::string name;
+    unsigned char type = DT_UNKNOWN;
+    bool statDone = false;
+    bool statOk = false;
+    struct stat st {};
+};
+
+char typeFromDirent(unsigned char type) {
+    switch (type) {
+        case DT_REG:
+            return 'f';
+        case DT_DIR:
+            return 'd';
+        case DT_LNK:
+            return 'l';
+        case DT_BLK:
+            return 'b';
+        case DT_CHR:
+            return 'c';
+        case DT_FIFO:
+            return 'p';
+        case DT_SOCK:
+            return 's';
+        default:
+            return '\0';
+    }
+}
+
+char typeFromMode(mode_t mode) {
+    if (S_ISREG(mode)) {
+        return 'f';
+    }
+    if (S_ISDIR(mode)) {
+        return 'd';
+    }
+    if (S_ISLNK(mode)) {
+        return 'l';
+    }
+    if (S_ISBLK(mode)) {
+        return 'b';
+    }
+    if (S_ISCHR(mode)) {
+        return 'c';
+    }
+    if (S_ISFIFO(mode)) {
+        return 'p';
+    }
+    return S_ISSOCK(mode) ? 's' : '\0';
+}
+
+// stat элемента относительно открытого каталога (или по пути, если dirFd < 0)
+bool statEntry(Entry& entry, int dirFd, const std::string& path) {
+    if (!entry.statDone) {
+        entry.statDone = true;
+        entry.statOk = dirFd >= 0
+                           ? fstatat(dirFd, entry.name.c_str(), &entry.st, AT_SYMLINK_NOFOLLOW) == 0
+                           : lstat(path.c_str(), &entry.st) == 0;
+    }
+    return entry.statOk;
+}
+
+char entryType(Entry& entry, int dirFd, const std::string& path) {
+    char type = typeFromDirent(entry.type);
+    if (type == '\0' && statEntry(entry, dirFd, path)) {
+        type = typeFromMode(entry.st.st_mode);
+    }
+    return type;
+}
+
+bool matches(const FindCommand::Filter& filter, Entry& entry, int dirFd,
+             const std::string& path) {
+    for (const auto& pattern : filter.names) {
+        if (fnmatch(pattern.c_str(), entry.name.c_str(), 0) != 0) {
+            return false;
+        }
+    }
+    if (filter.type != '\0' && entryType(entry, dirFd, path) != filter.type) {
+        return false;
+    }
+    if (!filter.needsStat()) {
+        return true;
+    }
+    if (!statEntry(entry, dirFd, path)) {
+        return false;
+    }
+    // Размер округляется вверх до единиц, как в GNU find
+    auto size = static_cast<uint64_t>(entry.st.st_size);
+    for (const auto& comparison : filter.sizes) {
+        if (!comparison.matches((size + comparison.unit - 1) / comparison.unit)) {
+            return false;
+        }
+    }
+    std::time_t age = filter.now - entry.st.st_mtime;
+    uint64_t days = age > 0 ? static_cast<uint64_t>(age) / 86400 : 0;
+    for (const auto& comparison : filter.mtimes) {
+        if (!comparison.matches(days)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string joinPath(const std::string& dir, const std::string& name) {
+    if (!dir.empty() && dir.back() == '/') {
+        return dir + name;
+    }
+    return dir + "/" + name;
+}
+
+// Имя корня для -name: последний компонент пути без завершающих '/'
+std::string baseName(const std::string& path) {
+    size_t end = path.find_last_not_of('/');
+    if (end == std::string::npos) {
+        return "/";
+    }
+    size_t start = path.rfind('/', end);
+    return path.substr(start == std::string::npos ? 0 : start + 1,
+                       end - (start == std::string::npos ? 0 : start + 1) + 1);
+}
+
+struct Node;
+
+/**
+ * Часть вывода каталога: найденные пути, затем вывод подкаталога child
+ */
+struct Part {
+    std::string text;
+    std::string errors;
+    std::unique_ptr<Node> child;
+};
+
+/**
+ * Результат чтения каталога; готов, когда done
+ */
+struct Node {
+    std::vector<Part> parts;
+    bool done = false;
+};
+
+/**
+ * Параллельный обход: каждый каталог — задача пула. В упорядоченном
+ * режиме задача заполняет свой Node, в неупорядоченном — кладёт
+ * готовые части в общую очередь.
+ */
+class Walk {
+public:
+    Walk(const FindCommand::Filter& filter, ThreadPool& pool) : filter_(filter), pool_(pool) {}
+
+    ~Walk() {
+        stop();
+        waitIdle();
+    }
+
+    void start(std::string path, size_t depth, Node* node) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++outstanding_;
+        }
+        pool_.submit([this, path = std::move(path), depth, node]() {
+            visit(path, depth, node);
+        });
+    }
+
+    void waitFor(const Node* node) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [node] { return node->done; });
+    }
+
+    // Следующая готовая часть (неупорядоченный режим); false — обход закончен
+    bool next(Part& part) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return !ready_.empty() || outstanding_ == 0; });
+        if (ready_.empty()) {
+            return false;
+        }
+        part = std::move(ready_.front());
+        ready_.pop_front();
+        return true;
+    }
+
+    void stop() {
+        stopped_ = true;
+    }
+
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return outstanding_ == 0; });
+    }
+
+private:
+    const FindCommand::Filter& filter_;
+    ThreadPool& pool_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    size_t outstanding_ = 0;
+    std::deque<Part> ready_;
+    std::atomic<bool> stopped_{false};
+
+    void visit(const std::string& path, size_t depth, Node* node);
+    void publish(Node* node, std::vector<Part> parts);
+};
+
+void Walk::visit(const std::string& path, size_t depth, Node* node) {
+    std::vector<Part> parts(1);
+    int fd = -1;
+    if (!stopped_) {
+        fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    }
+    std::vector<DirEntry> entries;
+    if (fd >= 0 && !readDirectory(fd, entries)) {
+        int error = errno;
+        close(fd);
+        fd = -1;
+        errno = error;
+    }
+    if (fd < 0 && !stopped_) {
+        parts[0].errors = "find: '" + path + "': " + std::strerror(errno) + "\n";
+    }
+
+    if (!filter_.unordered) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const DirEntry& a, const DirEntry& b) { return a.name < b.name; });
+    }
+    for (auto& item : entries) {
+        Entry entry;
+        entry.name = std::move(item.name);
+        entry.type = item.type;
+        std::string entryPath = joinPath(path, entry.name);
+        if (matches(filter_, entry, fd, entryPath)) {
+            parts.back().text += entryPath;
+            parts.back().text += filter_.terminator;
+        }
+        if (depth < filter_.maxDepth && entryType(entry, fd, entryPath) == 'd') {
+            std::unique_ptr<Node> child;
+            if (!filter_.unordered) {
+                child = std::make_unique<Node>();
+            }
+            start(entryPath, depth + 1, child.get());
+            parts.back().child = std::move(child);
+            parts.emplace_back();
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    publish(node, std::move(parts));
+}
+
+void Walk::publish(Node* node, std::vector<Part> parts) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (node != nullptr) {
+            node->parts = std::move(parts);
+            node->done = true;
+        } else {
+            for (auto& part : parts) {
+                if (!part.text.empty() || !part.errors.empty()) {
+                    ready_.push_back(std::move(part));
+                }
+            }
+        }
+        --outstanding_;
+    }
+    changed_.notify_all();
+}
+
+bool parseNumber(const std::string& text, size_t pos, uint64_t& value, size_t& end) {
+    end = pos;
+    value = 0;
+    while (end < text.size() && text[end] >= '0' && text[end] <= '9' && end - pos < 18) {
+        value = value * 10 + static_cast<uint64_t>(text[end] - '0');
+        ++end;
+    }
+    return end > pos;
+}
+
+// [+-]N: знак сравнения и число; pos — позиция после числа
+bool parseComparison(const std::string& text, FindCommand::Comparison& comparison,
+                     size_t& pos) {
+    size_t start = 0;
+    comparison.sign = 0;
+    if (!text.empty() && (text[0] == '+' || text[0] == '-')) {
+        comparison.sign = text[0] == '+' ? 1 : -1;
+        start = 1;
+    }
+    return parseNumber(text, start, comparison.value, pos);
+}
+
+}  // namespace
+
+CommandResult FindCommand::execute(std::istream&, std::ostream& out, std::ostream& err) {
+    if (!parseArguments(err)) {
+        return 1;
+    }
+    filter_.now = std::time(nullptr);
+
+    int exitCode = 0;
+    bool stopped = false;
+    auto emit = [&](const Part& part) {
+        if (!part.errors.empty()) {
+            err << part.errors;
+            exitCode = 1;
+        }
+        out << part.text;
+        stopped = !out || Interrupt::requested();
+    };
+
+    Walk walk(filter_, ThreadPool::shared());
+    std::vector<Part> roots;
+    for (const auto& root : roots_) {
+        Part part;
+        Entry entry;
+        entry.name = baseName(root);
+        if (!statEntry(entry, -1, root)) {
+            part.errors = "find: '" + root + "': " + std::strerror(errno) + "\n";
+            roots.push_back(std::move(part));
+            continue;
+        }
+        if (matches(filter_, entry, -1, root)) {
+            part.text = root + filter_.terminator;
+        }
+        if (filter_.maxDepth > 0 && S_ISDIR(entry.st.st_mode)) {
+            if (!filter_.unordered) {
+                part.child = std::make_unique<Node>();
+            }
+            walk.start(root, 1, part.child.get());
+        }
+        roots.push_back(std::move(part));
+    }
+
+    if (filter_.unordered) {
+        for (const auto& part : roots) {
+            emit(part);
+        }
+        Part part;
+        while (!stopped && walk.next(part)) {
+            emit(part);
+        }
+    } else {
+        // Обход в глубину по готовым узлам; узел освобождается после вывода
+        std::function<void(Node*)> printNode = [&](Node* node) {
+            walk.waitFor(node);
+            for (auto& part : node->parts) {
+                emit(part);
+                if (stopped) {
+                    return;
+                }
+                if (part.child) {
+                    printNode(part.child.get());
+                    if (stopped) {
+                        return;
+                    }
+                    part.child.reset();
+                }
+            }
+        };
+        for (auto& part : roots) {
+            emit(part);
+            if (stopped) {
+                break;
+            }
+            if (part.child) {
+                printNode(part.child.get());
+                if (stopped) {
+                    break;
+                }
+            }
+        }
+    }
+
+    walk.stop();
+    walk.waitIdle();
+    return exitCode;
+}
+
+void FindCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+bool FindCommand::parseArguments(std::ostream& err) {
+    roots_.clear();
+    filter_ = Filter{};
+    size_t i = 0;
+    for (; i < args_.size() && (args_[i].empty() || args_[i][0] != '-'); ++i) {
+        roots_.push_back(args_[i]);
+    }
+    if (roots_.empty()) {
+        roots_.push_back(".");
+    }
+
+    for (; i < args_.size(); ++i) {
+        const std::string& arg = args_[i];
+        if (arg == "-print") {
+            continue;
+        }
+        if (arg == "-print0") {
+            filter_.terminator = '\0';
+            continue;
+        }
+        if (arg == "-unordered") {
+            filter_.unordered = true;
+            continue;
+        }
+        if (arg != "-name" && arg != "-type" && arg != "-size" && arg != "-mtime" &&
+            arg != "-maxdepth") {
+            err << "find: unknown predicate '" << arg << "'\n";
+            return false;
+        }
+        if (i + 1 == args_.size()) {
+            err << "find: missing argument to '" << arg << "'\n";
+            return false;
+        }
+        const std::string& value = args_[++i];
+        size_t end = 0;
+        bool ok = true;
+        if (arg == "-name") {
+            filter_.names.push_back(value);
+        } else if (arg == "-type") {
+            ok = value.size() == 1 && std::strchr("fdlbcps", value[0]) != nullptr;
+            filter_.type = value[0];
+        } else if (arg == "-size") {
+            Comparison size;
+            size.unit = 512;
+            ok = parseComparison(value, size, end);
+            if (ok && end < value.size()) {
+                const char* units = "cwbkMG";
+                const uint64_t sizes[] = {1, 2, 512, 1024, 1 << 20, 1 << 30};
+                const char* unit = std::strchr(units, value[end]);
+                ok = end + 1 == value.size() && unit != nullptr;
+                if (ok) {
+                    size.unit = sizes[unit - units];
+                }
+            }
+            filter_.sizes.push_back(size);
+        } else if (arg == "-mtime") {
+            Comparison mtime;
+            ok = parseComparison(value, mtime, end) && end == value.size();
+            filter_.mtimes.push_back(mtime);
+        } else {
+            uint64_t depth = 0;
+            ok = parseNumber(value, 0, depth, end) && end == value.size();
+            filter_.maxDepth = static_cast<size_t>(depth);
+        }
+        if (!ok) {
+            err << "find: invalid argument '" << value << "' to '" << arg << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace shell
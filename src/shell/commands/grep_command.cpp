@@ -0,0 +1,588 @@
+#include "shell/commands/grep_command.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <memory>
+
+#include "shell/input_file.hpp"
+#include "shell/stream_pipe.hpp"
+#include "shell/text_counter.hpp"
+#include "shell/thread_pool.hpp"
+
+namespace shell {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Размер блока при чтении потока или необычного файла
+constexpr size_t kBlockSize = 128 * 1024;
+
+// Предел длины одной альтернативы образцов: программа Regex по большому
+// списку выражений (-f) иначе превысила бы допустимый размер
+constexpr size_t kRegexGroupBytes = 4096;
+
+// Есть ли в образце метасимволы BRE (или ERE)
+bool hasRegexMeta(const std::string& pattern, bool extended) {
+    return pattern.find_first_of(extended ? ".[]*^$\\+?|(){}" : ".[]*^$\\") != std::string::npos;
+}
+
+const char* lineStart(const char* limit, const char* pos) {
+    while (pos > limit && pos[-1] != '\n') {
+        --pos;
+    }
+    return pos;
+}
+
+const char* lineEnd(const char* pos, const char* end) {
+    const void* newline = std::memchr(pos, '\n', static_cast<size_t>(end - pos));
+    return newline != nullptr ? static_cast<const char*>(newline) : end;
+}
+
+// Читает блоками и передаёт scan только целые строки (последняя — при EOF).
+// scan возвращает false, если дальше читать не нужно.
+template <typename Read, typename Scan>
+bool scanBlocks(Read read, Scan scan) {
+    std::string pending;
+    auto block = std::make_unique<char[]>(kBlockSize);
+
+    while (true) {
+        auto bytesRead = read(block.get(), kBlockSize);
+        if (bytesRead < 0) {
+            return false;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        pending.append(block.get(), static_cast<size_t>(bytesRead));
+
+        size_t cut = pending.rfind('\n');
+        if (cut != std::string::npos) {
+            if (!scan(pending.data(), cut + 1)) {
+                return true;
+            }
+            pending.erase(0, cut + 1);
+        }
+    }
+
+    if (!pending.empty()) {
+        scan(pending.data(), pending.size());
+    }
+    return true;
+}
+
+// Рекурсивный обход без перехода по символическим ссылкам, имена в каталоге сортируются
+void walkDirectory(const std::string& dir, bool implicitRoot, std::vector<std::string>& files) {
+    std::error_code ec;
+    std::vector<fs::directory_entry> entries;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        entries.push_back(*it);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& a, const auto& b) {
+                  return a.path().filename() < b.path().filename();
+              });
+
+    for (const auto& entry : entries) {
+        std::string name = entry.path().filename().string();
+        std::string path = implicitRoot ? name : dir + "/" + name;
+        if (entry.is_symlink(ec)) {
+            continue;
+        }
+        if (entry.is_directory(ec)) {
+            walkDirectory(path, false, files);
+        } else if (entry.is_regular_file(ec)) {
+            files.push_back(path);
+        }
+    }
+}
+
+}  // namespace
+
+/**
+ * Поиск образцов в буфере: строкой или автоматом и регулярными выражениями.
+ * У каждого потока свой объект — кэш DFA не разделяется.
+ */
+class GrepCommand::LineFinder {
+public:
+    LineFinder(const LiteralSearcher* literal, const MultiLiteralSearcher* multi,
+               const std::vector<std::shared_ptr<const Regex>>& regexes)
+        : literal_(literal), multi_(multi) {
+        for (const auto& regex : regexes) {
+            matchers_.push_back(std::make_unique<RegexMatcher>(regex));
+        }
+        hits_.resize(matchers_.size() + (literal_ != nullptr || multi_ != nullptr ? 1 : 0));
+    }
+
+    // Новый буфер: найденные раньше позиции недействительны
+    void reset() {
+        for (auto& hit : hits_) {
+            hit.valid = false;
+        }
+    }
+
+    // Позиция внутри первой строки с совпадением или nullptr. Поиск идёт
+    // вперёд по буферу, поэтому совпадение источника, ещё не пройденное,
+    // не ищется заново: строки до него этого источника не содержат.
+    const char* find(const char* begin, const char* end) {
+        const char* best = nullptr;
+        for (size_t i = 0; i < hits_.size(); ++i) {
+            Hit& hit = hits_[i];
+            if (!hit.valid || (hit.pos != nullptr && hit.pos < begin)) {
+                hit.pos = search(i, begin, end);
+                hit.valid = true;
+            }
+            if (hit.pos != nullptr && (best == nullptr || hit.pos < best)) {
+                best = hit.pos;
+            }
+        }
+        return best;
+    }
+
+private:
+    struct Hit {
+        bool valid = false;
+        const char* pos = nullptr;
+    };
+
+    const LiteralSearcher* literal_;
+    const MultiLiteralSearcher* multi_;
+    std::vector<std::unique_ptr<RegexMatcher>> matchers_;
+    std::vector<Hit> hits_;  ///< По выражению на matchers_, затем строки
+
+    const char* search(size_t source, const char* begin, const char* end) {
+        if (source < matchers_.size()) {
+            return matchers_[source]->find(begin, end);
+        }
+        if (multi_ != nullptr) {
+            const char* hit = multi_->find(begin, end);
+            return hit == end ? nullptr : hit;
+        }
+        const char* hit = literal_->find(begin, end);
+        return hit == end && literal_->size() > 0 ? nullptr : hit;
+    }
+};
+
+GrepCommand::GrepCommand(RegexCache* regexCache, PatternFileCache* patternCache)
+    : regexCache_(regexCache), patternCache_(patternCache) {}
+
+CommandResult GrepCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    if (!parseArguments(err)) {
+        return 2;
+    }
+
+    if (!preparePattern(err)) {
+        return 2;
+    }
+
+    if (filenames_.empty() && !options_.recursive) {
+        return searchStream(in, out) > 0 ? 0 : 1;
+    }
+
+    std::vector<std::string> files = collectFiles();
+    options_.withNames = files.size() > 1 || options_.recursive;
+
+    // Файлы просматриваются параллельно, а выводятся строго в порядке перечисления
+    ThreadPool& pool = ThreadPool::shared();
+    std::vector<std::future<FileResult>> pending(files.size());
+    if (files.size() > 1 && pool.size() > 1) {
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (files[i] != "-") {
+                const std::string& filename = files[i];
+                pending[i] = pool.submit([this, &filename]() { return searchFile(filename); });
+            }
+        }
+    }
+
+    size_t matches = 0;
+    bool failed = false;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (files[i] == "-") {
+            matches += searchStream(in, out);
+            continue;
+        }
+
+        FileResult result = pending[i].valid() ? pending[i].get() : searchFile(files[i]);
+        if (!result.error.empty()) {
+            err << result.error;
+            failed = true;
+            continue;
+        }
+        out << result.output;
+        matches += result.matches;
+    }
+
+    if (failed) {
+        return 2;
+    }
+    return matches > 0 ? 0 : 1;
+}
+
+void GrepCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+bool GrepCommand::parseArguments(std::ostream& err) {
+    options_ = Options{};
+    patterns_.clear();
+    patternFiles_.clear();
+    filenames_.clear();
+    bool havePattern = false;
+    bool optionsDone = false;
+
+    for (size_t i = 0; i < args_.size(); ++i) {
+        const std::string& arg = args_[i];
+        if (optionsDone || arg.size() < 2 || arg[0] != '-') {
+            if (!havePattern) {
+                patterns_.push_back(arg);
+                havePattern = true;
+            } else {
+                filenames_.push_back(arg);
+            }
+            continue;
+        }
+        if (arg == "--") {
+            optionsDone = true;
+            continue;
+        }
+        for (size_t j = 1; j < arg.size(); ++j) {
+            switch (arg[j]) {
+                case 'c':
+                    options_.count = true;
+                    break;
+                case 'v':
+                    options_.invert = true;
+                    break;
+                case 'i':
+                    options_.ignoreCase = true;
+                    break;
+                case 'n':
+                    options_.lineNumbers = true;
+                    break;
+                case 'l':
+                    options_.filesOnly = true;
+                    break;
+                case 'r':
+                    options_.recursive = true;
+                    break;
+                case 'E':
+                    options_.extended = true;
+                    break;
+                case 'F':
+                    options_.fixed = true;
+                    break;
+                case 'e':
+                case 'f': {
+                    // Образец (или файл образцов) — остаток аргумента или следующий аргумент
+                    auto& target = arg[j] == 'e' ? patterns_ : patternFiles_;
+                    if (j + 1 < arg.size()) {
+                        target.push_back(arg.substr(j + 1));
+                    } else if (i + 1 < args_.size()) {
+                        target.push_back(args_[++i]);
+                    } else {
+                        err << "grep: option requires an argument -- '" << arg[j] << "'\n";
+                        return false;
+                    }
+                    havePattern = true;
+                    j = arg.size();
+                    break;
+                }
+                default:
+                    err << "grep: invalid option -- '" << arg[j] << "'\n";
+                    return false;
+            }
+        }
+    }
+
+    if (!havePattern) {
+        err << "Usage: grep [-cvinlrEF] [-e PATTERN]... [-f FILE]... [PATTERN] [FILE...]\n";
+        return false;
+    }
+    return true;
+}
+
+bool GrepCommand::preparePattern(std::ostream& err) {
+    literal_.reset();
+    multi_.reset();
+    regexes_.clear();
+
+    auto isLiteral = [this](const std::string& pattern) {
+        return options_.fixed || !hasRegexMeta(pattern, options_.extended);
+    };
+    std::vector<std::string> patterns;
+    std::string error;
+    if (patternCache_ != nullptr && patterns_.empty() && patternFiles_.size() == 1) {
+        // Единственный файл одних строк: автомат берётся из кэша сессии
+        multi_ = patternCache_->get(patternFiles_[0], options_.ignoreCase, isLiteral, patterns,
+                                    &error);
+        if (multi_) {
+            return true;
+        }
+        if (!error.empty()) {
+            err << "grep: " << error << "\n";
+            return false;
+        }
+    } else {
+        // Образец из нескольких строк — это несколько образцов
+        for (const auto& pattern : patterns_) {
+            size_t start = 0;
+            size_t newline = 0;
+            while ((newline = pattern.find('\n', start)) != std::string::npos) {
+                patterns.push_back(pattern.substr(start, newline - start));
+                start = newline + 1;
+            }
+            patterns.push_back(pattern.substr(start));
+        }
+        for (const auto& file : patternFiles_) {
+            if (!PatternFileCache::readPatterns(file, patterns, &error)) {
+                err << "grep: " << error << "\n";
+                return false;
+            }
+        }
+    }
+
+    // Строки ищутся автоматом, регулярными выражениями — только остальные образцы
+    std::vector<std::string> literals;
+    std::vector<std::string> regexes;
+    for (auto& pattern : patterns) {
+        (isLiteral(pattern) ? literals : regexes).push_back(std::move(pattern));
+    }
+    if (!regexes.empty()) {
+        // Пустой образец совпадает с любой строкой, остальные уже не важны
+        if (std::any_of(literals.begin(), literals.end(),
+                        [](const std::string& p) { return p.empty(); })) {
+            literal_ = std::make_unique<LiteralSearcher>(std::string());
+            return true;
+        }
+        if (!prepareRegex(regexes, err)) {
+            return false;
+        }
+        if (literals.empty()) {
+            return true;
+        }
+    }
+    if (literals.size() == 1) {
+        literal_ = std::make_unique<LiteralSearcher>(literals.front(), options_.ignoreCase);
+    } else {
+        multi_ = std::make_shared<const MultiLiteralSearcher>(std::move(literals),
+                                                              options_.ignoreCase);
+    }
+    return true;
+}
+
+bool GrepCommand::prepareRegex(const std::vector<std::string>& patterns, std::ostream& err) {
+    // Несколько образцов — альтернативы не длиннее kRegexGroupBytes
+    std::vector<size_t> bounds{0};
+    size_t bytes = 0;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        if (i > bounds.back() && bytes + patterns[i].size() > kRegexGroupBytes) {
+            bounds.push_back(i);
+            bytes = 0;
+        }
+        bytes += patterns[i].size() + 2;
+    }
+    bounds.push_back(patterns.size());
+
+    // Кэш сессии — только для одной альтернативы: группы большого списка вытеснили бы из
+    // него все остальные выражения
+    const bool cached = regexCache_ != nullptr && bounds.size() == 2;
+    std::string error;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+        if (!compileGroup(patterns, bounds[i], bounds[i + 1], cached, error)) {
+            err << "grep: " << error << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GrepCommand::compileGroup(const std::vector<std::string>& patterns, size_t from, size_t to,
+                               bool cached, std::string& error) {
+    // Альтернатива в BRE записывается как \|
+    std::string pattern;
+    for (size_t i = from; i < to; ++i) {
+        if (i > from) {
+            pattern += options_.extended ? "|" : "\\|";
+        }
+        pattern += patterns[i];
+    }
+
+    unsigned flags = (options_.extended ? Regex::kExtended : Regex::kBasic) |
+                     (options_.ignoreCase ? Regex::kIgnoreCase : 0U);
+    auto regex = cached ? regexCache_->get(pattern, flags, &error)
+                        : Regex::compile(pattern, flags, &error);
+    if (regex) {
+        regexes_.push_back(std::move(regex));
+        return true;
+    }
+    // Слишком большая программа или ошибка в одном из образцов: делим пополам, пока
+    // ошибка не останется за единственным образцом
+    if (to - from == 1) {
+        return false;
+    }
+    size_t middle = from + (to - from) / 2;
+    return compileGroup(patterns, from, middle, cached, error) &&
+           compileGroup(patterns, middle, to, cached, error);
+}
+
+std::vector<std::string> GrepCommand::collectFiles() const {
+    std::vector<std::string> files;
+    if (filenames_.empty()) {
+        // grep -r без файлов просматривает текущий каталог
+        walkDirectory(".", true, files);
+        return files;
+    }
+
+    for (const auto& name : filenames_) {
+        std::error_code ec;
+        if (options_.recursive && name != "-" && fs::is_directory(name, ec)) {
+            walkDirectory(name, false, files);
+        } else {
+            files.push_back(name);
+        }
+    }
+    return files;
+}
+
+void GrepCommand::scan(LineFinder& finder, const char* data, size_t size, ScanState& state,
+                       std::string& output) const {
+    const char* pos = data;
+    const char* end = data + size;
+    finder.reset();
+
+    auto select = [&](const char* begin, const char* finish) {
+        state.matches++;
+        if (options_.filesOnly) {
+            state.done = true;
+        } else if (!options_.count) {
+            emitLine(begin, finish, state, output);
+        }
+    };
+
+    while (pos < end && !state.done) {
+        const char* hit = finder.find(pos, end);
+        const char* matchLine = hit == nullptr ? end : lineStart(pos, hit);
+
+        if (options_.invert) {
+            // Все строки до строки с совпадением не содержат образца
+            while (pos < matchLine && !state.done) {
+                const char* finish = lineEnd(pos, matchLine);
+                state.lineNumber++;
+                select(pos, finish);
+                pos = finish < end ? finish + 1 : end;
+            }
+            if (hit == nullptr || state.done) {
+                break;
+            }
+            const char* finish = lineEnd(hit, end);
+            state.lineNumber++;
+            pos = finish < end ? finish + 1 : end;
+            continue;
+        }
+
+        if (hit == nullptr) {
+            if (options_.lineNumbers) {
+                state.lineNumber += TextCounter::countNewlines(pos, static_cast<size_t>(end - pos));
+            }
+            break;
+        }
+        if (options_.lineNumbers) {
+            state.lineNumber +=
+                TextCounter::countNewlines(pos, static_cast<size_t>(matchLine - pos));
+        }
+        const char* finish = lineEnd(hit, end);
+        state.lineNumber++;
+        select(matchLine, finish);
+        pos = finish < end ? finish + 1 : end;
+    }
+}
+
+void GrepCommand::emitLine(const char* begin, const char* end, const ScanState& state,
+                           std::string& output) const {
+    output += state.prefix;
+    if (options_.lineNumbers) {
+        output += std::to_string(state.lineNumber);
+        output += ':';
+    }
+    output.append(begin, end);
+    output += '\n';
+}
+
+void GrepCommand::finish(const std::string& name, const ScanState& state,
+                         std::string& output) const {
+    if (options_.filesOnly) {
+        if (state.matches > 0) {
+            output += name;
+            output += '\n';
+        }
+    } else if (options_.count) {
+        output += state.prefix;
+        output += std::to_string(state.matches);
+        output += '\n';
+    }
+}
+
+GrepCommand::FileResult GrepCommand::searchFile(const std::string& filename) const {
+    FileResult result;
+    InputFile file(filename);
+    if (!file.isOpen() || file.isDirectory()) {
+        result.error = "grep: " + filename + ": " + file.errorMessage() + "\n";
+        return result;
+    }
+
+    LineFinder finder(literal_.get(), multi_.get(), regexes_);
+    ScanState state;
+    if (options_.withNames) {
+        state.prefix = filename + ":";
+    }
+
+    std::string_view mapped = file.map();
+    if (!mapped.empty()) {
+        scan(finder, mapped.data(), mapped.size(), state, result.output);
+    } else {
+        bool ok = scanBlocks(
+            [&file](char* buffer, size_t capacity) { return file.read(buffer, capacity); },
+            [&](const char* data, size_t size) {
+                scan(finder, data, size, state, result.output);
+                return !state.done;
+            });
+        if (!ok) {
+            result.error = "grep: " + filename + ": read error\n";
+            return result;
+        }
+    }
+
+    finish(filename, state, result.output);
+    result.matches = state.matches;
+    return result;
+}
+
+size_t GrepCommand::searchStream(std::istream& in, std::ostream& out) const {
+    const std::string name = "(standard input)";
+    LineFinder finder(literal_.get(), multi_.get(), regexes_);
+    ScanState state;
+    if (options_.withNames) {
+        state.prefix = name + ":";
+    }
+
+    // Вывод отдаётся после каждого блока, не дожидаясь конца потока
+    std::string output;
+    scanBlocks(
+        [&in](char* buffer, size_t capacity) {
+            return static_cast<std::streamsize>(readAvailable(in, buffer, capacity));
+        },
+        [&](const char* data, size_t size) {
+            scan(finder, data, size, state, output);
+            out << output;
+            output.clear();
+            return !state.done && out;
+        });
+
+    finish(name, state, output);
+    out << output;
+    return state.matches;
+}
+
+}  // namespace shell
@@ -0,0 +1,113 @@
+#include "shell/commands/hash_command.hpp"
+
+#include <iomanip>
+
+namespace shell {
+
+HashCommand::HashCommand(PathCache& cache) : cache_(cache) {}
+
+CommandResult HashCommand::execute(std::istream& /*in*/, std::ostream& out, std::ostream& err) {
+    bool clearAll = false;
+    bool deleteMode = false;
+    bool printMode = false;
+    std::string explicitPath;
+    bool hasExplicitPath = false;
+
+    size_t i = 0;
+    for (; i < args_.size(); ++i) {
+        const std::string& arg = args_[i];
+        if (arg == "--") {
+            ++i;
+            break;
+        }
+        if (arg.size() < 2 || arg[0] != '-') {
+            break;
+        }
+        for (size_t j = 1; j < arg.size(); ++j) {
+            switch (arg[j]) {
+                case 'r':
+                    clearAll = true;
+                    break;
+                case 'd':
+                    deleteMode = true;
+                    break;
+                case 't':
+                    printMode = true;
+                    break;
+                case 'p':
+                    if (i + 1 >= args_.size()) {
+                        err << "hash: -p: option requires an argument\n";
+                        return 2;
+                    }
+                    explicitPath = args_[++i];
+                    hasExplicitPath = true;
+                    j = arg.size();
+                    break;
+                default:
+                    err << "hash: -" << arg[j] << ": invalid option\n";
+                    return 2;
+            }
+        }
+    }
+
+    if (clearAll) {
+        cache_.clear();
+    }
+
+    if (i == args_.size()) {
+        if (!clearAll && !deleteMode && !printMode && !hasExplicitPath) {
+            printTable(out);
+        }
+        return 0;
+    }
+
+    int exitCode = 0;
+    size_t nameCount = args_.size() - i;
+
+    for (; i < args_.size(); ++i) {
+        const std::string& name = args_[i];
+
+        if (hasExplicitPath) {
+            cache_.seed(name, explicitPath);
+        } else if (deleteMode) {
+            if (!cache_.remove(name)) {
+                err << "hash: " << name << ": not found\n";
+                exitCode = 1;
+            }
+        } else if (printMode) {
+            auto path = cache_.peek(name);
+            if (!path) {
+                err << "hash: " << name << ": not found\n";
+                exitCode = 1;
+            } else if (nameCount > 1) {
+                out << name << '\t' << *path << '\n';
+            } else {
+                out << *path << '\n';
+            }
+        } else if (name.find('/') == std::string::npos && !cache_.remember(name)) {
+            err << "hash: " << name << ": not found\n";
+            exitCode = 1;
+        }
+    }
+
+    return exitCode;
+}
+
+void HashCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+void HashCommand::printTable(std::ostream& out) const {
+    auto entries = cache_.entries();
+    if (entries.empty()) {
+        out << "hash: hash table empty\n";
+        return;
+    }
+
+    out << "hits\tcommand\n";
+    for (const auto& entry : entries) {
+        out << std::setw(4) << entry.hits << '\t' << entry.path << '\n';
+    }
+}
+
+}  // namespace shell
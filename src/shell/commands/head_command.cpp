@@ -0,0 +1,139 @@
+#include "shell/commands/head_command.hpp"
+
+#include <cstring>
+#include <memory>
+
+#include "shell/input_file.hpp"
+#include "shell/stream_pipe.hpp"
+
+namespace shell {
+
+namespace {
+
+// Размер блока чтения входа
+constexpr size_t kBlockSize = 64 * 1024;
+
+bool parseCount(const std::string& text, size_t& value) {
+    if (text.empty() || text.size() > 18) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+}  // namespace
+
+CommandResult HeadCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    if (!parseArguments(err)) {
+        return 1;
+    }
+
+    if (filenames_.empty()) {
+        copyLines([&in](char* buffer, size_t capacity) {
+            return static_cast<ssize_t>(readAvailable(in, buffer, capacity));
+        }, out);
+        return 0;
+    }
+
+    int exitCode = 0;
+    bool first = true;
+    for (const auto& filename : filenames_) {
+        InputFile file(filename);
+        if (!file.isOpen() || file.isDirectory()) {
+            err << "head: cannot open '" << filename << "' for reading: " << file.errorMessage()
+                << "\n";
+            exitCode = 1;
+            continue;
+        }
+        if (filenames_.size() > 1) {
+            out << (first ? "" : "\n") << "==> " << filename << " <==\n";
+        }
+        first = false;
+        bool ok = copyLines(
+            [&file](char* buffer, size_t capacity) { return file.read(buffer, capacity); }, out);
+        if (!ok) {
+            err << "head: " << filename << ": read error\n";
+            exitCode = 1;
+        }
+    }
+    return exitCode;
+}
+
+void HeadCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+bool HeadCommand::parseArguments(std::ostream& err) {
+    filenames_.clear();
+    lines_ = 10;
+    for (size_t i = 0; i < args_.size(); ++i) {
+        const std::string& arg = args_[i];
+        if (arg.size() < 2 || arg[0] != '-') {
+            filenames_.push_back(arg);
+            continue;
+        }
+        std::string value;
+        if (arg[1] >= '0' && arg[1] <= '9') {
+            value = arg.substr(1);
+        } else if (arg[1] != 'n') {
+            err << "head: invalid option -- '" << arg[1] << "'\n";
+            return false;
+        } else if (arg.size() > 2) {
+            value = arg.substr(2);
+        } else if (i + 1 < args_.size()) {
+            value = args_[++i];
+        } else {
+            err << "head: option requires an argument -- 'n'\n";
+            return false;
+        }
+        if (!parseCount(value, lines_)) {
+            err << "head: invalid number of lines: '" << value << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Read>
+bool HeadCommand::copyLines(Read read, std::ostream& out) const {
+    size_t remaining = lines_;
+    auto block = std::make_unique<char[]>(kBlockSize);
+    // Остановка при выводе N строк или если вывод больше не принимается
+    while (remaining > 0 && out) {
+        ssize_t bytesRead = read(block.get(), kBlockSize);
+        if (bytesRead <= 0) {
+            return bytesRead == 0;
+        }
+        const char* data = block.get();
+        const char* end = data + bytesRead;
+        const char* pos = data;
+        while (remaining > 0 && pos < end) {
+            const void* newline = std::memchr(pos, '\n', static_cast<size_t>(end - pos));
+            if (newline == nullptr) {
+                pos = end;
+                break;
+            }
+            pos = static_cast<const char*>(newline) + 1;
+            --remaining;
+        }
+        out.write(data, pos - data);
+    }
+    return true;
+}
+
+void HeadCommand::assignArguments(const std::pmr::vector<std::pmr::string>& args) {
+    args_.assign(args.begin(), args.end());
+}
+
+bool HeadCommand::reset() {
+    args_.clear();
+    return true;
+}
+
+}  // namespace shell
@@ -6,7 +6,7 @@
 
 namespace shell {
 
-int PwdCommand::execute(std::istream& /*in*/, std::ostream& out, std::ostream& err) {
+CommandResult PwdCommand::execute(std::istream& /*in*/, std::ostream& out, std::ostream& err) {
     char buffer[PATH_MAX];
 
     if (getcwd(buffer, sizeof(buffer)) != nullptr) {
@@ -18,8 +18,14 @@ int PwdCommand::execute(std::istream& /*in*/, std::ostream& out, std::ostream& e
     return 1;
 }
 
-void PwdCommand::setArguments(const std::vector<std::string>& /*args*/) {
+void PwdCommand::setArguments(std::vector<std::string> /*args*/) {
     // pwd игнорирует аргументы
 }
 
+void PwdCommand::assignArguments(const std::pmr::vector<std::pmr::string>& /*args*/) {}
+
+bool PwdCommand::reset() {
+    return true;
+}
+
 }  // namespace shell
@@ -0,0 +1,245 @@
+#include "shell/commands/sort_command.hpp"
+
+#include <cstdlib>
+#include <memory>
+
+#include "shell/input_file.hpp"
+#include "shell/thread_pool.hpp"
+
+namespace shell {
+
+namespace {
+
+// Размер блока чтения входа
+constexpr size_t kBlockSize = 128 * 1024;
+
+constexpr size_t kDefaultMemoryBudget = size_t{512} * 1024 * 1024;
+
+// Разобрать число в начале строки; pos сдвигается за него
+bool parseNumber(const std::string& text, size_t& pos, size_t& value) {
+    size_t start = pos;
+    value = 0;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+        value = value * 10 + static_cast<size_t>(text[pos] - '0');
+        ++pos;
+    }
+    return pos > start;
+}
+
+// Флаги ключа (n, r) до запятой или конца строки
+bool parseKeyFlags(const std::string& text, size_t& pos, SortKey& key) {
+    for (; pos < text.size() && text[pos] != ','; ++pos) {
+        if (text[pos] == 'n') {
+            key.numeric = true;
+        } else if (text[pos] == 'r') {
+            key.reverse = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+CommandResult SortCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    if (!parseArguments(err)) {
+        return 2;
+    }
+
+    ExternalSorter sorter(options_, memoryBudget_, tempDir_, ThreadPool::shared());
+    auto block = std::make_unique<char[]>(kBlockSize);
+
+    if (filenames_.empty()) {
+        filenames_.push_back("-");
+    }
+    // Каждый вход заканчивается концом строки, даже если в нём его нет
+    char last = '\n';
+    auto feed = [&](const char* data, size_t size) {
+        if (size == 0) {
+            return true;
+        }
+        last = data[size - 1];
+        return sorter.write(data, size);
+    };
+
+    for (const auto& filename : filenames_) {
+        bool ok = true;
+        if (filename == "-") {
+            while (ok && (in.read(block.get(), static_cast<std::streamsize>(kBlockSize)) ||
+                          in.gcount() > 0)) {
+                ok = feed(block.get(), static_cast<size_t>(in.gcount()));
+            }
+        } else {
+            InputFile file(filename);
+            if (!file.isOpen() || file.isDirectory()) {
+                err << "sort: cannot read: " << filename << ": " << file.errorMessage() << "\n";
+                return 2;
+            }
+            ssize_t bytesRead = 0;
+            while (ok && (bytesRead = file.read(block.get(), kBlockSize)) > 0) {
+                ok = feed(block.get(), static_cast<size_t>(bytesRead));
+            }
+            if (bytesRead < 0) {
+                err << "sort: " << filename << ": read error\n";
+                return 2;
+            }
+        }
+        if (ok && last != '\n') {
+            ok = feed("\n", 1);
+        }
+        if (!ok) {
+            err << "sort: " << sorter.error() << "\n";
+            return 2;
+        }
+    }
+
+    if (!sorter.finish(out)) {
+        err << "sort: " << sorter.error() << "\n";
+        return 2;
+    }
+    return 0;
+}
+
+void SortCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+bool SortCommand::parseArguments(std::ostream& err) {
+    options_ = SortOptions{};
+    memoryBudget_ = kDefaultMemoryBudget;
+    const char* tmpdir = std::getenv("TMPDIR");
+    tempDir_ = tmpdir != nullptr && *tmpdir != '\0' ? tmpdir : "/tmp";
+    filenames_.clear();
+    bool optionsDone = false;
+
+    for (size_t i = 0; i < args_.size(); ++i) {
+        const std::string& arg = args_[i];
+        if (optionsDone || arg.size() < 2 || arg[0] != '-') {
+            filenames_.push_back(arg);
+            continue;
+        }
+        if (arg == "--") {
+            optionsDone = true;
+            continue;
+        }
+        for (size_t j = 1; j < arg.size(); ++j) {
+            char flag = arg[j];
+            if (flag == 'n') {
+                options_.numeric = true;
+            } else if (flag == 'r') {
+                options_.reverse = true;
+            } else if (flag == 'u') {
+                options_.unique = true;
+            } else if (flag == 't' || flag == 'k' || flag == 'S' || flag == 'T') {
+                // Значение — остаток аргумента или следующий аргумент
+                std::string value;
+                if (j + 1 < arg.size()) {
+                    value = arg.substr(j + 1);
+                } else if (i + 1 < args_.size()) {
+                    value = args_[++i];
+                } else {
+                    err << "sort: option requires an argument -- '" << flag << "'\n";
+                    return false;
+                }
+                j = arg.size();
+
+                if (flag == 't') {
+                    if (value.size() != 1) {
+                        err << "sort: multi-character tab '" << value << "'\n";
+                        return false;
+                    }
+                    options_.separator = value[0];
+                    options_.hasSeparator = true;
+                } else if (flag == 'k') {
+                    SortKey key;
+                    if (!parseKey(value, key)) {
+                        err << "sort: invalid key specification: '" << value << "'\n";
+                        return false;
+                    }
+                    options_.keys.push_back(key);
+                } else if (flag == 'S') {
+                    if (!parseSize(value, memoryBudget_)) {
+                        err << "sort: invalid buffer size: '" << value << "'\n";
+                        return false;
+                    }
+                } else {
+                    tempDir_ = value;
+                }
+            } else {
+                err << "sort: invalid option -- '" << flag << "'\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool SortCommand::parseKey(const std::string& spec, SortKey& key) {
+    size_t pos = 0;
+    if (!parseNumber(spec, pos, key.startField) || key.startField == 0) {
+        return false;
+    }
+    if (pos < spec.size() && spec[pos] == '.') {
+        ++pos;
+        if (!parseNumber(spec, pos, key.startChar) || key.startChar == 0) {
+            return false;
+        }
+    }
+    if (!parseKeyFlags(spec, pos, key)) {
+        return false;
+    }
+    if (pos == spec.size()) {
+        return true;
+    }
+
+    ++pos;  // ','
+    if (!parseNumber(spec, pos, key.endField) || key.endField == 0) {
+        return false;
+    }
+    if (pos < spec.size() && spec[pos] == '.') {
+        ++pos;
+        if (!parseNumber(spec, pos, key.endChar)) {
+            return false;
+        }
+    }
+    return parseKeyFlags(spec, pos, key) && pos == spec.size();
+}
+
+bool SortCommand::parseSize(const std::string& text, size_t& size) {
+    size_t pos = 0;
+    size_t value = 0;
+    if (!parseNumber(text, pos, value)) {
+        return false;
+    }
+    size_t unit = 1024;
+    if (pos < text.size()) {
+        switch (text[pos]) {
+            case 'b':
+                unit = 1;
+                break;
+            case 'K':
+            case 'k':
+                unit = 1024;
+                break;
+            case 'M':
+            case 'm':
+                unit = size_t{1} << 20;
+                break;
+            case 'G':
+            case 'g':
+                unit = size_t{1} << 30;
+                break;
+            default:
+                return false;
+        }
+        ++pos;
+    }
+    if (pos != text.size() || value == 0) {
+        return false;
+    }
+    size = value * unit;
+    return true;
+}
+
+}  // namespace shell
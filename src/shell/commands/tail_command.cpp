@@ -0,0 +1,386 @@
+#include "shell/commands/tail_command.hpp"
+
+#include <deque>
+#include <memory>
+
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include "shell/interrupt.hpp"
+#include "shell/stream_pipe.hpp"
+
+namespace shell {
+
+namespace {
+
+// Размер блока чтения входа
+constexpr size_t kBlockSize = 64 * 1024;
+
+// Интервал повторной проверки файлов без событий: страхует от пропущенных
+// событий inotify (и заменяет их вне Linux), мс
+constexpr int kRecheckIntervalMs = 1000;
+
+bool parseCount(const std::string& text, size_t& value) {
+    if (text.empty() || text.size() > 18) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+/**
+ * Поиск начала последних lines строк при просмотре входа с конца.
+ * Блоки передаются в scan в порядке от конца к началу; завершающий
+ * перевод строки входа не отделяет строку.
+ */
+class TailFinder {
+public:
+    TailFinder(size_t lines, uint64_t total) : lines_(lines), total_(total) {}
+
+    /**
+     * Просмотреть блок [offset, offset + size)
+     * @return true, если начало найдено (см. start())
+     */
+    bool scan(const char* data, size_t size, uint64_t offset) {
+        if (lines_ == 0) {
+            start_ = total_;
+            return true;
+        }
+        for (size_t i = size; i > 0; --i) {
+            if (data[i - 1] != '\n' || offset + i == total_) {
+                continue;
+            }
+            if (++newlines_ == lines_) {
+                start_ = offset + i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t start() const {
+        return start_;
+    }
+
+private:
+    size_t lines_;
+    uint64_t total_;
+    size_t newlines_ = 0;
+    uint64_t start_ = 0;  ///< 0, пока не найдено: весь вход
+};
+
+size_t countNewlines(const std::string& data) {
+    size_t count = 0;
+    for (char c : data) {
+        count += c == '\n' ? 1 : 0;
+    }
+    return count;
+}
+
+}  // namespace
+
+CommandResult TailCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    if (!parseArguments(err)) {
+        return 1;
+    }
+
+    if (filenames_.empty()) {
+        tailStream(in, out);
+        return 0;
+    }
+
+    int exitCode = 0;
+    bool first = true;
+    std::vector<Followed> followed;
+    for (const auto& filename : filenames_) {
+        InputFile file(filename);
+        if (!file.isOpen() || file.isDirectory()) {
+            err << "tail: cannot open '" << filename << "' for reading: " << file.errorMessage()
+                << "\n";
+            exitCode = 1;
+            // С -F файл может появиться позже
+            if (followName_ && !file.isDirectory()) {
+                followed.push_back(Followed{filename, InputFile(), 0, 0, 0, -1});
+            }
+            continue;
+        }
+        if (filenames_.size() > 1) {
+            out << (first ? "" : "\n") << "==> " << filename << " <==\n";
+        }
+        first = false;
+        uint64_t shown = 0;
+        if (!tailFile(file, out, shown)) {
+            err << "tail: " << filename << ": read error\n";
+            exitCode = 1;
+            continue;
+        }
+        // Слежение продолжается с того места, до которого файл выведен: дописанное после
+        // tailFile попадёт в вывод, даже если появилось до начала слежения
+        struct stat st {};
+        if (follow_ && file.isRegular() && fstat(file.fd(), &st) == 0) {
+            followed.push_back(Followed{filename, std::move(file), static_cast<uint64_t>(st.st_dev),
+                                        static_cast<uint64_t>(st.st_ino), shown, -1});
+        }
+    }
+
+    if (follow_ && !followed.empty()) {
+        int followCode = followFiles(followed, out, err);
+        return followCode != 0 ? followCode : exitCode;
+    }
+    return exitCode;
+}
+
+void TailCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+bool TailCommand::parseArguments(std::ostream& err) {
+    filenames_.clear();
+    lines_ = 10;
+    follow_ = false;
+    followName_ = false;
+    for (size_t i = 0; i < args_.size(); ++i) {
+        const std::string& arg = args_[i];
+        if (arg.size() < 2 || arg[0] != '-') {
+            filenames_.push_back(arg);
+            continue;
+        }
+        if (arg == "-f" || arg == "-F") {
+            follow_ = true;
+            followName_ = followName_ || arg == "-F";
+            continue;
+        }
+        std::string value;
+        if (arg[1] >= '0' && arg[1] <= '9') {
+            value = arg.substr(1);
+        } else if (arg[1] != 'n') {
+            err << "tail: invalid option -- '" << arg[1] << "'\n";
+            return false;
+        } else if (arg.size() > 2) {
+            value = arg.substr(2);
+        } else if (i + 1 < args_.size()) {
+            value = args_[++i];
+        } else {
+            err << "tail: option requires an argument -- 'n'\n";
+            return false;
+        }
+        if (!parseCount(value, lines_)) {
+            err << "tail: invalid number of lines: '" << value << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TailCommand::tailFile(InputFile& file, std::ostream& out, uint64_t& shown) const {
+    auto block = std::make_unique<char[]>(kBlockSize);
+
+    if (!file.isRegular()) {
+        // Канал или устройство: читаем как поток
+        std::string data;
+        ssize_t bytesRead = 0;
+        while ((bytesRead = file.read(block.get(), kBlockSize)) > 0) {
+            data.append(block.get(), static_cast<size_t>(bytesRead));
+        }
+        if (bytesRead < 0) {
+            return false;
+        }
+        TailFinder finder(lines_, data.size());
+        finder.scan(data.data(), data.size(), 0);
+        out.write(data.data() + finder.start(),
+                  static_cast<std::streamsize>(data.size() - finder.start()));
+        shown = data.size();
+        return true;
+    }
+
+    // Обычный файл читается блоками с конца
+    const uint64_t size = file.size();
+    TailFinder finder(lines_, size);
+    for (uint64_t end = size; end > 0;) {
+        uint64_t begin = end > kBlockSize ? end - kBlockSize : 0;
+        auto length = static_cast<size_t>(end - begin);
+        if (pread(file.fd(), block.get(), length, static_cast<off_t>(begin)) !=
+            static_cast<ssize_t>(length)) {
+            return false;
+        }
+        if (finder.scan(block.get(), length, begin)) {
+            break;
+        }
+        end = begin;
+    }
+
+    for (shown = finder.start(); shown < size && out;) {
+        auto length = static_cast<size_t>(std::min<uint64_t>(kBlockSize, size - shown));
+        ssize_t bytesRead = pread(file.fd(), block.get(), length, static_cast<off_t>(shown));
+        if (bytesRead <= 0) {
+            return false;
+        }
+        out.write(block.get(), bytesRead);
+        shown += static_cast<uint64_t>(bytesRead);
+    }
+    return true;
+}
+
+void TailCommand::tailStream(std::istream& in, std::ostream& out) const {
+    // Блоки входа и число переводов строки в каждом; первый блок
+    // отбрасывается, когда последние строки целиком лежат в остальных
+    std::deque<std::pair<std::string, size_t>> blocks;
+    size_t newlines = 0;
+    auto block = std::make_unique<char[]>(kBlockSize);
+    size_t size = 0;
+    while ((size = readAvailable(in, block.get(), kBlockSize)) > 0) {
+        std::string data(block.get(), size);
+        size_t count = countNewlines(data);
+        blocks.emplace_back(std::move(data), count);
+        newlines += count;
+        while (blocks.size() > 1 && newlines - blocks.front().second > lines_) {
+            newlines -= blocks.front().second;
+            blocks.pop_front();
+        }
+    }
+
+    std::string data;
+    for (const auto& entry : blocks) {
+        data += entry.first;
+    }
+    TailFinder finder(lines_, data.size());
+    finder.scan(data.data(), data.size(), 0);
+    out.write(data.data() + finder.start(),
+              static_cast<std::streamsize>(data.size() - finder.start()));
+}
+
+int TailCommand::followFiles(std::vector<Followed>& files, std::ostream& out,
+                             std::ostream& err) const {
+    int notifyFd = -1;
+#ifdef __linux__
+    notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    // Для -F наблюдаем и каталоги: файл может быть создан или переименован в них заново
+    const uint32_t fileEvents = IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF;
+    auto watch = [&](Followed& followed) {
+        if (notifyFd >= 0 && followed.file.isOpen()) {
+            followed.watch = inotify_add_watch(notifyFd, followed.name.c_str(), fileEvents);
+        }
+    };
+    for (auto& followed : files) {
+        watch(followed);
+        if (followName_ && notifyFd >= 0) {
+            size_t slash = followed.name.rfind('/');
+            std::string dir = slash == std::string::npos ? "." : followed.name.substr(0, slash + 1);
+            inotify_add_watch(notifyFd, dir.c_str(), IN_CREATE | IN_MOVED_TO);
+        }
+    }
+#endif
+
+    auto block = std::make_unique<char[]>(kBlockSize);
+    size_t lastShown = files.size() - 1;
+    int exitCode = 0;
+
+    // Вывести дописанный диапазон файла
+    auto drain = [&](size_t i) {
+        Followed& followed = files[i];
+        struct stat st {};
+        if (!followed.file.isOpen() || fstat(followed.file.fd(), &st) != 0) {
+            return;
+        }
+        auto size = static_cast<uint64_t>(st.st_size);
+        if (size < followed.offset) {
+            err << "tail: " << followed.name << ": file truncated\n";
+            followed.offset = 0;
+        }
+        while (followed.offset < size && out) {
+            auto length =
+                static_cast<size_t>(std::min<uint64_t>(kBlockSize, size - followed.offset));
+            ssize_t bytesRead = pread(followed.file.fd(), block.get(), length,
+                                      static_cast<off_t>(followed.offset));
+            if (bytesRead <= 0) {
+                err << "tail: " << followed.name << ": read error\n";
+                exitCode = 1;
+                return;
+            }
+            if (files.size() > 1 && lastShown != i) {
+                out << "\n==> " << followed.name << " <==\n";
+                lastShown = i;
+            }
+            out.write(block.get(), bytesRead);
+            followed.offset += static_cast<uint64_t>(bytesRead);
+        }
+    };
+
+    while (out) {
+        for (size_t i = 0; i < files.size() && out; ++i) {
+            // Перед переходом на новый файл дочитывается старый
+            drain(i);
+            if (followName_ && reopen(files[i], err)) {
+#ifdef __linux__
+                if (files[i].watch >= 0) {
+                    inotify_rm_watch(notifyFd, files[i].watch);
+                }
+                watch(files[i]);
+#endif
+                drain(i);
+            }
+        }
+        out.flush();
+
+        // Ждём изменений файлов или Ctrl-C
+        struct pollfd fds[2] = {{Interrupt::fd(), POLLIN, 0}, {notifyFd, POLLIN, 0}};
+        if (!Interrupt::requested()) {
+            poll(fds, notifyFd >= 0 ? 2 : 1, kRecheckIntervalMs);
+        }
+        if (Interrupt::requested()) {
+            exitCode = 130;
+            break;
+        }
+        if (notifyFd >= 0 && (fds[1].revents & POLLIN) != 0) {
+            // Содержимое событий не важно: после любого проверяются все файлы
+            while (read(notifyFd, block.get(), kBlockSize) > 0) {
+            }
+        }
+    }
+
+    if (notifyFd >= 0) {
+        close(notifyFd);
+    }
+    return exitCode;
+}
+
+bool TailCommand::reopen(Followed& followed, std::ostream& err) const {
+    struct stat st {};
+    if (stat(followed.name.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        if (followed.file.isOpen() && followed.inode != 0) {
+            err << "tail: '" << followed.name << "' has become inaccessible\n";
+            followed.inode = 0;
+        }
+        return false;
+    }
+    if (followed.file.isOpen() && static_cast<uint64_t>(st.st_dev) == followed.device &&
+        static_cast<uint64_t>(st.st_ino) == followed.inode) {
+        return false;
+    }
+
+    InputFile file(followed.name);
+    if (!file.isOpen()) {
+        return false;
+    }
+    err << "tail: '" << followed.name << "' has "
+        << (followed.file.isOpen() ? "been replaced; following new file" : "appeared")
+        << "\n";
+    followed.file = std::move(file);
+    followed.device = static_cast<uint64_t>(st.st_dev);
+    followed.inode = static_cast<uint64_t>(st.st_ino);
+    followed.offset = 0;
+    return true;
+}
+
+}  // namespace shell
@@ -0,0 +1,294 @@
+#include "shell/commands/tee_command.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <optional>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "shell/process_util.hpp"
+#include "shell/stream_pipe.hpp"
+
+namespace shell {
+
+namespace {
+
+// Размер блока; при пересылке через внутренние каналы он уменьшается до
+// их фактической ёмкости, чтобы блок целиком помещался в канал
+constexpr size_t kBlockSize = 64 * 1024;
+
+// Прочитать и отбросить size байт из канала
+void discard(int fd, size_t size) {
+    char buffer[4096];
+    while (size > 0) {
+        ssize_t bytesRead = read(fd, buffer, std::min(size, sizeof(buffer)));
+        if (bytesRead <= 0) {
+            if (bytesRead < 0 && errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        size -= static_cast<size_t>(bytesRead);
+    }
+}
+
+#ifdef __linux__
+// Ёмкость канала после попытки поднять её до kBlockSize; 0 — неизвестна
+size_t pipeCapacity(int fd) {
+    fcntl(fd, F_SETPIPE_SZ, static_cast<int>(kBlockSize));
+    int capacity = fcntl(fd, F_GETPIPE_SZ);
+    return capacity > 0 ? static_cast<size_t>(capacity) : 0;
+}
+#endif
+
+}  // namespace
+
+TeeCommand::TeeCommand(Environment* env, PathCache* pathCache)
+    : env_(env), pathCache_(pathCache) {}
+
+CommandResult TeeCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    exitCode_ = 0;
+    sinks_.clear();
+    ignoreSigpipe();
+    if (!openSinks(err)) {
+        closeAll();
+        return 1;
+    }
+
+    size_t blockSize = kBlockSize;
+#ifdef __linux__
+    if (sinks_.size() >= 2 && (!openPipe(block_) || !openPipe(copy_))) {
+        closeAll();
+        err << "tee: pipe creation failed\n";
+        return 1;
+    }
+    if (block_[0] >= 0) {
+        // Этот поток — единственный читатель внутренних каналов, поэтому блок не должен
+        // превышать их ёмкость: сверх лимита pipe-user-pages-soft ядро создаёт каналы в
+        // одну страницу. Запись в block_ к тому же неблокирующая (см. fanOut)
+        blockSize = std::min({kBlockSize, pipeCapacity(block_[1]), pipeCapacity(copy_[1])});
+        int flags = fcntl(block_[1], F_GETFL);
+        if (blockSize == 0 || flags < 0 || fcntl(block_[1], F_SETFL, flags | O_NONBLOCK) != 0) {
+            closePipes();
+            blockSize = kBlockSize;
+        }
+    }
+#endif
+
+    auto block = std::make_unique<char[]>(blockSize);
+    size_t size = 0;
+    while ((size = readAvailable(in, block.get(), blockSize)) > 0) {
+        if (!out.write(block.get(), static_cast<std::streamsize>(size))) {
+            break;  // Следующая стадия завершилась
+        }
+        fanOut(block.get(), size, err);
+    }
+    out.flush();
+
+    closeAll();
+    return exitCode_;
+}
+
+void TeeCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+bool TeeCommand::openSinks(std::ostream& err) {
+    bool append = false;
+    for (size_t i = 0; i < args_.size(); ++i) {
+        const std::string& arg = args_[i];
+        if (arg == "-a") {
+            append = true;
+            continue;
+        }
+        if (arg.compare(0, 2, ">(") == 0) {
+            // Слова до закрывающей скобки — программа и её аргументы
+            std::vector<std::string> words{arg.substr(2)};
+            while (words.back().empty() || words.back().back() != ')') {
+                if (++i == args_.size()) {
+                    err << "tee: missing ')' in process substitution\n";
+                    return false;
+                }
+                words.push_back(args_[i]);
+            }
+            words.back().pop_back();
+            if (words.back().empty()) {
+                words.pop_back();
+            }
+            if (!startProgram(words, err)) {
+                return false;
+            }
+            continue;
+        }
+
+        int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+        int fd = open(arg.c_str(), flags, 0666);
+        if (fd < 0) {
+            err << "tee: " << arg << ": " << std::strerror(errno) << "\n";
+            exitCode_ = 1;
+            continue;
+        }
+        Sink sink;
+        sink.name = arg;
+        sink.fd = fd;
+        sinks_.push_back(sink);
+    }
+    return true;
+}
+
+bool TeeCommand::startProgram(const std::vector<std::string>& words, std::ostream& err) {
+    if (words.empty() || words.front().empty()) {
+        err << "tee: empty process substitution\n";
+        return false;
+    }
+    if (env_ == nullptr) {
+        err << "tee: process substitution is not available\n";
+        return false;
+    }
+    const std::string& name = words.front();
+    std::optional<std::string> path;
+    if (name.find('/') != std::string::npos) {
+        if (access(name.c_str(), X_OK) == 0) {
+            path = name;
+        }
+    } else {
+        path = pathCache_ != nullptr ? pathCache_->lookup(name)
+                                     : PathCache::resolve(name, env_->get("PATH"));
+    }
+    if (!path) {
+        err << name << ": command not found\n";
+        return false;
+    }
+
+    int fds[2];
+    if (!openPipe(fds)) {
+        err << "tee: pipe creation failed\n";
+        return false;
+    }
+    std::vector<std::string> args(words.begin() + 1, words.end());
+    pid_t pid = spawnProcess(*path, args, env_->toEnvp(), fds[0], -1);
+    close(fds[0]);
+    if (pid < 0) {
+        close(fds[1]);
+        err << "tee: fork failed\n";
+        return false;
+    }
+    Sink sink;
+    sink.name = name;
+    sink.fd = fds[1];
+    sink.pid = pid;
+    sinks_.push_back(sink);
+    return true;
+}
+
+void TeeCommand::fanOut(const char* data, size_t size, std::ostream& err) {
+    // Последний ещё работающий приёмник забирает блок из внутреннего канала
+    Sink* lastSink = nullptr;
+    for (auto& sink : sinks_) {
+        if (sink.fd >= 0) {
+            lastSink = &sink;
+        }
+    }
+    if (lastSink == nullptr) {
+        return;
+    }
+
+    // Блок, не поместившийся в канал целиком, вычитывается обратно и пишется обычной записью
+    bool inKernel = false;
+    if (block_[0] >= 0) {
+        ssize_t written = write(block_[1], data, size);
+        inKernel = written == static_cast<ssize_t>(size);
+        if (!inKernel && written > 0) {
+            discard(block_[0], static_cast<size_t>(written));
+        }
+    }
+    for (auto& sink : sinks_) {
+        if (sink.fd < 0) {
+            continue;
+        }
+        bool ok = inKernel ? spliceBlock(sink, data, size, &sink == lastSink)
+                           : writeAll(sink.fd, data, size);
+        if (!ok) {
+            fail(sink, err);
+        }
+    }
+}
+
+bool TeeCommand::spliceBlock(Sink& sink, const char* data, size_t size, bool last) {
+#ifdef __linux__
+    // Копия блока для не последнего приёмника: tee(2) дублирует ссылки на
+    // страницы внутреннего канала в пустой канал copy_, не извлекая данные
+    int source = block_[0];
+    size_t available = size;
+    if (!last) {
+        ssize_t copied = tee(block_[0], copy_[1], size, 0);
+        available = copied > 0 ? static_cast<size_t>(copied) : 0;
+        source = copy_[0];
+    }
+
+    size_t moved = 0;
+    while (moved < available && sink.spliceable) {
+        ssize_t count = splice(source, nullptr, sink.fd, nullptr, available - moved, SPLICE_F_MOVE);
+        if (count > 0) {
+            moved += static_cast<size_t>(count);
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0 && errno == EINVAL) {
+            sink.spliceable = false;  // Приёмник не поддерживает splice
+        } else {
+            discard(source, available - moved);
+            return false;
+        }
+    }
+    // Остаток (если splice недоступен) пишется из буфера обычной записью
+    discard(source, available - moved);
+    return writeAll(sink.fd, data + moved, size - moved);
+#else
+    (void)last;
+    return writeAll(sink.fd, data, size);
+#endif
+}
+
+void TeeCommand::fail(Sink& sink, std::ostream& err) {
+    // Программа, закрывшая stdin, ошибкой не считается: её код будет получен при ожидании
+    if (sink.pid < 0) {
+        err << "tee: " << sink.name << ": " << std::strerror(errno) << "\n";
+        exitCode_ = 1;
+    }
+    close(sink.fd);
+    sink.fd = -1;
+}
+
+void TeeCommand::closePipes() {
+    for (int* pipe : {block_, copy_}) {
+        for (int i = 0; i < 2; ++i) {
+            if (pipe[i] >= 0) {
+                close(pipe[i]);
+                pipe[i] = -1;
+            }
+        }
+    }
+}
+
+void TeeCommand::closeAll() {
+    closePipes();
+    for (auto& sink : sinks_) {
+        if (sink.fd >= 0) {
+            close(sink.fd);
+        }
+    }
+    for (auto& sink : sinks_) {
+        if (sink.pid >= 0) {
+            int code = waitProcess(sink.pid);
+            if (code != 0 && exitCode_ == 0) {
+                exitCode_ = code;
+            }
+        }
+    }
+    sinks_.clear();
+}
+
+}  // namespace shell
@@ -0,0 +1,156 @@
+#include "shell/commands/uniq_command.hpp"
+
+#include <cstdio>
+#include <memory>
+
+#include "shell/input_file.hpp"
+#include "shell/stream_pipe.hpp"
+
+namespace shell {
+
+namespace {
+
+// Размер блока чтения входа
+constexpr size_t kBlockSize = 128 * 1024;
+
+/**
+ * Группа одинаковых соседних строк; строка выводится, когда
+ * встречается отличная от неё или вход заканчивается.
+ */
+class Collapser {
+public:
+    Collapser(bool count, bool repeatedOnly, bool uniqueOnly)
+        : count_(count), repeatedOnly_(repeatedOnly), uniqueOnly_(uniqueOnly) {}
+
+    void add(std::string_view line) {
+        if (repeats_ > 0 && line == current_) {
+            ++repeats_;
+            return;
+        }
+        flush();
+        current_.assign(line.data(), line.size());
+        repeats_ = 1;
+    }
+
+    void flush() {
+        if (repeats_ == 0 || (repeatedOnly_ && repeats_ < 2) || (uniqueOnly_ && repeats_ > 1)) {
+            return;
+        }
+        if (count_) {
+            char number[32];
+            int length = std::snprintf(number, sizeof(number), "%7llu ",
+                                       static_cast<unsigned long long>(repeats_));
+            output_.append(number, static_cast<size_t>(length));
+        }
+        output_ += current_;
+        output_ += '\n';
+    }
+
+    // Накопленный вывод отдаётся после каждого блока
+    std::string& output() {
+        return output_;
+    }
+
+private:
+    bool count_;
+    bool repeatedOnly_;
+    bool uniqueOnly_;
+    std::string current_;
+    uint64_t repeats_ = 0;
+    std::string output_;
+};
+
+}  // namespace
+
+CommandResult UniqCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    count_ = false;
+    repeatedOnly_ = false;
+    uniqueOnly_ = false;
+    std::vector<std::string> operands;
+    for (const auto& arg : args_) {
+        if (arg.size() < 2 || arg[0] != '-') {
+            operands.push_back(arg);
+            continue;
+        }
+        for (size_t i = 1; i < arg.size(); ++i) {
+            if (arg[i] == 'c') {
+                count_ = true;
+            } else if (arg[i] == 'd') {
+                repeatedOnly_ = true;
+            } else if (arg[i] == 'u') {
+                uniqueOnly_ = true;
+            } else {
+                err << "uniq: invalid option -- '" << arg[i] << "'\n";
+                return 1;
+            }
+        }
+    }
+    if (operands.size() > 1) {
+        err << "uniq: extra operand '" << operands[1] << "'\n";
+        return 1;
+    }
+
+    InputFile file;
+    bool fromFile = !operands.empty() && operands[0] != "-";
+    if (fromFile) {
+        file = InputFile(operands[0]);
+        if (!file.isOpen() || file.isDirectory()) {
+            err << "uniq: " << operands[0] << ": " << file.errorMessage() << "\n";
+            return 1;
+        }
+    }
+
+    Collapser collapser(count_, repeatedOnly_, uniqueOnly_);
+    std::string pending;
+    auto block = std::make_unique<char[]>(kBlockSize);
+    while (true) {
+        ssize_t bytesRead = 0;
+        if (fromFile) {
+            bytesRead = file.read(block.get(), kBlockSize);
+        } else {
+            bytesRead = static_cast<ssize_t>(readAvailable(in, block.get(), kBlockSize));
+        }
+        if (bytesRead < 0) {
+            err << "uniq: " << operands[0] << ": read error\n";
+            return 1;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        pending.append(block.get(), static_cast<size_t>(bytesRead));
+
+        size_t start = 0;
+        for (size_t newline; (newline = pending.find('\n', start)) != std::string::npos;
+             start = newline + 1) {
+            collapser.add(std::string_view(pending).substr(start, newline - start));
+        }
+        pending.erase(0, start);
+        out << collapser.output();
+        collapser.output().clear();
+        if (!out) {
+            return 0;  // Вывод больше не принимается
+        }
+    }
+
+    if (!pending.empty()) {
+        collapser.add(pending);
+    }
+    collapser.flush();
+    out << collapser.output();
+    return 0;
+}
+
+void UniqCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+void UniqCommand::assignArguments(const std::pmr::vector<std::pmr::string>& args) {
+    args_.assign(args.begin(), args.end());
+}
+
+bool UniqCommand::reset() {
+    args_.clear();
+    return true;
+}
+
+}  // namespace shell
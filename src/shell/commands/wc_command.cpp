@@ -1,41 +1,92 @@
 #include "shell/commands/wc_command.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <memory>
 #include <sstream>
 
+#include "shell/input_file.hpp"
+#include "shell/io_ring.hpp"
+#include "shell/thread_pool.hpp"
+
 namespace shell {
 
-int WcCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
-    // Если аргументов нет — обрабатываем stdin
-    if (filenames_.empty()) {
-        // Читаем весь stdin в строку для подсчёта
-        std::stringstream buffer;
-        buffer << in.rdbuf();
-        std::istringstream stream(buffer.str());
+namespace {
+
+// Размер блока при чтении потока или необычного файла
+constexpr size_t kBlockSize = 128 * 1024;
+
+// Файлы от этого размера считаются по кускам на нескольких потоках
+constexpr size_t kParallelThreshold = 64 * 1024 * 1024;
+constexpr size_t kMinChunkSize = 16 * 1024 * 1024;
+
+// С этого числа файлов они читаются пачками через io_uring, а не параллельно по одному
+constexpr size_t kRingMinFiles = 8;
 
-        Counts counts = countStream(stream);
+}  // namespace
+
+CommandResult WcCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
+    if (!parseArguments(err)) {
+        return 1;
+    }
+
+    // Если файлов нет — обрабатываем входной поток
+    if (filenames_.empty()) {
+        Counts counts = countStream(in);
         printCounts(out, counts);
-        return 0;
+        return reportInvalid(err, counts, "standard input") ? 1 : 0;
+    }
+
+    // Много файлов без -c по отдельности: открытие и чтение пачками в кольце
+    bool hasStdin = std::find(filenames_.begin(), filenames_.end(), "-") != filenames_.end();
+    if (filenames_.size() >= kRingMinFiles && !hasStdin && mode_ != TextCounter::kBytes) {
+        if (IoRing* ring = IoRing::local()) {
+            return countFilesInRing(*ring, out, err);
+        }
+    }
+
+    // Файлы считаются параллельно, а выводятся строго в порядке аргументов
+    ThreadPool& pool = ThreadPool::shared();
+    std::vector<std::future<FileResult>> pending(filenames_.size());
+    if (filenames_.size() > 1 && pool.size() > 1) {
+        for (size_t i = 0; i < filenames_.size(); ++i) {
+            if (filenames_[i] != "-") {
+                const std::string& filename = filenames_[i];
+                pending[i] = pool.submit([this, &filename]() { return countFile(filename); });
+            }
+        }
     }
 
     int exitCode = 0;
-    Counts total{0, 0, 0};
+    Counts total;
 
-    for (const auto& filename : filenames_) {
-        std::ifstream file(filename, std::ios::binary);
+    for (size_t i = 0; i < filenames_.size(); ++i) {
+        const std::string& filename = filenames_[i];
+        FileResult result;
+        if (filename == "-") {
+            result.counts = countStream(in);
+        } else if (pending[i].valid()) {
+            result = pool.wait(pending[i]);
+        } else {
+            result = countFile(filename);
+        }
 
-        if (!file.is_open()) {
-            err << "wc: " << filename << ": No such file or directory\n";
+        if (!result.error.empty()) {
+            err << result.error;
             exitCode = 1;
             continue;
         }
 
-        Counts counts = countStream(file);
-        printCounts(out, counts, filename);
+        printCounts(out, result.counts, filename);
+        if (reportInvalid(err, result.counts, filename)) {
+            exitCode = 1;
+        }
 
-        total.lines += counts.lines;
-        total.words += counts.words;
-        total.bytes += counts.bytes;
+        total.lines += result.counts.lines;
+        total.words += result.counts.words;
+        total.chars += result.counts.chars;
+        total.bytes += result.counts.bytes;
     }
 
     // Если было несколько файлов — выводим итог
@@ -46,44 +97,231 @@ int WcCommand::execute(std::istream& in, std::ostream& out, std::ostream& err) {
     return exitCode;
 }
 
-void WcCommand::setArguments(const std::vector<std::string>& args) {
-    filenames_ = args;
+StageTask WcCommand::stage(StageIO& io) {
+    if (!parseArguments(io.err)) {
+        co_return 1;
+    }
+    std::ostringstream out;
+    if (!filenames_.empty()) {
+        // Файлы вход стадии не читают: считаются так же, как в execute()
+        std::istringstream noInput;
+        int code = execute(noInput, out, io.err);
+        co_yield out.str();
+        co_return code;
+    }
+
+    TextCounter counter(mode_);
+    for (std::string_view chunk; !(chunk = co_await io.read()).empty();) {
+        counter.update(chunk.data(), chunk.size());
+    }
+    Counts counts = counter.counts();
+    printCounts(out, counts);
+    co_yield out.str();
+    co_return reportInvalid(io.err, counts, "standard input") ? 1 : 0;
+}
+
+StageCommand* WcCommand::asStage() {
+    return std::find(args_.begin(), args_.end(), "-") == args_.end() ? this : nullptr;
+}
+
+void WcCommand::setArguments(std::vector<std::string> args) {
+    args_ = std::move(args);
+}
+
+bool WcCommand::parseArguments(std::ostream& err) {
+    filenames_.clear();
+    unsigned mode = 0;
+    bool optionsDone = false;
+
+    for (const auto& arg : args_) {
+        if (optionsDone || arg.size() < 2 || arg[0] != '-') {
+            filenames_.push_back(arg);
+            continue;
+        }
+        if (arg == "--") {
+            optionsDone = true;
+            continue;
+        }
+        if (arg == "--check-utf8") {
+            mode |= TextCounter::kValidate;
+            continue;
+        }
+        for (size_t i = 1; i < arg.size(); ++i) {
+            switch (arg[i]) {
+                case 'l':
+                    mode |= TextCounter::kLines;
+                    break;
+                case 'w':
+                    mode |= TextCounter::kWords;
+                    break;
+                case 'c':
+                    mode |= TextCounter::kBytes;
+                    break;
+                case 'm':
+                    mode |= TextCounter::kChars;
+                    break;
+                default:
+                    err << "wc: invalid option -- '" << arg[i] << "'\n";
+                    return false;
+            }
+        }
+    }
+
+    // Проверка UTF-8 не выбирает счётчики: без -l/-w/-m/-c выводятся все три
+    if ((mode & ~static_cast<unsigned>(TextCounter::kValidate)) == 0) {
+        mode |= TextCounter::kAll;
+    }
+    mode_ = mode;
+    return true;
 }
 
 WcCommand::Counts WcCommand::countStream(std::istream& stream) {
-    Counts counts{0, 0, 0};
-
-    std::string line;
-    while (std::getline(stream, line)) {
-        counts.lines++;
-        counts.bytes += line.size() + 1;  // +1 для \n
-
-        // Подсчёт слов
-        bool inWord = false;
-        for (char c : line) {
-            if (c == ' ' || c == '\t' || c == '\r') {
-                inWord = false;
+    TextCounter counter(mode_);
+    auto buffer = std::make_unique<char[]>(kBlockSize);
+
+    while (stream) {
+        stream.read(buffer.get(), static_cast<std::streamsize>(kBlockSize));
+        std::streamsize bytesRead = stream.gcount();
+        if (bytesRead <= 0) {
+            break;
+        }
+        counter.update(buffer.get(), static_cast<size_t>(bytesRead));
+    }
+
+    return counter.counts();
+}
+
+WcCommand::FileResult WcCommand::countFile(const std::string& filename) const {
+    FileResult result;
+    InputFile file(filename);
+    if (!file.isOpen() || file.isDirectory()) {
+        result.error = "wc: " + filename + ": " + file.errorMessage() + "\n";
+        return result;
+    }
+
+    // Только байты обычного файла — достаточно fstat
+    if (mode_ == TextCounter::kBytes && file.isRegular()) {
+        result.counts.bytes = static_cast<size_t>(file.size());
+        return result;
+    }
+
+    std::string_view mapped = file.map();
+    if (!mapped.empty()) {
+        ThreadPool& pool = ThreadPool::shared();
+        if (mapped.size() >= kParallelThreshold && pool.size() > 1) {
+            size_t chunkSize = std::max(kMinChunkSize, mapped.size() / (pool.size() * 4));
+            result.counts =
+                TextCounter::countParallel(mapped.data(), mapped.size(), mode_, pool, chunkSize);
+        } else {
+            TextCounter counter(mode_);
+            counter.update(mapped.data(), mapped.size());
+            result.counts = counter.counts();
+        }
+        return result;
+    }
+
+    TextCounter counter(mode_);
+    auto buffer = std::make_unique<char[]>(kBlockSize);
+    ssize_t bytesRead;
+    while ((bytesRead = file.read(buffer.get(), kBlockSize)) > 0) {
+        counter.update(buffer.get(), static_cast<size_t>(bytesRead));
+    }
+    if (bytesRead < 0) {
+        result.error = "wc: " + filename + ": read error\n";
+        return result;
+    }
+
+    result.counts = counter.counts();
+    return result;
+}
+
+int WcCommand::countFilesInRing(IoRing& ring, std::ostream& out, std::ostream& err) {
+    // Блоки файла считаются по мере чтения, результат выводится в end()
+    class Consumer : public FileConsumer {
+    public:
+        Consumer(WcCommand& wc, std::ostream& out, std::ostream& err)
+            : wc_(wc), out_(out), err_(err), counter_(wc.mode_) {}
+
+        bool data(size_t, const char* data, size_t size) override {
+            counter_.update(data, size);
+            return true;
+        }
+
+        void end(size_t index, int error) override {
+            const std::string& filename = wc_.filenames_[index];
+            if (error != 0) {
+                err_ << "wc: " << filename << ": " << std::strerror(error) << "\n";
+                exitCode = 1;
             } else {
-                if (!inWord) {
-                    counts.words++;
-                    inWord = true;
+                Counts counts = counter_.counts();
+                wc_.printCounts(out_, counts, filename);
+                if (reportInvalid(err_, counts, filename)) {
+                    exitCode = 1;
                 }
+                total.lines += counts.lines;
+                total.words += counts.words;
+                total.chars += counts.chars;
+                total.bytes += counts.bytes;
             }
+            counter_ = TextCounter(wc_.mode_);
         }
-    }
 
-    // Корректируем bytes если последняя строка без \n
-    // (getline не считает финальный символ если его нет)
+        Counts total;
+        int exitCode = 0;
+
+    private:
+        WcCommand& wc_;
+        std::ostream& out_;
+        std::ostream& err_;
+        TextCounter counter_;
+    };
 
-    return counts;
+    Consumer consumer(*this, out, err);
+    ring.readFiles(filenames_, consumer);
+    printCounts(out, consumer.total, "total");
+    return consumer.exitCode;
 }
 
 void WcCommand::printCounts(std::ostream& out, const Counts& counts, const std::string& filename) {
-    out << counts.lines << ' ' << counts.words << ' ' << counts.bytes;
+    bool first = true;
+    auto field = [&](unsigned flag, size_t value) {
+        if ((mode_ & flag) == 0) {
+            return;
+        }
+        if (!first) {
+            out << ' ';
+        }
+        out << value;
+        first = false;
+    };
+
+    field(TextCounter::kLines, counts.lines);
+    field(TextCounter::kWords, counts.words);
+    field(TextCounter::kChars, counts.chars);
+    field(TextCounter::kBytes, counts.bytes);
+
     if (!filename.empty()) {
         out << ' ' << filename;
     }
     out << '\n';
 }
 
+bool WcCommand::reportInvalid(std::ostream& err, const Counts& counts, const std::string& name) {
+    if (counts.invalid == 0) {
+        return false;
+    }
+    err << "wc: " << name << ": invalid UTF-8 at byte " << counts.firstInvalid << " ("
+        << counts.invalid << " invalid sequence" << (counts.invalid == 1 ? "" : "s") << ")\n";
+    return true;
+}
+
+void WcCommand::assignArguments(const std::pmr::vector<std::pmr::string>& args) {
+    args_.assign(args.begin(), args.end());
+}
+
+bool WcCommand::reset() {
+    args_.clear();
+    return true;
+}
+
 }  // namespace shell
@@ -0,0 +1,386 @@
+#include "shell/completion.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <unordered_set>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/directory_reader.hpp"
+
+namespace shell {
+
+namespace {
+
+// Элемент каталога — каталог (символические ссылки разыменовываются)
+bool isDirectory(int dirFd, const DirEntry& entry) {
+    if (entry.type == DT_DIR) {
+        return true;
+    }
+    if (entry.type != DT_LNK && entry.type != DT_UNKNOWN) {
+        return false;
+    }
+    struct stat st {};
+    return fstatat(dirFd, entry.name.c_str(), &st, 0) == 0 && S_ISDIR(st.st_mode);
+}
+
+// Элемент каталога — исполняемый обычный файл
+bool isExecutableFile(int dirFd, const DirEntry& entry) {
+    if (entry.type != DT_REG) {
+        if (entry.type != DT_LNK && entry.type != DT_UNKNOWN) {
+            return false;
+        }
+        struct stat st {};
+        if (fstatat(dirFd, entry.name.c_str(), &st, 0) != 0 || !S_ISREG(st.st_mode)) {
+            return false;
+        }
+    }
+    return faccessat(dirFd, entry.name.c_str(), X_OK, 0) == 0;
+}
+
+bool isVariableName(std::string_view name) {
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])) != 0) {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+    });
+}
+
+void sortUnique(std::vector<std::string>& names) {
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// NameTrie
+// ---------------------------------------------------------------------------
+
+NameTrie::NameTrie() : nodes_(1) {}
+
+uint32_t NameTrie::child(uint32_t node, char c) const {
+    for (const auto& [key, index] : nodes_[node].children) {
+        if (key == c) {
+            return index;
+        }
+    }
+    return 0;
+}
+
+void NameTrie::insert(std::string_view name) {
+    std::vector<uint32_t> path{0};
+    for (char c : name) {
+        uint32_t next = child(path.back(), c);
+        if (next == 0) {
+            if (!free_.empty()) {
+                next = free_.back();
+                free_.pop_back();
+            } else {
+                next = static_cast<uint32_t>(nodes_.size());
+                nodes_.emplace_back();
+            }
+            auto& children = nodes_[path.back()].children;
+            auto pos = std::lower_bound(
+                children.begin(), children.end(), c,
+                [](const std::pair<char, uint32_t>& item, char key) { return item.first < key; });
+            children.insert(pos, {c, next});
+        }
+        path.push_back(next);
+    }
+    if (nodes_[path.back()].count++ == 0) {
+        for (uint32_t node : path) {
+            nodes_[node].names++;
+        }
+    }
+}
+
+void NameTrie::erase(std::string_view name) {
+    std::vector<uint32_t> path{0};
+    for (char c : name) {
+        uint32_t next = child(path.back(), c);
+        if (next == 0) {
+            return;
+        }
+        path.push_back(next);
+    }
+    if (nodes_[path.back()].count == 0 || --nodes_[path.back()].count > 0) {
+        return;
+    }
+    for (uint32_t node : path) {
+        nodes_[node].names--;
+    }
+    // Узлы без имён отцепляются и переиспользуются
+    for (size_t i = path.size() - 1; i > 0 && nodes_[path[i]].names == 0; --i) {
+        auto& siblings = nodes_[path[i - 1]].children;
+        siblings.erase(std::find_if(siblings.begin(), siblings.end(),
+                                    [&](const auto& item) { return item.second == path[i]; }));
+        nodes_[path[i]] = Node{};
+        free_.push_back(path[i]);
+    }
+}
+
+std::vector<std::string> NameTrie::withPrefix(std::string_view prefix, size_t limit) const {
+    std::vector<std::string> out;
+    uint32_t node = 0;
+    for (char c : prefix) {
+        node = child(node, c);
+        if (node == 0) {
+            return out;
+        }
+    }
+    std::string name(prefix);
+    collect(node, name, limit, out);
+    return out;
+}
+
+void NameTrie::collect(uint32_t node, std::string& name, size_t limit,
+                       std::vector<std::string>& out) const {
+    if (nodes_[node].count > 0) {
+        out.push_back(name);
+    }
+    for (const auto& [c, next] : nodes_[node].children) {
+        if (out.size() >= limit) {
+            return;
+        }
+        name.push_back(c);
+        collect(next, name, limit, out);
+        name.pop_back();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ExecutableIndex
+// ---------------------------------------------------------------------------
+
+ExecutableIndex::ExecutableIndex(PathCache& paths) : paths_(paths) {}
+
+void ExecutableIndex::refresh() {
+    // Каталоги и отметки изменений — те же, что видит кэш путей
+    std::vector<PathCache::DirectoryStamp> stamps = paths_.directoryStamps();
+    std::vector<std::string> order;
+    std::unordered_set<std::string> seen;
+    for (const auto& dir : stamps) {
+        if (!dir.path.empty() && seen.insert(dir.path).second) {
+            order.push_back(dir.path);
+        }
+    }
+    for (auto it = dirs_.begin(); it != dirs_.end();) {
+        if (seen.count(it->first) == 0) {
+            for (const std::string& name : it->second.names) {
+                trie_.erase(name);
+            }
+            it = dirs_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    order_ = std::move(order);
+
+    std::vector<std::pair<std::string, std::promise<std::vector<std::string>>>> batch;
+    for (const auto& [path, stamp] : stamps) {
+        if (seen.erase(path) == 0) {
+            continue;  // Повтор в PATH или пустой элемент
+        }
+        Directory& dir = dirs_[path];
+        if (dir.pending.valid()) {
+            if (dir.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                continue;
+            }
+            apply(dir, dir.pending.get());
+        }
+        // Изменение во время чтения даст новую отметку и ещё одно чтение
+        if (stamp != dir.stamp) {
+            dir.stamp = stamp;
+            batch.emplace_back(path, std::promise<std::vector<std::string>>());
+            dir.pending = batch.back().second.get_future();
+            ++scans_;
+        }
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    // Один поток на пачку изменившихся каталогов; выход из shell его не ждёт
+    std::thread([batch = std::move(batch)]() mutable {
+        for (auto& [path, promise] : batch) {
+            try {
+                promise.set_value(scan(path));
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        }
+    }).detach();
+}
+
+std::vector<std::string> ExecutableIndex::complete(std::string_view prefix, size_t limit) {
+    refresh();
+    return trie_.withPrefix(prefix, limit);
+}
+
+void ExecutableIndex::waitForScans() {
+    refresh();
+    for (const std::string& path : order_) {
+        Directory& dir = dirs_[path];
+        if (dir.pending.valid()) {
+            apply(dir, dir.pending.get());
+        }
+    }
+}
+
+void ExecutableIndex::apply(Directory& dir, std::vector<std::string> names) {
+    for (const std::string& name : dir.names) {
+        trie_.erase(name);
+    }
+    for (const std::string& name : names) {
+        trie_.insert(name);
+    }
+    dir.names = std::move(names);
+}
+
+std::vector<std::string> ExecutableIndex::scan(const std::string& path) {
+    std::vector<std::string> names;
+    int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return names;
+    }
+    std::vector<DirEntry> entries;
+    readDirectory(fd, entries);
+    for (const DirEntry& entry : entries) {
+        if (isExecutableFile(fd, entry)) {
+            names.push_back(entry.name);
+        }
+    }
+    close(fd);
+    return names;
+}
+
+// ---------------------------------------------------------------------------
+// Completer
+// ---------------------------------------------------------------------------
+
+Completer::Completer(const Environment& env, CommandFactory& factory)
+    : env_(env), factory_(factory), executables_(factory.getPathCache()) {}
+
+void Completer::prefetch() {
+    executables_.refresh();
+}
+
+Completer::Result Completer::complete(std::string_view line, size_t cursor) {
+    cursor = std::min(cursor, line.size());
+    auto isBreak = [](char c) { return c == ' ' || c == '\t' || c == '|'; };
+
+    Result result;
+    result.start = cursor;
+    while (result.start > 0 && !isBreak(line[result.start - 1])) {
+        --result.start;
+    }
+    std::string_view word = line.substr(result.start, cursor - result.start);
+
+    // Позиция команды: до слова в этой части пайплайна только присваивания
+    size_t segment = line.find_last_of('|', result.start == 0 ? 0 : result.start - 1);
+    segment = segment == std::string_view::npos || result.start == 0 ? 0 : segment + 1;
+    bool command = true;
+    std::string_view before = line.substr(segment, result.start - segment);
+    for (size_t pos = 0; pos < before.size();) {
+        size_t end = before.find_first_of(" \t", pos);
+        end = end == std::string_view::npos ? before.size() : end;
+        std::string_view prior = before.substr(pos, end - pos);
+        if (!prior.empty() && prior.find('=') == std::string_view::npos) {
+            command = false;
+        }
+        pos = end + 1;
+    }
+
+    if (!word.empty() && word[0] == '$') {
+        result.candidates = completeVariable(word);
+    } else if (command && word.find('/') == std::string_view::npos) {
+        result.candidates = completeCommand(word);
+    } else {
+        result.candidates = completePath(word, command);
+    }
+    return result;
+}
+
+std::string Completer::commonPrefix(const std::vector<std::string>& candidates) {
+    if (candidates.empty()) {
+        return {};
+    }
+    std::string prefix = candidates.front();
+    for (const std::string& candidate : candidates) {
+        size_t length = 0;
+        while (length < prefix.size() && length < candidate.size() &&
+               prefix[length] == candidate[length]) {
+            ++length;
+        }
+        prefix.resize(length);
+    }
+    return prefix;
+}
+
+std::vector<std::string> Completer::completeCommand(std::string_view word) {
+    std::vector<std::string> names = executables_.complete(word);
+    for (std::string& name : factory_.commandNames()) {
+        if (name.compare(0, word.size(), word) == 0) {
+            names.push_back(std::move(name));
+        }
+    }
+    sortUnique(names);
+    return names;
+}
+
+std::vector<std::string> Completer::completeVariable(std::string_view word) const {
+    const bool braced = word.size() >= 2 && word[1] == '{';
+    std::string_view prefix = word.substr(braced ? 2 : 1);
+    std::vector<std::string> names;
+    for (const std::string& name : env_.names()) {
+        if (isVariableName(name) && name.compare(0, prefix.size(), prefix) == 0) {
+            names.push_back(braced ? "${" + name + "}" : "$" + name);
+        }
+    }
+    sortUnique(names);
+    return names;
+}
+
+std::vector<std::string> Completer::completePath(std::string_view word, bool commandsOnly) const {
+    size_t slash = word.rfind('/');
+    std::string_view dirPart = slash == std::string_view::npos ? "" : word.substr(0, slash + 1);
+    std::string_view base = word.substr(dirPart.size());
+
+    std::string dirPath = dirPart.empty() ? "." : std::string(dirPart);
+    if (dirPart.substr(0, 2) == "~/") {
+        dirPath = env_.get("HOME") + std::string(dirPart.substr(1));
+    }
+
+    std::vector<std::string> names;
+    int fd = open(dirPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return names;
+    }
+    std::vector<DirEntry> entries;
+    readDirectory(fd, entries);
+    for (const DirEntry& entry : entries) {
+        if (entry.name.compare(0, base.size(), base) != 0 ||
+            (entry.name[0] == '.' && (base.empty() || base[0] != '.'))) {
+            continue;
+        }
+        if (isDirectory(fd, entry)) {
+            names.push_back(std::string(dirPart) + entry.name + "/");
+        } else if (!commandsOnly || isExecutableFile(fd, entry)) {
+            names.push_back(std::string(dirPart) + entry.name);
+        }
+    }
+    close(fd);
+    sortUnique(names);
+    return names;
+}
+
+}  // namespace shell
@@ -0,0 +1,94 @@
+#include "shell/coroutine_stage.hpp"
+
+#include "shell/stream_pipe.hpp"
+
+namespace shell {
+
+StageTask& StageTask::operator=(StageTask&& other) noexcept {
+    if (this != &other) {
+        if (handle_) {
+            handle_.destroy();
+        }
+        handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+}
+
+StageTask::~StageTask() {
+    if (handle_) {
+        handle_.destroy();
+    }
+}
+
+int StageTask::result() const {
+    if (handle_.promise().exception_) {
+        std::rethrow_exception(handle_.promise().exception_);
+    }
+    return handle_.promise().code_;
+}
+
+std::vector<CommandResult> runStages(std::vector<StageTask>& stages,
+                                     std::vector<StageChannel>& channels, std::istream* in,
+                                     std::ostream& out, std::ostream& err) {
+    const size_t count = stages.size();
+    std::vector<CommandResult> results(count);
+    StageChannel& source = channels.front();
+    StageChannel& sink = channels.back();
+    if (in == nullptr) {
+        source.closed = true;
+    }
+
+    size_t running = count;
+    while (running > 0) {
+        bool progressed = false;
+        for (size_t i = count; i-- > 0;) {
+            StageTask& stage = stages[i];
+            if (stage.done() || !stage.io().ready()) {
+                continue;
+            }
+            stage.resume();
+            progressed = true;
+
+            // Вывод последней стадии не копится: сразу в out
+            if (!sink.data.empty()) {
+                if (!sink.abandoned && !out.write(sink.data.data(),
+                                                  static_cast<std::streamsize>(sink.data.size()))) {
+                    sink.abandoned = true;
+                }
+                sink.data.clear();
+            }
+
+            if (!stage.done()) {
+                continue;
+            }
+            --running;
+            try {
+                results[i] = stage.result();
+            } catch (const std::exception& e) {
+                err << "shell: " << e.what() << "\n";
+                results[i] = 1;
+            }
+            // Как при закрытии StreamPipe: следующая стадия получит конец
+            // входа, предыдущая — отказ в записи
+            channels[i + 1].closed = true;
+            channels[i].abandoned = true;
+            channels[i].data.clear();
+        }
+
+        // Первая стадия ждёт вход: подкачиваем из потока
+        if (!source.closed && source.data.empty() && !stages.front().done() &&
+            stages.front().io().waiting() == StageIO::Wait::kInput) {
+            source.data.resize(StageChannel::kLimit);
+            size_t size = readAvailable(*in, source.data.data(), source.data.size());
+            source.data.resize(size);
+            source.closed = size == 0;
+            progressed = true;
+        }
+        if (!progressed) {
+            break;  // Не должно случаться: в линейной цепочке всегда кто-то готов
+        }
+    }
+    return results;
+}
+
+}  // namespace shell
@@ -0,0 +1,76 @@
+#include "shell/directory_reader.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace shell {
+
+namespace {
+
+bool isDotOrDotDot(const char* name) {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+#ifdef __linux__
+// Буфер getdents64: один вызов читает сотни записей
+constexpr size_t kDentsBufferSize = 64 * 1024;
+
+// Смещения полей struct linux_dirent64
+constexpr size_t kDirentReclen = 16;
+constexpr size_t kDirentType = 18;
+constexpr size_t kDirentName = 19;
+#endif
+
+}  // namespace
+
+bool readDirectory(int fd, std::vector<DirEntry>& entries) {
+#ifdef __linux__
+    thread_local std::unique_ptr<char[]> buffer = std::make_unique<char[]>(kDentsBufferSize);
+    while (true) {
+        long size = syscall(SYS_getdents64, fd, buffer.get(), kDentsBufferSize);
+        if (size < 0) {
+            return false;
+        }
+        if (size == 0) {
+            return true;
+        }
+        for (size_t pos = 0; pos < static_cast<size_t>(size);) {
+            const char* record = buffer.get() + pos;
+            uint16_t length = 0;
+            std::memcpy(&length, record + kDirentReclen, sizeof(length));
+            const char* name = record + kDirentName;
+            if (!isDotOrDotDot(name)) {
+                entries.push_back({name, static_cast<unsigned char>(record[kDirentType])});
+            }
+            pos += length;
+        }
+    }
+#else
+    int dupFd = dup(fd);
+    DIR* dir = dupFd >= 0 ? fdopendir(dupFd) : nullptr;
+    if (dir == nullptr) {
+        if (dupFd >= 0) {
+            close(dupFd);
+        }
+        return false;
+    }
+    rewinddir(dir);
+    while (struct dirent* record = readdir(dir)) {
+        if (!isDotOrDotDot(record->d_name)) {
+            entries.push_back({record->d_name, record->d_type});
+        }
+    }
+    closedir(dir);
+    return true;
+#endif
+}
+
+}  // namespace shell
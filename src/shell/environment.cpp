@@ -16,10 +16,12 @@ std::string Environment::get(const std::string& name) const {
 
 void Environment::set(const std::string& name, const std::string& value) {
     variables_[name] = value;
+    ++version_;
 }
 
 void Environment::unset(const std::string& name) {
     variables_.erase(name);
+    ++version_;
 }
 
 bool Environment::contains(const std::string& name) const {
@@ -35,6 +37,15 @@ std::vector<std::string> Environment::toEnvp() const {
     return result;
 }
 
+std::vector<std::string> Environment::names() const {
+    std::vector<std::string> result;
+    result.reserve(variables_.size());
+    for (const auto& entry : variables_) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
 void Environment::initFromSystem() {
     if (environ == nullptr) {
         return;
@@ -52,6 +63,7 @@ void Environment::initFromSystem() {
 
     // Инициализируем специальную переменную для кода возврата
     variables_["?"] = "0";
+    ++version_;
 }
 
 }  // namespace shell
@@ -1,18 +1,378 @@
 #include "shell/executor.hpp"
 
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
-#include "shell/commands/exit_command.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
+
+#include "shell/commands/external_command.hpp"
+#include "shell/coroutine_stage.hpp"
+#include "shell/interrupt.hpp"
+#include "shell/process_util.hpp"
+#include "shell/reactor.hpp"
+#include "shell/stream_pipe.hpp"
+#include "shell/thread_pool.hpp"
 
 namespace shell {
 
+namespace {
+
+/**
+ * Выполнить встроенную стадию пайплайна: вход — канал предыдущей стадии
+ * (или пустой поток), выход — канал следующей (или std::cout).
+ */
+void runBuiltinStage(Command& command, StreamPipe* input, StreamPipe* output,
+                     CommandResult& result) {
+    std::istringstream emptyInput;
+    std::unique_ptr<PipeReadBuffer> inputBuffer;
+    if (input != nullptr) {
+        inputBuffer = std::make_unique<PipeReadBuffer>(*input);
+    }
+    std::istream pipeInput(inputBuffer.get());
+    std::istream& in = input != nullptr ? pipeInput : emptyInput;
+
+    // Исключение в потоке стадии не должно завершать процесс
+    auto run = [&](std::ostream& out) {
+        try {
+            result = command.execute(in, out, std::cerr);
+        } catch (const std::exception& e) {
+            std::cerr << "shell: " << e.what() << "\n";
+            result = 1;
+        }
+    };
+
+    if (output == nullptr) {
+        // Последняя команда — пишем в stdout
+        run(std::cout);
+    } else {
+        PipeWriteBuffer outputBuffer(*output);
+        std::ostream out(&outputBuffer);
+        run(out);
+        out.flush();
+        output->closeWrite();
+    }
+    // Стадия завершилась: вход ей больше не нужен, предыдущая стадия
+    // получит ошибку записи и остановится
+    if (input != nullptr) {
+        input->closeRead();
+    }
+}
+
+#ifdef __linux__
+
+constexpr size_t kRelayBufferSize = 256 * 1024;
+
+/**
+ * Незавершённая работа цикла событий: программы и пересылки. Когда всё
+ * закончилось, снимается и дескриптор прерывания, и run() возвращается.
+ */
+struct LoopState {
+    Reactor& reactor;
+    size_t pending = 0;
+
+    void finished() {
+        if (--pending == 0) {
+            reactor.remove(Interrupt::fd());
+        }
+    }
+};
+
+/**
+ * Пересылка между каналом программы (неблокирующий fd) и каналом
+ * StreamPipe встроенной стадии или std::cout. StreamPipe будит цикл
+ * через eventfd, поэтому поток стадии и цикл не ждут друг друга.
+ */
+class Relay {
+public:
+    Relay(LoopState& loop, int fd)
+        : loop_(loop), fd_(fd), buffer_(std::make_unique<char[]>(kRelayBufferSize)) {
+        ++loop_.pending;
+        fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK);
+        // Канал ядра размером с буфер: меньше пробуждений цикла на тот же объём
+        fcntl(fd_, F_SETPIPE_SZ, static_cast<int>(kRelayBufferSize));
+    }
+
+    virtual ~Relay() = default;
+
+    Relay(const Relay&) = delete;
+    Relay& operator=(const Relay&) = delete;
+
+    /// Зарегистрироваться в цикле и перенести то, что уже готово
+    virtual void start() = 0;
+
+protected:
+    LoopState& loop_;
+    int fd_;
+    int notify_ = -1;
+    std::unique_ptr<char[]> buffer_;
+    size_t offset_ = 0;
+    size_t pending_ = 0;  ///< Прочитано, но ещё не передано дальше
+
+    bool watchNotify() {
+        notify_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        return notify_ >= 0 && loop_.reactor.add(notify_, Reactor::kReadable, [this](uint32_t) {
+            uint64_t count = 0;
+            static_cast<void>(::read(notify_, &count, sizeof(count)));
+            pump();
+        });
+    }
+
+    virtual void pump() = 0;
+
+    /// Отвязать notify_ от StreamPipe: поток стадии не должен писать в закрытый номер
+    virtual void forgetNotify() {}
+
+    /// Снять дескрипторы с учёта и закрыть их
+    void finish() {
+        if (fd_ < 0) {
+            return;
+        }
+        loop_.reactor.remove(fd_);
+        close(fd_);
+        fd_ = -1;
+        if (notify_ >= 0) {
+            // Номер eventfd может сразу занять другой поток (find, sort, io_uring)
+            forgetNotify();
+            loop_.reactor.remove(notify_);
+            close(notify_);
+            notify_ = -1;
+        }
+        loop_.finished();
+    }
+};
+
+/// Встроенная стадия → stdin программы
+class PipeToProgram : public Relay {
+public:
+    PipeToProgram(LoopState& loop, StreamPipe& pipe, int fd) : Relay(loop, fd), pipe_(pipe) {}
+
+    ~PipeToProgram() override {
+        pipe_.notifyReader(-1);
+    }
+
+    void start() override {
+        // Без ожидаемых событий epoll сообщает только об обрыве: программа
+        // закрыла stdin, стадии больше некуда писать
+        bool ok = watchNotify() && loop_.reactor.add(fd_, 0, [this](uint32_t) {
+            if (!waitingWritable_) {
+                abandon();
+                return;
+            }
+            pump();
+        });
+        if (!ok) {
+            abandon();
+            return;
+        }
+        pipe_.notifyReader(notify_);
+        pump();
+    }
+
+private:
+    StreamPipe& pipe_;
+    bool waitingWritable_ = false;
+
+    void forgetNotify() override {
+        pipe_.notifyReader(-1);
+    }
+
+    void pump() override {
+        while (fd_ >= 0) {
+            if (pending_ == 0) {
+                bool eof = false;
+                pending_ = pipe_.tryRead(buffer_.get(), kRelayBufferSize, eof);
+                offset_ = 0;
+                if (eof) {
+                    finish();
+                    return;
+                }
+                if (pending_ == 0) {
+                    wantWritable(false);
+                    return;
+                }
+            }
+            ssize_t written = ::write(fd_, buffer_.get() + offset_, pending_);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN) {
+                    wantWritable(true);
+                    return;
+                }
+                abandon();
+                return;
+            }
+            offset_ += static_cast<size_t>(written);
+            pending_ -= static_cast<size_t>(written);
+        }
+    }
+
+    void wantWritable(bool writable) {
+        if (waitingWritable_ != writable) {
+            waitingWritable_ = writable;
+            loop_.reactor.modify(fd_, writable ? Reactor::kWritable : 0);
+        }
+    }
+
+    void abandon() {
+        pipe_.closeRead();
+        finish();
+    }
+};
+
+/// stdout программы → встроенная стадия
+class ProgramToPipe : public Relay {
+public:
+    ProgramToPipe(LoopState& loop, int fd, StreamPipe& pipe) : Relay(loop, fd), pipe_(pipe) {}
+
+    ~ProgramToPipe() override {
+        pipe_.notifyWriter(-1);
+    }
+
+    void start() override {
+        if (!watchNotify() || !watchProgram(true)) {
+            pipe_.closeWrite();
+            finish();
+            return;
+        }
+        pipe_.notifyWriter(notify_);
+        pump();
+    }
+
+private:
+    StreamPipe& pipe_;
+    bool watching_ = false;
+
+    void forgetNotify() override {
+        pipe_.notifyWriter(-1);
+    }
+
+    void pump() override {
+        while (fd_ >= 0) {
+            if (pending_ > 0) {
+                bool closed = false;
+                size_t written = pipe_.tryWrite(buffer_.get() + offset_, pending_, closed);
+                if (closed) {
+                    // Стадия больше не читает: программа получит SIGPIPE
+                    finish();
+                    return;
+                }
+                offset_ += written;
+                pending_ -= written;
+                if (pending_ > 0) {
+                    // Канал полон; обрыв программы не должен будить цикл впустую
+                    watchProgram(false);
+                    return;
+                }
+                watchProgram(true);
+            }
+            ssize_t count = ::read(fd_, buffer_.get(), kRelayBufferSize);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count < 0 && errno == EAGAIN) {
+                return;
+            }
+            if (count <= 0) {
+                pipe_.closeWrite();
+                finish();
+                return;
+            }
+            offset_ = 0;
+            pending_ = static_cast<size_t>(count);
+        }
+    }
+
+    bool watchProgram(bool watch) {
+        if (watching_ == watch) {
+            return true;
+        }
+        watching_ = watch;
+        if (!watch) {
+            loop_.reactor.remove(fd_);
+            return true;
+        }
+        return loop_.reactor.add(fd_, Reactor::kReadable, [this](uint32_t) { pump(); });
+    }
+};
+
+/// stdout последней программы → std::cout
+class ProgramToStream : public Relay {
+public:
+    ProgramToStream(LoopState& loop, int fd, std::ostream& out) : Relay(loop, fd), out_(out) {}
+
+    void start() override {
+        if (!loop_.reactor.add(fd_, Reactor::kReadable, [this](uint32_t) { pump(); })) {
+            finish();
+        }
+    }
+
+private:
+    std::ostream& out_;
+
+    void pump() override {
+        for (;;) {
+            ssize_t count = ::read(fd_, buffer_.get(), kRelayBufferSize);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count < 0 && errno == EAGAIN) {
+                out_.flush();
+                return;
+            }
+            // Закрываем канал и при отказе вывода — программа получит SIGPIPE
+            if (count <= 0 || !out_.write(buffer_.get(), count)) {
+                out_.flush();
+                finish();
+                return;
+            }
+        }
+    }
+};
+
+int openPidfd(pid_t pid) {
+#ifdef SYS_pidfd_open
+    return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+    static_cast<void>(pid);
+    return -1;
+#endif
+}
+
+#endif  // __linux__
+
+}  // namespace
+
 Executor::Executor(Environment& env) : env_(env) {}
 
 int Executor::execute(Pipeline& pipeline) {
     if (pipeline.isEmpty()) {
         return 0;
     }
+    // Размер общего пула берётся из окружения shell, пока пул не создан
+    ThreadPool::configureShared(env_);
+
+#ifdef __linux__
+    for (size_t i = 0; i < pipeline.size(); ++i) {
+        if (pipeline.getCommand(i).asExternal() != nullptr) {
+            return executeWithReactor(pipeline);
+        }
+    }
+#endif
 
     if (pipeline.size() == 1) {
         return executeSingleCommand(pipeline.getCommand(0));
@@ -22,13 +382,13 @@ int Executor::execute(Pipeline& pipeline) {
 }
 
 int Executor::executeAssignment(const ParsedAssignment& assignment) {
-    env_.set(assignment.variableName, assignment.value);
+    env_.set(std::string(assignment.variableName), std::string(assignment.value));
     return 0;
 }
 
 int Executor::executeAssignments(const ParsedAssignmentList& assignments) {
     for (const auto& assignment : assignments.assignments) {
-        env_.set(assignment.variableName, assignment.value);
+        env_.set(std::string(assignment.variableName), std::string(assignment.value));
     }
     return 0;
 }
@@ -41,61 +401,233 @@ int Executor::getExitCode() const {
     return exitCode_;
 }
 
+bool Executor::handleControl(const CommandResult& result) {
+    if (result.control() != CommandResult::Control::kExit) {
+        return false;
+    }
+    exitRequested_ = true;
+    exitCode_ = result.code();
+    return true;
+}
+
 int Executor::executeSingleCommand(Command& cmd) {
     std::istringstream emptyInput;
-    int returnCode = cmd.execute(emptyInput, std::cout, std::cerr);
+    CommandResult result = cmd.execute(emptyInput, std::cout, std::cerr);
+    int returnCode = result.code();
+    handleControl(result);
+
+    // Обновляем переменную $?
+    env_.set("?", std::to_string(returnCode));
+
+    return returnCode;
+}
+
+int Executor::executePipeline(Pipeline& pipeline) {
+    const size_t count = pipeline.size();
+
+    bool cooperative = true;
+    for (size_t i = 0; i < count && cooperative; ++i) {
+        cooperative = pipeline.getCommand(i).asStage() != nullptr;
+    }
+    if (cooperative) {
+        return executeStages(pipeline);
+    }
+
+    // Стадии исполняются одновременно, каждая в своём потоке; соседние
+    // связаны каналом StreamPipe
+    std::vector<std::unique_ptr<StreamPipe>> pipes;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        pipes.push_back(std::make_unique<StreamPipe>());
+    }
+    std::vector<CommandResult> results(count);
+
+    auto runStage = [&](size_t i) {
+        runBuiltinStage(pipeline.getCommand(i), i > 0 ? pipes[i - 1].get() : nullptr,
+                        i + 1 < count ? pipes[i].get() : nullptr, results[i]);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        threads.emplace_back(runStage, i);
+    }
+    runStage(count - 1);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::cout.flush();
+    return finishPipeline(results);
+}
+
+int Executor::executeStages(Pipeline& pipeline) {
+    const size_t count = pipeline.size();
+    std::vector<StageChannel> channels(count + 1);
+    std::deque<StageIO> io;
+    std::vector<StageTask> stages;
+    stages.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        io.emplace_back(channels[i], channels[i + 1], std::cerr);
+        stages.push_back(pipeline.getCommand(i).asStage()->stage(io.back()));
+    }
+
+    std::vector<CommandResult> results = runStages(stages, channels, nullptr, std::cout, std::cerr);
+    std::cout.flush();
+    return finishPipeline(results);
+}
 
-    // Проверяем, была ли это команда exit
-    if (auto* exitCmd = dynamic_cast<ExitCommand*>(&cmd)) {
-        if (exitCmd->wasExitRequested()) {
-            exitRequested_ = true;
-            exitCode_ = exitCmd->getExitCode();
+int Executor::finishPipeline(const std::vector<CommandResult>& results) {
+    // Первый управляющий сигнал по порядку стадий
+    for (const auto& result : results) {
+        if (handleControl(result)) {
+            break;
         }
     }
 
+    int returnCode = results.back().code();
+
     // Обновляем переменную $?
     env_.set("?", std::to_string(returnCode));
 
     return returnCode;
 }
 
-int Executor::executePipeline(Pipeline& pipeline) {
-    int returnCode = 0;
+#ifdef __linux__
 
-    // Буфер для передачи данных между командами
-    std::stringstream buffer;
+int Executor::executeWithReactor(Pipeline& pipeline) {
+    Reactor reactor;
+    if (!reactor.valid()) {
+        return pipeline.size() == 1 ? executeSingleCommand(pipeline.getCommand(0))
+                                    : executePipeline(pipeline);
+    }
+    ignoreSigpipe();
 
-    for (size_t i = 0; i < pipeline.size(); ++i) {
-        Command& cmd = pipeline.getCommand(i);
+    const size_t count = pipeline.size();
+    std::vector<ExternalCommand*> external(count);
+    for (size_t i = 0; i < count; ++i) {
+        external[i] = pipeline.getCommand(i).asExternal();
+    }
 
-        // Входной поток — результат предыдущей команды
-        std::istringstream inputStream(buffer.str());
-        buffer.str("");
-        buffer.clear();
+    // Между двумя программами — канал ядра без пересылки; StreamPipe
+    // нужен, только если с одной из сторон встроенная команда
+    std::vector<std::unique_ptr<StreamPipe>> pipes(count - 1);
+    for (size_t i = 0; i + 1 < count; ++i) {
+        if (external[i] == nullptr || external[i + 1] == nullptr) {
+            pipes[i] = std::make_unique<StreamPipe>();
+        }
+    }
+
+    std::vector<CommandResult> results(count);
+    std::vector<SpawnedProcess> processes(count);
+    LoopState loop{reactor};
+    std::vector<std::unique_ptr<Relay>> relays;
 
-        // Определяем выходной поток
-        if (i == pipeline.size() - 1) {
-            // Последняя команда — пишем в stdout
-            returnCode = cmd.execute(inputStream, std::cout, std::cerr);
+    // Программы запускаются из этого потока; их каналы и pidfd
+    // обслуживает цикл событий
+    int nextInput = -1;
+    for (size_t i = 0; i < count; ++i) {
+        if (external[i] == nullptr) {
+            continue;
+        }
+        int input = -1;
+        int output = -1;
+        int fds[2];
+        if (i == 0) {
+            input = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        } else if (external[i - 1] != nullptr) {
+            input = nextInput;
+            nextInput = -1;
+        } else if (openPipe(fds)) {
+            relays.push_back(std::make_unique<PipeToProgram>(loop, *pipes[i - 1], fds[1]));
+            input = fds[0];
+        }
+        if (openPipe(fds)) {
+            output = fds[1];
+            if (i + 1 == count) {
+                relays.push_back(std::make_unique<ProgramToStream>(loop, fds[0], std::cout));
+            } else if (external[i + 1] != nullptr) {
+                nextInput = fds[0];
+            } else {
+                relays.push_back(std::make_unique<ProgramToPipe>(loop, fds[0], *pipes[i]));
+            }
+        }
+
+        int failureCode = 1;
+        if (input < 0 || output < 0) {
+            std::cerr << external[i]->getName() << ": pipe creation failed\n";
         } else {
-            // Промежуточная команда — пишем в буфер
-            returnCode = cmd.execute(inputStream, buffer, std::cerr);
+            processes[i] = external[i]->start(input, output, std::cerr, failureCode);
         }
+        // Концы программы закрыты и при ошибке запуска: соседи получат EOF или EPIPE
+        for (int fd : {input, output}) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+        if (processes[i].pid < 0) {
+            results[i] = failureCode;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        SpawnedProcess& process = processes[i];
+        if (process.pid < 0) {
+            continue;
+        }
+        if (process.pidfd < 0) {
+            process.pidfd = openPidfd(process.pid);
+        }
+        ++loop.pending;
+        bool watched = process.pidfd >= 0 &&
+                       reactor.add(process.pidfd, Reactor::kReadable, [&, i](uint32_t) {
+                           reactor.remove(processes[i].pidfd);
+                           results[i] = waitProcess(processes[i].pid, processes[i].pidfd);
+                           processes[i] = SpawnedProcess{};
+                           loop.finished();
+                       });
+        if (!watched) {
+            --loop.pending;  // дождёмся после цикла
+        }
+    }
+    for (auto& relay : relays) {
+        relay->start();
+    }
 
-        // Проверяем команду exit
-        if (auto* exitCmd = dynamic_cast<ExitCommand*>(&cmd)) {
-            if (exitCmd->wasExitRequested()) {
-                exitRequested_ = true;
-                exitCode_ = exitCmd->getExitCode();
-                break;
+    // Ctrl-C: программы в пайплайне получают SIGINT и от shell, даже
+    // если терминала нет (Interrupt::request)
+    if (loop.pending > 0) {
+        reactor.add(Interrupt::fd(), Reactor::kReadable, [&](uint32_t) {
+            reactor.remove(Interrupt::fd());
+            for (const auto& process : processes) {
+                if (process.pid > 0) {
+                    kill(process.pid, SIGINT);
+                }
             }
+        });
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < count; ++i) {
+        if (external[i] == nullptr) {
+            threads.emplace_back(runBuiltinStage, std::ref(pipeline.getCommand(i)),
+                                 i > 0 ? pipes[i - 1].get() : nullptr,
+                                 i + 1 < count ? pipes[i].get() : nullptr, std::ref(results[i]));
         }
     }
 
-    // Обновляем переменную $?
-    env_.set("?", std::to_string(returnCode));
+    reactor.run();
 
-    return returnCode;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (processes[i].pid > 0) {
+            results[i] = waitProcess(processes[i].pid, processes[i].pidfd);
+        }
+    }
+    relays.clear();
+    std::cout.flush();
+    return finishPipeline(results);
 }
 
+#endif  // __linux__
+
 }  // namespace shell
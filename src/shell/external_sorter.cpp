@@ -0,0 +1,854 @@
+#include "shell/external_sorter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "shell/thread_pool.hpp"
+
+namespace shell {
+
+namespace {
+
+// Сколько кусков сливается за один проход; больше — предварительное слияние группами
+constexpr size_t kFanIn = 64;
+// Диапазоны меньше этого сортируются сравнением, а не поразрядно
+constexpr size_t kRadixThreshold = 64;
+// Глубже этого смещения в ключе поразрядная сортировка не продолжается
+constexpr size_t kMaxRadixDepth = 4096;
+constexpr size_t kMinChunk = 64 * 1024;
+constexpr size_t kMaxChunk = 256 * 1024 * 1024;
+constexpr size_t kWriteBuffer = 1024 * 1024;
+constexpr size_t kReadBuffer = 256 * 1024;
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+/**
+ * Строка куска: префикс ключа, смещение и длина (без '\n')
+ */
+struct Record {
+    uint64_t prefix;
+    uint32_t offset;
+    uint32_t length;
+};
+
+/**
+ * Разобранное число для -n: цифры целой части без ведущих нулей,
+ * дробной — без завершающих
+ */
+struct Number {
+    bool negative = false;
+    std::string_view integer;
+    std::string_view fraction;
+};
+
+Number parseNumber(std::string_view text) {
+    Number number;
+    size_t pos = 0;
+    while (pos < text.size() && isBlank(text[pos])) {
+        ++pos;
+    }
+    if (pos < text.size() && text[pos] == '-') {
+        number.negative = true;
+        ++pos;
+    }
+    while (pos < text.size() && text[pos] == '0') {
+        ++pos;
+    }
+    size_t start = pos;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+        ++pos;
+    }
+    number.integer = text.substr(start, pos - start);
+    if (pos < text.size() && text[pos] == '.') {
+        start = ++pos;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            ++pos;
+        }
+        size_t end = pos;
+        while (end > start && text[end - 1] == '0') {
+            --end;
+        }
+        number.fraction = text.substr(start, end - start);
+    }
+    // -0 и «не число» равны нулю
+    if (number.integer.empty() && number.fraction.empty()) {
+        number.negative = false;
+    }
+    return number;
+}
+
+int compareBytes(std::string_view a, std::string_view b) {
+    int c = std::memcmp(a.data(), b.data(), std::min(a.size(), b.size()));
+    if (c != 0) {
+        return c;
+    }
+    return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+}
+
+// Первые 8 байт ключа (big-endian, дополнение нулями) — монотонны относительно memcmp
+uint64_t bytePrefix(std::string_view key) {
+    uint64_t prefix = 0;
+    size_t n = std::min<size_t>(key.size(), 8);
+    for (size_t i = 0; i < 8; ++i) {
+        prefix <<= 8;
+        if (i < n) {
+            prefix |= static_cast<unsigned char>(key[i]);
+        }
+    }
+    return prefix;
+}
+
+// Старший бит — знак, далее длина целой части (8 бит) и первые 13 цифр по 4 бита;
+// у отрицательных чисел биты модуля инвертируются
+uint64_t numericPrefix(std::string_view key) {
+    Number number = parseNumber(key);
+    uint64_t magnitude = 0;
+    if (number.integer.size() < 255) {
+        magnitude = static_cast<uint64_t>(number.integer.size()) << 52;
+        size_t digit = 0;
+        for (std::string_view part : {number.integer, number.fraction}) {
+            for (size_t i = 0; i < part.size() && digit < 13; ++i, ++digit) {
+                magnitude |= static_cast<uint64_t>(part[i] - '0') << (48 - 4 * digit);
+            }
+        }
+    } else {
+        // Слишком длинные числа различаются только полным сравнением
+        magnitude = uint64_t{255} << 52;
+    }
+    uint64_t sign = uint64_t{1} << 63;
+    return number.negative ? ~(sign | magnitude) : (sign | magnitude);
+}
+
+// Что делать с группой строк, у которых совпал весь 8-байтный префикс
+enum class Rekey {
+    kContinue,  ///< Префиксы заменены следующими байтами ключа
+    kDone,      ///< Ключи равны, порядок ввода сохраняется
+    kSort,      ///< Нужна сортировка сравнением
+};
+
+/**
+ * Поразрядная сортировка (MSD) по байтам префикса. Распределение по
+ * корзинам устойчиво; малые диапазоны упорядочиваются сравнением. Когда
+ * префикс исчерпан, rekey может заменить его следующими байтами ключа.
+ */
+template <typename Less, typename RekeyFn>
+void radixSort(Record* data, Record* scratch, size_t n, size_t byte, size_t offset,
+               const Less& less, const RekeyFn& rekey) {
+    while (true) {
+        if (n < kRadixThreshold) {
+            std::sort(data, data + n, less);
+            return;
+        }
+        if (byte == 8) {
+            offset += 8;
+            Rekey next = offset <= kMaxRadixDepth ? rekey(data, n, offset) : Rekey::kSort;
+            if (next == Rekey::kSort) {
+                std::sort(data, data + n, less);
+            }
+            if (next != Rekey::kContinue) {
+                return;
+            }
+            byte = 0;
+        }
+
+        const size_t shift = 56 - 8 * byte;
+        uint32_t ends[256] = {};
+        for (size_t i = 0; i < n; ++i) {
+            ends[(data[i].prefix >> shift) & 0xFF]++;
+        }
+        if (std::find(std::begin(ends), std::end(ends), n) != std::end(ends)) {
+            ++byte;
+            continue;
+        }
+
+        uint32_t sum = 0;
+        for (auto& end : ends) {
+            uint32_t count = end;
+            end = sum;
+            sum += count;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            scratch[ends[(data[i].prefix >> shift) & 0xFF]++] = data[i];
+        }
+        std::copy(scratch, scratch + n, data);
+
+        // После распределения ends[b] — конец корзины b
+        uint32_t start = 0;
+        for (uint32_t end : ends) {
+            if (end - start > 1) {
+                radixSort(data + start, scratch + start, end - start, byte + 1, offset, less,
+                          rekey);
+            }
+            start = end;
+        }
+        return;
+    }
+}
+
+bool writeAll(int fd, const char* data, size_t size, std::string& error) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = std::string("write failed: ") + std::strerror(errno);
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// Временный файл удаляется сразу: он живёт, пока открыт дескриптор
+int createTempFile(const std::string& dir, std::string& error) {
+    std::string path = dir + "/shell-sort-XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    int fd = mkstemp(name.data());
+    if (fd < 0) {
+        error = "cannot create temporary file in '" + dir + "': " + std::strerror(errno);
+        return -1;
+    }
+    unlink(name.data());
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    return fd;
+}
+
+/**
+ * Буферизованная запись строк во временный файл
+ */
+class FileSink {
+public:
+    FileSink(int fd, std::string& error) : fd_(fd), error_(error) {
+        buffer_.reserve(kWriteBuffer);
+    }
+
+    bool put(std::string_view line) {
+        buffer_.append(line);
+        buffer_ += '\n';
+        return buffer_.size() < kWriteBuffer || flush();
+    }
+
+    bool flush() {
+        bool ok = writeAll(fd_, buffer_.data(), buffer_.size(), error_);
+        buffer_.clear();
+        return ok;
+    }
+
+private:
+    int fd_;
+    std::string& error_;
+    std::string buffer_;
+};
+
+/**
+ * Буферизованный вывод строк в поток
+ */
+class StreamSink {
+public:
+    explicit StreamSink(std::ostream& out) : out_(out) {
+        buffer_.reserve(kWriteBuffer);
+    }
+
+    bool put(std::string_view line) {
+        buffer_.append(line);
+        buffer_ += '\n';
+        return buffer_.size() < kWriteBuffer || flush();
+    }
+
+    bool flush() {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+        // Вывод больше не принимается (следующая стадия пайплайна завершилась)
+        return static_cast<bool>(out_);
+    }
+
+private:
+    std::ostream& out_;
+    std::string buffer_;
+};
+
+}  // namespace
+
+/**
+ * Отсортированный кусок: в памяти (data + records) или во временном файле
+ */
+struct ExternalSorter::Run {
+    std::string data;
+    std::vector<Record> records;
+    int fd = -1;
+    std::string error;
+
+    ~Run() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+namespace {
+
+using Run = ExternalSorter::Run;
+
+std::unique_ptr<Run> sortChunk(std::string data, const LineComparator& comparator, bool unique) {
+    auto run = std::make_unique<Run>();
+    run->data = std::move(data);
+    const char* base = run->data.data();
+    size_t size = run->data.size();
+
+    size_t pos = 0;
+    while (pos < size) {
+        const void* newline = std::memchr(base + pos, '\n', size - pos);
+        size_t end = newline != nullptr
+                         ? static_cast<size_t>(static_cast<const char*>(newline) - base)
+                         : size;
+        std::string_view line(base + pos, end - pos);
+        run->records.push_back({comparator.prefix(line), static_cast<uint32_t>(pos),
+                                static_cast<uint32_t>(end - pos)});
+        pos = end + 1;
+    }
+
+    auto view = [base](const Record& r) { return std::string_view(base + r.offset, r.length); };
+    // Равные строки остаются в порядке ввода: для -u выводится первая из них
+    auto less = [&](const Record& a, const Record& b) {
+        if (a.prefix != b.prefix) {
+            return a.prefix < b.prefix;
+        }
+        int c = comparator.compare(view(a), view(b));
+        return c != 0 ? c < 0 : a.offset < b.offset;
+    };
+    // Если порядок задаётся только байтами ключа, сортировка продолжается по следующим байтам
+    auto rekey = [&](Record* records, size_t n, size_t offset) {
+        if (!comparator.bytesDecide()) {
+            return Rekey::kSort;
+        }
+        bool longer = false;
+        bool sameLength = true;
+        size_t length = comparator.firstKey(view(records[0])).size();
+        for (size_t i = 0; i < n; ++i) {
+            std::string_view line = view(records[i]);
+            size_t keySize = comparator.firstKey(line).size();
+            longer = longer || keySize > offset;
+            sameLength = sameLength && keySize == length;
+            records[i].prefix = comparator.prefix(line, offset);
+        }
+        if (longer) {
+            return Rekey::kContinue;
+        }
+        return sameLength ? Rekey::kDone : Rekey::kSort;
+    };
+    std::vector<Record> scratch(run->records.size());
+    radixSort(run->records.data(), scratch.data(), run->records.size(), 0, 0, less, rekey);
+
+    if (unique && !run->records.empty()) {
+        size_t kept = 1;
+        for (size_t i = 1; i < run->records.size(); ++i) {
+            if (comparator.compare(view(run->records[kept - 1]), view(run->records[i])) != 0) {
+                run->records[kept++] = run->records[i];
+            }
+        }
+        run->records.resize(kept);
+    }
+    return run;
+}
+
+// Записать кусок из памяти во временный файл
+bool spillRun(Run& run, const std::string& tempDir) {
+    int fd = createTempFile(tempDir, run.error);
+    if (fd < 0) {
+        return false;
+    }
+    run.fd = fd;
+    FileSink sink(fd, run.error);
+    for (const Record& record : run.records) {
+        if (!sink.put(std::string_view(run.data.data() + record.offset, record.length))) {
+            return false;
+        }
+    }
+    if (!sink.flush()) {
+        return false;
+    }
+    run.data = std::string();
+    run.records = std::vector<Record>();
+    return true;
+}
+
+/**
+ * Текущая строка куска при слиянии
+ */
+class Cursor {
+public:
+    Cursor(const Run& run, const LineComparator& comparator)
+        : run_(run), comparator_(comparator) {
+        if (run_.fd >= 0) {
+            buffer_.resize(kReadBuffer);
+        }
+    }
+
+    bool valid() const {
+        return valid_;
+    }
+
+    std::string_view line() const {
+        return line_;
+    }
+
+    uint64_t prefix() const {
+        return prefix_;
+    }
+
+    const std::string& error() const {
+        return error_;
+    }
+
+    // Перейти к следующей строке; false — строки кончились или ошибка чтения
+    bool next() {
+        valid_ = run_.fd >= 0 ? nextFromFile() : nextFromMemory();
+        if (valid_) {
+            prefix_ = comparator_.prefix(line_);
+        }
+        return valid_;
+    }
+
+private:
+    const Run& run_;
+    const LineComparator& comparator_;
+    std::string_view line_;
+    uint64_t prefix_ = 0;
+    bool valid_ = false;
+    size_t index_ = 0;
+    std::string buffer_;
+    size_t begin_ = 0;
+    size_t filled_ = 0;
+    off_t offset_ = 0;
+    bool eof_ = false;
+    std::string error_;
+
+    bool nextFromMemory() {
+        if (index_ >= run_.records.size()) {
+            return false;
+        }
+        const Record& record = run_.records[index_++];
+        line_ = std::string_view(run_.data.data() + record.offset, record.length);
+        return true;
+    }
+
+    bool nextFromFile() {
+        while (true) {
+            const void* newline = std::memchr(buffer_.data() + begin_, '\n', filled_ - begin_);
+            if (newline != nullptr) {
+                auto end = static_cast<size_t>(static_cast<const char*>(newline) - buffer_.data());
+                line_ = std::string_view(buffer_.data() + begin_, end - begin_);
+                begin_ = end + 1;
+                return true;
+            }
+            if (eof_) {
+                return false;
+            }
+            // Неполная строка переносится в начало; если она заполняет буфер — он растёт
+            std::memmove(&buffer_[0], buffer_.data() + begin_, filled_ - begin_);
+            filled_ -= begin_;
+            begin_ = 0;
+            if (filled_ == buffer_.size()) {
+                buffer_.resize(buffer_.size() * 2);
+            }
+            ssize_t bytesRead =
+                pread(run_.fd, &buffer_[filled_], buffer_.size() - filled_, offset_);
+            if (bytesRead < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error_ = std::string("read failed: ") + std::strerror(errno);
+                return false;
+            }
+            if (bytesRead == 0) {
+                eof_ = true;
+            }
+            filled_ += static_cast<size_t>(bytesRead);
+            offset_ += bytesRead;
+        }
+    }
+};
+
+/**
+ * Многопутевое слияние на дереве проигравших: во внутренних узлах хранятся
+ * проигравшие, в tree_[0] — победитель; после продвижения победителя
+ * пересчитывается только путь от его листа к корню (log k сравнений).
+ * При равенстве побеждает кусок с меньшим номером — слияние устойчиво.
+ */
+template <typename Sink>
+bool mergeRuns(const std::vector<std::unique_ptr<Run>>& runs, size_t count,
+               const LineComparator& comparator, bool unique, Sink& sink, std::string& error) {
+    std::vector<Cursor> cursors;
+    cursors.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        cursors.emplace_back(*runs[i], comparator);
+        cursors.back().next();
+    }
+
+    auto less = [&](size_t a, size_t b) {
+        if (!cursors[a].valid()) {
+            return false;
+        }
+        if (!cursors[b].valid()) {
+            return true;
+        }
+        if (cursors[a].prefix() != cursors[b].prefix()) {
+            return cursors[a].prefix() < cursors[b].prefix();
+        }
+        int c = comparator.compare(cursors[a].line(), cursors[b].line());
+        return c != 0 ? c < 0 : a < b;
+    };
+
+    std::vector<size_t> tree(count);
+    std::vector<size_t> winners(2 * count);
+    for (size_t i = 0; i < count; ++i) {
+        winners[count + i] = i;
+    }
+    for (size_t node = count - 1; node >= 1; --node) {
+        size_t left = winners[2 * node];
+        size_t right = winners[2 * node + 1];
+        bool leftWins = less(left, right);
+        winners[node] = leftWins ? left : right;
+        tree[node] = leftWins ? right : left;
+    }
+    tree[0] = count > 1 ? winners[1] : 0;
+
+    std::string last;
+    bool haveLast = false;
+    while (cursors[tree[0]].valid()) {
+        size_t winner = tree[0];
+        std::string_view line = cursors[winner].line();
+        if (!unique || !haveLast || comparator.compare(last, line) != 0) {
+            if (!sink.put(line)) {
+                return false;
+            }
+            if (unique) {
+                last.assign(line);
+                haveLast = true;
+            }
+        }
+
+        if (!cursors[winner].next() && !cursors[winner].error().empty()) {
+            error = cursors[winner].error();
+            return false;
+        }
+        for (size_t node = (winner + count) / 2; node > 0; node /= 2) {
+            if (less(tree[node], winner)) {
+                std::swap(tree[node], winner);
+            }
+        }
+        tree[0] = winner;
+    }
+    return sink.flush();
+}
+
+}  // namespace
+
+LineComparator::LineComparator(const SortOptions& options)
+    : keys_(options.keys),
+      separator_(options.separator),
+      hasSeparator_(options.hasSeparator),
+      reverse_(options.reverse) {
+    // Ключ без собственных флагов наследует глобальные -n и -r
+    for (auto& key : keys_) {
+        if (!key.numeric && !key.reverse) {
+            key.numeric = options.numeric;
+            key.reverse = options.reverse;
+        }
+    }
+    bool wholeLine = keys_.empty();
+    if (wholeLine) {
+        SortKey key;
+        key.numeric = options.numeric;
+        key.reverse = options.reverse;
+        keys_.push_back(key);
+    }
+    // Для ключа «вся строка» без -n полное сравнение ничего не добавляет
+    lastResort_ = !options.unique && !(wholeLine && !options.numeric);
+}
+
+int LineComparator::compare(std::string_view a, std::string_view b) const {
+    for (const auto& key : keys_) {
+        std::string_view ka = extract(a, key);
+        std::string_view kb = extract(b, key);
+        int c = key.numeric ? compareNumeric(ka, kb) : compareBytes(ka, kb);
+        if (c != 0) {
+            return key.reverse ? -c : c;
+        }
+    }
+    if (!lastResort_) {
+        return 0;
+    }
+    int c = compareBytes(a, b);
+    return reverse_ ? -c : c;
+}
+
+uint64_t LineComparator::prefix(std::string_view line, size_t offset) const {
+    const SortKey& key = keys_.front();
+    std::string_view text = extract(line, key);
+    uint64_t prefix = 0;
+    if (key.numeric) {
+        prefix = numericPrefix(text);
+    } else {
+        prefix = bytePrefix(offset < text.size() ? text.substr(offset) : std::string_view());
+    }
+    return key.reverse ? ~prefix : prefix;
+}
+
+std::string_view LineComparator::firstKey(std::string_view line) const {
+    return extract(line, keys_.front());
+}
+
+bool LineComparator::bytesDecide() const {
+    return keys_.size() == 1 && !keys_.front().numeric && !lastResort_;
+}
+
+int LineComparator::compareNumeric(std::string_view a, std::string_view b) {
+    Number x = parseNumber(a);
+    Number y = parseNumber(b);
+    if (x.negative != y.negative) {
+        return x.negative ? -1 : 1;
+    }
+
+    int c = 0;
+    if (x.integer.size() != y.integer.size()) {
+        c = x.integer.size() < y.integer.size() ? -1 : 1;
+    } else {
+        c = x.integer.compare(y.integer);
+        if (c == 0) {
+            c = x.fraction.compare(y.fraction);
+        }
+    }
+    c = c < 0 ? -1 : (c > 0 ? 1 : 0);
+    return x.negative ? -c : c;
+}
+
+std::string_view LineComparator::extract(std::string_view line, const SortKey& key) const {
+    const char* begin = line.data();
+    const char* end = begin + line.size();
+    if (key.startField == 1 && key.startChar == 0 && key.endField == 0) {
+        return line;
+    }
+
+    const char* start = fieldStart(begin, end, key.startField);
+    if (key.startChar > 0) {
+        start += std::min(key.startChar - 1, static_cast<size_t>(end - start));
+    }
+
+    const char* finish = end;
+    if (key.endField > 0) {
+        const char* field = fieldStart(begin, end, key.endField);
+        finish = key.endChar == 0 ? fieldEnd(field, end)
+                                  : field + std::min(key.endChar, static_cast<size_t>(end - field));
+    }
+    if (finish < start) {
+        finish = start;
+    }
+    return std::string_view(start, static_cast<size_t>(finish - start));
+}
+
+const char* LineComparator::fieldStart(const char* begin, const char* end, size_t field) const {
+    const char* pos = begin;
+    for (size_t i = 1; i < field && pos < end; ++i) {
+        if (hasSeparator_) {
+            const void* next = std::memchr(pos, separator_, static_cast<size_t>(end - pos));
+            pos = next != nullptr ? static_cast<const char*>(next) + 1 : end;
+        } else {
+            pos = fieldEnd(pos, end);
+        }
+    }
+    return pos;
+}
+
+const char* LineComparator::fieldEnd(const char* pos, const char* end) const {
+    if (hasSeparator_) {
+        const void* next = std::memchr(pos, separator_, static_cast<size_t>(end - pos));
+        return next != nullptr ? static_cast<const char*>(next) : end;
+    }
+    while (pos < end && isBlank(*pos)) {
+        ++pos;
+    }
+    while (pos < end && !isBlank(*pos)) {
+        ++pos;
+    }
+    return pos;
+}
+
+ExternalSorter::ExternalSorter(const SortOptions& options, size_t memoryBudget, std::string tempDir,
+                               ThreadPool& pool, size_t chunkSize)
+    : comparator_(options),
+      unique_(options.unique),
+      memoryBudget_(memoryBudget),
+      tempDir_(std::move(tempDir)),
+      pool_(pool),
+      chunkSize_(chunkSize != 0 ? chunkSize : chunkSizeFor(memoryBudget, pool.size())) {}
+
+ExternalSorter::~ExternalSorter() {
+    // Незавершённые задачи ссылаются на comparator_
+    for (auto& pending : pending_) {
+        pending.wait();
+    }
+}
+
+size_t ExternalSorter::chunkSizeFor(size_t memoryBudget, size_t threads) {
+    // Данные и индекс занимают примерно вдвое больше входа; в работе — threads + 1 кусков
+    size_t chunk = memoryBudget / (2 * (threads + 1));
+    return std::clamp(chunk, kMinChunk, kMaxChunk);
+}
+
+bool ExternalSorter::write(const char* data, size_t size) {
+    while (size > 0 && error_.empty()) {
+        if (current_.capacity() < chunkSize_) {
+            current_.reserve(chunkSize_);
+        }
+        size_t room = current_.size() < chunkSize_ ? chunkSize_ - current_.size() : kMinChunk;
+        size_t take = std::min(size, room);
+        current_.append(data, take);
+        data += take;
+        size -= take;
+
+        if (current_.size() >= chunkSize_) {
+            // Кусок режется по последней целой строке; строка длиннее куска растит его
+            size_t cut = current_.rfind('\n');
+            if (cut == std::string::npos) {
+                continue;
+            }
+            std::string rest(current_, cut + 1);
+            current_.resize(cut + 1);
+            if (!dispatch(std::move(current_))) {
+                return false;
+            }
+            current_ = std::move(rest);
+        }
+    }
+    return error_.empty();
+}
+
+bool ExternalSorter::finish(std::ostream& out) {
+    if (!current_.empty() && !dispatch(std::move(current_))) {
+        return false;
+    }
+    current_ = std::string();
+    while (!pending_.empty()) {
+        auto run = pending_.front().get();
+        pending_.pop_front();
+        if (!collect(std::move(run))) {
+            return false;
+        }
+    }
+
+    while (runs_.size() > kFanIn) {
+        if (!mergeFileRuns(kFanIn)) {
+            return false;
+        }
+    }
+    if (runs_.empty()) {
+        return true;
+    }
+
+    StreamSink sink(out);
+    bool ok = mergeRuns(runs_, runs_.size(), comparator_, unique_, sink, error_);
+    runs_.clear();
+    // Остановка из-за закрытого вывода ошибкой не считается
+    return ok || error_.empty();
+}
+
+bool ExternalSorter::dispatch(std::string chunk) {
+    if (chunk.size() > UINT32_MAX) {
+        error_ = "line too long";
+        return false;
+    }
+
+    // В работе не больше threads + 1 кусков — память ограничена
+    while (pending_.size() > pool_.size()) {
+        auto run = pending_.front().get();
+        pending_.pop_front();
+        if (!collect(std::move(run))) {
+            return false;
+        }
+    }
+
+    bytesQueued_ += chunk.size();
+    if (!spilling_ && bytesQueued_ * 2 > memoryBudget_ && !startSpilling()) {
+        return false;
+    }
+
+    bool spill = spilling_;
+    pending_.push_back(pool_.submit([this, spill, data = std::move(chunk)]() mutable {
+        auto run = sortChunk(std::move(data), comparator_, unique_);
+        if (spill) {
+            spillRun(*run, tempDir_);
+        }
+        return run;
+    }));
+    return true;
+}
+
+bool ExternalSorter::collect(std::unique_ptr<Run> run) {
+    if (!run->error.empty()) {
+        error_ = run->error;
+        return false;
+    }
+    if (run->fd >= 0) {
+        spilled_++;
+    }
+    runs_.push_back(std::move(run));
+    // Открытых временных файлов не больше 2 * kFanIn
+    if (runs_.size() >= 2 * kFanIn && runs_.front()->fd >= 0) {
+        return mergeFileRuns(kFanIn);
+    }
+    return true;
+}
+
+bool ExternalSorter::startSpilling() {
+    spilling_ = true;
+    while (!pending_.empty()) {
+        auto run = pending_.front().get();
+        pending_.pop_front();
+        if (!run->error.empty()) {
+            error_ = run->error;
+            return false;
+        }
+        runs_.push_back(std::move(run));
+    }
+    // Всё, что уже отсортировано в памяти, уходит на диск: дальше все куски — файлы
+    for (auto& run : runs_) {
+        if (run->fd < 0) {
+            if (!spillRun(*run, tempDir_)) {
+                error_ = run->error;
+                return false;
+            }
+            spilled_++;
+        }
+    }
+    return true;
+}
+
+bool ExternalSorter::mergeFileRuns(size_t count) {
+    auto merged = std::make_unique<Run>();
+    merged->fd = createTempFile(tempDir_, error_);
+    if (merged->fd < 0) {
+        return false;
+    }
+    FileSink sink(merged->fd, error_);
+    if (!mergeRuns(runs_, count, comparator_, unique_, sink, error_)) {
+        return false;
+    }
+    // Слитые куски шли подряд с начала — результат занимает их место
+    runs_.erase(runs_.begin(), runs_.begin() + static_cast<std::ptrdiff_t>(count));
+    runs_.insert(runs_.begin(), std::move(merged));
+    return true;
+}
+
+}  // namespace shell
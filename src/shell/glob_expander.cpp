@@ -0,0 +1,344 @@
+#include "shell/glob_expander.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace shell {
+
+namespace {
+
+// Листинг моложе этого интервала относительно mtime каталога перечитывается
+constexpr int64_t kRacyWindowNs = 1000000000;
+
+// Предел кэша: при превышении кэш очищается целиком
+constexpr size_t kMaxCachedDirectories = 4096;
+
+int64_t modificationTime(const struct stat& st) {
+#ifdef __APPLE__
+    return static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+}
+
+int64_t currentTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+// Разбор класса [...] с позиции '['; end — позиция после ']'
+bool parseClass(std::string_view pattern, size_t start, std::bitset<256>& set, size_t& end) {
+    size_t i = start + 1;
+    bool negate = i < pattern.size() && (pattern[i] == '!' || pattern[i] == '^');
+    if (negate) {
+        ++i;
+    }
+    bool first = true;
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        if (c == ']' && !first) {
+            if (negate) {
+                set.flip();
+            }
+            end = i + 1;
+            return true;
+        }
+        first = false;
+        if (c == '\\' && i + 1 < pattern.size()) {
+            c = pattern[++i];
+        }
+        ++i;
+        auto low = static_cast<unsigned char>(c);
+        auto high = low;
+        if (i + 1 < pattern.size() && pattern[i] == '-' && pattern[i + 1] != ']') {
+            size_t next = i + 1;
+            if (pattern[next] == '\\' && next + 1 < pattern.size()) {
+                ++next;
+            }
+            high = static_cast<unsigned char>(pattern[next]);
+            i = next + 1;
+        }
+        for (unsigned value = low; value <= high; ++value) {
+            set.set(value);
+        }
+    }
+    return false;
+}
+
+bool isAssignmentWord(std::string_view word) {
+    size_t eq = word.find('=');
+    if (eq == std::string_view::npos || eq == 0 || (word[0] >= '0' && word[0] <= '9')) {
+        return false;
+    }
+    return std::all_of(word.begin(), word.begin() + static_cast<std::ptrdiff_t>(eq), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+               c == '_';
+    });
+}
+
+}  // namespace
+
+GlobPattern::GlobPattern(std::string_view pattern) {
+    for (size_t i = 0; i < pattern.size();) {
+        char c = pattern[i];
+        if (c == '*') {
+            if (elements_.empty() || elements_.back().kind != Kind::kStar) {
+                elements_.push_back({Kind::kStar, {}, {}});
+            }
+            literal_ = false;
+            ++i;
+            continue;
+        }
+        if (c == '?') {
+            elements_.push_back({Kind::kAny, {}, {}});
+            literal_ = false;
+            ++i;
+            continue;
+        }
+        if (c == '[') {
+            Element element{Kind::kClass, {}, {}};
+            size_t end = 0;
+            if (parseClass(pattern, i, element.set, end)) {
+                elements_.push_back(std::move(element));
+                literal_ = false;
+                i = end;
+                continue;
+            }
+        }
+        if (c == '\\' && i + 1 < pattern.size()) {
+            c = pattern[++i];
+        }
+        appendLiteral(c);
+        ++i;
+    }
+}
+
+void GlobPattern::appendLiteral(char c) {
+    if (elements_.empty() || elements_.back().kind != Kind::kLiteral) {
+        elements_.push_back({Kind::kLiteral, {}, {}});
+    }
+    elements_.back().text += c;
+    if (literal_) {
+        text_ += c;
+    }
+}
+
+bool GlobPattern::matches(std::string_view name) const {
+    // Все элементы, кроме *, фиксированной длины, поэтому достаточно
+    // помнить последнюю * и сдвигать её совпадение на один символ
+    size_t element = 0;
+    size_t pos = 0;
+    size_t starElement = std::string_view::npos;
+    size_t starPos = 0;
+    while (pos < name.size()) {
+        if (element < elements_.size()) {
+            const Element& e = elements_[element];
+            if (e.kind == Kind::kStar) {
+                starElement = ++element;
+                starPos = pos;
+                continue;
+            }
+            bool ok = false;
+            size_t length = 1;
+            if (e.kind == Kind::kLiteral) {
+                length = e.text.size();
+                ok = name.size() - pos >= length &&
+                     std::memcmp(name.data() + pos, e.text.data(), length) == 0;
+            } else {
+                ok = e.kind == Kind::kAny || e.set.test(static_cast<unsigned char>(name[pos]));
+            }
+            if (ok) {
+                pos += length;
+                ++element;
+                continue;
+            }
+        }
+        if (starElement == std::string_view::npos) {
+            return false;
+        }
+        element = starElement;
+        pos = ++starPos;
+    }
+    while (element < elements_.size() && elements_[element].kind == Kind::kStar) {
+        ++element;
+    }
+    return element == elements_.size();
+}
+
+void GlobExpander::expand(std::pmr::vector<Token>& tokens) {
+    bool hasPattern = std::any_of(tokens.begin(), tokens.end(),
+                                  [](const Token& token) { return !token.pattern.empty(); });
+    if (!hasPattern) {
+        return;
+    }
+    beginGeneration();
+
+    std::pmr::memory_resource* resource = tokens.get_allocator().resource();
+    std::pmr::vector<Token> result(resource);
+    result.reserve(tokens.size());
+    bool leading = true;
+    for (auto& token : tokens) {
+        bool assignment = leading && token.type == TokenType::WORD && isAssignmentWord(token.value);
+        leading = assignment;
+        if (assignment || token.pattern.empty()) {
+            result.push_back(std::move(token));
+            continue;
+        }
+        auto paths = expandPattern(token.pattern);
+        if (paths.empty()) {
+            token.pattern.clear();
+            result.push_back(std::move(token));
+            continue;
+        }
+        for (const auto& path : paths) {
+            result.emplace_back(TokenType::WORD, path, resource);
+        }
+    }
+    tokens = std::move(result);
+}
+
+std::vector<std::string> GlobExpander::expandPattern(std::string_view pattern) {
+    if (generation_ == 0) {
+        beginGeneration();
+    }
+    Query query;
+    std::string prefix;
+    if (!pattern.empty() && pattern[0] == '/') {
+        prefix = "/";
+    }
+    query.directoriesOnly = !pattern.empty() && pattern.back() == '/';
+    size_t start = 0;
+    while (start < pattern.size()) {
+        size_t end = pattern.find('/', start);
+        if (end == std::string_view::npos) {
+            end = pattern.size();
+        }
+        if (end > start) {
+            std::string_view text(pattern.data() + start, end - start);
+            query.segments.push_back({GlobPattern(text), text == "**"});
+        }
+        start = end + 1;
+    }
+    if (query.segments.empty()) {
+        return {};
+    }
+
+    walk(query, prefix, 0);
+    // Сортировка один раз для всего слова
+    std::sort(query.matches.begin(), query.matches.end());
+    return std::move(query.matches);
+}
+
+void GlobExpander::beginGeneration() {
+    ++generation_;
+    // Относительные пути в кэше привязаны к текущему каталогу
+    char buffer[4096];
+    std::string cwd = getcwd(buffer, sizeof(buffer)) != nullptr ? buffer : "";
+    if (cwd != cwd_ || cache_.size() > kMaxCachedDirectories) {
+        cache_.clear();
+        cwd_ = std::move(cwd);
+    }
+}
+
+const GlobExpander::Listing* GlobExpander::list(const std::string& prefix) {
+    std::string dir = prefix.empty() ? "." : prefix;
+    auto it = cache_.find(prefix);
+    if (it != cache_.end()) {
+        Listing& listing = it->second;
+        if (listing.generation == generation_) {
+            return listing.ok ? &listing : nullptr;
+        }
+        struct stat st {};
+        if (listing.ok && stat(dir.c_str(), &st) == 0 && modificationTime(st) == listing.mtime &&
+            listing.listedAt - listing.mtime >= kRacyWindowNs) {
+            listing.generation = generation_;
+            return &listing;
+        }
+    }
+
+    Listing& listing = cache_[prefix];
+    listing.entries.clear();
+    listing.generation = generation_;
+    listing.listedAt = currentTime();
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    struct stat st {};
+    listing.ok = fd >= 0 && fstat(fd, &st) == 0 && readDirectory(fd, listing.entries);
+    if (fd >= 0) {
+        close(fd);
+    }
+    listing.mtime = modificationTime(st);
+    return listing.ok ? &listing : nullptr;
+}
+
+void GlobExpander::walk(Query& query, std::string& prefix, size_t index) {
+    size_t length = prefix.size();
+    if (index == query.segments.size()) {
+        // Шаблон с завершающим '/': подходят только каталоги
+        struct stat st {};
+        if (stat(prefix.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+            query.matches.push_back(prefix);
+        }
+        return;
+    }
+    const Segment& segment = query.segments[index];
+    bool last = index + 1 == query.segments.size() && !query.directoriesOnly;
+
+    if (segment.pattern.isLiteral() && !segment.recursive) {
+        // Компонент без метасимволов: каталог не читаем
+        prefix += segment.pattern.text();
+        if (!last) {
+            prefix += '/';
+            walk(query, prefix, index + 1);
+        } else if (struct stat st {}; lstat(prefix.c_str(), &st) == 0) {
+            query.matches.push_back(prefix);
+        }
+        prefix.resize(length);
+        return;
+    }
+
+    if (segment.recursive && !last) {
+        walk(query, prefix, index + 1);
+    }
+    const Listing* listing = list(prefix);
+    if (listing == nullptr) {
+        return;
+    }
+    for (const auto& entry : listing->entries) {
+        if (entry.name[0] == '.' && !segment.pattern.matchesHidden()) {
+            continue;
+        }
+        if (!segment.recursive && !segment.pattern.matches(entry.name)) {
+            continue;
+        }
+        prefix += entry.name;
+        if (last) {
+            query.matches.push_back(prefix);
+        }
+        if (segment.recursive) {
+            // ** спускается только в настоящие каталоги, не по ссылкам
+            bool directory = entry.type == DT_DIR;
+            if (entry.type == DT_UNKNOWN) {
+                struct stat st {};
+                directory = lstat(prefix.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+            }
+            if (directory) {
+                prefix += '/';
+                walk(query, prefix, index);
+            }
+        } else if (!last && (entry.type == DT_DIR || entry.type == DT_LNK ||
+                             entry.type == DT_UNKNOWN)) {
+            prefix += '/';
+            walk(query, prefix, index + 1);
+        }
+        prefix.resize(length);
+    }
+}
+
+}  // namespace shell
@@ -0,0 +1,375 @@
+#include "shell/history.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace shell {
+
+namespace {
+
+// Начало записи, текст которой заканчивается перед contentEnd
+size_t entryStart(std::string_view data, size_t contentEnd) {
+    if (contentEnd == 0) {
+        return 0;
+    }
+    const auto* newline = static_cast<const char*>(memrchr(data.data(), '\n', contentEnd));
+    return newline == nullptr ? 0 : static_cast<size_t>(newline - data.data()) + 1;
+}
+
+/// Пустая ячейка суффиксного массива при индуцированной сортировке
+constexpr uint32_t kEmpty = UINT32_MAX;
+
+/**
+ * Суффиксный массив алгоритмом SA-IS (индуцированная сортировка, O(n)).
+ * Символы s — целые из [0, upper].
+ */
+template <typename Symbols>
+std::vector<uint32_t> suffixArray(const Symbols& s, size_t upper) {
+    const size_t n = s.size();
+    std::vector<uint32_t> sa(n);
+    if (n < 8) {
+        for (size_t i = 0; i < n; ++i) {
+            sa[i] = static_cast<uint32_t>(i);
+        }
+        std::sort(sa.begin(), sa.end(), [&s, n](uint32_t a, uint32_t b) {
+            for (; a < n && b < n; ++a, ++b) {
+                if (s[a] != s[b]) {
+                    return s[a] < s[b];
+                }
+            }
+            return a == n;
+        });
+        return sa;
+    }
+
+    // ls[i]: суффикс i меньше суффикса i + 1 (S-тип)
+    std::vector<bool> ls(n);
+    for (size_t i = n - 1; i-- > 0;) {
+        ls[i] = s[i] == s[i + 1] ? ls[i + 1] : s[i] < s[i + 1];
+    }
+    std::vector<uint32_t> sumL(upper + 1);
+    std::vector<uint32_t> sumS(upper + 1);
+    for (size_t i = 0; i < n; ++i) {
+        if (!ls[i]) {
+            sumS[s[i]]++;
+        } else {
+            sumL[s[i] + 1]++;  // Символ S-типа меньше upper
+        }
+    }
+    for (size_t c = 0; c <= upper; ++c) {
+        sumS[c] += sumL[c];
+        if (c < upper) {
+            sumL[c + 1] += sumS[c];
+        }
+    }
+
+    auto induce = [&](const std::vector<uint32_t>& lms) {
+        std::fill(sa.begin(), sa.end(), kEmpty);
+        std::vector<uint32_t> bucket(sumS);
+        for (uint32_t d : lms) {
+            sa[bucket[s[d]]++] = d;
+        }
+        bucket = sumL;
+        sa[bucket[s[n - 1]]++] = static_cast<uint32_t>(n - 1);
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t v = sa[i];
+            if (v != kEmpty && v >= 1 && !ls[v - 1]) {
+                sa[bucket[s[v - 1]]++] = v - 1;
+            }
+        }
+        bucket = sumL;
+        for (size_t i = n; i-- > 0;) {
+            uint32_t v = sa[i];
+            if (v != kEmpty && v >= 1 && ls[v - 1]) {
+                sa[--bucket[s[v - 1] + 1]] = v - 1;
+            }
+        }
+    };
+
+    std::vector<uint32_t> lmsIndex(n, kEmpty);
+    std::vector<uint32_t> lms;
+    for (size_t i = 1; i < n; ++i) {
+        if (!ls[i - 1] && ls[i]) {
+            lmsIndex[i] = static_cast<uint32_t>(lms.size());
+            lms.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    const size_t m = lms.size();
+
+    induce(lms);
+    if (m == 0) {
+        return sa;
+    }
+
+    // Имена LMS-подстрок и рекурсия по ним
+    std::vector<uint32_t> sortedLms;
+    sortedLms.reserve(m);
+    for (uint32_t v : sa) {
+        if (lmsIndex[v] != kEmpty) {
+            sortedLms.push_back(v);
+        }
+    }
+    std::vector<uint32_t> names(m);
+    uint32_t upperName = 0;
+    names[lmsIndex[sortedLms[0]]] = 0;
+    for (size_t i = 1; i < m; ++i) {
+        size_t l = sortedLms[i - 1];
+        size_t r = sortedLms[i];
+        size_t endL = lmsIndex[l] + 1 < m ? lms[lmsIndex[l] + 1] : n;
+        size_t endR = lmsIndex[r] + 1 < m ? lms[lmsIndex[r] + 1] : n;
+        bool same = endL - l == endR - r;
+        if (same) {
+            while (l < endL && s[l] == s[r]) {
+                ++l;
+                ++r;
+            }
+            same = l != n && r != n && s[l] == s[r];
+        }
+        if (!same) {
+            ++upperName;
+        }
+        names[lmsIndex[sortedLms[i]]] = upperName;
+    }
+
+    std::vector<uint32_t> namesSa = suffixArray(names, upperName);
+    for (size_t i = 0; i < m; ++i) {
+        sortedLms[i] = lms[namesSa[i]];
+    }
+    induce(sortedLms);
+    return sa;
+}
+
+// Байты строки как символы 0..255
+struct ByteSymbols {
+    std::string_view text;
+
+    size_t size() const {
+        return text.size();
+    }
+
+    size_t operator[](size_t i) const {
+        return static_cast<unsigned char>(text[i]);
+    }
+};
+
+}  // namespace
+
+History::History(const std::string& path) : file_(std::make_shared<InputFile>(path)) {
+    if (file_->isOpen() && file_->isRegular()) {
+        mapped_ = file_->map();
+        // Свежую или маленькую историю map() не отображает: читаем её целиком
+        if (mapped_.empty() && file_->size() > 0) {
+            auto contents = std::make_shared<std::string>();
+            char buffer[64 * 1024];
+            ssize_t n;
+            while ((n = file_->read(buffer, sizeof(buffer))) > 0) {
+                contents->append(buffer, static_cast<size_t>(n));
+            }
+            loaded_ = std::move(contents);
+            mapped_ = *loaded_;
+        }
+    }
+    appendFd_ = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+    // Последняя строка без перевода строки не должна склеиться с новой записью
+    if (appendFd_ >= 0 && !mapped_.empty() && mapped_.back() != '\n') {
+        static_cast<void>(::write(appendFd_, "\n", 1));
+    }
+
+    // Отдельный поток, а не общий пул: на большой истории построение занимает секунды, и
+    // команды не должны ждать его в очереди. Поток владеет отображением файла или его
+    // копией, поэтому выход из shell его не ждёт. Позиции в индексе 32-битные.
+    if (!mapped_.empty() && mapped_.size() < INT32_MAX) {
+        std::promise<Index> promise;
+        pending_ = promise.get_future();
+        std::thread([file = file_, loaded = loaded_, data = mapped_,
+                     promise = std::move(promise)]() mutable {
+            try {
+                promise.set_value(buildIndex(data));
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        }).detach();
+    }
+}
+
+History::~History() {
+    if (appendFd_ >= 0) {
+        ::close(appendFd_);
+    }
+}
+
+void History::add(std::string_view line) {
+    if (line.empty()) {
+        return;
+    }
+    size_t start = session_.size();
+    session_.append(line);
+    session_.push_back('\n');
+    if (appendFd_ >= 0) {
+        // Одна запись за один write: параллельные сессии не перемешивают строки
+        static_cast<void>(::write(appendFd_, session_.data() + start, session_.size() - start));
+    }
+}
+
+std::string_view History::entry(size_t pos) const {
+    std::string_view data = pos < mapped_.size() ? mapped_ : std::string_view(session_);
+    size_t offset = pos < mapped_.size() ? pos : pos - mapped_.size();
+    if (offset >= data.size()) {
+        return {};
+    }
+    size_t newline = data.find('\n', offset);
+    return data.substr(offset, newline == std::string_view::npos ? newline : newline - offset);
+}
+
+std::optional<size_t> History::previous(size_t pos) const {
+    if (pos == 0 || pos > end()) {
+        return std::nullopt;
+    }
+    if (pos > mapped_.size()) {
+        // Перед pos — '\n' предыдущей записи сессии
+        return mapped_.size() + entryStart(session_, pos - mapped_.size() - 1);
+    }
+    size_t contentEnd = pos;
+    if (pos < mapped_.size() || mapped_.back() == '\n') {
+        --contentEnd;
+    }
+    return entryStart(mapped_, contentEnd);
+}
+
+std::optional<size_t> History::next(size_t pos) const {
+    if (pos >= end()) {
+        return std::nullopt;
+    }
+    size_t after = pos + entry(pos).size();
+    // Последняя строка файла может быть без перевода строки
+    return after == mapped_.size() ? after : after + 1;
+}
+
+std::optional<size_t> History::search(std::string_view query, size_t before) const {
+    before = std::min(before, end());
+
+    // Записи сессии — от новых к старым
+    for (std::optional<size_t> pos = previous(before); pos && *pos >= mapped_.size();
+         pos = previous(*pos)) {
+        if (entry(*pos).find(query) != std::string_view::npos) {
+            return pos;
+        }
+    }
+
+    // Последняя запись файла, которую можно вернуть
+    size_t limit = std::min(before, mapped_.size());
+    if (limit == 0) {
+        return std::nullopt;
+    }
+    size_t lastEntry = entryStart(mapped_, limit - 1);
+    if (const Index* index = readyIndex()) {
+        return index->search(query, lastEntry);
+    }
+    size_t found = mapped_.substr(0, lastEntry + entry(lastEntry).size()).rfind(query);
+    if (found == std::string_view::npos) {
+        return std::nullopt;
+    }
+    return entryStart(mapped_, found);
+}
+
+void History::waitForIndex() const {
+    if (pending_.valid()) {
+        pending_.wait();
+    }
+}
+
+const History::Index* History::readyIndex() const {
+    if (pending_.valid() &&
+        pending_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        try {
+            index_ = std::make_unique<Index>(pending_.get());
+        } catch (const std::exception&) {
+            // Без индекса (например, не хватило памяти) поиск просматривает файл
+        }
+    }
+    return index_.get();
+}
+
+History::Index History::buildIndex(std::string_view data) {
+    // Последнее появление каждой различной записи
+    std::unordered_map<std::string_view, uint64_t> last;
+    for (size_t pos = 0; pos < data.size();) {
+        size_t newline = data.find('\n', pos);
+        size_t length = newline == std::string_view::npos ? data.size() - pos : newline - pos;
+        if (length > 0) {
+            last[data.substr(pos, length)] = pos;
+        }
+        pos += length + 1;
+    }
+    std::vector<std::pair<uint64_t, std::string_view>> entries;
+    entries.reserve(last.size());
+    for (const auto& [text, offset] : last) {
+        entries.emplace_back(offset, text);
+    }
+    last.clear();
+    std::sort(entries.begin(), entries.end());
+
+    Index index;
+    index.starts.reserve(entries.size());
+    index.offsets.reserve(entries.size());
+    for (const auto& [offset, text] : entries) {
+        index.starts.push_back(static_cast<uint32_t>(index.text.size()));
+        index.offsets.push_back(offset);
+        index.text.append(text);
+        index.text.push_back('\n');
+    }
+
+    // Суффиксы, начинающиеся с '\n', запросу без '\n' не нужны
+    index.suffixes = suffixArray(ByteSymbols{index.text}, 255);
+    std::erase_if(index.suffixes, [&index](uint32_t pos) { return index.text[pos] == '\n'; });
+    index.suffixes.shrink_to_fit();
+    return index;
+}
+
+std::optional<size_t> History::Index::search(std::string_view query, uint64_t lastEntry) const {
+    // Записи с номером меньше bound появились последний раз не позже lastEntry
+    auto bound = static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), lastEntry) -
+                                     offsets.begin());
+    if (bound == 0) {
+        return std::nullopt;
+    }
+    const size_t textBound = bound < starts.size() ? starts[bound] : text.size();
+
+    // Суффиксы с префиксом query занимают непрерывный отрезок массива
+    auto prefixOf = [this, &query](uint32_t pos) {
+        return std::string_view(text).substr(pos, query.size());
+    };
+    auto first = std::lower_bound(
+        suffixes.begin(), suffixes.end(), query,
+        [&prefixOf](uint32_t pos, std::string_view q) { return prefixOf(pos) < q; });
+    auto last = std::upper_bound(
+        first, suffixes.end(), query,
+        [&prefixOf](std::string_view q, uint32_t pos) { return q < prefixOf(pos); });
+
+    // Самое позднее вхождение до границы — в самой новой подходящей записи
+    uint32_t best = 0;
+    bool found = false;
+    for (auto it = first; it != last; ++it) {
+        if (*it < textBound && (!found || *it > best)) {
+            best = *it;
+            found = true;
+        }
+    }
+    if (!found) {
+        return std::nullopt;
+    }
+    auto id = static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), best) -
+                                  starts.begin()) - 1;
+    return offsets[id];
+}
+
+}  // namespace shell
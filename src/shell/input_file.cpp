@@ -0,0 +1,113 @@
+#include "shell/input_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace shell {
+
+InputFile::InputFile(const std::string& path) {
+    fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        error_ = errno;
+        return;
+    }
+
+    struct stat st {};
+    if (fstat(fd_, &st) == 0) {
+        regular_ = S_ISREG(st.st_mode);
+        directory_ = S_ISDIR(st.st_mode);
+        size_ = regular_ ? static_cast<uint64_t>(st.st_size) : 0;
+        mtimeSec_ = static_cast<int64_t>(st.st_mtime);
+    }
+}
+
+InputFile::~InputFile() {
+    reset();
+}
+
+InputFile::InputFile(InputFile&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      error_(other.error_),
+      regular_(other.regular_),
+      directory_(other.directory_),
+      size_(other.size_),
+      mtimeSec_(other.mtimeSec_),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mappingSize_(std::exchange(other.mappingSize_, 0)) {}
+
+InputFile& InputFile::operator=(InputFile&& other) noexcept {
+    if (this != &other) {
+        reset();
+        fd_ = std::exchange(other.fd_, -1);
+        error_ = other.error_;
+        regular_ = other.regular_;
+        directory_ = other.directory_;
+        size_ = other.size_;
+        mtimeSec_ = other.mtimeSec_;
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mappingSize_ = std::exchange(other.mappingSize_, 0);
+    }
+    return *this;
+}
+
+std::string InputFile::errorMessage() const {
+    if (directory_) {
+        return std::strerror(EISDIR);
+    }
+    return std::strerror(error_ != 0 ? error_ : EIO);
+}
+
+std::string_view InputFile::map() {
+    if (mapping_ != nullptr) {
+        return {static_cast<const char*>(mapping_), mappingSize_};
+    }
+    if (fd_ < 0 || !regular_ || size_ < kMinMapSize) {
+        return {};
+    }
+    // Недавно изменённый файл, вероятно, ещё пишется и может быть обрезан
+    if (std::time(nullptr) - mtimeSec_ < kSettleSeconds) {
+        return {};
+    }
+
+    auto length = static_cast<size_t>(size_);
+    void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (addr == MAP_FAILED) {
+        return {};
+    }
+    madvise(addr, length, MADV_SEQUENTIAL);
+
+    mapping_ = addr;
+    mappingSize_ = length;
+    return {static_cast<const char*>(mapping_), mappingSize_};
+}
+
+ssize_t InputFile::read(char* buffer, size_t capacity) {
+    while (true) {
+        ssize_t bytesRead = ::read(fd_, buffer, capacity);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        return bytesRead;
+    }
+}
+
+void InputFile::reset() noexcept {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mappingSize_);
+        mapping_ = nullptr;
+        mappingSize_ = 0;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+}  // namespace shell
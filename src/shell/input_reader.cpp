@@ -1,22 +1,43 @@
 #include "shell/input_reader.hpp"
 
+#include <unistd.h>
+
+#include "shell/history.hpp"
+#include "shell/line_editor.hpp"
+
 namespace shell {
 
 InputReader::InputReader(std::istream& input) : input_(input) {}
 
-std::optional<std::string> InputReader::readLine() {
-    if (showPrompt_) {
-        std::cout << prompt_ << std::flush;
-    }
+InputReader::~InputReader() = default;
+
+void InputReader::enableEditing(const std::string& historyPath, Completer* completer) {
+    editor_.reset();
+    history_ = std::make_unique<History>(historyPath);
+    editor_ = std::make_unique<LineEditor>(STDIN_FILENO, std::cout, *history_);
+    editor_->setCompleter(completer);
+}
 
+std::optional<std::string> InputReader::readLine() {
     std::string line;
-    if (std::getline(input_, line)) {
+    if (readLine(line)) {
         return line;
     }
 
     return std::nullopt;
 }
 
+bool InputReader::readLine(std::string& line) {
+    if (editor_) {
+        return editor_->readLine(showPrompt_ ? prompt_ : std::string(), line);
+    }
+    if (showPrompt_) {
+        std::cout << prompt_ << std::flush;
+    }
+
+    return static_cast<bool>(std::getline(input_, line));
+}
+
 void InputReader::setPrompt(const std::string& prompt) {
     prompt_ = prompt;
 }
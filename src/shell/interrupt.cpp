@@ -0,0 +1,75 @@
+#include "shell/interrupt.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <mutex>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace shell {
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+int selfPipe[2] = {-1, -1};
+std::once_flag pipeOnce;
+
+void openSelfPipe() {
+    if (pipe(selfPipe) < 0) {
+        selfPipe[0] = selfPipe[1] = -1;
+        return;
+    }
+    for (int end : selfPipe) {
+        fcntl(end, F_SETFL, fcntl(end, F_GETFL) | O_NONBLOCK);
+        fcntl(end, F_SETFD, FD_CLOEXEC);
+    }
+}
+
+// Только async-signal-safe операции
+void handleSigint(int) {
+    int savedErrno = errno;
+    interrupted.store(true);
+    if (selfPipe[1] >= 0) {
+        char byte = 1;
+        ssize_t written = write(selfPipe[1], &byte, 1);
+        (void)written;  // Канал полон — запрос уже отмечен
+    }
+    errno = savedErrno;
+}
+
+}  // namespace
+
+void Interrupt::install() {
+    std::call_once(pipeOnce, openSelfPipe);
+    struct sigaction action {};
+    action.sa_handler = handleSigint;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+}
+
+bool Interrupt::requested() {
+    return interrupted.load();
+}
+
+int Interrupt::fd() {
+    std::call_once(pipeOnce, openSelfPipe);
+    return selfPipe[0];
+}
+
+void Interrupt::request() {
+    std::call_once(pipeOnce, openSelfPipe);
+    handleSigint(SIGINT);
+}
+
+void Interrupt::clear() {
+    std::call_once(pipeOnce, openSelfPipe);
+    interrupted.store(false);
+    char buffer[64];
+    while (selfPipe[0] >= 0 && read(selfPipe[0], buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+}  // namespace shell
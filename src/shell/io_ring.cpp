@@ -0,0 +1,427 @@
+#include "shell/io_ring.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SHELL_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace shell {
+
+namespace {
+
+// -1: не проверено, 0: недоступно или запрещено, 1: доступно
+std::atomic<int> gState{-1};
+
+// Кольца завершившихся потоков
+std::mutex gSpareMutex;
+std::vector<std::unique_ptr<IoRing>>& spareRings() {
+    static std::vector<std::unique_ptr<IoRing>> rings;
+    return rings;
+}
+constexpr size_t kMaxSpareRings = 16;
+
+#ifdef SHELL_IO_URING
+
+constexpr unsigned kEntries = 64;
+
+// Тег завершения: номер буфера и операция
+enum Operation : uint64_t { kOpen, kRead, kClose, kCancel };
+
+uint64_t makeTag(Operation operation, size_t slot) {
+    return static_cast<uint64_t>(slot) << 8 | operation;
+}
+
+Operation operationOf(uint64_t tag) {
+    return static_cast<Operation>(tag & 0xff);
+}
+
+size_t slotOf(uint64_t tag) {
+    return static_cast<size_t>(tag >> 8);
+}
+
+template <typename T>
+T* at(void* base, unsigned offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+#endif  // SHELL_IO_URING
+
+}  // namespace
+
+/**
+ * @brief Кольцо, закреплённое за потоком; при выходе потока отдаётся в запас
+ */
+struct IoRingLease {
+    std::unique_ptr<IoRing> ring;
+
+    ~IoRingLease() {
+        if (ring) {
+            std::lock_guard<std::mutex> lock(gSpareMutex);
+            if (spareRings().size() < kMaxSpareRings) {
+                spareRings().push_back(std::move(ring));
+            }
+        }
+    }
+};
+
+IoRing::~IoRing() {
+#ifdef SHELL_IO_URING
+    if (sqes_ != nullptr) {
+        munmap(sqes_, sqesSize_);
+    }
+    if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+        munmap(cqRing_, cqRingSize_);
+    }
+    if (sqRing_ != nullptr) {
+        munmap(sqRing_, sqRingSize_);
+    }
+#endif
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+void IoRing::setEnabled(bool enabled) {
+    gState.store(enabled ? -1 : 0);
+}
+
+IoRing* IoRing::local() {
+    int state = gState.load(std::memory_order_relaxed);
+    if (state == 0) {
+        return nullptr;
+    }
+    thread_local IoRingLease lease;
+    if (!lease.ring) {
+        lease.ring = create();
+    }
+    return lease.ring.get();
+}
+
+std::unique_ptr<IoRing> IoRing::create() {
+    {
+        std::lock_guard<std::mutex> lock(gSpareMutex);
+        auto& spare = spareRings();
+        if (!spare.empty()) {
+            auto ring = std::move(spare.back());
+            spare.pop_back();
+            return ring;
+        }
+    }
+    if (gState.load() == -1) {
+        const char* setting = std::getenv("SHELL_IO_URING");
+        if (setting != nullptr && std::strcmp(setting, "0") == 0) {
+            gState.store(0);
+            return nullptr;
+        }
+    }
+    std::unique_ptr<IoRing> ring(new IoRing());
+    if (!ring->init()) {
+        gState.store(0);
+        return nullptr;
+    }
+    gState.store(1);
+    return ring;
+}
+
+char* IoRing::buffer(size_t index) const {
+    return aligned_ + index * kBufferSize;
+}
+
+#ifdef SHELL_IO_URING
+
+bool IoRing::init() {
+    io_uring_params params{};
+    long fd = syscall(__NR_io_uring_setup, kEntries, &params);
+    if (fd < 0) {
+        return false;
+    }
+    fd_ = static_cast<int>(fd);
+    // Текущая позиция файла (off = -1) и общий mmap для SQ и CQ — ядро 5.6+
+    if ((params.features & IORING_FEAT_RW_CUR_POS) == 0 ||
+        (params.features & IORING_FEAT_SINGLE_MMAP) == 0) {
+        return false;
+    }
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    void* ring = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd_, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+        return false;
+    }
+    sqRing_ = cqRing_ = ring;
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+    sqes_ = sqes;
+
+    sqHead_ = at<unsigned>(sqRing_, params.sq_off.head);
+    sqTail_ = at<unsigned>(sqRing_, params.sq_off.tail);
+    sqArray_ = at<unsigned>(sqRing_, params.sq_off.array);
+    sqMask_ = *at<unsigned>(sqRing_, params.sq_off.ring_mask);
+    sqEntries_ = params.sq_entries;
+    cqHead_ = at<unsigned>(cqRing_, params.cq_off.head);
+    cqTail_ = at<unsigned>(cqRing_, params.cq_off.tail);
+    cqMask_ = *at<unsigned>(cqRing_, params.cq_off.ring_mask);
+    cqes_ = at<io_uring_cqe>(cqRing_, params.cq_off.cqes);
+
+    // Все нужные операции должны поддерживаться ядром
+    constexpr size_t kProbeOps = 64;
+    std::array<char, sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op)> probeBuffer{};
+    auto* probe = reinterpret_cast<io_uring_probe*>(probeBuffer.data());
+    if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe, kProbeOps) < 0) {
+        return false;
+    }
+    for (unsigned op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_READ_FIXED, IORING_OP_CLOSE,
+                        IORING_OP_ASYNC_CANCEL}) {
+        if (op > probe->last_op || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0) {
+            return false;
+        }
+    }
+
+    buffers_ = std::make_unique<char[]>(kBufferCount * kBufferSize + 4096);
+    auto address = reinterpret_cast<uintptr_t>(buffers_.get());
+    aligned_ = buffers_.get() + ((4096 - address % 4096) % 4096);
+    std::array<iovec, kBufferCount> vectors{};
+    for (size_t i = 0; i < kBufferCount; ++i) {
+        vectors[i] = {buffer(i), kBufferSize};
+    }
+    // Без регистрации (лимит закреплённой памяти) работают обычные READ
+    fixed_ = syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, vectors.data(),
+                     kBufferCount) == 0;
+    return true;
+}
+
+void* IoRing::acquireSqe() {
+    unsigned tail = *sqTail_;
+    if (tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= sqEntries_) {
+        // Очередь заполнена: ядро забирает все отправленные SQE сразу
+        submit(false);
+    }
+    unsigned index = tail & sqMask_;
+    auto* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqArray_[index] = index;
+    __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+    return sqe;
+}
+
+void IoRing::prepareOpen(const char* path, uint64_t tag) {
+    auto* sqe = static_cast<io_uring_sqe*>(acquireSqe());
+    sqe->opcode = IORING_OP_OPENAT;
+    sqe->fd = AT_FDCWD;
+    sqe->addr = reinterpret_cast<uintptr_t>(path);
+    sqe->open_flags = O_RDONLY | O_CLOEXEC;
+    sqe->user_data = tag;
+}
+
+void IoRing::prepareRead(int fd, size_t bufferIndex, size_t offset, size_t length, uint64_t tag) {
+    auto* sqe = static_cast<io_uring_sqe*>(acquireSqe());
+    sqe->opcode = fixed_ ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uintptr_t>(buffer(bufferIndex) + offset);
+    sqe->len = static_cast<uint32_t>(length);
+    sqe->off = static_cast<uint64_t>(-1);  // с текущей позиции: годится и для каналов
+    sqe->buf_index = static_cast<uint16_t>(bufferIndex);
+    sqe->user_data = tag;
+}
+
+void IoRing::prepareClose(int fd) {
+    auto* sqe = static_cast<io_uring_sqe*>(acquireSqe());
+    sqe->opcode = IORING_OP_CLOSE;
+    sqe->fd = fd;
+    sqe->user_data = makeTag(kClose, 0);
+    ++closes_;
+}
+
+void IoRing::prepareCancel(uint64_t tag) {
+    auto* sqe = static_cast<io_uring_sqe*>(acquireSqe());
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = tag;
+    sqe->user_data = makeTag(kCancel, 0);
+}
+
+void IoRing::submit(bool wait) {
+    for (;;) {
+        unsigned pending = *sqTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        if (pending == 0 && !wait) {
+            return;
+        }
+        unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+        long result = syscall(__NR_io_uring_enter, fd_, pending, wait ? 1U : 0U, flags, nullptr, 0);
+        if (result >= 0 || (errno != EINTR && errno != EAGAIN && errno != EBUSY)) {
+            return;
+        }
+    }
+}
+
+bool IoRing::pop(Completion& completion) {
+    unsigned head = *cqHead_;
+    if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    const auto& cqe = static_cast<io_uring_cqe*>(cqes_)[head & cqMask_];
+    completion = {cqe.user_data, cqe.res};
+    __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+    if (operationOf(completion.tag) == kClose) {
+        --closes_;
+    }
+    return true;
+}
+
+IoRing::Completion IoRing::next() {
+    Completion completion{};
+    while (!pop(completion)) {
+        submit(true);
+    }
+    return completion;
+}
+
+void IoRing::readFiles(const std::vector<std::string>& paths, FileConsumer& consumer) {
+    // Буфер slot занят файлом с номером index (slot = index % kBufferCount)
+    struct Slot {
+        size_t index = 0;
+        int fd = -1;
+        int error = 0;
+        size_t filled = 0;
+        bool busy = false;  // в кольце есть операция над слотом
+        bool eof = false;
+    };
+    std::array<Slot, kBufferCount> slots;
+    size_t started = 0;
+    size_t head = 0;
+
+    auto startFiles = [&] {
+        for (; started < paths.size() && started - head < kBufferCount; ++started) {
+            size_t slot = started % kBufferCount;
+            slots[slot] = Slot{};
+            slots[slot].index = started;
+            slots[slot].busy = true;
+            prepareOpen(paths[started].c_str(), makeTag(kOpen, slot));
+        }
+    };
+    auto readMore = [&](size_t slot) {
+        Slot& s = slots[slot];
+        s.busy = true;
+        prepareRead(s.fd, slot, s.filled, kBufferSize - s.filled, makeTag(kRead, slot));
+    };
+
+    startFiles();
+    bool stopped = false;
+    while (head < paths.size() && !stopped) {
+        size_t headSlot = head % kBufferCount;
+        Slot& current = slots[headSlot];
+        if (!current.busy) {
+            if (current.filled > 0) {
+                stopped = !consumer.data(head, buffer(headSlot), current.filled);
+                current.filled = 0;
+                if (stopped) {
+                    break;
+                }
+            }
+            if (current.eof || current.error != 0) {
+                if (current.fd >= 0) {
+                    prepareClose(current.fd);
+                }
+                consumer.end(head, current.error);
+                ++head;
+                startFiles();
+                continue;
+            }
+            readMore(headSlot);
+        }
+
+        // Первое завершение ждём, остальные забираем без ожидания
+        Completion completion = next();
+        do {
+            Operation operation = operationOf(completion.tag);
+            if (operation != kOpen && operation != kRead) {
+                continue;
+            }
+            size_t slot = slotOf(completion.tag);
+            Slot& s = slots[slot];
+            s.busy = false;
+            if (completion.result < 0) {
+                s.error = -completion.result;
+            } else if (operation == kOpen) {
+                s.fd = completion.result;
+                readMore(slot);
+            } else if (completion.result == 0) {
+                s.eof = true;
+            } else {
+                s.filled += static_cast<size_t>(completion.result);
+                // Файл, до которого не дошла очередь, дочитывается в свой буфер
+                if (s.index != head && s.filled < kBufferSize) {
+                    readMore(slot);
+                }
+            }
+        } while (pop(completion));
+    }
+
+    if (stopped) {
+        // Получатель закрыт (например, head вышел): чтения бесконечных источников
+        // вроде /dev/urandom или каналов отменяются, а не доводятся до конца
+        for (size_t index = head; index < started; ++index) {
+            size_t slot = index % kBufferCount;
+            if (slots[slot].busy) {
+                prepareCancel(makeTag(kOpen, slot));
+                prepareCancel(makeTag(kRead, slot));
+            }
+        }
+        auto anyBusy = [&] {
+            return std::any_of(slots.begin(), slots.end(), [](const Slot& s) { return s.busy; });
+        };
+        while (anyBusy()) {
+            Completion completion = next();
+            Operation operation = operationOf(completion.tag);
+            if (operation != kOpen && operation != kRead) {
+                continue;
+            }
+            Slot& s = slots[slotOf(completion.tag)];
+            s.busy = false;
+            if (operation == kOpen && completion.result >= 0) {
+                s.fd = completion.result;
+            }
+        }
+        for (size_t index = head; index < started; ++index) {
+            if (slots[index % kBufferCount].fd >= 0) {
+                prepareClose(slots[index % kBufferCount].fd);
+            }
+        }
+    }
+
+    // Кольцо отдаётся следующей команде без незавершённых операций
+    while (closes_ > 0) {
+        next();
+    }
+}
+
+#else  // SHELL_IO_URING
+
+bool IoRing::init() {
+    return false;
+}
+
+void IoRing::readFiles(const std::vector<std::string>&, FileConsumer&) {}
+
+#endif  // SHELL_IO_URING
+
+}  // namespace shell
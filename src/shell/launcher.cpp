@@ -0,0 +1,388 @@
+#include "shell/launcher.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+
+#include <limits.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+#include "shell/process_util.hpp"
+
+namespace shell {
+
+namespace {
+
+#ifdef __linux__
+
+// Номер clone3 одинаков на всех архитектурах; флаги — на случай старых заголовков libc
+#ifdef SYS_clone3
+constexpr long kClone3 = SYS_clone3;
+#else
+constexpr long kClone3 = 435;
+#endif
+constexpr uint64_t kClonePidfd = 0x1000;
+constexpr uint64_t kCloneParent = 0x8000;
+
+// struct clone_args из linux/sched.h (первая версия, 64 байта)
+struct CloneArgs {
+    uint64_t flags;
+    uint64_t pidfd;
+    uint64_t childTid;
+    uint64_t parentTid;
+    uint64_t exitSignal;
+    uint64_t stack;
+    uint64_t stackSize;
+    uint64_t tls;
+};
+
+constexpr uint32_t kHasStdin = 1;
+constexpr uint32_t kHasStdout = 2;
+
+// Запрос: заголовок, затем строки с завершающим нулём — путь, каталог,
+// argc аргументов и envc переменных окружения
+struct RequestHeader {
+    uint32_t argc;
+    uint32_t envc;
+    uint32_t flags;
+};
+
+// Ответ; при error == 0 к нему приложен pidfd
+struct Reply {
+    int32_t error;
+    int32_t pid;
+};
+
+// Сообщение SOCK_SEQPACKET ограничено буфером сокета; больший запрос идёт через fork
+constexpr size_t kMaxRequestSize = 192 * 1024;
+constexpr size_t kMaxStrings = 16 * 1024;
+
+// Буферы запускателя статические: он создаётся fork из многопоточного
+// процесса и не должен обращаться к куче. В shell эти страницы не тронуты.
+char gRequest[kMaxRequestSize];
+char* gArgv[kMaxStrings + 2];
+char* gEnvp[kMaxStrings + 1];
+
+bool sendMessage(int socket, const void* data, size_t size, const int* fds, size_t count) {
+    iovec iov{const_cast<void*>(data), size};
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 2)];
+    if (count > 0) {
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int) * count);
+        std::memcpy(CMSG_DATA(header), fds, sizeof(int) * count);
+    }
+    ssize_t sent = 0;
+    while ((sent = sendmsg(socket, &message, MSG_NOSIGNAL)) < 0 && errno == EINTR) {
+    }
+    return sent == static_cast<ssize_t>(size);
+}
+
+// Принять сообщение и до двух дескрипторов; truncated — сообщение не поместилось
+ssize_t receiveMessage(int socket, void* data, size_t size, int fds[2], size_t& count,
+                       bool& truncated) {
+    iovec iov{data, size};
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 2)];
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    ssize_t received = 0;
+    while ((received = recvmsg(socket, &message, MSG_CMSG_CLOEXEC)) < 0 && errno == EINTR) {
+    }
+    count = 0;
+    for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr;
+         header = CMSG_NXTHDR(&message, header)) {
+        if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+            size_t length = header->cmsg_len - CMSG_LEN(0);
+            count = length / sizeof(int) > 2 ? 2 : length / sizeof(int);
+            std::memcpy(fds, CMSG_DATA(header), sizeof(int) * count);
+        }
+    }
+    truncated = (message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0;
+    return received;
+}
+
+// Разобрать запрос в gArgv/gEnvp; cwd — указатель на каталог внутри gRequest
+bool parseRequest(size_t size, const RequestHeader& header, const char*& cwd) {
+    if (header.argc > kMaxStrings || header.envc > kMaxStrings - header.argc) {
+        return false;
+    }
+    size_t strings = 2 + size_t{header.argc} + header.envc;
+    size_t pos = sizeof(RequestHeader);
+    for (size_t i = 0; i < strings; ++i) {
+        const void* end = pos < size ? std::memchr(gRequest + pos, '\0', size - pos) : nullptr;
+        if (end == nullptr) {
+            return false;
+        }
+        char* text = gRequest + pos;
+        if (i == 0) {
+            gArgv[0] = text;
+        } else if (i == 1) {
+            cwd = text;
+        } else if (i < 2 + size_t{header.argc}) {
+            gArgv[i - 1] = text;
+        } else {
+            gEnvp[i - 2 - header.argc] = text;
+        }
+        pos = static_cast<size_t>(static_cast<const char*>(end) - gRequest) + 1;
+    }
+    gArgv[header.argc + 1] = nullptr;
+    gEnvp[header.envc] = nullptr;
+    return true;
+}
+
+// Создать программу дочерним процессом shell; возвращает errno или 0
+int launch(const char* cwd, int stdinFd, int stdoutFd, pid_t& pid, int& pidfd) {
+    CloneArgs args{};
+    args.flags = kCloneParent | kClonePidfd;
+    args.pidfd = reinterpret_cast<uintptr_t>(&pidfd);
+    long result = syscall(kClone3, &args, sizeof(args));
+    if (result < 0) {
+        return errno;
+    }
+    if (result > 0) {
+        pid = static_cast<pid_t>(result);
+        return 0;
+    }
+
+    // Дочерний процесс: восстанавливаем то, что запускатель игнорирует
+    signal(SIGINT, SIG_DFL);
+    signal(SIGQUIT, SIG_DFL);
+    signal(SIGPIPE, SIG_DFL);
+    if (chdir(cwd) != 0) {
+        _exit(127);
+    }
+    if (stdinFd >= 0) {
+        dup2(stdinFd, STDIN_FILENO);
+    }
+    if (stdoutFd >= 0) {
+        dup2(stdoutFd, STDOUT_FILENO);
+    }
+    execve(gArgv[0], gArgv, gEnvp);
+    _exit(127);
+}
+
+[[noreturn]] void serve(int socket) {
+    // Ctrl-C адресован программам и shell, а не запускателю
+    signal(SIGINT, SIG_IGN);
+    signal(SIGQUIT, SIG_IGN);
+    signal(SIGPIPE, SIG_IGN);
+    sigset_t empty;
+    sigemptyset(&empty);
+    sigprocmask(SIG_SETMASK, &empty, nullptr);
+
+    for (;;) {
+        int fds[2] = {-1, -1};
+        size_t count = 0;
+        bool truncated = false;
+        ssize_t size = receiveMessage(socket, gRequest, sizeof(gRequest), fds, count, truncated);
+        if (size <= 0) {
+            _exit(0);  // shell закрыл сокет
+        }
+
+        Reply reply{0, -1};
+        RequestHeader header{};
+        const char* cwd = nullptr;
+        size_t expected = 0;
+        if (static_cast<size_t>(size) >= sizeof(header)) {
+            std::memcpy(&header, gRequest, sizeof(header));
+            expected = size_t{(header.flags & kHasStdin) != 0} +
+                       size_t{(header.flags & kHasStdout) != 0};
+        }
+        int pidfd = -1;
+        if (truncated || expected != count ||
+            !parseRequest(static_cast<size_t>(size), header, cwd)) {
+            reply.error = EINVAL;
+        } else {
+            int stdinFd = (header.flags & kHasStdin) != 0 ? fds[0] : -1;
+            int stdoutFd = (header.flags & kHasStdout) != 0 ? fds[count - 1] : -1;
+            pid_t pid = -1;
+            reply.error = launch(cwd, stdinFd, stdoutFd, pid, pidfd);
+            reply.pid = pid;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            close(fds[i]);
+        }
+        if (!sendMessage(socket, &reply, sizeof(reply), &pidfd, pidfd >= 0 ? 1 : 0)) {
+            _exit(0);
+        }
+        if (pidfd >= 0) {
+            close(pidfd);
+        }
+    }
+}
+
+#endif  // __linux__
+
+}  // namespace
+
+Launcher::~Launcher() {
+    stop();
+}
+
+Launcher& Launcher::shared() {
+    static Launcher launcher;
+    return launcher;
+}
+
+bool Launcher::start() {
+#ifdef __linux__
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (socket_ >= 0) {
+        return true;
+    }
+    if (pid_ > 0) {
+        waitProcess(pid_);
+        pid_ = -1;
+    }
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) != 0) {
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        serve(fds[1]);
+    }
+    close(fds[1]);
+    socket_ = fds[0];
+    pid_ = pid;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Launcher::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopLocked();
+}
+
+void Launcher::stopLocked() {
+    // Запускатель завершается, увидев конец сокета
+    if (socket_ >= 0) {
+        close(socket_);
+        socket_ = -1;
+    }
+    if (pid_ > 0) {
+        waitProcess(pid_);
+        pid_ = -1;
+    }
+}
+
+bool Launcher::running() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return socket_ >= 0;
+}
+
+SpawnedProcess Launcher::spawn(const std::string& path, const std::vector<std::string>& args,
+                               const std::vector<std::string>& env, int stdinFd, int stdoutFd) {
+    SpawnedProcess process;
+    if (!request(path, args, env, stdinFd, stdoutFd, process)) {
+        process.pid = spawnProcess(path, args, env, stdinFd, stdoutFd);
+    }
+    return process;
+}
+
+bool Launcher::request(const std::string& path, const std::vector<std::string>& args,
+                       const std::vector<std::string>& env, int stdinFd, int stdoutFd,
+                       SpawnedProcess& process) {
+#ifdef __linux__
+    if (!running() || args.size() + env.size() > kMaxStrings) {
+        return false;
+    }
+    // Программа запускается в процессе с другим текущим каталогом
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) == nullptr) {
+        return false;
+    }
+
+    RequestHeader header{static_cast<uint32_t>(args.size()), static_cast<uint32_t>(env.size()),
+                         0};
+    int fds[2];
+    size_t count = 0;
+    if (stdinFd >= 0) {
+        header.flags |= kHasStdin;
+        fds[count++] = stdinFd;
+    }
+    if (stdoutFd >= 0) {
+        header.flags |= kHasStdout;
+        fds[count++] = stdoutFd;
+    }
+    std::string payload(reinterpret_cast<const char*>(&header), sizeof(header));
+    auto append = [&payload](const char* text, size_t size) {
+        payload.append(text, size);
+        payload += '\0';
+    };
+    append(path.c_str(), path.size());
+    append(cwd, std::strlen(cwd));
+    for (const auto& arg : args) {
+        append(arg.c_str(), arg.size());
+    }
+    for (const auto& var : env) {
+        append(var.c_str(), var.size());
+    }
+    if (payload.size() > kMaxRequestSize) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (socket_ < 0 || !sendMessage(socket_, payload.data(), payload.size(), fds, count)) {
+        return false;
+    }
+    Reply reply{};
+    int received[2] = {-1, -1};
+    bool truncated = false;
+    ssize_t size = receiveMessage(socket_, &reply, sizeof(reply), received, count, truncated);
+    if (size != static_cast<ssize_t>(sizeof(reply)) || truncated) {
+        // Запускатель завершился: дальше только fork
+        for (size_t i = 0; i < count; ++i) {
+            close(received[i]);
+        }
+        close(socket_);
+        socket_ = -1;
+        return false;
+    }
+    if (reply.error != 0) {
+        // Ядро без clone3 (ENOSYS), запрет seccomp (EPERM) или неподдерживаемые флаги
+        // (EINVAL) не пройдут и в следующий раз: дальше только fork, без лишнего обмена
+        if (reply.error == ENOSYS || reply.error == EPERM || reply.error == EINVAL) {
+            stopLocked();
+        }
+        return false;
+    }
+    process.pid = reply.pid;
+    process.pidfd = count > 0 ? received[0] : -1;
+    return true;
+#else
+    static_cast<void>(path);
+    static_cast<void>(args);
+    static_cast<void>(env);
+    static_cast<void>(stdinFd);
+    static_cast<void>(stdoutFd);
+    static_cast<void>(process);
+    return false;
+#endif
+}
+
+}  // namespace shell
@@ -4,10 +4,11 @@
 
 namespace shell {
 
-Lexer::Lexer(const std::string& input) : input_(input), position_(0) {}
+Lexer::Lexer(std::string_view input, std::pmr::memory_resource* resource)
+    : resource_(resource), input_(input, resource), position_(0) {}
 
-std::vector<Token> Lexer::tokenize() {
-    std::vector<Token> tokens;
+std::pmr::vector<Token> Lexer::tokenize() {
+    std::pmr::vector<Token> tokens(resource_);
 
     while (position_ < input_.size()) {
         skipWhitespace();
@@ -20,7 +21,7 @@ std::vector<Token> Lexer::tokenize() {
 
         if (c == '|') {
             advance();
-            tokens.emplace_back(TokenType::PIPE, "|");
+            tokens.emplace_back(TokenType::PIPE, "|", resource_);
         } else if (c == '\'' || c == '"') {
             tokens.push_back(readQuotedString(c));
         } else {
@@ -28,7 +29,7 @@ std::vector<Token> Lexer::tokenize() {
         }
     }
 
-    tokens.emplace_back(TokenType::END_OF_INPUT, "");
+    tokens.emplace_back(TokenType::END_OF_INPUT, "", resource_);
     return tokens;
 }
 
@@ -53,7 +54,12 @@ void Lexer::skipWhitespace() {
 }
 
 Token Lexer::readWord() {
-    std::string value;
+    Token token(TokenType::WORD, "", resource_);
+    std::pmr::string& value = token.value;
+    // Параллельно собираем шаблон для раскрытия путей: метасимволы из
+    // кавычек экранируются, чтобы '*.log' осталось литералом
+    std::pmr::string pattern(resource_);
+    bool hasGlob = false;
 
     while (position_ < input_.size()) {
         char c = peek();
@@ -66,24 +72,40 @@ Token Lexer::readWord() {
             // Кавычки внутри слова — читаем строку в кавычках и добавляем к слову
             Token quoted = readQuotedString(c);
             value += quoted.value;
+            for (char q : quoted.value) {
+                if (isGlobChar(q)) {
+                    pattern += '\\';
+                }
+                pattern += q;
+            }
         } else {
-            value += advance();
+            c = advance();
+            value += c;
+            hasGlob = hasGlob || c == '*' || c == '?' || c == '[';
+            if (c == '\\') {
+                pattern += '\\';
+            }
+            pattern += c;
         }
     }
 
-    return Token(TokenType::WORD, value);
+    if (hasGlob) {
+        token.pattern = std::move(pattern);
+    }
+    return token;
 }
 
 Token Lexer::readQuotedString(char quote) {
     advance();  // Пропускаем открывающую кавычку
-    std::string value;
+    Token token(TokenType::WORD, "", resource_);
+    std::pmr::string& value = token.value;
 
     while (position_ < input_.size()) {
         char c = peek();
 
         if (c == quote) {
             advance();  // Пропускаем закрывающую кавычку
-            return Token(TokenType::WORD, value);
+            return token;
         }
 
         // Обработка escape-последовательностей внутри двойных кавычек
@@ -100,13 +122,17 @@ Token Lexer::readQuotedString(char quote) {
     }
 
     // Незакрытая кавычка — возвращаем то, что прочитали
-    return Token(TokenType::WORD, value);
+    return token;
 }
 
 bool Lexer::isSpecialChar(char c) const {
     return c == '|' || c == '=' || c == '\'' || c == '"';
 }
 
+bool Lexer::isGlobChar(char c) const {
+    return c == '*' || c == '?' || c == '[' || c == ']' || c == '\\';
+}
+
 bool Lexer::isWordChar(char c) const {
     return c != ' ' && c != '\t' && c != '|' && c != '\0';
 }
@@ -0,0 +1,37 @@
+#include "shell/line_arena.hpp"
+
+namespace shell {
+
+LineArena::LineArena(size_t initialSize)
+    : size_(initialSize), buffer_(std::make_unique<std::byte[]>(initialSize)) {
+    resource_.emplace(buffer_.get(), size_, &overflow_);
+}
+
+void LineArena::reset() {
+    if (overflow_.allocated == 0) {
+        resource_->release();
+        return;
+    }
+    // Строке не хватило буфера: заменяем его буфером, вмещающим её целиком
+    size_t size = size_ + overflow_.allocated;
+    resource_.reset();
+    overflow_.allocated = 0;
+    size_ = size;
+    buffer_ = std::make_unique<std::byte[]>(size_);
+    resource_.emplace(buffer_.get(), size_, &overflow_);
+}
+
+void* LineArena::Overflow::do_allocate(size_t bytes, size_t alignment) {
+    allocated += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void LineArena::Overflow::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool LineArena::Overflow::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+}  // namespace shell
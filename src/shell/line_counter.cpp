@@ -0,0 +1,113 @@
+#include "shell/line_counter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace shell {
+
+namespace {
+
+constexpr size_t kInitialSlots = 1024;
+constexpr size_t kArenaBlock = 256 * 1024;
+
+// Порядок вывода: больший счётчик раньше, при равенстве — меньший ключ
+bool before(const LineCounter::Entry& a, const LineCounter::Entry& b) {
+    if (a.count != b.count) {
+        return a.count > b.count;
+    }
+    return a.key < b.key;
+}
+
+}  // namespace
+
+LineCounter::LineCounter() : slots_(kInitialSlots, Slot{0, nullptr, 0, 0}) {}
+
+void LineCounter::add(std::string_view key, uint64_t count) {
+    uint64_t hash = std::hash<std::string_view>{}(key);
+    size_t mask = slots_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        Slot& slot = slots_[i];
+        if (slot.count == 0) {
+            slot = Slot{hash, store(key), key.size(), count};
+            if (++size_ * 2 > slots_.size()) {
+                grow();
+            }
+            return;
+        }
+        if (slot.hash == hash && slot.length == key.size() &&
+            std::memcmp(slot.key, key.data(), key.size()) == 0) {
+            slot.count += count;
+            return;
+        }
+    }
+}
+
+const char* LineCounter::store(std::string_view key) {
+    if (key.size() > arenaLeft_) {
+        size_t blockSize = std::max(kArenaBlock, key.size());
+        blocks_.push_back(std::make_unique<char[]>(blockSize));
+        arenaPos_ = blocks_.back().get();
+        arenaLeft_ = blockSize;
+    }
+    char* stored = arenaPos_;
+    std::memcpy(stored, key.data(), key.size());
+    arenaPos_ += key.size();
+    arenaLeft_ -= key.size();
+    return stored;
+}
+
+void LineCounter::grow() {
+    std::vector<Slot> old(slots_.size() * 2, Slot{0, nullptr, 0, 0});
+    old.swap(slots_);
+    size_t mask = slots_.size() - 1;
+    for (const Slot& slot : old) {
+        if (slot.count == 0) {
+            continue;
+        }
+        size_t i = slot.hash & mask;
+        while (slots_[i].count != 0) {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = slot;
+    }
+}
+
+std::vector<LineCounter::Entry> LineCounter::sorted() const {
+    std::vector<Entry> entries;
+    entries.reserve(size_);
+    for (const Slot& slot : slots_) {
+        if (slot.count != 0) {
+            entries.push_back({std::string_view(slot.key, slot.length), slot.count});
+        }
+    }
+    std::sort(entries.begin(), entries.end(), before);
+    return entries;
+}
+
+std::vector<LineCounter::Entry> LineCounter::top(size_t k) const {
+    if (k >= size_) {
+        return sorted();
+    }
+    // Куча с худшим из отобранных на вершине
+    std::vector<Entry> heap;
+    heap.reserve(k + 1);
+    for (const Slot& slot : slots_) {
+        if (slot.count == 0) {
+            continue;
+        }
+        Entry entry{std::string_view(slot.key, slot.length), slot.count};
+        if (heap.size() < k) {
+            heap.push_back(entry);
+            std::push_heap(heap.begin(), heap.end(), before);
+        } else if (k > 0 && before(entry, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), before);
+            heap.back() = entry;
+            std::push_heap(heap.begin(), heap.end(), before);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), before);
+    return heap;
+}
+
+}  // namespace shell
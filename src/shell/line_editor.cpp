@@ -0,0 +1,441 @@
+#include "shell/line_editor.hpp"
+
+#include <cerrno>
+#include <optional>
+
+#include <termios.h>
+#include <unistd.h>
+
+#include "shell/completion.hpp"
+
+namespace shell {
+
+namespace {
+
+// Коды клавиш: байты ввода 0..255, остальные — разобранные ESC-последовательности
+enum Key : int {
+    kEof = -1,
+    kNone = -2,
+    kCtrlA = 0x01,
+    kCtrlB = 0x02,
+    kCtrlC = 0x03,
+    kCtrlD = 0x04,
+    kCtrlE = 0x05,
+    kCtrlF = 0x06,
+    kCtrlG = 0x07,
+    kCtrlH = 0x08,
+    kTab = 0x09,
+    kCtrlK = 0x0B,
+    kCtrlL = 0x0C,
+    kEnter = 0x0D,
+    kCtrlN = 0x0E,
+    kCtrlP = 0x10,
+    kCtrlR = 0x12,
+    kCtrlU = 0x15,
+    kCtrlW = 0x17,
+    kEscape = 0x1B,
+    kBackspace = 0x7F,
+    kUp = 0x100,
+    kDown,
+    kLeft,
+    kRight,
+    kHome,
+    kEnd,
+    kDelete,
+};
+
+bool isContinuation(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+bool isPrintable(int key) {
+    return key >= 0x20 && key <= 0xFF && key != kBackspace;
+}
+
+// Число символов UTF-8 (ширина строки на экране без учёта двойных символов)
+size_t columns(std::string_view text) {
+    size_t count = 0;
+    for (char c : text) {
+        count += isContinuation(c) ? 0U : 1U;
+    }
+    return count;
+}
+
+// Неканонический режим терминала без эха на время чтения строки
+class RawMode {
+public:
+    explicit RawMode(int fd) : fd_(fd) {
+        if (!isatty(fd) || tcgetattr(fd, &saved_) != 0) {
+            return;
+        }
+        termios raw = saved_;
+        raw.c_iflag &= ~static_cast<tcflag_t>(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
+        raw.c_lflag &= ~static_cast<tcflag_t>(ECHO | ICANON | IEXTEN | ISIG);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        active_ = tcsetattr(fd, TCSADRAIN, &raw) == 0;
+    }
+
+    ~RawMode() {
+        if (active_) {
+            tcsetattr(fd_, TCSADRAIN, &saved_);
+        }
+    }
+
+    RawMode(const RawMode&) = delete;
+    RawMode& operator=(const RawMode&) = delete;
+
+private:
+    int fd_;
+    termios saved_{};
+    bool active_ = false;
+};
+
+}  // namespace
+
+LineEditor::LineEditor(int inputFd, std::ostream& output, History& history)
+    : fd_(inputFd), out_(output), history_(history) {}
+
+bool LineEditor::readLine(const std::string& prompt, std::string& line) {
+    RawMode raw(fd_);
+    prompt_ = prompt;
+    buffer_.clear();
+    cursor_ = 0;
+    historyPos_ = history_.end();
+    draft_.clear();
+    refresh();
+
+    int previous = kNone;
+    while (true) {
+        int key = readByte();
+        if (key == kEscape) {
+            key = readEscape();
+        } else if (key == kCtrlR) {
+            key = reverseSearch();
+        }
+        const bool repeatedTab = key == kTab && previous == kTab;
+        previous = key;
+
+        switch (key) {
+            case kEof:
+            case kCtrlD:
+                if (buffer_.empty()) {
+                    out_ << "\n" << std::flush;
+                    return false;
+                }
+                if (key == kEof) {
+                    // Незавершённая строка в конце ввода выполняется
+                    out_ << "\n" << std::flush;
+                    break;
+                }
+                [[fallthrough]];
+            case kDelete:
+                if (cursor_ < buffer_.size()) {
+                    size_t end = cursor_ + 1;
+                    while (end < buffer_.size() && isContinuation(buffer_[end])) {
+                        ++end;
+                    }
+                    buffer_.erase(cursor_, end - cursor_);
+                }
+                refresh();
+                continue;
+            case kBackspace:
+            case kCtrlH:
+                if (cursor_ > 0) {
+                    size_t start = cursor_ - 1;
+                    while (start > 0 && isContinuation(buffer_[start])) {
+                        --start;
+                    }
+                    buffer_.erase(start, cursor_ - start);
+                    cursor_ = start;
+                }
+                refresh();
+                continue;
+            case kLeft:
+            case kCtrlB:
+                while (cursor_ > 0 && isContinuation(buffer_[--cursor_])) {
+                }
+                refresh();
+                continue;
+            case kRight:
+            case kCtrlF:
+                while (cursor_ < buffer_.size() && isContinuation(buffer_[++cursor_])) {
+                }
+                refresh();
+                continue;
+            case kHome:
+            case kCtrlA:
+                cursor_ = 0;
+                refresh();
+                continue;
+            case kEnd:
+            case kCtrlE:
+                cursor_ = buffer_.size();
+                refresh();
+                continue;
+            case kCtrlK:
+                buffer_.erase(cursor_);
+                refresh();
+                continue;
+            case kCtrlU:
+                buffer_.erase(0, cursor_);
+                cursor_ = 0;
+                refresh();
+                continue;
+            case kCtrlW: {
+                size_t start = cursor_;
+                while (start > 0 && buffer_[start - 1] == ' ') {
+                    --start;
+                }
+                while (start > 0 && buffer_[start - 1] != ' ') {
+                    --start;
+                }
+                buffer_.erase(start, cursor_ - start);
+                cursor_ = start;
+                refresh();
+                continue;
+            }
+            case kUp:
+            case kCtrlP:
+                historyStep(true);
+                continue;
+            case kDown:
+            case kCtrlN:
+                historyStep(false);
+                continue;
+            case kTab:
+                complete(repeatedTab);
+                continue;
+            case kCtrlL:
+                out_ << "\x1b[H\x1b[2J";
+                refresh();
+                continue;
+            case kCtrlC:
+                // Строка сбрасывается, shell получает пустую строку и выводит приглашение
+                out_ << "^C\n" << std::flush;
+                line.clear();
+                return true;
+            case kEnter:
+            case '\n':
+                out_ << "\n" << std::flush;
+                break;
+            default:
+                if (isPrintable(key)) {
+                    buffer_.insert(cursor_, 1, static_cast<char>(key));
+                    ++cursor_;
+                    refresh();
+                }
+                continue;
+        }
+        break;
+    }
+
+    line = buffer_;
+    if (line.find_first_not_of(' ') != std::string::npos) {
+        std::optional<size_t> last = history_.previous(history_.end());
+        if (!last || history_.entry(*last) != line) {
+            history_.add(line);
+        }
+    }
+    return true;
+}
+
+int LineEditor::readByte() {
+    unsigned char c;
+    while (true) {
+        ssize_t size = ::read(fd_, &c, 1);
+        if (size == 1) {
+            return c;
+        }
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        return kEof;
+    }
+}
+
+int LineEditor::readEscape() {
+    int first = readByte();
+    if (first != '[' && first != 'O') {
+        return first == kEof ? kEof : kNone;
+    }
+    int second = readByte();
+    switch (second) {
+        case 'A':
+            return kUp;
+        case 'B':
+            return kDown;
+        case 'C':
+            return kRight;
+        case 'D':
+            return kLeft;
+        case 'H':
+            return kHome;
+        case 'F':
+            return kEnd;
+        default:
+            break;
+    }
+    if (second < '0' || second > '9') {
+        return second == kEof ? kEof : kNone;
+    }
+    // ESC [ число ~
+    int code = second - '0';
+    for (int c = readByte(); c != '~'; c = readByte()) {
+        if (c < '0' || c > '9') {
+            return c == kEof ? kEof : kNone;
+        }
+        code = code * 10 + (c - '0');
+    }
+    switch (code) {
+        case 1:
+        case 7:
+            return kHome;
+        case 4:
+        case 8:
+            return kEnd;
+        case 3:
+            return kDelete;
+        default:
+            return kNone;
+    }
+}
+
+int LineEditor::reverseSearch() {
+    const std::string original = buffer_;
+    const size_t originalCursor = cursor_;
+    std::string query;
+    size_t match = history_.end();  // end() — совпадения ещё нет
+    bool failed = false;
+
+    // Найти самую новую запись раньше before; при older пропустить повторы текущей
+    auto find = [&](size_t before, bool older) {
+        if (query.empty()) {
+            failed = false;
+            return;
+        }
+        std::optional<size_t> pos = history_.search(query, before);
+        while (older && pos && history_.entry(*pos) == buffer_) {
+            pos = history_.search(query, *pos);
+        }
+        failed = !pos;
+        if (pos) {
+            match = *pos;
+            setBuffer(history_.entry(*pos));
+            cursor_ = buffer_.find(query);
+        }
+    };
+    auto show = [&]() {
+        out_ << '\r' << (failed ? "(failed reverse-i-search)`" : "(reverse-i-search)`") << query
+             << "': " << buffer_ << "\x1b[K" << std::flush;
+    };
+
+    show();
+    while (true) {
+        int key = readByte();
+        if (key == kCtrlR) {
+            find(match, true);
+        } else if (key == kBackspace || key == kCtrlH) {
+            while (!query.empty()) {
+                char c = query.back();
+                query.pop_back();
+                if (!isContinuation(c)) {
+                    break;
+                }
+            }
+            match = history_.end();
+            find(match, false);
+        } else if (key == kCtrlG || key == kCtrlC) {
+            buffer_ = original;
+            cursor_ = originalCursor;
+            refresh();
+            return kNone;
+        } else if (isPrintable(key)) {
+            query.push_back(static_cast<char>(key));
+            find(match == history_.end() ? match : match + 1, false);
+        } else {
+            // Любая другая клавиша принимает совпадение и обрабатывается как обычно
+            if (match != history_.end()) {
+                historyPos_ = match;
+            }
+            refresh();
+            return key == kEscape ? readEscape() : key;
+        }
+        show();
+    }
+}
+
+void LineEditor::setBuffer(std::string_view text) {
+    buffer_.assign(text);
+    cursor_ = buffer_.size();
+}
+
+void LineEditor::historyStep(bool older) {
+    std::optional<size_t> pos = older ? history_.previous(historyPos_) : history_.next(historyPos_);
+    if (!pos) {
+        return;
+    }
+    if (historyPos_ == history_.end()) {
+        draft_ = buffer_;
+    }
+    historyPos_ = *pos;
+    if (historyPos_ == history_.end()) {
+        setBuffer(draft_);
+    } else {
+        setBuffer(history_.entry(historyPos_));
+    }
+    refresh();
+}
+
+void LineEditor::complete(bool list) {
+    // Сколько вариантов выводится по двойному Tab
+    constexpr size_t kMaxListed = 100;
+
+    if (completer_ == nullptr) {
+        return;
+    }
+    Completer::Result result = completer_->complete(buffer_, cursor_);
+    const auto& candidates = result.candidates;
+    if (candidates.empty()) {
+        out_ << '\a' << std::flush;
+        return;
+    }
+
+    // Единственный вариант дописывается целиком (с пробелом, если это не каталог),
+    // несколько — до общего префикса
+    std::string replacement =
+        candidates.size() == 1 ? candidates[0] : Completer::commonPrefix(candidates);
+    if (candidates.size() == 1 && replacement.back() != '/') {
+        replacement += ' ';
+    }
+    if (replacement.size() > cursor_ - result.start) {
+        buffer_.replace(result.start, cursor_ - result.start, replacement);
+        cursor_ = result.start + replacement.size();
+        refresh();
+        return;
+    }
+    if (!list) {
+        out_ << '\a' << std::flush;
+        return;
+    }
+    out_ << '\n';
+    for (size_t i = 0; i < candidates.size() && i < kMaxListed; ++i) {
+        out_ << candidates[i] << (i + 1 < candidates.size() ? "  " : "");
+    }
+    if (candidates.size() > kMaxListed) {
+        out_ << "... (" << candidates.size() - kMaxListed << " more)";
+    }
+    out_ << '\n';
+    refresh();
+}
+
+void LineEditor::refresh() {
+    out_ << '\r' << prompt_ << buffer_ << "\x1b[K";
+    size_t tail = columns(std::string_view(buffer_).substr(cursor_));
+    if (tail > 0) {
+        out_ << "\x1b[" << tail << 'D';
+    }
+    out_ << std::flush;
+}
+
+}  // namespace shell
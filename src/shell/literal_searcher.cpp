@@ -0,0 +1,185 @@
+#include "shell/literal_searcher.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHELL_LITERAL_SEARCHER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace shell {
+
+namespace {
+
+inline unsigned char foldCase(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+}
+
+inline bool isAsciiLetter(unsigned char c) {
+    unsigned char lower = static_cast<unsigned char>(c | 0x20);
+    return lower >= 'a' && lower <= 'z';
+}
+
+// Совпадает ли образец с текстом в позиции pos (needle при ignoreCase — в нижнем регистре)
+inline bool equalsAt(const char* pos, const std::string& needle, bool ignoreCase) {
+    if (!ignoreCase) {
+        return std::memcmp(pos, needle.data(), needle.size()) == 0;
+    }
+    for (size_t i = 0; i < needle.size(); ++i) {
+        if (foldCase(static_cast<unsigned char>(pos[i])) !=
+            static_cast<unsigned char>(needle[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* findScalar(const char* begin, const char* end, const std::string& needle,
+                       bool ignoreCase) {
+    size_t n = needle.size();
+    const char* last = end - n;
+    auto first = static_cast<unsigned char>(needle[0]);
+
+    for (const char* pos = begin; pos <= last; ++pos) {
+        if (!ignoreCase) {
+            pos = static_cast<const char*>(
+                std::memchr(pos, first, static_cast<size_t>(last - pos) + 1));
+            if (pos == nullptr) {
+                return end;
+            }
+        } else if (foldCase(static_cast<unsigned char>(*pos)) != first) {
+            continue;
+        }
+        if (equalsAt(pos, needle, ignoreCase)) {
+            return pos;
+        }
+    }
+    return end;
+}
+
+using FindKernel = const char* (*)(const char*, const char*, const std::string&, bool);
+
+#ifdef SHELL_LITERAL_SEARCHER_X86
+
+// Без учёта регистра байт текста приводится OR 0x20 только для позиций,
+// где в образце буква; лишние кандидаты (например, '@' для '`') отсеивает проверка
+inline char foldMask(unsigned char c, bool ignoreCase) {
+    return static_cast<char>(ignoreCase && isAsciiLetter(c) ? 0x20 : 0);
+}
+
+const char* findSse2(const char* begin, const char* end, const std::string& needle,
+                     bool ignoreCase) {
+    size_t n = needle.size();
+    auto size = static_cast<size_t>(end - begin);
+    auto firstByte = static_cast<unsigned char>(needle[0]);
+    auto lastByte = static_cast<unsigned char>(needle[n - 1]);
+    const __m128i first = _mm_set1_epi8(static_cast<char>(firstByte));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(lastByte));
+    const __m128i firstFold = _mm_set1_epi8(foldMask(firstByte, ignoreCase));
+    const __m128i lastFold = _mm_set1_epi8(foldMask(lastByte, ignoreCase));
+
+    size_t i = 0;
+    for (; i + n - 1 + 16 <= size; i += 16) {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i + n - 1));
+        __m128i hit = _mm_and_si128(_mm_cmpeq_epi8(_mm_or_si128(head, firstFold), first),
+                                    _mm_cmpeq_epi8(_mm_or_si128(tail, lastFold), last));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        while (mask != 0) {
+            const char* pos = begin + i + static_cast<size_t>(__builtin_ctz(mask));
+            if (equalsAt(pos, needle, ignoreCase)) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return findScalar(begin + i, end, needle, ignoreCase);
+}
+
+__attribute__((target("avx2"))) const char* findAvx2(const char* begin, const char* end,
+                                                     const std::string& needle, bool ignoreCase) {
+    size_t n = needle.size();
+    auto size = static_cast<size_t>(end - begin);
+    auto firstByte = static_cast<unsigned char>(needle[0]);
+    auto lastByte = static_cast<unsigned char>(needle[n - 1]);
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(firstByte));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(lastByte));
+    const __m256i firstFold = _mm256_set1_epi8(foldMask(firstByte, ignoreCase));
+    const __m256i lastFold = _mm256_set1_epi8(foldMask(lastByte, ignoreCase));
+
+    size_t i = 0;
+    for (; i + n - 1 + 32 <= size; i += 32) {
+        __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i));
+        __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i + n - 1));
+        __m256i hit =
+            _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_or_si256(head, firstFold), first),
+                             _mm256_cmpeq_epi8(_mm256_or_si256(tail, lastFold), last));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+        while (mask != 0) {
+            const char* pos = begin + i + static_cast<size_t>(__builtin_ctz(mask));
+            if (equalsAt(pos, needle, ignoreCase)) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return findScalar(begin + i, end, needle, ignoreCase);
+}
+
+#endif  // SHELL_LITERAL_SEARCHER_X86
+
+FindKernel selectKernel() {
+#ifdef SHELL_LITERAL_SEARCHER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return findAvx2;
+    }
+    return findSse2;
+#else
+    return findScalar;
+#endif
+}
+
+FindKernel kernel() {
+    static const FindKernel selected = selectKernel();
+    return selected;
+}
+
+}  // namespace
+
+LiteralSearcher::LiteralSearcher(std::string needle, bool ignoreCase)
+    : needle_(std::move(needle)), ignoreCase_(ignoreCase) {
+    if (ignoreCase_) {
+        for (auto& c : needle_) {
+            c = static_cast<char>(foldCase(static_cast<unsigned char>(c)));
+        }
+        // Образец без букв ищется быстрее с учётом регистра
+        bool hasLetters = false;
+        for (char c : needle_) {
+            hasLetters = hasLetters || isAsciiLetter(static_cast<unsigned char>(c));
+        }
+        ignoreCase_ = hasLetters;
+    }
+}
+
+const char* LiteralSearcher::find(const char* begin, const char* end) const {
+    size_t n = needle_.size();
+    if (n == 0) {
+        return begin;
+    }
+    if (static_cast<size_t>(end - begin) < n) {
+        return end;
+    }
+    if (n == 1 && !ignoreCase_) {
+        const void* pos =
+            std::memchr(begin, needle_[0], static_cast<size_t>(end - begin));
+        return pos != nullptr ? static_cast<const char*>(pos) : end;
+    }
+    return kernel()(begin, end, needle_, ignoreCase_);
+}
+
+}  // namespace shell
@@ -1,6 +1,15 @@
+#include <cstdlib>
+#include <cstring>
+
+#include "shell/launcher.hpp"
 #include "shell/shell.hpp"
 
 int main() {
+    // Запускатель создаётся до Shell, пока процесс ещё мал; SHELL_LAUNCHER=0 отключает его
+    const char* launcher = std::getenv("SHELL_LAUNCHER");
+    if (launcher == nullptr || std::strcmp(launcher, "0") != 0) {
+        shell::Launcher::shared().start();
+    }
     shell::Shell shell;
     return shell.run();
 }
@@ -0,0 +1,418 @@
+#include "shell/multi_literal_searcher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHELL_MULTI_LITERAL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace shell {
+
+namespace {
+
+// Наборы большего размера ищутся только автоматом: фильтр Teddy
+// на восьми группах даёт слишком много ложных кандидатов
+constexpr size_t kTeddyMaxPatterns = 32;
+constexpr size_t kTeddyBuckets = 8;
+constexpr size_t kTeddyMaxWidth = 3;
+
+// Полные строки переходов — для состояний глубины до 3 и ветвящихся состояний,
+// в пределах бюджета (в элементах)
+constexpr uint32_t kDenseDepth = 3;
+constexpr uint32_t kDenseEdges = 4;
+constexpr size_t kMaxRowEntries = size_t{1} << 22;
+
+constexpr uint32_t kNone = UINT32_MAX;
+
+inline unsigned char foldCase(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+}
+
+// Совпадает ли образец (при ignoreCase — в нижнем регистре) с текстом в позиции pos
+inline bool equalsAt(const char* pos, const std::string& pattern, bool ignoreCase) {
+    if (!ignoreCase) {
+        return std::memcmp(pos, pattern.data(), pattern.size()) == 0;
+    }
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (foldCase(static_cast<unsigned char>(pos[i])) !=
+            static_cast<unsigned char>(pattern[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Таблицы фильтра Teddy: бит b в lo[k][n] (hi[k][n]) означает, что у
+ * какого-то образца группы b байт k имеет младший (старший) полубайт n.
+ */
+struct TeddyTables {
+    size_t width = 0;  ///< Сколько первых байт образцов проверяет фильтр
+    uint8_t lo[kTeddyMaxWidth][16] = {};
+    uint8_t hi[kTeddyMaxWidth][16] = {};
+    std::vector<std::string> patterns;  ///< При ignoreCase — в нижнем регистре
+    std::vector<uint32_t> buckets[kTeddyBuckets];
+    bool ignoreCase = false;
+};
+
+// Проверить кандидата в позиции pos для групп из маски bits
+const char* verify(const TeddyTables& t, const char* pos, const char* end, unsigned bits) {
+    auto left = static_cast<size_t>(end - pos);
+    while (bits != 0) {
+        auto bucket = static_cast<size_t>(__builtin_ctz(bits));
+        for (uint32_t index : t.buckets[bucket]) {
+            const std::string& pattern = t.patterns[index];
+            if (pattern.size() <= left && equalsAt(pos, pattern, t.ignoreCase)) {
+                return pos;
+            }
+        }
+        bits &= bits - 1;
+    }
+    return nullptr;
+}
+
+const char* teddyScalar(const TeddyTables& t, const char* pos, const char* end) {
+    for (; static_cast<size_t>(end - pos) >= t.width; ++pos) {
+        unsigned bits = 0xFF;
+        for (size_t k = 0; k < t.width; ++k) {
+            auto c = static_cast<unsigned char>(pos[k]);
+            bits &= static_cast<unsigned>(t.lo[k][c & 0x0F] & t.hi[k][c >> 4]);
+        }
+        if (bits != 0) {
+            if (const char* hit = verify(t, pos, end, bits)) {
+                return hit;
+            }
+        }
+    }
+    return end;
+}
+
+using TeddyKernel = const char* (*)(const TeddyTables&, const char*, const char*);
+
+#ifdef SHELL_MULTI_LITERAL_X86
+
+__attribute__((target("ssse3"))) const char* teddySsse3(const TeddyTables& t, const char* begin,
+                                                        const char* end) {
+    auto size = static_cast<size_t>(end - begin);
+    const size_t width = t.width;
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i lo[kTeddyMaxWidth];
+    __m128i hi[kTeddyMaxWidth];
+    for (size_t k = 0; k < width; ++k) {
+        lo[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.lo[k]));
+        hi[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.hi[k]));
+    }
+
+    size_t i = 0;
+    for (; i + width - 1 + 16 <= size; i += 16) {
+        __m128i res = _mm_set1_epi8(-1);
+        for (size_t k = 0; k < width; ++k) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i + k));
+            __m128i low = _mm_shuffle_epi8(lo[k], _mm_and_si128(v, nibble));
+            __m128i high = _mm_shuffle_epi8(hi[k], _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+            res = _mm_and_si128(res, _mm_and_si128(low, high));
+        }
+        auto mask =
+            static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(res, _mm_setzero_si128()))) ^
+            0xFFFFU;
+        if (mask == 0) {
+            continue;
+        }
+        alignas(16) uint8_t bits[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(bits), res);
+        while (mask != 0) {
+            auto j = static_cast<size_t>(__builtin_ctz(mask));
+            if (const char* hit = verify(t, begin + i + j, end, bits[j])) {
+                return hit;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return teddyScalar(t, begin + i, end);
+}
+
+__attribute__((target("avx2"))) const char* teddyAvx2(const TeddyTables& t, const char* begin,
+                                                      const char* end) {
+    auto size = static_cast<size_t>(end - begin);
+    const size_t width = t.width;
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i lo[kTeddyMaxWidth];
+    __m256i hi[kTeddyMaxWidth];
+    for (size_t k = 0; k < width; ++k) {
+        lo[k] = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.lo[k])));
+        hi[k] = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.hi[k])));
+    }
+
+    size_t i = 0;
+    for (; i + width - 1 + 32 <= size; i += 32) {
+        __m256i res = _mm256_set1_epi8(-1);
+        for (size_t k = 0; k < width; ++k) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i + k));
+            __m256i low = _mm256_shuffle_epi8(lo[k], _mm256_and_si256(v, nibble));
+            __m256i high =
+                _mm256_shuffle_epi8(hi[k], _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+            res = _mm256_and_si256(res, _mm256_and_si256(low, high));
+        }
+        auto mask = ~static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(res, _mm256_setzero_si256())));
+        if (mask == 0) {
+            continue;
+        }
+        alignas(32) uint8_t bits[32];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(bits), res);
+        while (mask != 0) {
+            auto j = static_cast<size_t>(__builtin_ctz(mask));
+            if (const char* hit = verify(t, begin + i + j, end, bits[j])) {
+                return hit;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return teddyScalar(t, begin + i, end);
+}
+
+#endif  // SHELL_MULTI_LITERAL_X86
+
+// Без векторных инструкций фильтр не быстрее автомата — тогда nullptr
+TeddyKernel selectTeddy() {
+#ifdef SHELL_MULTI_LITERAL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return teddyAvx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return teddySsse3;
+    }
+#endif
+    return nullptr;
+}
+
+TeddyKernel teddyKernel() {
+    static const TeddyKernel selected = selectTeddy();
+    return selected;
+}
+
+}  // namespace
+
+struct MultiLiteralSearcher::Teddy : TeddyTables {};
+
+MultiLiteralSearcher::MultiLiteralSearcher(std::vector<std::string> patterns, bool ignoreCase)
+    : patterns_(std::move(patterns)) {
+    std::vector<std::string> folded;
+    folded.reserve(patterns_.size());
+    for (const auto& pattern : patterns_) {
+        if (pattern.empty()) {
+            matchesEmpty_ = true;
+            continue;
+        }
+        folded.push_back(pattern);
+        if (ignoreCase) {
+            for (auto& c : folded.back()) {
+                c = static_cast<char>(foldCase(static_cast<unsigned char>(c)));
+            }
+        }
+    }
+    std::sort(folded.begin(), folded.end());
+    folded.erase(std::unique(folded.begin(), folded.end()), folded.end());
+
+    // Классы байт: по одному на каждый байт образцов (по возрастанию, чтобы
+    // переходы отсортированных образцов шли по возрастанию класса) и общий для остальных
+    std::array<bool, 256> present{};
+    for (const auto& pattern : folded) {
+        for (char c : pattern) {
+            present[static_cast<unsigned char>(c)] = true;
+        }
+    }
+    size_t classes = 0;
+    for (size_t b = 0; b < 256; ++b) {
+        if (present[b]) {
+            byteClass_[b] = static_cast<uint8_t>(classes++);
+        }
+    }
+    classCount_ = classes < 256 ? classes + 1 : classes;
+    for (size_t b = 0; b < 256; ++b) {
+        if (!present[b]) {
+            auto lower = foldCase(static_cast<unsigned char>(b));
+            byteClass_[b] = ignoreCase && present[lower] ? byteClass_[lower]
+                                                         : static_cast<uint8_t>(classCount_ - 1);
+        }
+    }
+
+    if (!folded.empty() && folded.size() <= kTeddyMaxPatterns && teddyKernel() != nullptr) {
+        teddy_ = std::make_unique<Teddy>();
+        teddy_->ignoreCase = ignoreCase;
+        teddy_->width = kTeddyMaxWidth;
+        for (const auto& pattern : folded) {
+            teddy_->width = std::min(teddy_->width, pattern.size());
+        }
+        // Соседние после сортировки образцы (с общими началами) попадают в одну группу
+        for (size_t i = 0; i < folded.size(); ++i) {
+            size_t bucket = i * kTeddyBuckets / folded.size();
+            auto bit = static_cast<uint8_t>(1U << bucket);
+            teddy_->buckets[bucket].push_back(static_cast<uint32_t>(i));
+            for (size_t k = 0; k < teddy_->width; ++k) {
+                auto c = static_cast<unsigned char>(folded[i][k]);
+                teddy_->lo[k][c & 0x0F] |= bit;
+                teddy_->hi[k][c >> 4] |= bit;
+                if (ignoreCase && c >= 'a' && c <= 'z') {
+                    auto upper = static_cast<unsigned char>(c & ~0x20U);
+                    teddy_->lo[k][upper & 0x0F] |= bit;
+                    teddy_->hi[k][upper >> 4] |= bit;
+                }
+            }
+        }
+        teddy_->patterns = folded;
+    }
+
+    build(std::move(folded));
+}
+
+MultiLiteralSearcher::~MultiLiteralSearcher() = default;
+
+bool MultiLiteralSearcher::usesTeddy() const {
+    return teddy_ != nullptr;
+}
+
+void MultiLiteralSearcher::build(std::vector<std::string> folded) {
+    // Бор строится по отсортированным образцам: новый узел всегда становится
+    // последним ребёнком, поэтому хватает списков «первый ребёнок — следующий брат»
+    std::vector<uint32_t> firstChild{kNone};
+    std::vector<uint32_t> lastChild{kNone};
+    std::vector<uint32_t> nextSibling{kNone};
+    std::vector<uint8_t> nodeClass{0};
+    std::vector<uint32_t> terminal{0};
+
+    std::vector<uint32_t> path{0};
+    const std::string* previous = nullptr;
+    for (const auto& pattern : folded) {
+        size_t common = 0;
+        if (previous != nullptr) {
+            size_t limit = std::min(previous->size(), pattern.size());
+            while (common < limit && (*previous)[common] == pattern[common]) {
+                ++common;
+            }
+        }
+        path.resize(common + 1);
+        for (size_t i = common; i < pattern.size(); ++i) {
+            auto id = static_cast<uint32_t>(firstChild.size());
+            uint32_t parent = path.back();
+            firstChild.push_back(kNone);
+            lastChild.push_back(kNone);
+            nextSibling.push_back(kNone);
+            nodeClass.push_back(byteClass_[static_cast<unsigned char>(pattern[i])]);
+            terminal.push_back(0);
+            if (lastChild[parent] == kNone) {
+                firstChild[parent] = id;
+            } else {
+                nextSibling[lastChild[parent]] = id;
+            }
+            lastChild[parent] = id;
+            path.push_back(id);
+        }
+        terminal[path.back()] = static_cast<uint32_t>(pattern.size());
+        previous = &pattern;
+    }
+    folded.clear();
+    folded.shrink_to_fit();
+    lastChild = {};
+
+    // Перенумерация в порядке обхода в ширину: переходы каждого состояния
+    // лежат подряд, а ссылки неудачи указывают на состояния с меньшими номерами
+    size_t count = firstChild.size();
+    nodes_.assign(count, Node{});
+    std::vector<uint32_t> order{0};
+    order.reserve(count);
+    edgeClass_.reserve(count - 1);
+    edgeTarget_.reserve(count - 1);
+    for (size_t head = 0; head < order.size(); ++head) {
+        uint32_t old = order[head];
+        Node& node = nodes_[head];
+        node.edges = static_cast<uint32_t>(edgeClass_.size());
+        node.match = terminal[old];
+        for (uint32_t child = firstChild[old]; child != kNone; child = nextSibling[child]) {
+            edgeClass_.push_back(nodeClass[child]);
+            edgeTarget_.push_back(static_cast<uint32_t>(order.size()));
+            order.push_back(child);
+        }
+        node.edgeCount = static_cast<uint32_t>(edgeClass_.size()) - node.edges;
+    }
+
+    std::vector<uint32_t> depth(count, 0);
+    for (size_t u = 0; u < count; ++u) {
+        Node& node = nodes_[u];
+        if (u != 0 && node.match == 0) {
+            node.match = nodes_[node.fail].match;
+        }
+
+        bool dense = u == 0 || depth[u] <= kDenseDepth || node.edgeCount >= kDenseEdges;
+        if (dense && rows_.size() + classCount_ <= kMaxRowEntries) {
+            size_t row = rows_.size();
+            node.row = static_cast<uint32_t>(row / classCount_);
+            rows_.resize(row + classCount_, 0);
+            if (u != 0) {
+                for (size_t c = 0; c < classCount_; ++c) {
+                    rows_[row + c] = next(node.fail, static_cast<uint8_t>(c));
+                }
+            }
+            for (uint32_t e = node.edges; e < node.edges + node.edgeCount; ++e) {
+                rows_[row + edgeClass_[e]] = edgeTarget_[e];
+            }
+        }
+
+        for (uint32_t e = node.edges; e < node.edges + node.edgeCount; ++e) {
+            uint32_t child = edgeTarget_[e];
+            depth[child] = depth[u] + 1;
+            nodes_[child].fail = u == 0 ? 0 : next(node.fail, edgeClass_[e]);
+        }
+    }
+}
+
+uint32_t MultiLiteralSearcher::next(uint32_t state, uint8_t cls) const {
+    while (true) {
+        const Node& node = nodes_[state];
+        if (node.row != kNoRow) {
+            return rows_[static_cast<size_t>(node.row) * classCount_ + cls];
+        }
+        const uint8_t* classes = edgeClass_.data() + node.edges;
+        for (uint32_t i = 0; i < node.edgeCount; ++i) {
+            if (classes[i] == cls) {
+                return edgeTarget_[node.edges + i];
+            }
+        }
+        state = node.fail;
+    }
+}
+
+const char* MultiLiteralSearcher::findAutomaton(const char* begin, const char* end) const {
+    uint32_t state = 0;
+    for (const char* pos = begin; pos < end; ++pos) {
+        state = next(state, byteClass_[static_cast<unsigned char>(*pos)]);
+        uint32_t length = nodes_[state].match;
+        if (length != 0) {
+            return pos + 1 - length;
+        }
+    }
+    return end;
+}
+
+const char* MultiLiteralSearcher::find(const char* begin, const char* end) const {
+    if (matchesEmpty_) {
+        return begin;
+    }
+    if (begin >= end || nodes_.size() == 1) {
+        return end;
+    }
+    if (teddy_) {
+        return teddyKernel()(*teddy_, begin, end);
+    }
+    return findAutomaton(begin, end);
+}
+
+}  // namespace shell
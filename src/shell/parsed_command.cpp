@@ -2,16 +2,28 @@
 
 namespace shell {
 
-ParsedAssignment::ParsedAssignment(std::string name, std::string val)
-    : variableName(std::move(name)), value(std::move(val)) {}
+ParsedAssignment::ParsedAssignment(std::string_view name, std::string_view val,
+                                   std::pmr::memory_resource* resource)
+    : variableName(name, resource), value(val, resource) {}
 
-ParsedSimpleCommand::ParsedSimpleCommand(std::string name, std::vector<std::string> args)
-    : commandName(std::move(name)), arguments(std::move(args)) {}
+ParsedSimpleCommand::ParsedSimpleCommand(std::pmr::memory_resource* resource)
+    : commandName(resource), arguments(resource) {}
+
+ParsedSimpleCommand::ParsedSimpleCommand(std::string_view name,
+                                         std::pmr::vector<std::pmr::string> args)
+    : commandName(name, args.get_allocator().resource()),
+      arguments(std::move(args)),
+      builtin(lookupBuiltin(name)) {}
+
+ParsedPipeline::ParsedPipeline(std::pmr::memory_resource* resource) : commands(resource) {}
 
 void ParsedPipeline::addCommand(ParsedSimpleCommand cmd) {
     commands.push_back(std::move(cmd));
 }
 
+ParsedAssignmentList::ParsedAssignmentList(std::pmr::memory_resource* resource)
+    : assignments(resource) {}
+
 void ParsedAssignmentList::addAssignment(ParsedAssignment assignment) {
     assignments.push_back(std::move(assignment));
 }
@@ -4,9 +4,10 @@
 
 namespace shell {
 
-Parser::Parser(std::vector<Token> tokens) : tokens_(std::move(tokens)), position_(0) {}
+Parser::Parser(std::pmr::vector<Token> tokens)
+    : tokens_(std::move(tokens)), resource_(tokens_.get_allocator().resource()), position_(0) {}
 
-std::unique_ptr<ParsedCommand> Parser::parse() {
+ParsedCommand Parser::parse() {
     return parseCommandLine();
 }
 
@@ -46,7 +47,7 @@ bool Parser::isAssignmentToken(const Token& token) const {
         return false;
     }
 
-    const std::string& value = token.value;
+    std::string_view value = token.value;
     size_t eqPos = value.find('=');
 
     // Должен быть знак = и непустое имя переменной до него
@@ -74,37 +75,32 @@ bool Parser::isAssignmentToken(const Token& token) const {
     return true;
 }
 
-std::unique_ptr<ParsedCommand> Parser::parseCommandLine() {
+ParsedCommand Parser::parseCommandLine() {
     // Пустая строка
     if (isAtEnd()) {
-        return std::make_unique<ParsedEmpty>();
+        return ParsedEmpty{};
     }
 
     // Проверяем, начинается ли строка с присваиваний
-    std::vector<ParsedAssignment> assignments;
+    std::pmr::vector<ParsedAssignment> assignments(resource_);
 
     while (!isAtEnd() && isAssignmentToken(current())) {
-        const std::string& value = current().value;
+        std::string_view value = current().value;
         size_t eqPos = value.find('=');
-        std::string varName = value.substr(0, eqPos);
-        std::string varValue = value.substr(eqPos + 1);
-        assignments.emplace_back(std::move(varName), std::move(varValue));
+        assignments.emplace_back(value.substr(0, eqPos), value.substr(eqPos + 1), resource_);
         advance();
     }
 
     // Если после присваиваний ничего нет — это только присваивания
     if (isAtEnd()) {
         if (assignments.empty()) {
-            return std::make_unique<ParsedEmpty>();
+            return ParsedEmpty{};
         }
         if (assignments.size() == 1) {
-            return std::make_unique<ParsedAssignment>(std::move(assignments[0].variableName),
-                                                      std::move(assignments[0].value));
-        }
-        auto list = std::make_unique<ParsedAssignmentList>();
-        for (auto& a : assignments) {
-            list->addAssignment(std::move(a));
+            return std::move(assignments[0]);
         }
+        ParsedAssignmentList list(resource_);
+        list.assignments = std::move(assignments);
         return list;
     }
 
@@ -112,21 +108,21 @@ std::unique_ptr<ParsedCommand> Parser::parseCommandLine() {
     // (присваивания перед командой пока игнорируем — для полной совместимости
     // с bash нужна более сложная логика)
 
-    auto pipeline = std::make_unique<ParsedPipeline>();
+    ParsedPipeline pipeline(resource_);
 
     // Первая команда
-    pipeline->addCommand(parseSimpleCommand());
+    pipeline.addCommand(parseSimpleCommand());
 
     // Остальные команды через |
     while (match(TokenType::PIPE)) {
-        pipeline->addCommand(parseSimpleCommand());
+        pipeline.addCommand(parseSimpleCommand());
     }
 
     return pipeline;
 }
 
 ParsedSimpleCommand Parser::parseSimpleCommand() {
-    ParsedSimpleCommand cmd;
+    ParsedSimpleCommand cmd(resource_);
 
     if (isAtEnd()) {
         return cmd;
@@ -135,6 +131,7 @@ ParsedSimpleCommand Parser::parseSimpleCommand() {
     // Первый токен — имя команды
     if (current().type == TokenType::WORD) {
         cmd.commandName = current().value;
+        cmd.builtin = lookupBuiltin(cmd.commandName);
         advance();
     }
 
@@ -0,0 +1,328 @@
+#include "shell/path_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+namespace shell {
+
+namespace {
+
+// Стандартные пути на случай пустого PATH
+const char* const kDefaultPath = "/usr/local/bin:/usr/bin:/bin";
+
+// Пустой элемент PATH (":" в начале, в конце или "::") — текущий каталог, как в POSIX
+std::vector<std::string> splitPath(const std::string& pathVar) {
+    std::vector<std::string> dirs;
+    size_t start = 0;
+    while (start <= pathVar.size()) {
+        size_t colon = pathVar.find(':', start);
+        if (colon == std::string::npos) {
+            colon = pathVar.size();
+        }
+        dirs.push_back(colon == start ? "." : pathVar.substr(start, colon - start));
+        start = colon + 1;
+    }
+    return dirs;
+}
+
+bool isExecutable(const std::string& dir, const std::string& name) {
+    std::string fullPath = dir + "/" + name;
+    return access(fullPath.c_str(), X_OK) == 0;
+}
+
+}  // namespace
+
+PathCache::PathCache(const Environment& env) : env_(env) {}
+
+PathCache::~PathCache() {
+    closeWatches();
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);
+    }
+}
+
+std::optional<std::string> PathCache::lookup(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    syncWithEnvironment();
+    drainEvents();
+
+    auto it = entries_.find(name);
+    if (it != entries_.end() && !it->second.pinned) {
+        // Директории без inotify проверяем по mtime; запись может быть удалена
+        size_t limit = it->second.scannedDirs;
+        for (size_t i = 0; i < limit && i < dirs_.size(); ++i) {
+            if (dirs_[i].watch < 0 && refreshDirState(dirs_[i])) {
+                invalidateFrom(i);
+                break;
+            }
+        }
+        it = entries_.find(name);
+    }
+
+    if (it == entries_.end()) {
+        it = entries_.emplace(name, resolveEntry(name)).first;
+    }
+
+    if (it->second.path.empty()) {
+        return std::nullopt;
+    }
+    it->second.hits++;
+    return it->second.path;
+}
+
+bool PathCache::remember(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    syncWithEnvironment();
+    drainEvents();
+
+    CacheEntry entry = resolveEntry(name);
+    bool found = !entry.path.empty();
+    entries_[name] = std::move(entry);
+    return found;
+}
+
+void PathCache::seed(const std::string& name, const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    syncWithEnvironment();
+
+    CacheEntry entry;
+    entry.path = path;
+    entry.pinned = true;
+    entries_[name] = std::move(entry);
+}
+
+std::optional<std::string> PathCache::peek(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(name);
+    if (it == entries_.end() || it->second.path.empty()) {
+        return std::nullopt;
+    }
+    return it->second.path;
+}
+
+bool PathCache::remove(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(name);
+    if (it == entries_.end() || it->second.path.empty()) {
+        return false;
+    }
+    entries_.erase(it);
+    return true;
+}
+
+void PathCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+std::vector<PathCache::Entry> PathCache::entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Entry> result;
+    for (const auto& [name, entry] : entries_) {
+        if (!entry.path.empty()) {
+            result.push_back({name, entry.path, entry.hits});
+        }
+    }
+    std::sort(result.begin(), result.end(),
+              [](const Entry& a, const Entry& b) { return a.name < b.name; });
+    return result;
+}
+
+std::vector<PathCache::DirectoryStamp> PathCache::directoryStamps() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    syncWithEnvironment();
+    drainEvents();
+
+    std::vector<DirectoryStamp> result;
+    result.reserve(dirs_.size());
+    for (size_t i = 0; i < dirs_.size(); ++i) {
+        if (dirs_[i].watch < 0 && refreshDirState(dirs_[i])) {
+            invalidateFrom(i);
+        }
+        result.push_back({dirs_[i].path, dirs_[i].stamp});
+    }
+    return result;
+}
+
+std::optional<std::string> PathCache::resolve(const std::string& name, const std::string& pathVar) {
+    for (const auto& dir : splitPath(pathVar.empty() ? kDefaultPath : pathVar)) {
+        if (isExecutable(dir, name)) {
+            return dir + "/" + name;
+        }
+    }
+    return std::nullopt;
+}
+
+void PathCache::syncWithEnvironment() {
+    if (initialized_ && env_.getVersion() == seenVersion_) {
+        return;
+    }
+    seenVersion_ = env_.getVersion();
+
+    std::string pathVar = env_.get("PATH");
+    if (initialized_ && pathVar == pathVar_) {
+        return;
+    }
+
+    // PATH изменился — все результаты поиска недействительны
+    initialized_ = true;
+    pathVar_ = std::move(pathVar);
+    entries_.clear();
+    rebuildDirs();
+}
+
+void PathCache::rebuildDirs() {
+    closeWatches();
+    dirs_.clear();
+
+#ifdef __linux__
+    if (inotifyFd_ < 0) {
+        inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    }
+#endif
+
+    for (auto& dirPath : splitPath(pathVar_.empty() ? kDefaultPath : pathVar_)) {
+        DirState dir;
+        dir.path = std::move(dirPath);
+        dir.stamp = ++lastStamp_;
+#ifdef __linux__
+        // Относительный каталог зависит от текущего: inotify следил бы за тем, что был
+        // текущим при наблюдении, поэтому такие каталоги проверяются по mtime
+        if (inotifyFd_ >= 0 && dir.path.front() == '/') {
+            const uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB |
+                                  IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+            dir.watch = inotify_add_watch(inotifyFd_, dir.path.c_str(), mask);
+        }
+#endif
+        dirs_.push_back(std::move(dir));
+    }
+}
+
+void PathCache::closeWatches() {
+#ifdef __linux__
+    if (inotifyFd_ < 0) {
+        return;
+    }
+    for (auto& dir : dirs_) {
+        if (dir.watch >= 0) {
+            // Повторное удаление того же дескриптора (дубликаты в PATH) безвредно
+            inotify_rm_watch(inotifyFd_, dir.watch);
+            dir.watch = -1;
+        }
+    }
+#endif
+}
+
+void PathCache::drainEvents() {
+#ifdef __linux__
+    if (inotifyFd_ < 0) {
+        return;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    size_t firstChanged = dirs_.size();
+
+    while (true) {
+        ssize_t bytesRead = read(inotifyFd_, buffer, sizeof(buffer));
+        if (bytesRead <= 0) {
+            break;
+        }
+
+        size_t offset = 0;
+        while (offset + sizeof(inotify_event) <= static_cast<size_t>(bytesRead)) {
+            inotify_event event;
+            std::memcpy(&event, buffer + offset, sizeof(event));
+            offset += sizeof(inotify_event) + event.len;
+
+            if ((event.mask & IN_Q_OVERFLOW) != 0) {
+                firstChanged = 0;
+                for (auto& dir : dirs_) {
+                    dir.stamp = ++lastStamp_;
+                }
+                continue;
+            }
+
+            for (size_t i = 0; i < dirs_.size(); ++i) {
+                if (dirs_[i].watch != event.wd) {
+                    continue;
+                }
+                firstChanged = std::min(firstChanged, i);
+                dirs_[i].stamp = ++lastStamp_;
+                if ((event.mask & IN_IGNORED) != 0) {
+                    // Директория удалена или перемещена — дальше следим по mtime
+                    dirs_[i].watch = -1;
+                    dirs_[i].known = false;
+                }
+            }
+        }
+    }
+
+    if (firstChanged < dirs_.size()) {
+        invalidateFrom(firstChanged);
+    }
+#endif
+}
+
+void PathCache::invalidateFrom(size_t dirIndex) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (!it->second.pinned && it->second.scannedDirs > dirIndex) {
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool PathCache::refreshDirState(DirState& dir) {
+    struct stat st {};
+    bool exists = stat(dir.path.c_str(), &st) == 0;
+    int64_t sec = 0;
+    int64_t nsec = 0;
+    if (exists) {
+#ifdef __APPLE__
+        sec = st.st_mtimespec.tv_sec;
+        nsec = st.st_mtimespec.tv_nsec;
+#else
+        sec = st.st_mtim.tv_sec;
+        nsec = st.st_mtim.tv_nsec;
+#endif
+    }
+
+    bool changed = dir.known && (exists != dir.exists || sec != dir.mtimeSec ||
+                                 nsec != dir.mtimeNsec);
+    if (changed) {
+        dir.stamp = ++lastStamp_;
+    }
+    dir.known = true;
+    dir.exists = exists;
+    dir.mtimeSec = sec;
+    dir.mtimeNsec = nsec;
+    return changed;
+}
+
+PathCache::CacheEntry PathCache::resolveEntry(const std::string& name) {
+    CacheEntry entry;
+    for (size_t i = 0; i < dirs_.size(); ++i) {
+        DirState& dir = dirs_[i];
+        if (dir.watch < 0 && !dir.known) {
+            // Запоминаем исходное состояние директории для ленивой проверки
+            refreshDirState(dir);
+        }
+        if (isExecutable(dir.path, name)) {
+            entry.path = dir.path + "/" + name;
+            entry.scannedDirs = i + 1;
+            return entry;
+        }
+    }
+    entry.scannedDirs = dirs_.size();
+    return entry;
+}
+
+}  // namespace shell
@@ -0,0 +1,159 @@
+#include "shell/pattern_file_cache.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+#include <sys/stat.h>
+
+#include "shell/input_file.hpp"
+
+namespace shell {
+
+namespace {
+
+constexpr size_t kBlockSize = 64 * 1024;
+
+bool openPatternFile(const std::string& path, InputFile& file, std::string* error) {
+    file = InputFile(path);
+    if (!file.isOpen() || file.isDirectory()) {
+        if (error != nullptr) {
+            *error = path + ": " + file.errorMessage();
+        }
+        return false;
+    }
+    return true;
+}
+
+// Образцы — строки файла; пустой хвост после последнего '\n' образцом не считается
+bool readLines(InputFile& file, const std::string& path, std::vector<std::string>& patterns,
+               std::string* error) {
+    std::string content;
+    std::string_view mapped = file.map();
+    if (!mapped.empty()) {
+        content.assign(mapped.data(), mapped.size());
+    } else {
+        auto block = std::make_unique<char[]>(kBlockSize);
+        ssize_t bytesRead = 0;
+        while ((bytesRead = file.read(block.get(), kBlockSize)) > 0) {
+            content.append(block.get(), static_cast<size_t>(bytesRead));
+        }
+        if (bytesRead < 0) {
+            if (error != nullptr) {
+                *error = path + ": read error";
+            }
+            return false;
+        }
+    }
+
+    size_t start = 0;
+    while (start < content.size()) {
+        size_t newline = content.find('\n', start);
+        if (newline == std::string::npos) {
+            newline = content.size();
+        }
+        patterns.emplace_back(content, start, newline - start);
+        start = newline + 1;
+    }
+    return true;
+}
+
+// Идентификатор версии файла: устройство, inode, время изменения, размер
+std::string fileKey(int fd, bool ignoreCase) {
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        return {};
+    }
+#ifdef __APPLE__
+    int64_t sec = st.st_mtimespec.tv_sec;
+    int64_t nsec = st.st_mtimespec.tv_nsec;
+#else
+    int64_t sec = st.st_mtim.tv_sec;
+    int64_t nsec = st.st_mtim.tv_nsec;
+#endif
+    return std::to_string(static_cast<uint64_t>(st.st_dev)) + ':' +
+           std::to_string(static_cast<uint64_t>(st.st_ino)) + ':' + std::to_string(sec) + '.' +
+           std::to_string(nsec) + ':' + std::to_string(static_cast<int64_t>(st.st_size)) +
+           (ignoreCase ? ":i" : ":");
+}
+
+}  // namespace
+
+PatternFileCache::PatternFileCache(size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+std::shared_ptr<const MultiLiteralSearcher> PatternFileCache::get(
+    const std::string& path, bool ignoreCase, const LiteralTest& literal,
+    std::vector<std::string>& patterns, std::string* error) {
+    InputFile file;
+    if (!openPatternFile(path, file, error)) {
+        return nullptr;
+    }
+
+    std::string key = fileKey(file.fd(), ignoreCase);
+    std::shared_ptr<const MultiLiteralSearcher> cached;
+    if (!key.empty()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            hits_++;
+            cached = it->second->second;
+        }
+    }
+    // Автомат строился для строк; при другом синтаксисе (без -F) образцы проверяются снова
+    if (cached) {
+        const auto& cachedPatterns = cached->patterns();
+        if (std::all_of(cachedPatterns.begin(), cachedPatterns.end(), literal)) {
+            return cached;
+        }
+        patterns.insert(patterns.end(), cachedPatterns.begin(), cachedPatterns.end());
+        return nullptr;
+    }
+
+    // Чтение и построение — вне блокировки: для больших списков это долго
+    std::vector<std::string> lines;
+    if (!readLines(file, path, lines, error)) {
+        return nullptr;
+    }
+    if (!std::all_of(lines.begin(), lines.end(), literal)) {
+        patterns.insert(patterns.end(), std::make_move_iterator(lines.begin()),
+                        std::make_move_iterator(lines.end()));
+        return nullptr;
+    }
+    auto searcher = std::make_shared<const MultiLiteralSearcher>(std::move(lines), ignoreCase);
+    if (key.empty()) {
+        return searcher;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        return it->second->second;
+    }
+    entries_.emplace_front(key, searcher);
+    index_[key] = entries_.begin();
+    if (entries_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    return searcher;
+}
+
+bool PatternFileCache::readPatterns(const std::string& path, std::vector<std::string>& patterns,
+                                    std::string* error) {
+    InputFile file;
+    return openPatternFile(path, file, error) && readLines(file, path, patterns, error);
+}
+
+size_t PatternFileCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t PatternFileCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+}  // namespace shell
@@ -2,7 +2,13 @@
 
 namespace shell {
 
+Pipeline::Pipeline(std::pmr::memory_resource* resource) : commands_(resource) {}
+
 void Pipeline::addCommand(std::unique_ptr<Command> command) {
+    commands_.emplace_back(command.release());
+}
+
+void Pipeline::addCommand(CommandPtr command) {
     commands_.push_back(std::move(command));
 }
 
@@ -4,16 +4,17 @@ namespace shell {
 
 PipelineBuilder::PipelineBuilder(CommandFactory& factory) : factory_(factory) {}
 
-Pipeline PipelineBuilder::build(const ParsedPipeline& parsed) {
-    Pipeline pipeline;
+Pipeline PipelineBuilder::build(const ParsedPipeline& parsed,
+                                std::pmr::memory_resource* resource) {
+    Pipeline pipeline(resource);
 
     for (const auto& parsedCmd : parsed.commands) {
         // Пропускаем пустые имена команд (например, "| wc" или "echo |")
         if (parsedCmd.commandName.empty()) {
             continue;
         }
-        auto command = factory_.create(parsedCmd.commandName);
-        command->setArguments(parsedCmd.arguments);
+        auto command = factory_.create(parsedCmd.builtin, parsedCmd.commandName, resource);
+        command->assignArguments(parsedCmd.arguments);
         pipeline.addCommand(std::move(command));
     }
 
@@ -0,0 +1,115 @@
+#include "shell/plugin_table.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <dlfcn.h>
+
+namespace shell {
+
+namespace {
+
+// Собирает команды, которые регистрирует плагин
+class CollectingRegistrar : public PluginRegistrar {
+public:
+    void add(const char* name, Factory factory) override {
+        if (name != nullptr && factory != nullptr) {
+            commands.emplace_back(name, factory);
+        }
+    }
+
+    std::vector<std::pair<std::string, Factory>> commands;
+};
+
+template <typename Function>
+Function findSymbol(void* library, const char* name) {
+    return reinterpret_cast<Function>(dlsym(library, name));
+}
+
+}  // namespace
+
+PluginTable::~PluginTable() {
+    commands_.clear();
+    for (void* library : libraries_) {
+        dlclose(library);
+    }
+}
+
+bool PluginTable::load(const std::string& path, const std::vector<std::string>& names,
+                       std::string& error) {
+    void* library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (library == nullptr) {
+        const char* message = dlerror();
+        error = "cannot open shared object " + path + ": " + (message ? message : "unknown error");
+        return false;
+    }
+
+    auto version = findSymbol<int (*)()>(library, "shell_plugin_abi_version");
+    auto registerCommands =
+        findSymbol<void (*)(PluginRegistrar*)>(library, "shell_plugin_register");
+    if (version == nullptr || registerCommands == nullptr) {
+        error = path + ": not a shell plugin";
+        dlclose(library);
+        return false;
+    }
+    if (int abi = version(); abi != kPluginAbiVersion) {
+        error = path + ": plugin ABI version " + std::to_string(abi) + ", expected " +
+                std::to_string(kPluginAbiVersion);
+        dlclose(library);
+        return false;
+    }
+
+    CollectingRegistrar registrar;
+    registerCommands(&registrar);
+
+    // Сначала проверяем все имена: либо включаются все, либо ни одно
+    std::vector<std::pair<std::string, PluginRegistrar::Factory>> enabled;
+    if (names.empty()) {
+        enabled = registrar.commands;
+    }
+    for (const auto& name : names) {
+        auto it = std::find_if(registrar.commands.begin(), registrar.commands.end(),
+                               [&](const auto& command) { return command.first == name; });
+        if (it == registrar.commands.end()) {
+            error = name + ": not found in " + path;
+            dlclose(library);
+            return false;
+        }
+        enabled.push_back(*it);
+    }
+    if (enabled.empty()) {
+        error = path + ": plugin registers no commands";
+        dlclose(library);
+        return false;
+    }
+
+    for (auto& [name, factory] : enabled) {
+        commands_[name] = Entry{name, path, factory};
+    }
+    libraries_.push_back(library);
+    return true;
+}
+
+bool PluginTable::remove(const std::string& name) {
+    return commands_.erase(name) > 0;
+}
+
+CommandPtr PluginTable::create(std::string_view name) const {
+    auto it = commands_.find(name);
+    if (it == commands_.end()) {
+        return nullptr;
+    }
+    // Объект создан new внутри плагина, удаляется обычным delete
+    return CommandPtr(it->second.factory());
+}
+
+std::vector<PluginTable::Entry> PluginTable::entries() const {
+    std::vector<Entry> result;
+    result.reserve(commands_.size());
+    for (const auto& item : commands_) {
+        result.push_back(item.second);
+    }
+    return result;
+}
+
+}  // namespace shell
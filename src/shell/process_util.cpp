@@ -0,0 +1,121 @@
+#include "shell/process_util.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace shell {
+
+bool openPipe(int fds[2]) {
+#ifdef __linux__
+    return pipe2(fds, O_CLOEXEC) == 0;
+#else
+    if (pipe(fds) < 0) {
+        return false;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#endif
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+void ignoreSigpipe() {
+    static std::once_flag once;
+    std::call_once(once, [] { signal(SIGPIPE, SIG_IGN); });
+}
+
+pid_t spawnProcess(const std::string& path, const std::vector<std::string>& args,
+                   const std::vector<std::string>& env, int stdinFd, int stdoutFd) {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(path.c_str()));
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    std::vector<char*> envp;
+    for (const auto& s : env) {
+        envp.push_back(const_cast<char*>(s.c_str()));
+    }
+    envp.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+
+    // Дочерний процесс: игнорирование SIGPIPE наследуется через execve
+    signal(SIGPIPE, SIG_DFL);
+
+    // Перенаправляем stdin и stdout; остальные концы каналов закроются при execve
+    if (stdinFd >= 0) {
+        dup2(stdinFd, STDIN_FILENO);
+    }
+    if (stdoutFd >= 0) {
+        dup2(stdoutFd, STDOUT_FILENO);
+    }
+
+    execve(path.c_str(), argv.data(), envp.data());
+
+    // Если execve вернулся — ошибка
+    _exit(127);
+}
+
+int waitProcess(pid_t pid) {
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return 1;
+        }
+    }
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        return 128 + WTERMSIG(status);
+    }
+    return 1;
+}
+
+int waitProcess(pid_t pid, int pidfd) {
+#ifdef __linux__
+    if (pidfd >= 0) {
+        // P_PIDFD (Linux 5.4) может отсутствовать в заголовках libc
+        constexpr auto kPidfdType = static_cast<idtype_t>(3);
+        siginfo_t info{};
+        int result = 0;
+        while ((result = waitid(kPidfdType, static_cast<id_t>(pidfd), &info, WEXITED)) < 0 &&
+               errno == EINTR) {
+        }
+        close(pidfd);
+        if (result == 0) {
+            return info.si_code == CLD_EXITED ? info.si_status : 128 + info.si_status;
+        }
+    }
+#else
+    if (pidfd >= 0) {
+        close(pidfd);
+    }
+#endif
+    return waitProcess(pid);
+}
+
+}  // namespace shell
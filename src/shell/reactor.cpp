@@ -0,0 +1,99 @@
+#include "shell/reactor.hpp"
+
+#include <array>
+#include <cerrno>
+
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+namespace shell {
+
+#ifdef __linux__
+
+static_assert(Reactor::kReadable == EPOLLIN && Reactor::kWritable == EPOLLOUT);
+
+Reactor::Reactor() : epoll_(epoll_create1(EPOLL_CLOEXEC)) {}
+
+Reactor::~Reactor() {
+    if (epoll_ >= 0) {
+        close(epoll_);
+    }
+}
+
+bool Reactor::add(int fd, uint32_t events, Handler handler) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return false;
+    }
+    handlers_[fd] = std::make_unique<Handler>(std::move(handler));
+    return true;
+}
+
+void Reactor::modify(int fd, uint32_t events) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    epoll_ctl(epoll_, EPOLL_CTL_MOD, fd, &event);
+}
+
+void Reactor::remove(int fd) {
+    auto it = handlers_.find(fd);
+    if (it == handlers_.end()) {
+        return;
+    }
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, fd, nullptr);
+    retired_.push_back(std::move(it->second));
+    handlers_.erase(it);
+}
+
+void Reactor::run() {
+    std::array<epoll_event, 32> events;
+    while (!handlers_.empty()) {
+        int count = epoll_wait(epoll_, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            const epoll_event& event = events[static_cast<size_t>(i)];
+            // Дескриптор мог быть снят обработчиком раньше в этой же пачке
+            auto it = handlers_.find(event.data.fd);
+            if (it == handlers_.end()) {
+                continue;
+            }
+            uint32_t ready = event.events & (kReadable | kWritable);
+            if ((event.events & (EPOLLHUP | EPOLLERR)) != 0) {
+                ready |= kReadable | kWritable;
+            }
+            (*it->second)(ready);
+        }
+        retired_.clear();
+    }
+}
+
+#else  // __linux__
+
+Reactor::Reactor() = default;
+
+Reactor::~Reactor() = default;
+
+bool Reactor::add(int, uint32_t, Handler) {
+    return false;
+}
+
+void Reactor::modify(int, uint32_t) {}
+
+void Reactor::remove(int) {}
+
+void Reactor::run() {}
+
+#endif  // __linux__
+
+}  // namespace shell
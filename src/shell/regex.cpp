@@ -0,0 +1,763 @@
+#include "shell/regex.hpp"
+
+#include <cctype>
+#include <utility>
+
+namespace shell {
+
+namespace {
+
+// Ограничения на размер, чтобы образец из ввода не исчерпал память
+constexpr int kMaxRepeat = 1000;
+constexpr size_t kMaxProgram = 100000;
+
+using ByteSet = std::array<uint64_t, 4>;
+
+void addByte(ByteSet& set, unsigned c) {
+    set[c >> 6] |= uint64_t{1} << (c & 63);
+}
+
+void addRange(ByteSet& set, unsigned lo, unsigned hi) {
+    for (unsigned c = lo; c <= hi; ++c) {
+        addByte(set, c);
+    }
+}
+
+bool hasByte(const ByteSet& set, unsigned c) {
+    return ((set[c >> 6] >> (c & 63)) & 1) != 0;
+}
+
+bool isLetter(unsigned c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/**
+ * Узел дерева разбора
+ */
+struct Node {
+    enum class Kind { kEmpty, kSet, kConcat, kAlternate, kRepeat, kBol, kEol };
+
+    Kind kind = Kind::kEmpty;
+    ByteSet set{};
+    std::vector<Node> children;
+    int min = 0;
+    int max = -1;  ///< -1 — без ограничения
+    bool literal = false;  ///< Множество из одного символа образца (для префикса)
+    unsigned char byte = 0;
+
+    static Node makeSet(const ByteSet& bytes) {
+        Node node;
+        node.kind = Kind::kSet;
+        node.set = bytes;
+        return node;
+    }
+
+    static Node makeList(Kind kind, std::vector<Node> items) {
+        if (items.size() == 1) {
+            return std::move(items[0]);
+        }
+        Node node;
+        node.kind = items.empty() ? Kind::kEmpty : kind;
+        node.children = std::move(items);
+        return node;
+    }
+};
+
+// Многобайтные символы UTF-8 (и одиночные некорректные байты) как альтернативы
+std::vector<Node> nonAsciiCharacter() {
+    ByteSet continuation{};
+    addRange(continuation, 0x80, 0xBF);
+
+    std::vector<Node> alternatives;
+    for (unsigned length = 2; length <= 4; ++length) {
+        ByteSet lead{};
+        if (length == 2) {
+            addRange(lead, 0xC0, 0xDF);
+        } else if (length == 3) {
+            addRange(lead, 0xE0, 0xEF);
+        } else {
+            addRange(lead, 0xF0, 0xF7);
+        }
+        std::vector<Node> sequence{Node::makeSet(lead)};
+        for (unsigned i = 1; i < length; ++i) {
+            sequence.push_back(Node::makeSet(continuation));
+        }
+        alternatives.push_back(Node::makeList(Node::Kind::kConcat, std::move(sequence)));
+    }
+
+    ByteSet stray = continuation;
+    addRange(stray, 0xF8, 0xFF);
+    alternatives.push_back(Node::makeSet(stray));
+    return alternatives;
+}
+
+/**
+ * Разбор образца BRE/ERE в дерево
+ */
+class RegexParser {
+public:
+    RegexParser(const std::string& pattern, unsigned flags)
+        : pattern_(pattern),
+          extended_((flags & Regex::kExtended) != 0),
+          ignoreCase_((flags & Regex::kIgnoreCase) != 0) {}
+
+    bool parse(Node& root) {
+        root = parseAlternation(0);
+        if (error_.empty() && pos_ < pattern_.size()) {
+            error_ = "Unmatched ) or \\)";
+        }
+        return error_.empty();
+    }
+
+    const std::string& error() const {
+        return error_;
+    }
+
+private:
+    const std::string& pattern_;
+    bool extended_;
+    bool ignoreCase_;
+    size_t pos_ = 0;
+    std::string error_;
+
+    bool atEnd() const {
+        return pos_ >= pattern_.size();
+    }
+
+    unsigned char peek(size_t offset = 0) const {
+        return pos_ + offset < pattern_.size() ? static_cast<unsigned char>(pattern_[pos_ + offset])
+                                               : 0;
+    }
+
+    bool fail(const std::string& message) {
+        if (error_.empty()) {
+            error_ = message;
+        }
+        return false;
+    }
+
+    // Оператор, записанный в BRE с обратной косой чертой, а в ERE — без неё
+    bool atOperator(char op) const {
+        if (extended_) {
+            return peek() == op;
+        }
+        return peek() == '\\' && peek(1) == op;
+    }
+
+    void skipOperator() {
+        pos_ += extended_ ? 1 : 2;
+    }
+
+    bool atBar() const {
+        return atOperator('|');
+    }
+
+    bool atClose(size_t depth) const {
+        return depth > 0 && atOperator(')');
+    }
+
+    Node parseAlternation(size_t depth) {
+        std::vector<Node> branches;
+        branches.push_back(parseConcat(depth));
+        while (error_.empty() && atBar()) {
+            skipOperator();
+            branches.push_back(parseConcat(depth));
+        }
+        return Node::makeList(Node::Kind::kAlternate, std::move(branches));
+    }
+
+    Node parseConcat(size_t depth) {
+        std::vector<Node> items;
+        while (error_.empty() && !atEnd() && !atBar() && !atClose(depth)) {
+            bool atStart = items.empty() || items.back().kind == Node::Kind::kBol;
+
+            // В начале выражения '*' — обычный символ
+            if (atStart && peek() == '*') {
+                ++pos_;
+                items.push_back(literal('*'));
+            } else if (!parseAtom(depth, items.empty(), items)) {
+                break;
+            }
+            parseQuantifiers(items.back());
+        }
+        return Node::makeList(Node::Kind::kConcat, std::move(items));
+    }
+
+    bool parseAtom(size_t depth, bool atStart, std::vector<Node>& items) {
+        unsigned char c = peek();
+
+        if (atOperator('(')) {
+            skipOperator();
+            Node group = parseAlternation(depth + 1);
+            if (!atOperator(')')) {
+                return fail("Unmatched ( or \\(");
+            }
+            skipOperator();
+            items.push_back(std::move(group));
+            return true;
+        }
+        if (extended_ && c == ')') {
+            return fail("Unmatched ) or \\)");
+        }
+        if (!extended_ && c == '\\' && (peek(1) == '{' || peek(1) == '}')) {
+            return fail("Invalid preceding regular expression");
+        }
+
+        if (c == '^' && (extended_ || atStart)) {
+            ++pos_;
+            Node node;
+            node.kind = Node::Kind::kBol;
+            items.push_back(std::move(node));
+            return true;
+        }
+        if (c == '$' && (extended_ || atPatternEnd(depth))) {
+            ++pos_;
+            Node node;
+            node.kind = Node::Kind::kEol;
+            items.push_back(std::move(node));
+            return true;
+        }
+        if (c == '.') {
+            ++pos_;
+            items.push_back(anyCharacter());
+            return true;
+        }
+        if (c == '[') {
+            ++pos_;
+            Node node;
+            if (!parseBracket(node)) {
+                return false;
+            }
+            items.push_back(std::move(node));
+            return true;
+        }
+        if (c == '\\') {
+            return parseEscape(items);
+        }
+        if (extended_ && (c == '*' || c == '+' || c == '?')) {
+            // Квантификатор без операнда (например, после '|') — обычный символ
+            ++pos_;
+            items.push_back(literal(c));
+            return true;
+        }
+
+        items.push_back(character());
+        return true;
+    }
+
+    // $ в BRE — якорь только в конце выражения, группы или ветви
+    bool atPatternEnd(size_t depth) const {
+        if (pos_ + 1 >= pattern_.size()) {
+            return true;
+        }
+        size_t saved = pos_ + 1;
+        bool close = depth > 0 && pattern_.compare(saved, 2, "\\)") == 0;
+        return close || pattern_.compare(saved, 2, "\\|") == 0;
+    }
+
+    bool parseEscape(std::vector<Node>& items) {
+        if (pos_ + 1 >= pattern_.size()) {
+            return fail("Trailing backslash");
+        }
+        unsigned char c = peek(1);
+        pos_ += 2;
+
+        ByteSet set{};
+        switch (c) {
+            case 'w':
+            case 'W':
+                addRange(set, 'a', 'z');
+                addRange(set, 'A', 'Z');
+                addRange(set, '0', '9');
+                addByte(set, '_');
+                items.push_back(c == 'w' ? Node::makeSet(set) : negated(set));
+                return true;
+            case 's':
+            case 'S':
+                addByte(set, ' ');
+                addRange(set, '\t', '\r');
+                items.push_back(c == 's' ? Node::makeSet(set) : negated(set));
+                return true;
+            case '<':
+            case '>':
+            case 'b':
+            case 'B':
+            case '`':
+            case '\'':
+                return fail("Word boundaries are not supported");
+            default:
+                break;
+        }
+        if (c >= '1' && c <= '9') {
+            return fail("Back-references are not supported");
+        }
+        items.push_back(literal(c));
+        return true;
+    }
+
+    void parseQuantifiers(Node& atom) {
+        while (error_.empty() && !atEnd()) {
+            int min = 0;
+            int max = -1;
+            if (peek() == '*') {
+                ++pos_;
+            } else if (atOperator('+')) {
+                skipOperator();
+                min = 1;
+            } else if (atOperator('?')) {
+                skipOperator();
+                max = 1;
+            } else if (atOperator('{')) {
+                size_t saved = pos_;
+                skipOperator();
+                if (!parseInterval(min, max)) {
+                    // В ERE некорректный интервал — обычный символ '{'
+                    if (extended_ && error_.empty()) {
+                        pos_ = saved;
+                        return;
+                    }
+                    fail("Invalid content of \\{\\}");
+                    return;
+                }
+            } else {
+                return;
+            }
+
+            Node repeat;
+            repeat.kind = Node::Kind::kRepeat;
+            repeat.min = min;
+            repeat.max = max;
+            repeat.children.push_back(std::move(atom));
+            atom = std::move(repeat);
+        }
+    }
+
+    bool readNumber(int& value) {
+        if (!std::isdigit(peek())) {
+            return false;
+        }
+        value = 0;
+        while (std::isdigit(peek())) {
+            value = value * 10 + (peek() - '0');
+            if (value > kMaxRepeat) {
+                return fail("Regular expression too big");
+            }
+            ++pos_;
+        }
+        return true;
+    }
+
+    bool parseInterval(int& min, int& max) {
+        if (!readNumber(min)) {
+            return false;
+        }
+        max = min;
+        if (peek() == ',') {
+            ++pos_;
+            max = -1;
+            if (std::isdigit(peek()) && !readNumber(max)) {
+                return false;
+            }
+        }
+        if (!atOperator('}')) {
+            return false;
+        }
+        skipOperator();
+        if (max != -1 && max < min) {
+            return fail("Invalid content of \\{\\}");
+        }
+        return true;
+    }
+
+    Node literal(unsigned char c) const {
+        ByteSet set{};
+        addByte(set, c);
+        if (ignoreCase_ && isLetter(c)) {
+            addByte(set, c ^ 0x20U);
+        }
+        Node node = Node::makeSet(set);
+        node.literal = true;
+        node.byte = ignoreCase_ && isLetter(c) ? static_cast<unsigned char>(c | 0x20) : c;
+        return node;
+    }
+
+    // Символ образца целиком (многобайтный UTF-8 — последовательность литералов)
+    Node character() {
+        unsigned char lead = peek();
+        size_t length = 1;
+        if (lead >= 0xC0) {
+            while (length < 4 && (peek(length) & 0xC0) == 0x80) {
+                ++length;
+            }
+        }
+        std::vector<Node> bytes;
+        for (size_t i = 0; i < length; ++i) {
+            bytes.push_back(literal(peek()));
+            ++pos_;
+        }
+        return Node::makeList(Node::Kind::kConcat, std::move(bytes));
+    }
+
+    static Node anyCharacter() {
+        ByteSet ascii{};
+        addRange(ascii, 0, 0x7F);
+        ascii[0] &= ~(uint64_t{1} << '\n');
+        std::vector<Node> alternatives{Node::makeSet(ascii)};
+        for (auto& node : nonAsciiCharacter()) {
+            alternatives.push_back(std::move(node));
+        }
+        return Node::makeList(Node::Kind::kAlternate, std::move(alternatives));
+    }
+
+    // Отрицание ASCII-множества: любой другой ASCII-символ (кроме '\n') или не-ASCII символ
+    static Node negated(const ByteSet& set) {
+        ByteSet ascii{};
+        for (unsigned c = 0; c < 0x80; ++c) {
+            if (!hasByte(set, c) && c != '\n') {
+                addByte(ascii, c);
+            }
+        }
+        std::vector<Node> alternatives{Node::makeSet(ascii)};
+        for (auto& node : nonAsciiCharacter()) {
+            alternatives.push_back(std::move(node));
+        }
+        return Node::makeList(Node::Kind::kAlternate, std::move(alternatives));
+    }
+
+    bool addClass(const std::string& name, ByteSet& set) {
+        for (unsigned c = 0; c < 0x80; ++c) {
+            bool member = false;
+            if (name == "alpha") {
+                member = std::isalpha(static_cast<int>(c)) != 0;
+            } else if (name == "digit") {
+                member = std::isdigit(static_cast<int>(c)) != 0;
+            } else if (name == "alnum") {
+                member = std::isalnum(static_cast<int>(c)) != 0;
+            } else if (name == "upper") {
+                member = std::isupper(static_cast<int>(c)) != 0;
+            } else if (name == "lower") {
+                member = std::islower(static_cast<int>(c)) != 0;
+            } else if (name == "space") {
+                member = std::isspace(static_cast<int>(c)) != 0;
+            } else if (name == "blank") {
+                member = c == ' ' || c == '\t';
+            } else if (name == "punct") {
+                member = std::ispunct(static_cast<int>(c)) != 0;
+            } else if (name == "print") {
+                member = std::isprint(static_cast<int>(c)) != 0;
+            } else if (name == "graph") {
+                member = std::isgraph(static_cast<int>(c)) != 0;
+            } else if (name == "cntrl") {
+                member = std::iscntrl(static_cast<int>(c)) != 0;
+            } else if (name == "xdigit") {
+                member = std::isxdigit(static_cast<int>(c)) != 0;
+            } else {
+                return fail("Invalid character class name");
+            }
+            if (member) {
+                addByte(set, c);
+            }
+        }
+        return true;
+    }
+
+    bool parseBracket(Node& result) {
+        ByteSet set{};
+        std::vector<Node> sequences;  // Многобайтные символы списка
+        bool negate = false;
+        if (peek() == '^') {
+            negate = true;
+            ++pos_;
+        }
+
+        bool first = true;
+        while (true) {
+            if (atEnd()) {
+                return fail("Unmatched [, [^, [:, [., or [=");
+            }
+            unsigned char c = peek();
+            if (c == ']' && !first) {
+                ++pos_;
+                break;
+            }
+            first = false;
+
+            if (c == '[' && (peek(1) == ':' || peek(1) == '=' || peek(1) == '.')) {
+                char kind = static_cast<char>(peek(1));
+                size_t close = pattern_.find(std::string{kind, ']'}, pos_ + 2);
+                if (close == std::string::npos) {
+                    return fail("Unmatched [, [^, [:, [., or [=");
+                }
+                std::string name = pattern_.substr(pos_ + 2, close - pos_ - 2);
+                pos_ = close + 2;
+                if (kind == ':') {
+                    if (!addClass(name, set)) {
+                        return false;
+                    }
+                } else if (name.size() == 1) {
+                    addByte(set, static_cast<unsigned char>(name[0]));
+                } else {
+                    return fail("Invalid collation character");
+                }
+                continue;
+            }
+
+            if (c >= 0x80) {
+                if (negate) {
+                    return fail("Non-ASCII characters in [^...] are not supported");
+                }
+                sequences.push_back(character());
+                if (peek() == '-' && peek(1) != ']') {
+                    return fail("Ranges of non-ASCII characters are not supported");
+                }
+                continue;
+            }
+
+            ++pos_;
+            if (peek() == '-' && peek(1) != ']' && peek(1) != 0) {
+                unsigned char hi = peek(1);
+                if (hi >= 0x80) {
+                    return fail("Ranges of non-ASCII characters are not supported");
+                }
+                if (hi < c) {
+                    return fail("Invalid range end");
+                }
+                pos_ += 2;
+                addRange(set, c, hi);
+            } else {
+                addByte(set, c);
+            }
+        }
+
+        if (ignoreCase_) {
+            for (unsigned c = 'A'; c <= 'z'; ++c) {
+                if (isLetter(c) && hasByte(set, c)) {
+                    addByte(set, c ^ 0x20U);
+                }
+            }
+        }
+
+        if (negate) {
+            result = negated(set);
+            return true;
+        }
+        std::vector<Node> alternatives{Node::makeSet(set)};
+        for (auto& node : sequences) {
+            alternatives.push_back(std::move(node));
+        }
+        result = Node::makeList(Node::Kind::kAlternate, std::move(alternatives));
+        return true;
+    }
+};
+
+// Строка, с которой начинается любое совпадение узла; complete — узел и есть эта строка
+std::string prefixOf(const Node& node, bool& complete) {
+    complete = false;
+    if (node.kind == Node::Kind::kSet) {
+        complete = node.literal;
+        return node.literal ? std::string(1, static_cast<char>(node.byte)) : std::string();
+    }
+    if (node.kind != Node::Kind::kConcat) {
+        return {};
+    }
+    std::string prefix;
+    for (const auto& child : node.children) {
+        bool childComplete = false;
+        prefix += prefixOf(child, childComplete);
+        if (!childComplete) {
+            return prefix;
+        }
+    }
+    complete = true;
+    return prefix;
+}
+
+}  // namespace
+
+/**
+ * Компиляция дерева в программу NFA Томпсона
+ */
+class RegexCompiler {
+public:
+    RegexCompiler(std::vector<Regex::Inst>& program, std::vector<Regex::ByteSet>& sets)
+        : program_(program), sets_(sets) {}
+
+    bool emit(const Node& node) {
+        if (program_.size() > kMaxProgram) {
+            return false;
+        }
+        switch (node.kind) {
+            case Node::Kind::kEmpty:
+                return true;
+            case Node::Kind::kSet: {
+                uint32_t pc = add(Regex::Op::kByteSet);
+                program_[pc].set = static_cast<uint32_t>(sets_.size());
+                sets_.push_back(node.set);
+                return true;
+            }
+            case Node::Kind::kBol:
+                add(Regex::Op::kBol);
+                return true;
+            case Node::Kind::kEol:
+                add(Regex::Op::kEol);
+                return true;
+            case Node::Kind::kConcat:
+                for (const auto& child : node.children) {
+                    if (!emit(child)) {
+                        return false;
+                    }
+                }
+                return true;
+            case Node::Kind::kAlternate:
+                return emitAlternate(node);
+            case Node::Kind::kRepeat:
+                return emitRepeat(node);
+        }
+        return false;
+    }
+
+    uint32_t add(Regex::Op op) {
+        auto pc = static_cast<uint32_t>(program_.size());
+        Regex::Inst inst;
+        inst.op = op;
+        inst.out = pc + 1;
+        program_.push_back(inst);
+        return pc;
+    }
+
+private:
+    std::vector<Regex::Inst>& program_;
+    std::vector<Regex::ByteSet>& sets_;
+
+    uint32_t here() const {
+        return static_cast<uint32_t>(program_.size());
+    }
+
+    bool emitAlternate(const Node& node) {
+        std::vector<uint32_t> jumps;
+        for (size_t i = 0; i + 1 < node.children.size(); ++i) {
+            uint32_t split = add(Regex::Op::kSplit);
+            if (!emit(node.children[i])) {
+                return false;
+            }
+            jumps.push_back(add(Regex::Op::kJmp));
+            program_[split].out1 = here();
+        }
+        if (!emit(node.children.back())) {
+            return false;
+        }
+        for (uint32_t jump : jumps) {
+            program_[jump].out = here();
+        }
+        return true;
+    }
+
+    bool emitRepeat(const Node& node) {
+        const Node& child = node.children[0];
+        for (int i = 0; i < node.min; ++i) {
+            if (!emit(child)) {
+                return false;
+            }
+        }
+
+        if (node.max == -1) {
+            // L: split(тело, выход); тело; jmp L
+            uint32_t split = add(Regex::Op::kSplit);
+            if (!emit(child)) {
+                return false;
+            }
+            uint32_t jump = add(Regex::Op::kJmp);
+            program_[jump].out = split;
+            program_[split].out1 = here();
+            return true;
+        }
+
+        std::vector<uint32_t> splits;
+        for (int i = node.min; i < node.max; ++i) {
+            splits.push_back(add(Regex::Op::kSplit));
+            if (!emit(child)) {
+                return false;
+            }
+        }
+        for (uint32_t split : splits) {
+            program_[split].out1 = here();
+        }
+        return true;
+    }
+};
+
+std::shared_ptr<const Regex> Regex::compile(const std::string& pattern, unsigned flags,
+                                            std::string* error) {
+    Node root;
+    RegexParser parser(pattern, flags);
+    if (!parser.parse(root)) {
+        if (error != nullptr) {
+            *error = parser.error();
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<Regex> regex(new Regex());
+    regex->pattern_ = pattern;
+    regex->flags_ = flags;
+
+    RegexCompiler compiler(regex->program_, regex->sets_);
+    if (!compiler.emit(root) || regex->program_.size() > kMaxProgram) {
+        if (error != nullptr) {
+            *error = "Regular expression too big";
+        }
+        return nullptr;
+    }
+    compiler.add(Op::kMatch);
+    regex->start_ = 0;
+    regex->computeByteClasses();
+
+    // Короткий префикс не окупает повторного прохода по строке
+    bool complete = false;
+    std::string prefix = prefixOf(root, complete);
+    if (prefix.size() >= 2) {
+        regex->prefix_ = prefix;
+        regex->prefixSearcher_ =
+            std::make_unique<LiteralSearcher>(prefix, (flags & kIgnoreCase) != 0);
+    }
+    return regex;
+}
+
+void Regex::computeByteClasses() {
+    // Последовательно дробим классы по принадлежности каждому множеству;
+    // '\n' всегда в отдельном классе — от него зависят якоря
+    std::array<uint16_t, 256> classes{};
+    uint16_t count = 1;
+
+    ByteSet newline{};
+    addByte(newline, '\n');
+    std::vector<const ByteSet*> refiners{&newline};
+    for (const auto& set : sets_) {
+        refiners.push_back(&set);
+    }
+
+    for (const ByteSet* set : refiners) {
+        std::vector<int> remap(static_cast<size_t>(count) * 2, -1);
+        uint16_t next = 0;
+        for (unsigned c = 0; c < 256; ++c) {
+            size_t key = static_cast<size_t>(classes[c]) * 2 + (hasByte(*set, c) ? 1 : 0);
+            if (remap[key] < 0) {
+                remap[key] = next++;
+            }
+            classes[c] = static_cast<uint16_t>(remap[key]);
+        }
+        count = next;
+    }
+
+    classRepresentative_.assign(count, 0);
+    std::vector<bool> seen(count, false);
+    for (unsigned c = 0; c < 256; ++c) {
+        byteClass_[c] = static_cast<uint8_t>(classes[c]);
+        if (!seen[classes[c]]) {
+            seen[classes[c]] = true;
+            classRepresentative_[classes[c]] = static_cast<uint8_t>(c);
+        }
+    }
+}
+
+}  // namespace shell
@@ -0,0 +1,50 @@
+#include "shell/regex_cache.hpp"
+
+namespace shell {
+
+RegexCache::RegexCache(size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+std::shared_ptr<const Regex> RegexCache::get(const std::string& pattern, unsigned flags,
+                                             std::string* error) {
+    std::string key = std::to_string(flags) + ':' + pattern;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            hits_++;
+            return it->second->second;
+        }
+    }
+
+    // Компиляция — вне блокировки: она может быть долгой
+    std::shared_ptr<const Regex> regex = Regex::compile(pattern, flags, error);
+    if (!regex) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        return it->second->second;
+    }
+    entries_.emplace_front(key, regex);
+    index_[key] = entries_.begin();
+    if (entries_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    return regex;
+}
+
+size_t RegexCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t RegexCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+}  // namespace shell
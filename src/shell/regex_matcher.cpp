@@ -0,0 +1,220 @@
+#include "shell/regex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace shell {
+
+namespace {
+
+const char* lineStart(const char* limit, const char* pos) {
+    while (pos > limit && pos[-1] != '\n') {
+        --pos;
+    }
+    return pos;
+}
+
+}  // namespace
+
+RegexMatcher::RegexMatcher(std::shared_ptr<const Regex> regex, size_t cacheBudget)
+    : regex_(std::move(regex)),
+      classCount_(regex_->classRepresentative_.size()),
+      cacheBudget_(cacheBudget),
+      visited_(regex_->program_.size(), 0) {}
+
+const char* RegexMatcher::find(const char* begin, const char* end) {
+    const LiteralSearcher* prefix = regex_->prefixSearcher_.get();
+    if (prefix == nullptr) {
+        return scan(begin, end, end);
+    }
+
+    // Совпадение начинается с префикса и не пересекает строк: автомат
+    // запускается только на строках, где префикс найден, каждая строка — один раз
+    const char* pos = begin;
+    while (pos < end) {
+        const char* hit = prefix->find(pos, end);
+        if (hit == end) {
+            return nullptr;
+        }
+        const char* lineBegin = lineStart(pos, hit);
+        const void* newline = std::memchr(hit, '\n', static_cast<size_t>(end - hit));
+        const char* lineEnd = newline != nullptr ? static_cast<const char*>(newline) : end;
+
+        if (const char* match = scan(lineBegin, lineEnd, end)) {
+            return match;
+        }
+        pos = lineEnd < end ? lineEnd + 1 : end;
+    }
+    return nullptr;
+}
+
+const char* RegexMatcher::scan(const char* begin, const char* stop, const char* end) {
+    const auto& byteClass = regex_->byteClass_;
+    // За последним '\n' буфера строки нет: пустое совпадение там не считается
+    const bool trailingNewline = begin < end && end[-1] == '\n';
+    auto acceptsAt = [&](int32_t state, const char* p) {
+        if (p == end && trailingNewline) {
+            return false;
+        }
+        uint8_t accept = accept_[static_cast<size_t>(state)];
+        return (accept & kAccepting) != 0 ||
+               ((accept & kAcceptingAtEol) != 0 && (p == end || *p == '\n'));
+    };
+
+    int32_t state = startState();
+    if (acceptsAt(state, begin)) {
+        return begin;
+    }
+
+    // В таблице хранятся смещения строк; принимающие состояния закодированы
+    // отрицательными значениями, поэтому на байт приходится одно сравнение
+    int32_t row = state * static_cast<int32_t>(classCount_);
+    for (const char* p = begin; p != stop; ++p) {
+        uint8_t cls = byteClass[static_cast<unsigned char>(*p)];
+        int32_t next = transitions_[static_cast<size_t>(row) + cls];
+        if (next < 0) {
+            if (next == kUnknown) {
+                next = encode(transition(row / static_cast<int32_t>(classCount_), cls));
+            }
+            if (next < 0) {
+                row = -next - 2;
+                if (acceptsAt(row / static_cast<int32_t>(classCount_), p + 1)) {
+                    return p + 1;
+                }
+                continue;
+            }
+        }
+        row = next;
+    }
+    return nullptr;
+}
+
+int32_t RegexMatcher::encode(int32_t state) const {
+    int32_t row = state * static_cast<int32_t>(classCount_);
+    return accept_[static_cast<size_t>(state)] != 0 ? -row - 2 : row;
+}
+
+int32_t RegexMatcher::startState() {
+    if (start_ < 0) {
+        std::vector<uint32_t> insts;
+        ++generation_;
+        addClosure(regex_->start_, true, insts);
+        start_ = intern(insts);
+    }
+    return start_;
+}
+
+int32_t RegexMatcher::transition(int32_t state, uint8_t byteClass) {
+    unsigned char c = regex_->classRepresentative_[byteClass];
+    bool atLineStart = c == '\n';
+
+    std::vector<uint32_t> next;
+    ++generation_;
+    for (uint32_t pc : sets_[static_cast<size_t>(state)]) {
+        const Regex::Inst& inst = regex_->program_[pc];
+        if (inst.op != Regex::Op::kByteSet) {
+            continue;
+        }
+        const auto& set = regex_->sets_[inst.set];
+        if (((set[c >> 6] >> (c & 63)) & 1) != 0) {
+            addClosure(inst.out, atLineStart, next);
+        }
+    }
+    // Поиск не привязан к началу: совпадение может начаться в любой позиции
+    addClosure(regex_->start_, atLineStart, next);
+
+    // Переполнение бюджета: сбрасываем кэш, вычисленное состояние сохраняется
+    size_t rowBytes = classCount_ * sizeof(int32_t);
+    if ((sets_.size() + 1) * rowBytes > cacheBudget_) {
+        clearCache();
+        flushes_++;
+        int32_t target = intern(next);
+        startState();
+        return target;
+    }
+
+    int32_t target = intern(next);
+    transitions_[static_cast<size_t>(state) * classCount_ + byteClass] = encode(target);
+    return target;
+}
+
+int32_t RegexMatcher::intern(std::vector<uint32_t>& insts) {
+    std::sort(insts.begin(), insts.end());
+    std::string key(reinterpret_cast<const char*>(insts.data()), insts.size() * sizeof(uint32_t));
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        return it->second;
+    }
+
+    // Совпадение сейчас или при условии, что дальше конец строки ($)
+    uint8_t accept = 0;
+    std::vector<uint32_t> atEol;
+    ++generation_;
+    for (uint32_t pc : insts) {
+        const Regex::Inst& inst = regex_->program_[pc];
+        if (inst.op == Regex::Op::kMatch) {
+            accept |= kAccepting;
+        } else if (inst.op == Regex::Op::kEol) {
+            addClosure(inst.out, false, atEol);
+        }
+    }
+    for (uint32_t pc : atEol) {
+        if (regex_->program_[pc].op == Regex::Op::kMatch) {
+            accept |= kAcceptingAtEol;
+        }
+    }
+
+    auto id = static_cast<int32_t>(sets_.size());
+    sets_.push_back(std::move(insts));
+    accept_.push_back(accept);
+    transitions_.resize(sets_.size() * classCount_, kUnknown);
+    index_.emplace(std::move(key), id);
+    return id;
+}
+
+void RegexMatcher::addClosure(uint32_t pc, bool atLineStart, std::vector<uint32_t>& out) {
+    // Обход ε-переходов; в состояние попадают только инструкции,
+    // которые ждут байт, якорь $ или завершают совпадение
+    stack_.clear();
+    stack_.push_back(pc);
+    while (!stack_.empty()) {
+        uint32_t current = stack_.back();
+        stack_.pop_back();
+        if (visited_[current] == generation_) {
+            continue;
+        }
+        visited_[current] = generation_;
+
+        const Regex::Inst& inst = regex_->program_[current];
+        switch (inst.op) {
+            case Regex::Op::kSplit:
+                stack_.push_back(inst.out1);
+                stack_.push_back(inst.out);
+                break;
+            case Regex::Op::kJmp:
+                stack_.push_back(inst.out);
+                break;
+            case Regex::Op::kBol:
+                if (atLineStart) {
+                    stack_.push_back(inst.out);
+                }
+                break;
+            case Regex::Op::kByteSet:
+            case Regex::Op::kEol:
+            case Regex::Op::kMatch:
+                out.push_back(current);
+                break;
+        }
+    }
+}
+
+void RegexMatcher::clearCache() {
+    sets_.clear();
+    accept_.clear();
+    transitions_.clear();
+    index_.clear();
+    start_ = -1;
+}
+
+}  // namespace shell
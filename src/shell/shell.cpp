@@ -1,82 +1,120 @@
 #include "shell/shell.hpp"
 
 #include <iostream>
+#include <variant>
+
+#include <unistd.h>
+
+#include "shell/interrupt.hpp"
 
 namespace shell {
 
+namespace {
+
+// Набор лямбд как один посетитель для std::visit
+template <typename... Ts>
+struct Overloaded : Ts... {
+    using Ts::operator()...;
+};
+template <typename... Ts>
+Overloaded(Ts...) -> Overloaded<Ts...>;
+
+}  // namespace
+
 Shell::Shell()
-    : environment_(),
+    : arena_(),
+      environment_(),
       inputReader_(),
       substitutor_(environment_),
+      globExpander_(),
       commandFactory_(environment_),
+      completer_(environment_, commandFactory_),
       pipelineBuilder_(commandFactory_),
       executor_(environment_) {
     environment_.initFromSystem();
 }
 
 int Shell::run() {
-    while (!executor_.shouldExit()) {
-        auto line = inputReader_.readLine();
+    // Ctrl-C прерывает выполняющуюся команду, а не shell
+    Interrupt::install();
+
+    // В терминале — редактирование строки, история (HISTFILE или ~/.shell_history)
+    // и дополнение по Tab; каталоги PATH начинают читаться в фоне сразу
+    if (isatty(STDIN_FILENO) && isatty(STDOUT_FILENO)) {
+        std::string historyPath = environment_.get("HISTFILE");
+        if (historyPath.empty() && !environment_.get("HOME").empty()) {
+            historyPath = environment_.get("HOME") + "/.shell_history";
+        }
+        completer_.prefetch();
+        inputReader_.enableEditing(historyPath, &completer_);
+    }
 
-        if (!line) {
+    // Буфер строки переиспользуется между итерациями
+    std::string line;
+    while (!executor_.shouldExit()) {
+        if (!inputReader_.readLine(line)) {
             break;
         }
 
-        if (line->empty()) {
+        if (line.empty()) {
             continue;
         }
 
-        processLine(*line);
+        Interrupt::clear();
+        processLine(line);
     }
 
     return executor_.getExitCode();
 }
 
 int Shell::processLine(const std::string& line) {
+    int code = executeLine(line);
+    // Токены, AST и пайплайн строки уже разрушены — освобождаем арену целиком
+    arena_.reset();
+    return code;
+}
+
+int Shell::executeLine(const std::string& line) {
+    std::pmr::memory_resource* resource = arena_.resource();
     try {
         // 1. Подстановка переменных
-        std::string substituted = substitutor_.substitute(line);
+        std::pmr::string substituted = substitutor_.substitute(line, resource);
 
         // 2. Лексический анализ
-        Lexer lexer(substituted);
-        std::vector<Token> tokens = lexer.tokenize();
+        Lexer lexer(substituted, resource);
+        std::pmr::vector<Token> tokens = lexer.tokenize();
 
-        // 3. Синтаксический анализ
-        Parser parser(std::move(tokens));
-        auto parsed = parser.parse();
-
-        if (!parsed) {
-            return 0;
-        }
-
-        // 4. Выполнение
-        if (parsed->isEmpty()) {
-            return 0;
-        }
+        // 3. Раскрытие шаблонов путей
+        globExpander_.expand(tokens);
 
-        if (parsed->isAssignment()) {
-            if (auto* assignment = dynamic_cast<ParsedAssignment*>(parsed.get())) {
-                return executor_.executeAssignment(*assignment);
-            }
-            if (auto* assignments = dynamic_cast<ParsedAssignmentList*>(parsed.get())) {
-                return executor_.executeAssignments(*assignments);
-            }
-        }
-
-        if (parsed->isPipeline()) {
-            auto* pipelineAst = dynamic_cast<ParsedPipeline*>(parsed.get());
-            if (pipelineAst && !pipelineAst->commands.empty()) {
-                Pipeline pipeline = pipelineBuilder_.build(*pipelineAst);
-                if (pipeline.isEmpty()) {
-                    std::cerr << "shell: empty pipeline (missing command name)\n";
-                    environment_.set("?", "2");
-                    return 2;
-                }
-                return executor_.execute(pipeline);
-            }
-        }
-
-        return 0;
+        // 4. Синтаксический анализ
+        Parser parser(std::move(tokens));
+        ParsedCommand parsed = parser.parse();
+
+        // 5. Выполнение
+        return std::visit(
+            Overloaded{
+                [](const ParsedEmpty&) { return 0; },
+                [this](const ParsedAssignment& assignment) {
+                    return executor_.executeAssignment(assignment);
+                },
+                [this](const ParsedAssignmentList& assignments) {
+                    return executor_.executeAssignments(assignments);
+                },
+                [this, resource](const ParsedPipeline& pipelineAst) {
+                    if (pipelineAst.commands.empty()) {
+                        return 0;
+                    }
+                    Pipeline pipeline = pipelineBuilder_.build(pipelineAst, resource);
+                    if (pipeline.isEmpty()) {
+                        std::cerr << "shell: empty pipeline (missing command name)\n";
+                        environment_.set("?", "2");
+                        return 2;
+                    }
+                    return executor_.execute(pipeline);
+                },
+            },
+            parsed);
     } catch (const std::exception& e) {
         std::cerr << "shell: " << e.what() << "\n";
         environment_.set("?", "1");
@@ -0,0 +1,203 @@
+#include "shell/stream_pipe.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace shell {
+
+namespace {
+
+// Размер буферов потоков поверх канала
+constexpr size_t kStreamBufferSize = 64 * 1024;
+
+}  // namespace
+
+StreamPipe::StreamPipe(size_t capacity) : ring_(std::max<size_t>(capacity, 1)) {}
+
+size_t StreamPipe::put(const char* data, size_t size) {
+    size_t total = 0;
+    while (total < size && size_ < ring_.size()) {
+        // Копируем в свободную часть кольца до его конца
+        size_t tail = (head_ + size_) % ring_.size();
+        size_t chunk = std::min({size - total, ring_.size() - size_, ring_.size() - tail});
+        std::memcpy(&ring_[tail], data + total, chunk);
+        size_ += chunk;
+        total += chunk;
+    }
+    if (total > 0) {
+        readable_.notify_one();
+        if (readerWaiting_) {
+            readerWaiting_ = false;
+            signal(readerNotify_);
+        }
+    }
+    return total;
+}
+
+size_t StreamPipe::take(char* buffer, size_t capacity) {
+    size_t total = 0;
+    while (total < capacity && size_ > 0) {
+        size_t chunk = std::min({capacity - total, size_, ring_.size() - head_});
+        std::memcpy(buffer + total, &ring_[head_], chunk);
+        head_ = (head_ + chunk) % ring_.size();
+        size_ -= chunk;
+        total += chunk;
+    }
+    if (total > 0) {
+        writable_.notify_one();
+        if (writerWaiting_) {
+            writerWaiting_ = false;
+            signal(writerNotify_);
+        }
+    }
+    return total;
+}
+
+void StreamPipe::signal(int fd) {
+    if (fd >= 0) {
+        uint64_t one = 1;
+        static_cast<void>(::write(fd, &one, sizeof(one)));
+    }
+}
+
+bool StreamPipe::write(const char* data, size_t size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (size > 0) {
+        writable_.wait(lock, [this] { return readClosed_ || size_ < ring_.size(); });
+        if (readClosed_) {
+            return false;
+        }
+        size_t written = put(data, size);
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+size_t StreamPipe::read(char* buffer, size_t capacity) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    readable_.wait(lock, [this] { return readClosed_ || writeClosed_ || size_ > 0; });
+    if (readClosed_) {
+        return 0;
+    }
+    return take(buffer, capacity);
+}
+
+size_t StreamPipe::tryWrite(const char* data, size_t size, bool& closed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed = readClosed_;
+    size_t written = closed ? 0 : put(data, size);
+    writerWaiting_ = !closed && written < size;
+    return written;
+}
+
+size_t StreamPipe::tryRead(char* buffer, size_t capacity, bool& eof) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    eof = readClosed_ || (writeClosed_ && size_ == 0);
+    size_t total = eof ? 0 : take(buffer, capacity);
+    readerWaiting_ = !eof && total == 0;
+    return total;
+}
+
+void StreamPipe::notifyReader(int fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    readerNotify_ = fd;
+}
+
+void StreamPipe::notifyWriter(int fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writerNotify_ = fd;
+}
+
+void StreamPipe::closeWrite() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writeClosed_ = true;
+    readable_.notify_all();
+    signal(readerNotify_);
+}
+
+void StreamPipe::closeRead() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    readClosed_ = true;
+    size_ = 0;
+    writable_.notify_all();
+    readable_.notify_all();
+    signal(writerNotify_);
+}
+
+PipeReadBuffer::PipeReadBuffer(StreamPipe& pipe)
+    : pipe_(pipe), buffer_(std::make_unique<char[]>(kStreamBufferSize)) {
+    setg(buffer_.get(), buffer_.get(), buffer_.get());
+}
+
+PipeReadBuffer::int_type PipeReadBuffer::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    size_t size = pipe_.read(buffer_.get(), kStreamBufferSize);
+    if (size == 0) {
+        return traits_type::eof();
+    }
+    setg(buffer_.get(), buffer_.get(), buffer_.get() + size);
+    return traits_type::to_int_type(*gptr());
+}
+
+PipeWriteBuffer::PipeWriteBuffer(StreamPipe& pipe)
+    : pipe_(pipe), buffer_(std::make_unique<char[]>(kStreamBufferSize)) {
+    setp(buffer_.get(), buffer_.get() + kStreamBufferSize);
+}
+
+bool PipeWriteBuffer::flush() {
+    size_t size = static_cast<size_t>(pptr() - pbase());
+    setp(buffer_.get(), buffer_.get() + kStreamBufferSize);
+    if (broken_ || (size > 0 && !pipe_.write(buffer_.get(), size))) {
+        broken_ = true;
+    }
+    return !broken_;
+}
+
+PipeWriteBuffer::int_type PipeWriteBuffer::overflow(int_type c) {
+    if (!flush()) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize PipeWriteBuffer::xsputn(const char* data, std::streamsize size) {
+    if (size < epptr() - pptr()) {
+        std::memcpy(pptr(), data, static_cast<size_t>(size));
+        pbump(static_cast<int>(size));
+        return size;
+    }
+    // Крупный блок пишется в канал напрямую, минуя буфер
+    if (!flush() || !pipe_.write(data, static_cast<size_t>(size))) {
+        broken_ = true;
+        return 0;
+    }
+    return size;
+}
+
+int PipeWriteBuffer::sync() {
+    return flush() ? 0 : -1;
+}
+
+size_t readAvailable(std::istream& in, char* buffer, size_t capacity) {
+    std::streambuf* source = in.rdbuf();
+    if (source == nullptr || capacity == 0 ||
+        std::streambuf::traits_type::eq_int_type(source->sgetc(),
+                                                 std::streambuf::traits_type::eof())) {
+        return 0;
+    }
+    std::streamsize available = std::max<std::streamsize>(source->in_avail(), 1);
+    std::streamsize size = std::min(available, static_cast<std::streamsize>(capacity));
+    return static_cast<size_t>(source->sgetn(buffer, size));
+}
+
+}  // namespace shell
@@ -4,8 +4,9 @@ namespace shell {
 
 Substitutor::Substitutor(Environment& env) : env_(env) {}
 
-std::string Substitutor::substitute(const std::string& input) const {
-    std::string result;
+template <typename String>
+void Substitutor::substituteInto(std::string_view input, String& result) const {
+    result.reserve(input.size());
     size_t i = 0;
 
     while (i < input.size()) {
@@ -69,7 +70,18 @@ std::string Substitutor::substitute(const std::string& input) const {
             i++;
         }
     }
+}
+
+std::string Substitutor::substitute(const std::string& input) const {
+    std::string result;
+    substituteInto(input, result);
+    return result;
+}
 
+std::pmr::string Substitutor::substitute(std::string_view input,
+                                         std::pmr::memory_resource* resource) const {
+    std::pmr::string result(resource);
+    substituteInto(input, result);
     return result;
 }
 
@@ -0,0 +1,496 @@
+#include "shell/text_counter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "shell/thread_pool.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHELL_TEXT_COUNTER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace shell {
+
+namespace {
+
+using ByteKernel = size_t (*)(const char*, size_t);
+using WordKernel = size_t (*)(const char*, size_t, TextCounter::WordState&);
+
+// Крупные блоки (например, целиком отображённый файл) обрабатываем
+// кусками, чтобы второе ядро читало данные из кэша, а не из памяти
+constexpr size_t kSliceSize = 256 * 1024;
+
+size_t countNewlinesScalar(const char* data, size_t size) {
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        count += data[i] == '\n' ? 1 : 0;
+    }
+    return count;
+}
+
+size_t countCharsScalar(const char* data, size_t size) {
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        // Байты продолжения 0x80..0xBF — это -128..-65 в знаковом виде
+        count += static_cast<signed char>(data[i]) > -65 ? 1 : 0;
+    }
+    return count;
+}
+
+enum class SpaceStep { kNoMatch, kPartial, kComplete };
+
+// Может ли байт начинать многобайтный пробел Unicode (C2, E1, E2, E3)
+inline bool isSpaceLead(unsigned char c) {
+    return c == 0xC2 || (c >= 0xE1 && c <= 0xE3);
+}
+
+// Продолжает ли байт c начатую последовательность seq[0..len) пробела Unicode
+SpaceStep spaceSequenceStep(const unsigned char* seq, size_t len, unsigned char c) {
+    switch (seq[0]) {
+        case 0xC2:  // U+0085
+            return c == 0x85 ? SpaceStep::kComplete : SpaceStep::kNoMatch;
+        case 0xE1:  // U+1680
+            if (len == 1) {
+                return c == 0x9A ? SpaceStep::kPartial : SpaceStep::kNoMatch;
+            }
+            return c == 0x80 ? SpaceStep::kComplete : SpaceStep::kNoMatch;
+        case 0xE2:  // U+2000..U+200A (кроме U+2007), U+2028, U+2029, U+205F
+            if (len == 1) {
+                return c == 0x80 || c == 0x81 ? SpaceStep::kPartial : SpaceStep::kNoMatch;
+            }
+            if (seq[1] == 0x80) {
+                bool space = (c >= 0x80 && c <= 0x8A && c != 0x87) || c == 0xA8 || c == 0xA9;
+                return space ? SpaceStep::kComplete : SpaceStep::kNoMatch;
+            }
+            return c == 0x9F ? SpaceStep::kComplete : SpaceStep::kNoMatch;
+        case 0xE3:  // U+3000
+            if (c != 0x80) {
+                return SpaceStep::kNoMatch;
+            }
+            return len == 1 ? SpaceStep::kPartial : SpaceStep::kComplete;
+        default:
+            return SpaceStep::kNoMatch;
+    }
+}
+
+size_t countWordStartsScalar(const char* data, size_t size, TextCounter::WordState& state) {
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        auto c = static_cast<unsigned char>(data[i]);
+        if (state.pendingSize > 0) {
+            SpaceStep step = spaceSequenceStep(state.pending, state.pendingSize, c);
+            if (step == SpaceStep::kComplete) {
+                state.prevIsSpace = true;
+                state.pendingSize = 0;
+                continue;
+            }
+            if (step == SpaceStep::kPartial) {
+                state.pending[state.pendingSize++] = c;
+                continue;
+            }
+            // Последовательность оказалась обычным символом
+            count += state.prevIsSpace ? 1 : 0;
+            state.prevIsSpace = false;
+            state.pendingSize = 0;
+        }
+
+        if (TextCounter::isSpace(c)) {
+            state.prevIsSpace = true;
+        } else if (isSpaceLead(c)) {
+            state.pending[0] = c;
+            state.pendingSize = 1;
+        } else {
+            count += state.prevIsSpace ? 1 : 0;
+            state.prevIsSpace = false;
+        }
+    }
+    return count;
+}
+
+// Длина префикса из ASCII-байт
+size_t asciiPrefix(const unsigned char* data, size_t size) {
+    size_t i = 0;
+#ifdef SHELL_TEXT_COUNTER_X86
+    for (; size - i >= 16; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+    }
+#else
+    for (; size - i >= 16; i += 16) {
+        uint64_t words[2];
+        std::memcpy(words, data + i, sizeof(words));
+        if (((words[0] | words[1]) & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+#endif
+    while (i < size && data[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+#ifdef SHELL_TEXT_COUNTER_X86
+
+// Число начал слов в 64-байтном окне по маске пробельных байт
+inline size_t wordStartsInMask(uint64_t spaceMask, bool& prevIsSpace) {
+    uint64_t prevMask = (spaceMask << 1) | (prevIsSpace ? 1U : 0U);
+    prevIsSpace = (spaceMask >> 63) != 0;
+    return static_cast<size_t>(__builtin_popcountll(~spaceMask & prevMask));
+}
+
+size_t countNewlinesSse2(const char* data, size_t size) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+
+    while (size - i >= 16) {
+        // Байтовые счётчики переполняются после 255 итераций
+        size_t steps = std::min<size_t>((size - i) / 16, 255);
+        __m128i acc = _mm_setzero_si128();
+        for (size_t s = 0; s < steps; ++s, i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(chunk, newline));
+        }
+        alignas(16) uint64_t sums[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(sums), _mm_sad_epu8(acc, _mm_setzero_si128()));
+        count += static_cast<size_t>(sums[0] + sums[1]);
+    }
+
+    return count + countNewlinesScalar(data + i, size - i);
+}
+
+size_t countCharsSse2(const char* data, size_t size) {
+    const __m128i threshold = _mm_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+
+    while (size - i >= 16) {
+        size_t steps = std::min<size_t>((size - i) / 16, 255);
+        __m128i acc = _mm_setzero_si128();
+        for (size_t s = 0; s < steps; ++s, i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            acc = _mm_sub_epi8(acc, _mm_cmpgt_epi8(chunk, threshold));
+        }
+        alignas(16) uint64_t sums[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(sums), _mm_sad_epu8(acc, _mm_setzero_si128()));
+        count += static_cast<size_t>(sums[0] + sums[1]);
+    }
+
+    return count + countCharsScalar(data + i, size - i);
+}
+
+// Маска байт, которые могут начинать пробел Unicode (C2, E1..E3)
+inline uint32_t spaceLeadMaskSse2(__m128i chunk) {
+    __m128i c2 = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(static_cast<char>(0xC2)));
+    __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8(static_cast<char>(0xE1)));
+    __m128i e1e3 = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(2)), shifted);
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(c2, e1e3)));
+}
+
+inline uint32_t spaceMaskSse2(__m128i chunk) {
+    __m128i blank = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '));
+    // '\t'..'\r': (c - '\t') как беззнаковое не больше 4
+    __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+    __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(blank, control)));
+}
+
+size_t countWordStartsSse2(const char* data, size_t size, TextCounter::WordState& state) {
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; size - i >= 64; i += 64) {
+        uint64_t mask = 0;
+        uint32_t leads = 0;
+        for (size_t part = 0; part < 4; ++part) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + part * 16));
+            mask |= static_cast<uint64_t>(spaceMaskSse2(chunk)) << (part * 16);
+            leads |= spaceLeadMaskSse2(chunk);
+        }
+        // Окно с возможным пробелом Unicode разбирается скалярным автоматом
+        if (leads != 0 || state.pendingSize != 0) {
+            count += countWordStartsScalar(data + i, 64, state);
+            continue;
+        }
+        count += wordStartsInMask(mask, state.prevIsSpace);
+    }
+
+    return count + countWordStartsScalar(data + i, size - i, state);
+}
+
+__attribute__((target("avx2"))) size_t countNewlinesAvx2(const char* data, size_t size) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+
+    while (size - i >= 32) {
+        size_t steps = std::min<size_t>((size - i) / 32, 255);
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t s = 0; s < steps; ++s, i += 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(chunk, newline));
+        }
+        alignas(32) uint64_t sums[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(sums),
+                           _mm256_sad_epu8(acc, _mm256_setzero_si256()));
+        count += static_cast<size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+
+    return count + countNewlinesScalar(data + i, size - i);
+}
+
+__attribute__((target("avx2"))) size_t countCharsAvx2(const char* data, size_t size) {
+    const __m256i threshold = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+
+    while (size - i >= 32) {
+        size_t steps = std::min<size_t>((size - i) / 32, 255);
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t s = 0; s < steps; ++s, i += 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpgt_epi8(chunk, threshold));
+        }
+        alignas(32) uint64_t sums[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(sums),
+                           _mm256_sad_epu8(acc, _mm256_setzero_si256()));
+        count += static_cast<size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+
+    return count + countCharsScalar(data + i, size - i);
+}
+
+__attribute__((target("avx2"))) inline uint32_t spaceLeadMaskAvx2(__m256i chunk) {
+    __m256i c2 = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(static_cast<char>(0xC2)));
+    __m256i shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8(static_cast<char>(0xE1)));
+    __m256i e1e3 = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(2)), shifted);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(c2, e1e3)));
+}
+
+__attribute__((target("avx2"))) inline uint32_t spaceMaskAvx2(__m256i chunk) {
+    __m256i blank = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' '));
+    __m256i shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8('\t'));
+    __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(blank, control)));
+}
+
+__attribute__((target("avx2,popcnt"))) size_t countWordStartsAvx2(const char* data, size_t size,
+                                                                  TextCounter::WordState& state) {
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; size - i >= 64; i += 64) {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        if ((spaceLeadMaskAvx2(low) | spaceLeadMaskAvx2(high)) != 0 || state.pendingSize != 0) {
+            count += countWordStartsScalar(data + i, 64, state);
+            continue;
+        }
+        uint64_t mask = static_cast<uint64_t>(spaceMaskAvx2(low)) |
+                        (static_cast<uint64_t>(spaceMaskAvx2(high)) << 32);
+        count += wordStartsInMask(mask, state.prevIsSpace);
+    }
+
+    return count + countWordStartsScalar(data + i, size - i, state);
+}
+
+#endif  // SHELL_TEXT_COUNTER_X86
+
+struct Kernels {
+    ByteKernel newlines;
+    WordKernel wordStarts;
+    ByteKernel chars;
+};
+
+Kernels selectKernels() {
+#ifdef SHELL_TEXT_COUNTER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        return {countNewlinesAvx2, countWordStartsAvx2, countCharsAvx2};
+    }
+    return {countNewlinesSse2, countWordStartsSse2, countCharsSse2};
+#else
+    return {countNewlinesScalar, countWordStartsScalar, countCharsScalar};
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+}  // namespace
+
+TextCounter::TextCounter(unsigned mode) : mode_(mode) {}
+
+void TextCounter::update(const char* data, size_t size) {
+    if ((mode_ & ~static_cast<unsigned>(kBytes)) != 0) {
+        for (size_t offset = 0; offset < size; offset += kSliceSize) {
+            size_t length = std::min(kSliceSize, size - offset);
+            const char* slice = data + offset;
+
+            if ((mode_ & kLines) != 0) {
+                counts_.lines += countNewlines(slice, length);
+            }
+            if ((mode_ & kWords) != 0) {
+                counts_.words += countWordStarts(slice, length, words_);
+            }
+            if ((mode_ & kChars) != 0) {
+                counts_.chars += countChars(slice, length);
+            }
+            if ((mode_ & kValidate) != 0) {
+                validate(reinterpret_cast<const unsigned char*>(slice), length, counts_.bytes + offset);
+            }
+        }
+    }
+    counts_.bytes += size;
+}
+
+void TextCounter::setPrecedingData(const char* data, size_t size) {
+    WordState state;
+    countWordStarts(data, size, state);
+    if (state.pendingSize > 0) {
+        // Граница куска выровнена по началу символа, значит последовательность
+        // оборвалась и была обычным символом
+        state.prevIsSpace = false;
+        state.pendingSize = 0;
+    }
+    words_ = state;
+}
+
+TextCounter::Counts TextCounter::counts() const {
+    Counts result = counts_;
+    if ((mode_ & kWords) != 0 && words_.pendingSize > 0 && words_.prevIsSpace) {
+        result.words++;
+    }
+    if ((mode_ & kValidate) != 0 && utf8_.need > 0) {
+        if (result.invalid == 0) {
+            result.firstInvalid = utf8_.start;
+        }
+        result.invalid++;
+    }
+    return result;
+}
+
+void TextCounter::validate(const unsigned char* data, size_t size, size_t base) {
+    auto reportInvalid = [this](size_t offset) {
+        if (counts_.invalid == 0) {
+            counts_.firstInvalid = offset;
+        }
+        counts_.invalid++;
+    };
+
+    size_t i = 0;
+    while (i < size) {
+        if (utf8_.need == 0) {
+            i += asciiPrefix(data + i, size - i);
+            if (i == size) {
+                break;
+            }
+        }
+
+        unsigned char c = data[i];
+        if (utf8_.need > 0) {
+            if (c < utf8_.lower || c > utf8_.upper) {
+                // Оборванная последовательность; байт разбирается заново как начало
+                reportInvalid(utf8_.start);
+                utf8_ = Utf8State{};
+                continue;
+            }
+            utf8_.need--;
+            utf8_.lower = 0x80;
+            utf8_.upper = 0xBF;
+            ++i;
+            continue;
+        }
+
+        // Первый байт: длина и допустимый диапазон второго байта отсекают
+        // слишком длинные формы, суррогаты и значения больше U+10FFFF
+        utf8_.start = base + i;
+        ++i;
+        if (c >= 0xC2 && c <= 0xDF) {
+            utf8_.need = 1;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            utf8_.need = 2;
+            utf8_.lower = c == 0xE0 ? 0xA0 : 0x80;
+            utf8_.upper = c == 0xED ? 0x9F : 0xBF;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            utf8_.need = 3;
+            utf8_.lower = c == 0xF0 ? 0x90 : 0x80;
+            utf8_.upper = c == 0xF4 ? 0x8F : 0xBF;
+        } else {
+            reportInvalid(utf8_.start);
+        }
+    }
+}
+
+TextCounter::Counts TextCounter::countParallel(const char* data, size_t size, unsigned mode,
+                                               ThreadPool& pool, size_t chunkSize) {
+    chunkSize = std::max<size_t>(chunkSize, 1);
+    std::vector<Counts> parts((size + chunkSize - 1) / chunkSize);
+
+    // Граница куска не должна разрезать символ UTF-8: сдвигается за продолжения
+    auto boundary = [data, size](size_t pos) {
+        for (size_t step = 0; step < 3 && pos < size && isContinuation(data[pos]); ++step) {
+            ++pos;
+        }
+        return pos;
+    };
+
+    pool.parallelFor(0, size, chunkSize, [&](size_t from, size_t to) {
+        size_t begin = from == 0 ? 0 : boundary(from);
+        size_t end = boundary(to);
+        if (begin >= end) {
+            return;
+        }
+        TextCounter counter(mode);
+        // Слово, пересекающее границу, засчитывается куску, где оно началось
+        size_t lookbehind = std::min<size_t>(begin, 3);
+        counter.setPrecedingData(data + begin - lookbehind, lookbehind);
+        counter.update(data + begin, end - begin);
+        Counts counts = counter.counts();
+        counts.firstInvalid += begin;
+        parts[from / chunkSize] = counts;
+    });
+
+    Counts total;
+    for (const Counts& counts : parts) {
+        total.lines += counts.lines;
+        total.words += counts.words;
+        total.chars += counts.chars;
+        total.bytes += counts.bytes;
+        if (counts.invalid > 0 && total.invalid == 0) {
+            total.firstInvalid = counts.firstInvalid;
+        }
+        total.invalid += counts.invalid;
+    }
+    return total;
+}
+
+size_t TextCounter::countNewlines(const char* data, size_t size) {
+    return kernels().newlines(data, size);
+}
+
+size_t TextCounter::countWordStarts(const char* data, size_t size, bool prevIsSpace) {
+    WordState state;
+    state.prevIsSpace = prevIsSpace;
+    size_t count = kernels().wordStarts(data, size, state);
+    // Незавершённая последовательность в конце — обычный символ
+    return count + (state.pendingSize > 0 && state.prevIsSpace ? 1 : 0);
+}
+
+size_t TextCounter::countWordStarts(const char* data, size_t size, WordState& state) {
+    return kernels().wordStarts(data, size, state);
+}
+
+size_t TextCounter::countChars(const char* data, size_t size) {
+    return kernels().chars(data, size);
+}
+
+}  // namespace shell
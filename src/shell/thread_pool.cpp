@@ -0,0 +1,207 @@
+#include "shell/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace shell {
+
+namespace {
+
+// Работник пула, которому принадлежит текущий поток
+thread_local const ThreadPool* tPool = nullptr;
+thread_local size_t tWorker = 0;
+
+// SHELL_THREADS из окружения shell на случай, если общий пул ещё не создан
+std::mutex gSharedMutex;
+std::string gSharedThreads;
+bool gSharedConfigured = false;
+std::atomic<bool> gSharedCreated{false};
+
+#ifdef __linux__
+
+// Квота CPU cgroup в ядрах (округляется вверх); 0 — без ограничения
+size_t cgroupCpuLimit() {
+    // cgroup v2: "<квота> <период>" или "max <период>" в каталоге группы процесса
+    std::string group;
+    std::ifstream self("/proc/self/cgroup");
+    for (std::string line; std::getline(self, line);) {
+        if (line.rfind("0::", 0) == 0) {
+            group = line.substr(3);
+        }
+    }
+    for (const std::string& dir : {"/sys/fs/cgroup" + group, std::string("/sys/fs/cgroup")}) {
+        std::ifstream max(dir + "/cpu.max");
+        std::string quota;
+        double period = 0;
+        if (max >> quota >> period) {
+            if (quota == "max" || period <= 0) {
+                return 0;
+            }
+            return static_cast<size_t>(std::ceil(std::atof(quota.c_str()) / period));
+        }
+    }
+
+    // cgroup v1
+    std::ifstream quotaFile("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+    std::ifstream periodFile("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+    double quota = 0;
+    double period = 0;
+    if (quotaFile >> quota && periodFile >> period && quota > 0 && period > 0) {
+        return static_cast<size_t>(std::ceil(quota / period));
+    }
+    return 0;
+}
+
+#endif  // __linux__
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+    threads = std::max<size_t>(threads, 1);
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Потоки запускаются после создания всех очередей: работник сразу перехватывает из соседних
+    for (size_t i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    available_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool([] {
+        std::lock_guard<std::mutex> lock(gSharedMutex);
+        gSharedCreated.store(true);
+        return gSharedConfigured ? sizeFor(gSharedThreads.c_str()) : defaultSize();
+    }());
+    return pool;
+}
+
+void ThreadPool::configureShared(const Environment& env) {
+    if (gSharedCreated.load()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(gSharedMutex);
+    gSharedThreads = env.get("SHELL_THREADS");
+    gSharedConfigured = true;
+}
+
+size_t ThreadPool::defaultSize() {
+    return sizeFor(std::getenv("SHELL_THREADS"));
+}
+
+size_t ThreadPool::sizeFor(const char* value) {
+    if (value != nullptr) {
+        char* end = nullptr;
+        unsigned long threads = std::strtoul(value, &end, 10);
+        if (end != value && *end == '\0' && threads > 0) {
+            return std::min<size_t>(threads, 1024);
+        }
+    }
+
+    size_t cpus = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+#ifdef __linux__
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        cpus = static_cast<size_t>(std::max(CPU_COUNT(&set), 1));
+    }
+    if (size_t limit = cgroupCpuLimit(); limit > 0) {
+        cpus = std::min(cpus, limit);
+    }
+#endif
+    return cpus;
+}
+
+ThreadPool::Stats ThreadPool::stats() const {
+    Stats stats;
+    stats.threads = workers_.size();
+    for (const auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        stats.depths.push_back(worker->tasks.size());
+        stats.queued += worker->tasks.size();
+    }
+    stats.executed = executed_.load(std::memory_order_relaxed);
+    stats.steals = steals_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    size_t target = tPool == this ? tWorker
+                                  : nextWorker_.fetch_add(1, std::memory_order_relaxed) %
+                                        workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+        workers_[target]->tasks.push_back(std::move(task));
+        queued_.fetch_add(1);
+    }
+    // Пустая блокировка: работник не пропустит уведомление между проверкой и ожиданием
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    available_.notify_one();
+}
+
+bool ThreadPool::take(size_t self, std::function<void()>& task) {
+    const size_t count = workers_.size();
+    for (size_t step = 0; step < count; ++step) {
+        Worker& worker = *workers_[(self + step) % count];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty()) {
+            continue;
+        }
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        queued_.fetch_sub(1);
+        if (step > 0) {
+            steals_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::runPending() {
+    std::function<void()> task;
+    if (!take(tPool == this ? tWorker : 0, task)) {
+        return false;
+    }
+    task();
+    executed_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    tPool = this;
+    tWorker = index;
+    while (true) {
+        std::function<void()> task;
+        if (take(index, task)) {
+            task();
+            executed_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        available_.wait(lock, [this]() { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+}  // namespace shell
@@ -2,7 +2,8 @@
 
 namespace shell {
 
-Token::Token(TokenType t, std::string v) : type(t), value(std::move(v)) {}
+Token::Token(TokenType t, std::string_view v, std::pmr::memory_resource* resource)
+    : type(t), value(v, resource), pattern(resource) {}
 
 bool Token::operator==(const Token& other) const {
     return type == other.type && value == other.value;
@@ -0,0 +1,31 @@
+/**
+ * Плагин для теста проверки версии ABI: сообщает версию, предшествующую
+ * kPluginAbiVersion, как плагин, собранный со старыми заголовками.
+ */
+
+#include "shell/plugin.hpp"
+
+namespace {
+
+class OldCommand : public shell::Command {
+public:
+    shell::CommandResult execute(std::istream&, std::ostream&, std::ostream&) override {
+        return 0;
+    }
+
+    void setArguments(std::vector<std::string>) override {}
+
+    std::string getName() const override {
+        return "old";
+    }
+};
+
+}  // namespace
+
+extern "C" int shell_plugin_abi_version() {
+    return shell::kPluginAbiVersion - 1;
+}
+
+extern "C" void shell_plugin_register(shell::PluginRegistrar* registrar) {
+    registrar->add("old", []() -> shell::Command* { return new OldCommand(); });
+}
@@ -1,3 +1,5 @@
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 
@@ -9,6 +11,7 @@
 #include "shell/commands/pwd_command.hpp"
 #include "shell/commands/wc_command.hpp"
 #include "shell/environment.hpp"
+#include "shell/input_file.hpp"
 
 using namespace shell;
 
@@ -99,6 +102,17 @@ TEST_F(CommandsTest, CatFromStdin) {
     EXPECT_EQ(output.str(), "hello from stdin");
 }
 
+// Проверяет: пустой вход не переводит выходной поток в состояние ошибки.
+// Вход: cat без аргументов и пустой stdin, затем запись в тот же out. Выход: out исправен.
+TEST_F(CommandsTest, CatEmptyInputKeepsOutputUsable) {
+    CatCommand cmd;
+    cmd.setArguments({});
+    EXPECT_EQ(cmd.execute(emptyInput, output, errors), 0);
+    EXPECT_TRUE(output.good());
+    output << "after";
+    EXPECT_EQ(output.str(), "after");
+}
+
 TEST_F(CommandsTest, CatFileNotFound) {
     CatCommand cmd;
     cmd.setArguments({"nonexistent_file_12345.txt"});
@@ -200,6 +214,120 @@ TEST_F(CommandsTest, WcExistingFile) {
     std::remove(filename.c_str());
 }
 
+// Проверяет: в память отображаются только большие файлы, давно не менявшиеся (обрезание
+// отображённого файла — SIGBUS), остальные wc читает через read с тем же результатом.
+// Вход: файл 1 МиБ сразу после записи и с mtime час назад, старый файл 4 байта.
+// Выход: map() пуст, затем весь файл; пуст для маленького; одинаковый вывод wc.
+TEST_F(CommandsTest, WcMapsOnlySettledFiles) {
+    namespace fs = std::filesystem;
+    const std::string filename = "/tmp/test_wc_settled.txt";
+    const std::string small = "/tmp/test_wc_settled_small.txt";
+    std::string content;
+    while (content.size() < 1024 * 1024) {
+        content += "alpha beta\n";
+    }
+    std::ofstream(filename) << content;
+    std::ofstream(small) << "abc\n";
+
+    auto count = [&]() {
+        output.str("");
+        WcCommand cmd;
+        cmd.setArguments({filename});
+        EXPECT_EQ(cmd.execute(emptyInput, output, errors), 0);
+        return output.str();
+    };
+
+    EXPECT_TRUE(InputFile(filename).map().empty());
+    std::string fresh = count();
+
+    auto hourAgo = fs::file_time_type::clock::now() - std::chrono::hours(1);
+    fs::last_write_time(filename, hourAgo);
+    fs::last_write_time(small, hourAgo);
+    EXPECT_EQ(InputFile(filename).map().size(), content.size());
+    EXPECT_TRUE(InputFile(small).map().empty());
+    EXPECT_EQ(count(), fresh);
+    EXPECT_EQ(fresh, std::to_string(content.size() / 11) + " " +
+                         std::to_string(content.size() / 11 * 2) + " " +
+                         std::to_string(content.size()) + " " + filename + "\n");
+    std::remove(filename.c_str());
+    std::remove(small.c_str());
+}
+
+// Проверяет: последняя строка без перевода строки учитывается в байтах, но не в строках.
+// Вход: "hello world" (11 байт). Выход: "0 2 11\n".
+TEST_F(CommandsTest, WcNoTrailingNewline) {
+    WcCommand cmd;
+    cmd.setArguments({});
+
+    std::istringstream input("hello world");
+    int result = cmd.execute(input, output, errors);
+
+    EXPECT_EQ(result, 0);
+    EXPECT_EQ(output.str(), "0 2 11\n");
+}
+
+// Проверяет: флаги -l, -w, -c выводят только выбранные счётчики в порядке строки/слова/байты.
+TEST_F(CommandsTest, WcSelectedCounters) {
+    WcCommand lines;
+    lines.setArguments({"-l"});
+    std::istringstream input1("a b\nc\n");
+    EXPECT_EQ(lines.execute(input1, output, errors), 0);
+    EXPECT_EQ(output.str(), "2\n");
+
+    output.str("");
+    WcCommand combined;
+    combined.setArguments({"-cw"});
+    std::istringstream input2("a b\nc\n");
+    EXPECT_EQ(combined.execute(input2, output, errors), 0);
+    EXPECT_EQ(output.str(), "3 6\n");
+}
+
+// Проверяет: wc -c по обычному файлу и итоговая строка для нескольких файлов.
+// Вход: два файла по 4 байта. Выход: "4 f1\n4 f2\n8 total\n".
+TEST_F(CommandsTest, WcBytesOfFilesWithTotal) {
+    const std::string first = "/tmp/test_wc_bytes_1.txt";
+    const std::string second = "/tmp/test_wc_bytes_2.txt";
+    {
+        std::ofstream f1(first);
+        f1 << "abc\n";
+        std::ofstream f2(second);
+        f2 << "de f";
+    }
+    WcCommand cmd;
+    cmd.setArguments({"-c", first, second});
+    int result = cmd.execute(emptyInput, output, errors);
+    EXPECT_EQ(result, 0);
+    EXPECT_EQ(output.str(), "4 " + first + "\n4 " + second + "\n8 total\n");
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+}
+
+// Проверяет: неизвестный флаг — ошибка. Вход: args=["-z"]. Выход: 1, сообщение в err.
+TEST_F(CommandsTest, WcInvalidOption) {
+    WcCommand cmd;
+    cmd.setArguments({"-z"});
+    EXPECT_EQ(cmd.execute(emptyInput, output, errors), 1);
+    EXPECT_NE(errors.str().find("invalid option"), std::string::npos);
+}
+
+// Проверяет: wc -m считает символы UTF-8, --check-utf8 сообщает о некорректном вводе.
+// Вход: "привет мир\n" и "a\xffb". Выход: "11\n"; для второго — код 1 и сообщение в err.
+TEST_F(CommandsTest, WcCharsAndUtf8Check) {
+    WcCommand chars;
+    chars.setArguments({"-m"});
+    std::istringstream input1("привет мир\n");
+    EXPECT_EQ(chars.execute(input1, output, errors), 0);
+    EXPECT_EQ(output.str(), "11\n");
+
+    output.str("");
+    WcCommand check;
+    check.setArguments({"--check-utf8"});
+    std::istringstream input2("a\xff" "b");
+    EXPECT_EQ(check.execute(input2, output, errors), 1);
+    EXPECT_EQ(output.str(), "0 1 3\n");
+    EXPECT_NE(errors.str().find("invalid UTF-8 at byte 1"), std::string::npos);
+}
+
 // Проверяет: wc .gitignore (критерий ДЗ). Вход: args=["../.gitignore"] если файл есть. Выход: 0,
 // строка с числами.
 TEST_F(CommandsTest, WcGitignore) {
@@ -235,9 +363,10 @@ TEST_F(CommandsTest, ExitDefault) {
     ExitCommand cmd;
     cmd.setArguments({});
 
-    int result = cmd.execute(emptyInput, output, errors);
+    CommandResult result = cmd.execute(emptyInput, output, errors);
 
-    EXPECT_EQ(result, 0);
+    EXPECT_EQ(result.code(), 0);
+    EXPECT_EQ(result.control(), CommandResult::Control::kExit);
     EXPECT_TRUE(cmd.wasExitRequested());
     EXPECT_EQ(cmd.getExitCode(), 0);
 }
@@ -246,9 +375,10 @@ TEST_F(CommandsTest, ExitWithCode) {
     ExitCommand cmd;
     cmd.setArguments({"42"});
 
-    int result = cmd.execute(emptyInput, output, errors);
+    CommandResult result = cmd.execute(emptyInput, output, errors);
 
-    EXPECT_EQ(result, 42);
+    EXPECT_EQ(result.code(), 42);
+    EXPECT_EQ(result.control(), CommandResult::Control::kExit);
     EXPECT_TRUE(cmd.wasExitRequested());
     EXPECT_EQ(cmd.getExitCode(), 42);
 }
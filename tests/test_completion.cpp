@@ -0,0 +1,174 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/completion.hpp"
+#include "shell/environment.hpp"
+#include "shell/history.hpp"
+#include "shell/line_editor.hpp"
+#include "shell/path_cache.hpp"
+
+using namespace shell;
+namespace fs = std::filesystem;
+
+/**
+ * Юнит-тесты для NameTrie, ExecutableIndex (каталоги PATH во временном
+ * каталоге) и Completer, в том числе через Tab в LineEditor.
+ */
+class CompletionTest : public ::testing::Test {
+protected:
+    fs::path root = fs::temp_directory_path() / "shell_completion_test";
+
+    void SetUp() override {
+        fs::remove_all(root);
+        fs::create_directories(root / "bin1");
+        fs::create_directories(root / "bin2");
+        fs::create_directories(root / "work" / "src");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    static void touch(const fs::path& path, bool executable) {
+        std::ofstream(path) << "#!/bin/sh\n";
+        fs::permissions(path, executable ? fs::perms::owner_all : fs::perms::owner_read);
+    }
+
+    // Сдвинуть mtime каталога, чтобы изменение было заметно при грубых отметках времени
+    static void bumpMtime(const fs::path& dir) {
+        fs::last_write_time(dir, fs::last_write_time(dir) + std::chrono::seconds(2));
+    }
+};
+
+// Проверяет: повторно добавленное имя остаётся до такого же числа удалений, выдача по префиксу
+// упорядочена и ограничена. Вход: "git" дважды, "gitk", "grep". Выход: списки по префиксам.
+TEST_F(CompletionTest, NameTrieCountsDuplicates) {
+    NameTrie trie;
+    for (const char* name : {"git", "gitk", "grep", "git"}) {
+        trie.insert(name);
+    }
+    EXPECT_EQ(trie.size(), 3U);
+    EXPECT_EQ(trie.withPrefix("g"), (std::vector<std::string>{"git", "gitk", "grep"}));
+    EXPECT_EQ(trie.withPrefix("g", 2), (std::vector<std::string>{"git", "gitk"}));
+
+    trie.erase("git");
+    EXPECT_EQ(trie.withPrefix("gi"), (std::vector<std::string>{"git", "gitk"}));
+    trie.erase("git");
+    trie.erase("gitk");
+    trie.erase("absent");
+    EXPECT_EQ(trie.withPrefix("gi"), std::vector<std::string>{});
+    EXPECT_EQ(trie.size(), 1U);
+
+    // Освободившиеся узлы переиспользуются
+    trie.insert("gitx");
+    EXPECT_EQ(trie.withPrefix(""), (std::vector<std::string>{"gitx", "grep"}));
+}
+
+// Проверяет: индекс видит только исполняемые файлы, перечитывает каталог, изменение которого
+// заметил PathCache, и убирает имена каталога, исчезнувшего из PATH. Вход: bin1, bin2.
+// Выход: списки имён.
+TEST_F(CompletionTest, ExecutableIndexFollowsPathCache) {
+    touch(root / "bin1" / "tool-a", true);
+    touch(root / "bin1" / "tool-notes", false);
+    touch(root / "bin2" / "tool-b", true);
+    Environment env;
+    env.set("PATH", (root / "bin1").string() + ":" + (root / "bin2").string());
+    PathCache cache(env);
+    ExecutableIndex index(cache);
+
+    index.waitForScans();
+    EXPECT_EQ(index.complete("tool"), (std::vector<std::string>{"tool-a", "tool-b"}));
+    size_t scans = index.scanCount();
+    index.refresh();
+    EXPECT_EQ(index.scanCount(), scans);
+
+    touch(root / "bin1" / "tool-c", true);
+    bumpMtime(root / "bin1");
+    index.waitForScans();
+    EXPECT_EQ(index.scanCount(), scans + 1);
+    EXPECT_EQ(index.complete("tool"), (std::vector<std::string>{"tool-a", "tool-b", "tool-c"}));
+
+    env.set("PATH", (root / "bin2").string());
+    index.waitForScans();
+    EXPECT_EQ(index.complete("tool"), std::vector<std::string>{"tool-b"});
+}
+
+// Проверяет: выбор вида дополнения по позиции слова. Вход: команда, команда после '|' и
+// присваивания, переменная, путь, "${". Выход: начало слова и варианты.
+TEST_F(CompletionTest, CompleterPicksContext) {
+    touch(root / "bin1" / "ech-tool", true);
+    touch(root / "work" / "notes.txt", false);
+    touch(root / "work" / ".hidden", false);
+    Environment env;
+    env.set("PATH", (root / "bin1").string());
+    env.set("HOME", root.string());
+    env.set("SHELL_COMPLETION_VAR", "1");
+    CommandFactory factory(env);
+    Completer completer(env, factory);
+    completer.executables().waitForScans();
+
+    auto result = completer.complete("ech", 3);
+    EXPECT_EQ(result.start, 0U);
+    EXPECT_EQ(result.candidates, (std::vector<std::string>{"ech-tool", "echo"}));
+
+    std::string line = "cat x | A=1 ec";
+    result = completer.complete(line, line.size());
+    EXPECT_EQ(result.start, line.size() - 2);
+    EXPECT_EQ(result.candidates, (std::vector<std::string>{"ech-tool", "echo"}));
+
+    line = "echo $SHELL_COMP";
+    result = completer.complete(line, line.size());
+    EXPECT_EQ(result.candidates, std::vector<std::string>{"$SHELL_COMPLETION_VAR"});
+    line = "echo ${SHELL_COMP";
+    result = completer.complete(line, line.size());
+    EXPECT_EQ(result.candidates, std::vector<std::string>{"${SHELL_COMPLETION_VAR}"});
+
+    line = "cat ~/work/";
+    result = completer.complete(line, line.size());
+    EXPECT_EQ(result.start, 4U);
+    EXPECT_EQ(result.candidates, (std::vector<std::string>{"~/work/notes.txt", "~/work/src/"}));
+    line = "cat ~/work/.h";
+    result = completer.complete(line, line.size());
+    EXPECT_EQ(result.candidates, std::vector<std::string>{"~/work/.hidden"});
+}
+
+// Проверяет: Tab в редакторе дописывает единственный вариант с пробелом, а при нескольких —
+// общий префикс; повторный Tab выводит варианты. Вход: "hea\t", "ec\t\t". Выход: строки.
+TEST_F(CompletionTest, LineEditorCompletesOnTab) {
+    Environment env;
+    env.set("PATH", (root / "bin1").string());
+    CommandFactory factory(env);
+    Completer completer(env, factory);
+    touch(root / "bin1" / "echoes", true);
+    completer.executables().waitForScans();
+    History history((root / "history").string());
+
+    auto edit = [&](const std::string& keys, std::string& screen) {
+        int fds[2];
+        EXPECT_EQ(pipe(fds), 0);
+        EXPECT_EQ(write(fds[1], keys.data(), keys.size()), static_cast<ssize_t>(keys.size()));
+        close(fds[1]);
+        std::ostringstream out;
+        LineEditor editor(fds[0], out, history);
+        editor.setCompleter(&completer);
+        std::string line;
+        editor.readLine("$ ", line);
+        close(fds[0]);
+        screen = out.str();
+        return line;
+    };
+
+    std::string screen;
+    EXPECT_EQ(edit("hea\thi\r", screen), "head hi");
+    EXPECT_EQ(edit("ec\t\t\r", screen), "echo");
+    EXPECT_NE(screen.find("\necho  echoes\n"), std::string::npos);
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/commands/cat_command.hpp"
+#include "shell/commands/echo_command.hpp"
+#include "shell/commands/wc_command.hpp"
+#include "shell/coroutine_stage.hpp"
+#include "shell/environment.hpp"
+#include "shell/executor.hpp"
+#include "shell/pipeline.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для стадий-сопрограмм (StageTask, runStages) и пайплайнов
+ * из команд-сопрограмм в Executor.
+ */
+namespace {
+
+// Отдаёт count кусков по size байт, пока следующая стадия читает
+StageTask produce(StageIO& /*io*/, size_t count, size_t size, size_t& produced) {
+    std::string chunk(size, 'x');
+    for (size_t i = 0; i < count; ++i) {
+        if (!(co_yield chunk)) {
+            co_return 141;
+        }
+        ++produced;
+    }
+    co_return 0;
+}
+
+// Читает вход до конца или до limit байт, запоминая наибольший кусок
+StageTask consume(StageIO& io, size_t limit, size_t& received, size_t& largest) {
+    for (std::string_view chunk; !(chunk = co_await io.read()).empty();) {
+        received += chunk.size();
+        largest = std::max(largest, chunk.size());
+        if (received >= limit) {
+            break;
+        }
+    }
+    co_return 0;
+}
+
+// Команда-сопрограмма, запоминающая поток, в котором выполнялась
+class ThreadRecorder : public StageCommand {
+public:
+    explicit ThreadRecorder(std::thread::id& id) : id_(id) {}
+
+    CommandResult execute(std::istream&, std::ostream&, std::ostream&) override {
+        return 1;
+    }
+
+    StageTask stage(StageIO& io) override {
+        id_ = std::this_thread::get_id();
+        for (std::string_view chunk; !(chunk = co_await io.read()).empty();) {
+            co_yield chunk;
+        }
+        co_return 0;
+    }
+
+    void setArguments(std::vector<std::string>) override {}
+
+    std::string getName() const override {
+        return "recorder";
+    }
+
+private:
+    std::thread::id& id_;
+};
+
+}  // namespace
+
+// Проверяет: стадии чередуются в одном потоке, а канал между ними не растёт больше предела.
+// Вход: 4096 кусков по 1 КиБ → потребитель. Выход: всё доставлено, кусок ≤ kLimit + 1 КиБ.
+TEST(CoroutineStageTest, InterleavesWithBoundedChannel) {
+    std::vector<StageChannel> channels(3);
+    StageIO producerIo(channels[0], channels[1], std::cerr);
+    StageIO consumerIo(channels[1], channels[2], std::cerr);
+    size_t produced = 0;
+    size_t received = 0;
+    size_t largest = 0;
+    std::vector<StageTask> stages;
+    stages.push_back(produce(producerIo, 4096, 1024, produced));
+    stages.push_back(consume(consumerIo, SIZE_MAX, received, largest));
+
+    std::ostringstream out;
+    auto results = runStages(stages, channels, nullptr, out, std::cerr);
+    EXPECT_EQ(received, 4096U * 1024U);
+    EXPECT_LE(largest, StageChannel::kLimit + 1024);
+    EXPECT_EQ(results[0].code(), 0);
+    EXPECT_EQ(results[1].code(), 0);
+}
+
+// Проверяет: когда следующая стадия завершилась, co_yield возвращает false и производитель
+// останавливается. Вход: бесконечный производитель → потребитель 10 КиБ. Выход: код 141.
+TEST(CoroutineStageTest, StopsProducerWhenConsumerFinishes) {
+    std::vector<StageChannel> channels(3);
+    StageIO producerIo(channels[0], channels[1], std::cerr);
+    StageIO consumerIo(channels[1], channels[2], std::cerr);
+    size_t produced = 0;
+    size_t received = 0;
+    size_t largest = 0;
+    std::vector<StageTask> stages;
+    stages.push_back(produce(producerIo, SIZE_MAX, 1024, produced));
+    stages.push_back(consume(consumerIo, 10 * 1024, received, largest));
+
+    std::ostringstream out;
+    auto results = runStages(stages, channels, nullptr, out, std::cerr);
+    EXPECT_GE(received, 10U * 1024U);
+    EXPECT_LT(produced, 1024U);
+    EXPECT_EQ(results[0].code(), 141);
+}
+
+// Проверяет: пайплайн из команд-сопрограмм выполняется в вызывающем потоке и даёт тот же
+// вывод, что и обычное выполнение. Вход: echo → cat → recorder → wc. Выход: "1 2 12\n".
+TEST(CoroutineStageTest, ExecutorRunsStagesOnCallingThread) {
+    Environment env;
+    std::thread::id stageThread;
+    Pipeline pipeline;
+    auto echo = std::make_unique<EchoCommand>();
+    echo->setArguments({"hello", "world"});
+    pipeline.addCommand(std::move(echo));
+    pipeline.addCommand(std::make_unique<CatCommand>());
+    pipeline.addCommand(std::make_unique<ThreadRecorder>(stageThread));
+    pipeline.addCommand(std::make_unique<WcCommand>());
+
+    std::ostringstream captured;
+    std::streambuf* old = std::cout.rdbuf(captured.rdbuf());
+    Executor executor(env);
+    int code = executor.execute(pipeline);
+    std::cout.rdbuf(old);
+
+    EXPECT_EQ(code, 0);
+    EXPECT_EQ(captured.str(), "1 2 12\n");
+    EXPECT_EQ(stageThread, std::this_thread::get_id());
+}
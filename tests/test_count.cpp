@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/commands/count_command.hpp"
+#include "shell/commands/uniq_command.hpp"
+#include "shell/environment.hpp"
+#include "shell/line_counter.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для LineCounter, CountCommand и UniqCommand.
+ */
+class CountTest : public ::testing::Test {
+protected:
+    std::ostringstream output;
+    std::ostringstream errors;
+
+    template <typename T>
+    int run(const std::vector<std::string>& args, const std::string& input = "") {
+        T cmd;
+        cmd.setArguments(args);
+        std::istringstream in(input);
+        return cmd.execute(in, output, errors);
+    }
+};
+
+// Проверяет: счётчики совпадают с std::map при росте таблицы, top(k) — префикс sorted().
+// Вход: 100000 случайных ключей из 5000. Выход: те же пары, порядок по убыванию счётчика.
+TEST_F(CountTest, LineCounterMatchesMap) {
+    std::mt19937 gen(7);
+    std::geometric_distribution<int> pick(0.001);
+    LineCounter counter;
+    std::map<std::string, uint64_t> expected;
+    for (int i = 0; i < 100000; ++i) {
+        std::string key = "key" + std::to_string(pick(gen) % 5000);
+        counter.add(key);
+        ++expected[key];
+    }
+    counter.add("");
+    ++expected[""];
+
+    auto entries = counter.sorted();
+    ASSERT_EQ(counter.size(), expected.size());
+    ASSERT_EQ(entries.size(), expected.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        EXPECT_EQ(entries[i].count, expected[std::string(entries[i].key)]);
+        if (i > 0) {
+            EXPECT_TRUE(entries[i - 1].count > entries[i].count ||
+                        (entries[i - 1].count == entries[i].count &&
+                         entries[i - 1].key < entries[i].key));
+        }
+    }
+
+    for (size_t k : {0, 1, 10, 100}) {
+        auto top = counter.top(k);
+        ASSERT_EQ(top.size(), k);
+        for (size_t i = 0; i < k; ++i) {
+            EXPECT_EQ(top[i].key, entries[i].key);
+            EXPECT_EQ(top[i].count, entries[i].count);
+        }
+    }
+}
+
+// Проверяет: count по строкам, по полю (пробелы и -t) и -n; формат как у uniq -c.
+// Вход: журнал "метод путь". Выход: частоты по убыванию.
+TEST_F(CountTest, CountCommand) {
+    const std::string log = "GET /a\nPOST /b\nGET /b\n  GET /a\nGET /a\nPOST /b";
+    EXPECT_EQ(run<CountCommand>({}, log), 0);
+    EXPECT_EQ(output.str(), "      2 GET /a\n      2 POST /b\n      1   GET /a\n      1 GET /b\n");
+
+    output.str("");
+    EXPECT_EQ(run<CountCommand>({"-f", "1", "-n", "1"}, log), 0);
+    EXPECT_EQ(output.str(), "      4 GET\n");
+
+    output.str("");
+    EXPECT_EQ(run<CountCommand>({"-t/", "-f2"}, log), 0);
+    EXPECT_EQ(output.str(), "      3 a\n      3 b\n");
+
+    EXPECT_EQ(run<CountCommand>({"-f", "0"}), 1);
+    EXPECT_NE(errors.str().find("invalid field"), std::string::npos);
+}
+
+// Проверяет: uniq схлопывает только соседние строки; -c, -d, -u; файл и ошибки.
+TEST_F(CountTest, UniqCommand) {
+    const std::string input = "a\na\nb\na\nc\nc\nc";
+    EXPECT_EQ(run<UniqCommand>({}, input), 0);
+    EXPECT_EQ(output.str(), "a\nb\na\nc\n");
+
+    output.str("");
+    EXPECT_EQ(run<UniqCommand>({"-c"}, input), 0);
+    EXPECT_EQ(output.str(), "      2 a\n      1 b\n      1 a\n      3 c\n");
+
+    output.str("");
+    EXPECT_EQ(run<UniqCommand>({"-d"}, input), 0);
+    EXPECT_EQ(output.str(), "a\nc\n");
+
+    output.str("");
+    EXPECT_EQ(run<UniqCommand>({"-u"}, input), 0);
+    EXPECT_EQ(output.str(), "b\na\n");
+
+    std::string path = (std::filesystem::temp_directory_path() / "shell_uniq_test.txt").string();
+    std::ofstream(path) << "x\nx\ny\n";
+    output.str("");
+    EXPECT_EQ(run<UniqCommand>({"-c", path}), 0);
+    EXPECT_EQ(output.str(), "      2 x\n      1 y\n");
+    EXPECT_EQ(run<UniqCommand>({path, "extra"}), 1);
+    std::remove(path.c_str());
+
+    Environment env;
+    CommandFactory factory(env);
+    EXPECT_TRUE(factory.isBuiltin("uniq"));
+    EXPECT_TRUE(factory.isBuiltin("count"));
+}
@@ -1,3 +1,4 @@
+#include <memory>
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -5,6 +6,8 @@
 #include "shell/command_factory.hpp"
 #include "shell/environment.hpp"
 #include "shell/executor.hpp"
+#include "shell/io_ring.hpp"
+#include "shell/path_cache.hpp"
 #include "shell/parsed_command.hpp"
 #include "shell/pipeline.hpp"
 
@@ -117,6 +120,36 @@ TEST_F(ExecutorTest, ExitWithoutArgCodeZero) {
     EXPECT_EQ(executor.getExitCode(), 0);
 }
 
+/**
+ * Команда, запрашивающая выход через результат (не ExitCommand).
+ */
+class QuitCommand : public Command {
+public:
+    CommandResult execute(std::istream&, std::ostream&, std::ostream&) override {
+        return CommandResult::exit(5);
+    }
+    void setArguments(std::vector<std::string>) override {}
+    std::string getName() const override {
+        return "quit";
+    }
+};
+
+// Проверяет: выход определяется по результату команды, а не по её типу, в том числе в
+// середине пайплайна. Вход: quit | echo x. Выход: shouldExit()==true, getExitCode()==5, код 0.
+TEST_F(ExecutorTest, ExitSignaledThroughResult) {
+    CommandFactory factory(env);
+    Executor executor(env);
+    Pipeline pipeline;
+    pipeline.addCommand(std::make_unique<QuitCommand>());
+    auto echo = factory.create("echo");
+    echo->setArguments({"x"});
+    pipeline.addCommand(std::move(echo));
+
+    EXPECT_EQ(executor.execute(pipeline), 0);
+    EXPECT_TRUE(executor.shouldExit());
+    EXPECT_EQ(executor.getExitCode(), 5);
+}
+
 // Проверяет: выполнение одной команды echo выводит в stdout и возвращает 0.
 // Вход: Pipeline с EchoCommand("hello"). Выход: код 0, capturedOut == "hello\n".
 TEST_F(ExecutorTest, ExecuteSingleEcho) {
@@ -156,3 +189,67 @@ TEST_F(ExecutorTest, ShouldExitFalseInitially) {
     Executor executor(env);
     EXPECT_FALSE(executor.shouldExit());
 }
+
+/**
+ * Бесконечный источник: пишет строки, пока вывод их принимает.
+ */
+class EndlessCommand : public Command {
+public:
+    CommandResult execute(std::istream&, std::ostream& out, std::ostream&) override {
+        while (out << "line\n") {
+        }
+        return 0;
+    }
+    void setArguments(std::vector<std::string>) override {}
+    std::string getName() const override {
+        return "endless";
+    }
+};
+
+// Проверяет: после выхода head предыдущие стадии останавливаются — встроенная получает ошибку
+// записи, внешняя (yes) — SIGPIPE. Вход: endless | head -n 2, yes | head -n 3.
+// Выход: пайплайны завершаются, выводятся только первые строки.
+TEST_F(ExecutorTest, HeadStopsUpstreamStages) {
+    CommandFactory factory(env);
+    Executor executor(env);
+    Pipeline pipeline;
+    pipeline.addCommand(std::make_unique<EndlessCommand>());
+    pipeline.addCommand(std::make_unique<EndlessCommand>());
+    auto head = factory.create("head");
+    head->setArguments({"-n", "2"});
+    pipeline.addCommand(std::move(head));
+    EXPECT_EQ(executor.execute(pipeline), 0);
+    EXPECT_EQ(capturedOut.str(), "line\nline\n");
+
+    if (!PathCache::resolve("yes", env.get("PATH"))) {
+        return;
+    }
+    capturedOut.str("");
+    Pipeline external;
+    external.addCommand(factory.create("yes"));
+    head = factory.create("head");
+    head->setArguments({"-3"});
+    external.addCommand(std::move(head));
+    EXPECT_EQ(executor.execute(external), 0);
+    EXPECT_EQ(capturedOut.str(), "y\ny\ny\n");
+}
+
+// Проверяет: cat, читающий файлы через io_uring, прекращает чтение, когда head закрыл канал,
+// а не дочитывает бесконечный источник. Вход: cat /dev/urandom | head -n 1.
+// Выход: пайплайн завершается, выведена одна строка.
+TEST_F(ExecutorTest, HeadStopsCatReadingThroughRing) {
+    IoRing::setEnabled(true);
+    CommandFactory factory(env);
+    Executor executor(env);
+    Pipeline pipeline;
+    auto cat = factory.create("cat");
+    cat->setArguments({"/dev/urandom"});
+    pipeline.addCommand(std::move(cat));
+    auto head = factory.create("head");
+    head->setArguments({"-n", "1"});
+    pipeline.addCommand(std::move(head));
+    EXPECT_EQ(executor.execute(pipeline), 0);
+    std::string line = capturedOut.str();
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.find('\n'), line.size() - 1);
+}
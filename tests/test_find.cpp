@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/commands/find_command.hpp"
+#include "shell/environment.hpp"
+
+using namespace shell;
+namespace fs = std::filesystem;
+
+/**
+ * Юнит-тесты для FindCommand.
+ */
+class FindTest : public ::testing::Test {
+protected:
+    std::ostringstream output;
+    std::ostringstream errors;
+    fs::path root = fs::temp_directory_path() / "shell_find_test";
+
+    void SetUp() override {
+        fs::remove_all(root);
+        // Дерево: 3 уровня по 4 подкаталога (всего 84); в каждом a.txt (10 байт) и b.log (2000)
+        std::vector<fs::path> level{root};
+        for (int depth = 0; depth < 3; ++depth) {
+            std::vector<fs::path> next;
+            for (const auto& dir : level) {
+                for (int i = 0; i < 4; ++i) {
+                    next.push_back(dir / ("d" + std::to_string(i)));
+                    fs::create_directories(next.back());
+                }
+            }
+            level = std::move(next);
+        }
+        for (const auto& entry : fs::recursive_directory_iterator(root)) {
+            if (entry.is_directory()) {
+                std::ofstream(entry.path() / "a.txt") << std::string(10, 'a');
+                std::ofstream(entry.path() / "b.log") << std::string(2000, 'b');
+            }
+        }
+        fs::create_symlink("d0", root / "link");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    int run(const std::vector<std::string>& args) {
+        FindCommand cmd;
+        cmd.setArguments(args);
+        std::istringstream in;
+        return cmd.execute(in, output, errors);
+    }
+
+    // Эталон: рекурсивный обход в глубину с сортировкой имён в каждом каталоге
+    static void listSorted(const fs::path& dir, std::string& result) {
+        std::vector<std::string> names;
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            names.push_back(entry.path().filename().string());
+        }
+        std::sort(names.begin(), names.end());
+        for (const auto& name : names) {
+            fs::path path = dir / name;
+            result += path.string() + "\n";
+            if (fs::is_directory(fs::symlink_status(path))) {
+                listSorted(path, result);
+            }
+        }
+    }
+
+    static std::vector<std::string> lines(const std::string& text, char separator = '\n') {
+        std::vector<std::string> result;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line, separator)) {
+            result.push_back(line);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+// Проверяет: порядок вывода детерминирован и совпадает с обходом в глубину по отсортированным
+// именам; ссылки не разыменовываются; -unordered выдаёт то же множество.
+// Вход: дерево из 85 каталогов с корнем. Выход: эталонный список путей.
+TEST_F(FindTest, MatchesRecursiveListing) {
+    std::string expected = root.string() + "\n";
+    listSorted(root, expected);
+
+    EXPECT_EQ(run({root.string()}), 0);
+    EXPECT_EQ(output.str(), expected);
+    EXPECT_TRUE(errors.str().empty());
+
+    output.str("");
+    EXPECT_EQ(run({root.string(), "-unordered"}), 0);
+    EXPECT_EQ(lines(output.str()), lines(expected));
+}
+
+// Проверяет: -name, -type, -size, -mtime, -maxdepth, -print0 и их сочетание.
+TEST_F(FindTest, Filters) {
+    EXPECT_EQ(run({root.string(), "-name", "*.txt"}), 0);
+    EXPECT_EQ(lines(output.str()).size(), 84u);
+
+    output.str("");
+    EXPECT_EQ(run({root.string(), "-type", "d", "-maxdepth", "1"}), 0);
+    EXPECT_EQ(lines(output.str()).size(), 5u);
+
+    output.str("");
+    EXPECT_EQ(run({root.string(), "-type", "l"}), 0);
+    EXPECT_EQ(output.str(), (root / "link").string() + "\n");
+
+    output.str("");
+    EXPECT_EQ(run({root.string(), "-type", "f", "-size", "+2"}), 0);
+    EXPECT_EQ(lines(output.str()).size(), 84u);
+
+    output.str("");
+    EXPECT_EQ(run({root.string(), "-size", "-2000c", "-size", "+9c", "-mtime", "0"}), 0);
+    EXPECT_EQ(lines(output.str()).size(), 84u);
+
+    output.str("");
+    EXPECT_EQ(run({root.string(), "-mtime", "+1"}), 0);
+    EXPECT_TRUE(output.str().empty());
+
+    output.str("");
+    EXPECT_EQ(run({(root / "d1").string(), "-maxdepth", "0", "-print0"}), 0);
+    EXPECT_EQ(output.str(), (root / "d1").string() + std::string(1, '\0'));
+}
+
+// Проверяет: ошибки аргументов и недоступные пути; обход остальных путей продолжается.
+TEST_F(FindTest, Errors) {
+    EXPECT_EQ(run({"-type", "x"}), 1);
+    EXPECT_EQ(run({"-size"}), 1);
+    EXPECT_EQ(run({"-bogus"}), 1);
+    EXPECT_NE(errors.str().find("unknown predicate"), std::string::npos);
+
+    errors.str("");
+    EXPECT_EQ(run({(root / "missing").string(), (root / "d2").string(), "-maxdepth", "0"}), 1);
+    EXPECT_NE(errors.str().find("missing"), std::string::npos);
+    EXPECT_EQ(output.str(), (root / "d2").string() + "\n");
+
+    Environment env;
+    CommandFactory factory(env);
+    EXPECT_TRUE(factory.isBuiltin("find"));
+}
@@ -0,0 +1,124 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fnmatch.h>
+
+#include <gtest/gtest.h>
+
+#include "shell/glob_expander.hpp"
+#include "shell/lexer.hpp"
+
+using namespace shell;
+namespace fs = std::filesystem;
+
+/**
+ * Юнит-тесты для GlobPattern и GlobExpander.
+ */
+class GlobTest : public ::testing::Test {
+protected:
+    fs::path root = fs::temp_directory_path() / "shell_glob_test";
+    GlobExpander expander;
+
+    void SetUp() override {
+        fs::remove_all(root);
+        for (const char* dir : {"src/lib", "src/app", "docs", ".hidden"}) {
+            fs::create_directories(root / dir);
+        }
+        for (const char* file : {"a.log", "b.log", "c.txt", ".secret.log", "src/main.c",
+                                 "src/lib/util.c", "src/lib/util.h", "src/app/app.c",
+                                 ".hidden/x.c", "docs/readme"}) {
+            std::ofstream(root / file) << file;
+        }
+        fs::create_directory_symlink(root / "src", root / "docs/link");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    std::vector<std::string> expand(const std::string& pattern) {
+        auto paths = expander.expandPattern((root / "").string() + pattern);
+        for (auto& path : paths) {
+            path.erase(0, (root / "").string().size());
+        }
+        return paths;
+    }
+
+    static std::vector<std::string> words(const std::pmr::vector<Token>& tokens) {
+        std::vector<std::string> result;
+        for (const auto& token : tokens) {
+            if (token.type == TokenType::WORD) {
+                result.emplace_back(token.value);
+            }
+        }
+        return result;
+    }
+};
+
+// Проверяет: скомпилированный шаблон совпадает с fnmatch на случайных шаблонах и именах.
+// Вход: 20000 пар над алфавитом "ab.*?[]!-". Выход: те же ответы.
+TEST_F(GlobTest, PatternMatchesFnmatch) {
+    std::mt19937 gen(11);
+    const std::string alphabet = "ab.*?[]!-";
+    auto randomString = [&](const std::string& chars, size_t maxLength) {
+        std::string s(gen() % (maxLength + 1), ' ');
+        for (auto& c : s) {
+            c = chars[gen() % chars.size()];
+        }
+        return s;
+    };
+    for (int i = 0; i < 20000; ++i) {
+        std::string pattern = randomString(alphabet, 7);
+        std::string name = randomString("ab.-", 8);
+        bool expected = fnmatch(pattern.c_str(), name.c_str(), 0) == 0;
+        EXPECT_EQ(GlobPattern(pattern).matches(name), expected)
+            << "pattern=" << pattern << " name=" << name;
+    }
+    EXPECT_TRUE(GlobPattern("[!a-c]x").matches("dx"));
+    EXPECT_FALSE(GlobPattern("[!a-c]x").matches("bx"));
+    EXPECT_TRUE(GlobPattern("\\*").isLiteral());
+    EXPECT_TRUE(GlobPattern("\\*").matches("*"));
+}
+
+// Проверяет: *, ?, [...], **, скрытые файлы, завершающий '/', ссылки и отсутствие совпадений.
+TEST_F(GlobTest, ExpandsPatterns) {
+    EXPECT_EQ(expand("*.log"), (std::vector<std::string>{"a.log", "b.log"}));
+    EXPECT_EQ(expand(".*.log"), (std::vector<std::string>{".secret.log"}));
+    EXPECT_EQ(expand("[ac].???"), (std::vector<std::string>{"a.log", "c.txt"}));
+    EXPECT_EQ(expand("src/*/*.c"), (std::vector<std::string>{"src/app/app.c", "src/lib/util.c"}));
+    EXPECT_EQ(expand("**/*.c"), (std::vector<std::string>{"src/app/app.c", "src/lib/util.c",
+                                                           "src/main.c"}));
+    EXPECT_EQ(expand("docs/*/main.c"), (std::vector<std::string>{"docs/link/main.c"}));
+    EXPECT_EQ(expand("*/"), (std::vector<std::string>{"docs/", "src/"}));
+    EXPECT_EQ(expand("src/lib/util.?"),
+              (std::vector<std::string>{"src/lib/util.c", "src/lib/util.h"}));
+    EXPECT_TRUE(expand("*.none").empty());
+    EXPECT_TRUE(expand("missing/*").empty());
+}
+
+// Проверяет: лексер раскрывает только метасимволы вне кавычек; присваивания и слова без
+// совпадений остаются как есть.
+TEST_F(GlobTest, ExpandsTokens) {
+    std::string dir = (root / "").string();
+    Lexer lexer("X=" + dir + "*.log wc " + dir + "*.log '" + dir + "*.log' " + dir + "'*'.txt " +
+                dir + "*.none");
+    auto tokens = lexer.tokenize();
+    expander.expand(tokens);
+    EXPECT_EQ(words(tokens), (std::vector<std::string>{"X=" + dir + "*.log", "wc", dir + "a.log",
+                                                       dir + "b.log", dir + "*.log",
+                                                       dir + "*.txt", dir + "*.none"}));
+}
+
+// Проверяет: листинг кэшируется и перечитывается после изменения каталога.
+TEST_F(GlobTest, CacheSeesNewFiles) {
+    EXPECT_EQ(expand("*.log").size(), 2u);
+    EXPECT_GE(expander.cachedDirectories(), 1u);
+    std::ofstream(root / "d.log") << "d";
+    std::pmr::vector<Token> tokens{Token(TokenType::WORD, "x")};
+    tokens[0].pattern = (root / "*.log").string();
+    expander.expand(tokens);
+    EXPECT_EQ(tokens.size(), 3u);
+}
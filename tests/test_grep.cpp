@@ -0,0 +1,373 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/commands/grep_command.hpp"
+#include "shell/environment.hpp"
+#include "shell/literal_searcher.hpp"
+#include "shell/multi_literal_searcher.hpp"
+#include "shell/pattern_file_cache.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для LiteralSearcher, MultiLiteralSearcher, PatternFileCache и GrepCommand.
+ */
+class GrepTest : public ::testing::Test {
+protected:
+    Environment env;
+    std::ostringstream output;
+    std::ostringstream errors;
+    std::string dir;
+
+    void SetUp() override {
+        dir = (std::filesystem::temp_directory_path() /
+               ("shell_grep_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed())))
+                  .string();
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::string writeFile(const std::string& name, const std::string& content) {
+        std::string path = dir + "/" + name;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+        std::ofstream(path) << content;
+        return path;
+    }
+
+    int run(const std::vector<std::string>& args, const std::string& input = "") {
+        GrepCommand cmd;
+        cmd.setArguments(args);
+        std::istringstream in(input);
+        return cmd.execute(in, output, errors);
+    }
+};
+
+// Проверяет: векторный поиск совпадает с std::string::find для образцов длины 1..40
+// на любых смещениях, в том числе без учёта регистра.
+TEST_F(GrepTest, LiteralSearcherMatchesNaiveFind) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::string text(3000, 'a');
+    for (auto& c : text) {
+        c = "abAB"[pick(gen)];
+    }
+    std::string lower = text;
+    for (auto& c : lower) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    for (size_t length = 1; length <= 40; ++length) {
+        for (size_t start : {0UL, 17UL, 1000UL, 2990UL}) {
+            std::string needle = text.substr(start, length);
+            LiteralSearcher exact(needle);
+            const char* hit = exact.find(text.data(), text.data() + text.size());
+            size_t expected = text.find(needle);
+            EXPECT_EQ(static_cast<size_t>(hit - text.data()),
+                      expected == std::string::npos ? text.size() : expected);
+
+            std::string lowerNeedle = lower.substr(start, length);
+            LiteralSearcher folded(needle, true);
+            hit = folded.find(text.data(), text.data() + text.size());
+            EXPECT_EQ(static_cast<size_t>(hit - text.data()), lower.find(lowerNeedle));
+        }
+    }
+
+    LiteralSearcher missing("abba@");
+    EXPECT_EQ(missing.find(text.data(), text.data() + text.size()), text.data() + text.size());
+}
+
+// Проверяет: поиск по входному потоку и флаги -v, -n, -c, -i.
+// Вход: "alpha\nbeta\nAlphabet\ngamma". Выход: выбранные строки в ожидаемом формате.
+TEST_F(GrepTest, StreamFlags) {
+    const std::string input = "alpha\nbeta\nAlphabet\ngamma";
+
+    EXPECT_EQ(run({"alpha"}, input), 0);
+    EXPECT_EQ(output.str(), "alpha\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-in", "ALPHA"}, input), 0);
+    EXPECT_EQ(output.str(), "1:alpha\n3:Alphabet\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-vn", "alpha"}, input), 0);
+    EXPECT_EQ(output.str(), "2:beta\n3:Alphabet\n4:gamma\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-c", "a"}, input), 0);
+    EXPECT_EQ(output.str(), "4\n");
+
+    output.str("");
+    EXPECT_EQ(run({"delta"}, input), 1);
+    EXPECT_EQ(output.str(), "");
+}
+
+// Проверяет: несколько файлов выводятся с именами в порядке аргументов, -l и -c,
+// отсутствующий файл даёт код 2.
+TEST_F(GrepTest, MultipleFiles) {
+    std::string a = writeFile("a.txt", "one\ntwo\n");
+    std::string b = writeFile("b.txt", "three\n");
+    std::string c = writeFile("c.txt", "two two\nfour\n");
+
+    EXPECT_EQ(run({"two", a, b, c}), 0);
+    EXPECT_EQ(output.str(), a + ":two\n" + c + ":two two\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-l", "o", a, b, c}), 0);
+    EXPECT_EQ(output.str(), a + "\n" + c + "\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-c", "two", a, b}), 0);
+    EXPECT_EQ(output.str(), a + ":1\n" + b + ":0\n");
+
+    output.str("");
+    EXPECT_EQ(run({"two", a, dir + "/missing.txt"}), 2);
+    EXPECT_EQ(output.str(), a + ":two\n");
+    EXPECT_NE(errors.str().find("missing.txt"), std::string::npos);
+}
+
+// Проверяет: -r обходит каталог в отсортированном порядке.
+TEST_F(GrepTest, RecursiveSearch) {
+    writeFile("b.txt", "needle b\n");
+    writeFile("a/inner.txt", "no\nneedle inner\n");
+    writeFile("c.txt", "nothing\n");
+
+    EXPECT_EQ(run({"-rn", "needle", dir}), 0);
+    EXPECT_EQ(output.str(), dir + "/a/inner.txt:2:needle inner\n" + dir + "/b.txt:1:needle b\n");
+}
+
+// Проверяет: образцы с метасимволами ищутся регулярным выражением (BRE по умолчанию, -E),
+// некорректный образец — код 2.
+TEST_F(GrepTest, RegexPatterns) {
+    const std::string input = "error 1\nwarning\nfatal error\nerr\n";
+
+    EXPECT_EQ(run({"-n", "^err"}, input), 0);
+    EXPECT_EQ(output.str(), "1:error 1\n4:err\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-E", "-c", "err(or)?$"}, input), 0);
+    EXPECT_EQ(output.str(), "2\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-v", "r.*r"}, input), 0);
+    EXPECT_EQ(output.str(), "warning\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-E", "(unclosed"}, input), 2);
+    EXPECT_NE(errors.str().find("Unmatched"), std::string::npos);
+}
+
+// Проверяет: образцы, совпадающие с пустой строкой, не находят строки за завершающим '\n' —
+// ни в файле, ни во входном потоке из нескольких блоков. Вход: "a\n\nb\n", 300 КиБ строк.
+// Выход: число и номера строк как у GNU grep.
+TEST_F(GrepTest, EmptyMatchAfterTrailingNewline) {
+    const std::string small = "a\n\nb\n";
+    std::string file = writeFile("small.txt", small);
+    EXPECT_EQ(run({"-c", "^$", file}), 0);
+    EXPECT_EQ(output.str(), "1\n");
+    output.str("");
+    EXPECT_EQ(run({"-n", "^$", file}), 0);
+    EXPECT_EQ(output.str(), "2:\n");
+    output.str("");
+    EXPECT_EQ(run({"-c", "^a*$"}, small), 0);
+    EXPECT_EQ(output.str(), "2\n");
+
+    // Поток читается блоками по 128 КиБ: лишнего совпадения в конце блока нет
+    std::string big;
+    while (big.size() < 300 * 1024) {
+        big += "line of text\n";
+    }
+    output.str("");
+    EXPECT_EQ(run({"-c", "^$"}, big), 1);
+    EXPECT_EQ(output.str(), "0\n");
+    output.str("");
+    EXPECT_EQ(run({"-c", "^a*$"}, big + "\naaa\n"), 0);
+    EXPECT_EQ(output.str(), "2\n");
+    output.str("");
+    EXPECT_EQ(run({"-c", "^$", writeFile("big.txt", big)}), 1);
+    EXPECT_EQ(output.str(), "0\n");
+}
+
+// Проверяет: поиск набора строк совпадает с наивной проверкой каждой строки текста для наборов
+// от 2 до 300 образцов (фильтр Teddy и автомат), с учётом и без учёта регистра.
+// Вход: случайный текст над алфавитом "abcAB\n". Выход: найденное вхождение — начало образца.
+TEST_F(GrepTest, MultiLiteralSearcherMatchesNaive) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> pick(0, 5);
+    std::uniform_int_distribution<size_t> length(1, 6);
+    auto randomText = [&](size_t size) {
+        std::string text(size, 'a');
+        for (auto& c : text) {
+            c = "abcAB\n"[pick(gen)];
+        }
+        return text;
+    };
+    auto lowered = [](std::string text) {
+        for (auto& c : text) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return text;
+    };
+
+    for (size_t count : {2UL, 5UL, 32UL, 33UL, 300UL}) {
+        std::vector<std::string> patterns;
+        for (size_t i = 0; i < count; ++i) {
+            std::string pattern = randomText(length(gen));
+            pattern.erase(std::remove(pattern.begin(), pattern.end(), '\n'), pattern.end());
+            patterns.push_back(pattern.empty() ? "c" : pattern + "c");
+        }
+        for (bool ignoreCase : {false, true}) {
+            MultiLiteralSearcher searcher(patterns, ignoreCase);
+            std::string text = randomText(4000);
+            std::istringstream lines(text);
+            std::string line;
+            while (std::getline(lines, line)) {
+                const char* end = line.data() + line.size();
+                const char* hit = searcher.find(line.data(), end);
+                std::string haystack = ignoreCase ? lowered(line) : line;
+                bool expected = false;
+                for (const auto& pattern : patterns) {
+                    std::string needle = ignoreCase ? lowered(pattern) : pattern;
+                    expected = expected || haystack.find(needle) != std::string::npos;
+                }
+                ASSERT_EQ(hit != end, expected) << line;
+                if (hit != end) {
+                    std::string rest = haystack.substr(static_cast<size_t>(hit - line.data()));
+                    bool startsPattern = false;
+                    for (const auto& pattern : patterns) {
+                        startsPattern = startsPattern ||
+                                        rest.compare(0, pattern.size(),
+                                                     ignoreCase ? lowered(pattern) : pattern) == 0;
+                    }
+                    EXPECT_TRUE(startsPattern) << line;
+                }
+            }
+        }
+    }
+}
+
+// Проверяет: grep -f читает образцы из файла (строка подходит при любом из них), -e повторяется,
+// пустой файл образцов не находит ничего. Вход: файл "beta\nDELTA\n". Выход: подходящие строки.
+TEST_F(GrepTest, PatternFiles) {
+    const std::string input = "alpha\nbeta\ngamma\ndelta\n";
+    std::string patterns = writeFile("patterns.txt", "beta\nDELTA\n");
+
+    EXPECT_EQ(run({"-F", "-f", patterns}, input), 0);
+    EXPECT_EQ(output.str(), "beta\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-in", "-f", patterns}, input), 0);
+    EXPECT_EQ(output.str(), "2:beta\n4:delta\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-e", "alpha", "-e", "^g"}, input), 0);
+    EXPECT_EQ(output.str(), "alpha\ngamma\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-f", writeFile("empty.txt", "")}, input), 1);
+    EXPECT_EQ(output.str(), "");
+
+    EXPECT_EQ(run({"-f", dir + "/missing.txt"}, input), 2);
+    EXPECT_NE(errors.str().find("missing.txt"), std::string::npos);
+}
+
+// Проверяет: автомат по файлу образцов строится один раз и перестраивается после изменения файла.
+// Вход: два запроса к неизменному файлу, затем запрос после перезаписи.
+// Выход: hits()=1, после перезаписи — новый автомат.
+TEST_F(GrepTest, PatternFileCacheReusesAutomaton) {
+    PatternFileCache cache;
+    auto literal = [](const std::string&) { return true; };
+    std::vector<std::string> patterns;
+    std::string path = writeFile("list.txt", "one\ntwo\n");
+
+    auto first = cache.get(path, false, literal, patterns);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->patterns().size(), 2U);
+    EXPECT_EQ(cache.get(path, false, literal, patterns), first);
+    EXPECT_EQ(cache.hits(), 1U);
+
+    writeFile("list.txt", "one\ntwo\nthree\n");
+    auto rebuilt = cache.get(path, false, literal, patterns);
+    ASSERT_NE(rebuilt, nullptr);
+    EXPECT_NE(rebuilt, first);
+    EXPECT_EQ(rebuilt->patterns().size(), 3U);
+    EXPECT_TRUE(patterns.empty());
+
+    std::string error;
+    EXPECT_EQ(cache.get(dir + "/missing.txt", false, literal, patterns, &error), nullptr);
+    EXPECT_NE(error.find("missing.txt"), std::string::npos);
+}
+
+// Проверяет: для файла с регулярными выражениями автомат не строится и не кэшируется, а образцы
+// возвращаются; закэшированный автомат не выдаётся, если образцы перестали считаться строками.
+// Вход: "a.c\nxyz\n", затем "one\nt.o\n" с -F и без. Выход: nullptr и образцы, размер кэша.
+TEST_F(GrepTest, PatternFileCacheSkipsRegexFiles) {
+    PatternFileCache cache;
+    auto fixed = [](const std::string&) { return true; };
+    auto noDot = [](const std::string& p) { return p.find('.') == std::string::npos; };
+    std::vector<std::string> patterns;
+
+    std::string regexes = writeFile("regexes.txt", "a.c\nxyz\n");
+    EXPECT_EQ(cache.get(regexes, false, noDot, patterns), nullptr);
+    EXPECT_EQ(patterns, (std::vector<std::string>{"a.c", "xyz"}));
+    EXPECT_EQ(cache.size(), 0U);
+
+    patterns.clear();
+    std::string mixed = writeFile("mixed.txt", "one\nt.o\n");
+    ASSERT_NE(cache.get(mixed, false, fixed, patterns), nullptr);
+    EXPECT_EQ(cache.get(mixed, false, noDot, patterns), nullptr);
+    EXPECT_EQ(patterns, (std::vector<std::string>{"one", "t.o"}));
+    EXPECT_EQ(cache.size(), 1U);
+}
+
+// Проверяет: большой список регулярных выражений (-f) не упирается в предел размера программы
+// Regex и не попадает в кэш автоматов; строки из того же файла ищутся автоматом.
+// Вход: 5000 образцов "idN.z" и строка "plain-word". Выход: строки с -n, -v, -c.
+TEST_F(GrepTest, LargeRegexPatternFile) {
+    std::string list;
+    for (int i = 0; i < 5000; ++i) {
+        list += "id" + std::to_string(i) + ".z\n";
+    }
+    list += "plain-word\n";
+    std::string path = writeFile("blocklist.txt", list);
+    const std::string input = "x id4999Qz y\nnone\nplain-word here\nid0z\nid7_z\n";
+
+    CommandFactory factory(env);
+    auto grep = [&](std::vector<std::string> args) {
+        auto cmd = factory.create("grep");
+        cmd->setArguments(std::move(args));
+        std::istringstream in(input);
+        return cmd->execute(in, output, errors);
+    };
+
+    EXPECT_EQ(grep({"-n", "-f", path}), 0);
+    EXPECT_EQ(output.str(), "1:x id4999Qz y\n3:plain-word here\n5:id7_z\n");
+    EXPECT_EQ(errors.str(), "");
+
+    output.str("");
+    EXPECT_EQ(grep({"-vn", "-f", path}), 0);
+    EXPECT_EQ(output.str(), "2:none\n4:id0z\n");
+
+    output.str("");
+    EXPECT_EQ(grep({"-c", "-f", path}), 0);
+    EXPECT_EQ(output.str(), "3\n");
+    EXPECT_EQ(factory.getPatternFileCache().size(), 0U);
+}
+
+// Проверяет: grep зарегистрирован в фабрике как встроенная команда.
+TEST_F(GrepTest, FactoryRegistersGrep) {
+    CommandFactory factory(env);
+    EXPECT_TRUE(factory.isBuiltin("grep"));
+    EXPECT_EQ(factory.create("grep")->getName(), "grep");
+}
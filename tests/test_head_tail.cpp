@@ -0,0 +1,216 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/commands/head_command.hpp"
+#include "shell/commands/tail_command.hpp"
+#include "shell/environment.hpp"
+#include "shell/interrupt.hpp"
+#include "shell/stream_pipe.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для StreamPipe, HeadCommand и TailCommand.
+ */
+class HeadTailTest : public ::testing::Test {
+protected:
+    std::ostringstream output;
+    std::ostringstream errors;
+
+    template <typename T>
+    int run(const std::vector<std::string>& args, const std::string& input = "") {
+        T cmd;
+        cmd.setArguments(args);
+        std::istringstream in(input);
+        return cmd.execute(in, output, errors);
+    }
+};
+
+// Проверяет: данные через канал с маленьким буфером доходят целиком и по порядку; после
+// closeRead запись завершается ошибкой. Вход: 1 МБ через канал на 1000 байт.
+TEST_F(HeadTailTest, StreamPipeTransfersAndCloses) {
+    std::string data;
+    for (int i = 0; i < 100000; ++i) {
+        data += std::to_string(i) + "\n";
+    }
+    StreamPipe pipe(1000);
+    std::thread writer([&] {
+        PipeWriteBuffer buffer(pipe);
+        std::ostream out(&buffer);
+        for (size_t pos = 0; pos < data.size(); pos += 7) {
+            out << data.substr(pos, 7);
+        }
+        out.flush();
+        pipe.closeWrite();
+    });
+    PipeReadBuffer buffer(pipe);
+    std::istream in(&buffer);
+    std::ostringstream received;
+    received << in.rdbuf();
+    writer.join();
+    EXPECT_EQ(received.str(), data);
+
+    StreamPipe closed(16);
+    closed.closeRead();
+    EXPECT_FALSE(closed.write("x", 1));
+}
+
+// Проверяет: head -n/-N и по умолчанию 10 строк; строка без перевода строки; ошибки.
+TEST_F(HeadTailTest, Head) {
+    std::string input;
+    for (int i = 1; i <= 20; ++i) {
+        input += std::to_string(i) + "\n";
+    }
+    EXPECT_EQ(run<HeadCommand>({"-n", "3"}, input), 0);
+    EXPECT_EQ(output.str(), "1\n2\n3\n");
+
+    output.str("");
+    EXPECT_EQ(run<HeadCommand>({}, input), 0);
+    EXPECT_EQ(output.str(), input.substr(0, input.find("11\n")));
+
+    output.str("");
+    EXPECT_EQ(run<HeadCommand>({"-5"}, "a\nb"), 0);
+    EXPECT_EQ(output.str(), "a\nb");
+
+    EXPECT_EQ(run<HeadCommand>({"-n", "x"}), 1);
+    EXPECT_NE(errors.str().find("invalid number"), std::string::npos);
+}
+
+// Проверяет: tail по обычному файлу (чтение с конца через несколько блоков) и по потоку
+// совпадает с последними строками; заголовки при нескольких файлах.
+// Вход: 50000 строк. Выход: последние N строк для разных N.
+TEST_F(HeadTailTest, Tail) {
+    std::vector<std::string> lines;
+    std::string input;
+    for (int i = 0; i < 50000; ++i) {
+        lines.push_back("line " + std::to_string(i));
+        input += lines.back() + "\n";
+    }
+    auto path = (std::filesystem::temp_directory_path() / "shell_tail_test.txt").string();
+    std::ofstream(path) << input;
+
+    for (size_t n : {0, 1, 3, 20000, 60000}) {
+        std::string expected;
+        for (size_t i = lines.size() - std::min(n, lines.size()); i < lines.size(); ++i) {
+            expected += lines[i] + "\n";
+        }
+        output.str("");
+        EXPECT_EQ(run<TailCommand>({"-n", std::to_string(n), path}), 0);
+        EXPECT_EQ(output.str(), expected) << n;
+        output.str("");
+        EXPECT_EQ(run<TailCommand>({"-n", std::to_string(n)}, input), 0);
+        EXPECT_EQ(output.str(), expected) << n;
+    }
+
+    output.str("");
+    EXPECT_EQ(run<TailCommand>({"-2"}, "a\nb\nc"), 0);
+    EXPECT_EQ(output.str(), "b\nc");
+
+    output.str("");
+    EXPECT_EQ(run<TailCommand>({"-1", path, path}), 0);
+    std::string name = "==> " + path + " <==\n";
+    EXPECT_EQ(output.str(), name + "line 49999\n\n" + name + "line 49999\n");
+    std::remove(path.c_str());
+
+    Environment env;
+    CommandFactory factory(env);
+    EXPECT_TRUE(factory.isBuiltin("head"));
+    EXPECT_TRUE(factory.isBuiltin("tail"));
+}
+
+// Проверяет: tail -F выводит дописанные строки, после ротации (переименование и новый файл)
+// следует за новым файлом, по запросу прерывания завершается с кодом 130.
+// Вход: файл "a\nb\n", дописывание "c\n", ротация с "d\n". Выход: "b\nc\nd\n".
+TEST_F(HeadTailTest, TailFollowsAppendsAndRotation) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string path = (dir / "shell_tail_follow.log").string();
+    std::string rotated = path + ".1";
+    std::ofstream(path) << "a\nb\n";
+
+    StreamPipe pipe;
+    int code = -1;
+    Interrupt::clear();
+    std::thread follower([&] {
+        PipeWriteBuffer buffer(pipe);
+        std::ostream out(&buffer);
+        TailCommand cmd;
+        cmd.setArguments({"-F", "-n", "1", path});
+        code = cmd.execute(std::cin, out, errors);
+        out.flush();
+        pipe.closeWrite();
+    });
+
+    std::string received;
+    auto waitFor = [&](const std::string& expected) {
+        char buffer[256];
+        while (received.size() < expected.size()) {
+            size_t size = pipe.read(buffer, sizeof(buffer));
+            ASSERT_GT(size, 0U);
+            received.append(buffer, size);
+        }
+        EXPECT_EQ(received, expected);
+    };
+
+    waitFor("b\n");
+    std::ofstream(path, std::ios::app) << "c\n";
+    waitFor("b\nc\n");
+    std::filesystem::rename(path, rotated);
+    std::ofstream(path) << "d\n";
+    waitFor("b\nc\nd\n");
+
+    Interrupt::request();
+    follower.join();
+    Interrupt::clear();
+    EXPECT_EQ(code, 130);
+    std::remove(path.c_str());
+    std::remove(rotated.c_str());
+}
+
+// Проверяет: строки, дописанные, пока tail -f ещё выводит конец файла, тоже выводятся — слежение
+// начинается с выведенного смещения, а не с размера после вывода. Вход: строка 200 КиБ, вывод в
+// канал на 1000 байт, дописывание "tail\n" во время вывода. Выход: строка и "tail\n".
+TEST_F(HeadTailTest, TailFollowKeepsAppendsDuringInitialOutput) {
+    std::string path = (std::filesystem::temp_directory_path() / "shell_tail_race.log").string();
+    const std::string line = std::string(200 * 1024, 'x') + "\n";
+    std::ofstream(path) << line;
+
+    StreamPipe pipe(1000);
+    int code = -1;
+    Interrupt::clear();
+    std::thread follower([&] {
+        PipeWriteBuffer buffer(pipe);
+        std::ostream out(&buffer);
+        TailCommand cmd;
+        cmd.setArguments({"-f", "-n", "1", path});
+        code = cmd.execute(std::cin, out, errors);
+        out.flush();
+        pipe.closeWrite();
+    });
+
+    // Первый байт вывода означает, что размер файла уже взят и вывод упирается в канал
+    std::string received;
+    char buffer[4096];
+    received.append(buffer, pipe.read(buffer, 1));
+    std::ofstream(path, std::ios::app) << "tail\n";
+    const std::string expected = line + "tail\n";
+    while (received.size() < expected.size()) {
+        size_t size = pipe.read(buffer, sizeof(buffer));
+        ASSERT_GT(size, 0U);
+        received.append(buffer, size);
+    }
+    EXPECT_EQ(received, expected);
+
+    Interrupt::request();
+    follower.join();
+    Interrupt::clear();
+    EXPECT_EQ(code, 130);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,165 @@
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <cstddef>
+#include <iterator>
+
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "shell/launcher.hpp"
+#include "shell/path_cache.hpp"
+#include "shell/process_util.hpp"
+#include "shell/shell.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для Launcher (процесс-запускатель внешних команд).
+ */
+class LauncherTest : public ::testing::Test {
+protected:
+    std::string sh;
+
+    void SetUp() override {
+        const char* path = std::getenv("PATH");
+        auto resolved = PathCache::resolve("sh", path != nullptr ? path : "/bin:/usr/bin");
+        ASSERT_TRUE(resolved.has_value());
+        sh = *resolved;
+    }
+
+    // Запустить sh -c script с входом input; вывод — в output, код возврата — результат
+    static int run(Launcher& launcher, const std::string& sh, const std::string& script,
+                   const std::vector<std::string>& env, const std::string& input,
+                   std::string& output, SpawnedProcess& process) {
+        int in[2];
+        int out[2];
+        if (!openPipe(in) || !openPipe(out)) {
+            return -1;
+        }
+        process = launcher.spawn(sh, {"-c", script}, env, in[0], out[1]);
+        close(in[0]);
+        close(out[1]);
+        writeAll(in[1], input.data(), input.size());
+        close(in[1]);
+        char buffer[4096];
+        ssize_t size = 0;
+        while ((size = read(out[0], buffer, sizeof(buffer))) > 0) {
+            output.append(buffer, static_cast<size_t>(size));
+        }
+        close(out[0]);
+        return waitProcess(process.pid, process.pidfd);
+    }
+};
+
+// Проверяет: запускатель передаёт программе аргументы, окружение, текущий каталог shell и
+// дескрипторы stdin/stdout, а в ответ даёт pidfd дочернего процесса самого shell.
+// Вход: sh -c 'read x; echo "$x $NAME"; pwd; exit 3' в каталоге /tmp.
+// Выход: "input value\n/tmp\n", код 3, pidfd ≥ 0.
+TEST_F(LauncherTest, SpawnsWithFdsEnvironmentAndDirectory) {
+#ifdef __linux__
+    Launcher launcher;
+    ASSERT_TRUE(launcher.start());
+    EXPECT_TRUE(launcher.running());
+
+    auto previous = std::filesystem::current_path();
+    auto directory = std::filesystem::canonical(std::filesystem::temp_directory_path());
+    std::filesystem::current_path(directory);
+    std::string output;
+    SpawnedProcess process;
+    int code = run(launcher, sh, "read x; echo \"$x $NAME\"; pwd; exit 3", {"NAME=value"},
+                   "input\n", output, process);
+    std::filesystem::current_path(previous);
+
+    EXPECT_EQ(code, 3);
+    EXPECT_EQ(output, "input value\n" + directory.string() + "\n");
+    EXPECT_GT(process.pid, 0);
+    EXPECT_GE(process.pidfd, 0);
+
+    // Процесс создан с CLONE_PARENT: его родитель — тестовый процесс, а не запускатель
+    output.clear();
+    EXPECT_EQ(run(launcher, sh, "echo $PPID", {}, "", output, process), 0);
+    EXPECT_EQ(output, std::to_string(getpid()) + "\n");
+#endif
+}
+
+// Проверяет: без запускателя (не запущен или остановлен) spawn использует fork.
+// Вход: sh -c 'exit 7' до start() и после stop(). Выход: код 7, pidfd = -1.
+TEST_F(LauncherTest, FallsBackToForkWhenStopped) {
+    Launcher launcher;
+    std::string output;
+    SpawnedProcess process;
+    EXPECT_EQ(run(launcher, sh, "exit 7", {}, "", output, process), 7);
+    EXPECT_EQ(process.pidfd, -1);
+
+    launcher.start();
+    launcher.stop();
+    EXPECT_FALSE(launcher.running());
+    EXPECT_EQ(run(launcher, sh, "exit 7", {}, "", output, process), 7);
+    EXPECT_EQ(process.pidfd, -1);
+}
+
+// Проверяет: если ядро отвергает clone3 (ENOSYS на старом ядре, EPERM под seccomp), запускатель
+// останавливается после первого отказа, и следующие запуски сразу идут через fork. Проверка — в
+// дочернем процессе с фильтром seccomp, отвечающим ENOSYS на clone3.
+// Вход: два запуска sh -c 'exit 5'. Выход: оба с кодом 5, после первого running() == false.
+TEST_F(LauncherTest, StopsWhenKernelRejectsClone3) {
+#if defined(__linux__) && defined(SYS_clone3)
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        sock_filter filter[] = {
+            BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, SYS_clone3, 0, 1),
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | ENOSYS),
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+        };
+        sock_fprog program{static_cast<unsigned short>(std::size(filter)), filter};
+        if (prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) != 0 ||
+            prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &program) != 0) {
+            _exit(10);
+        }
+        Launcher launcher;
+        if (!launcher.start()) {
+            _exit(11);
+        }
+        std::string output;
+        SpawnedProcess process;
+        if (run(launcher, sh, "exit 5", {}, "", output, process) != 5 || process.pidfd != -1) {
+            _exit(12);
+        }
+        if (launcher.running()) {
+            _exit(13);
+        }
+        _exit(run(launcher, sh, "exit 5", {}, "", output, process) == 5 ? 0 : 14);
+    }
+    EXPECT_EQ(waitProcess(child), 0);
+#endif
+}
+
+// Проверяет: внешние команды пайплайна запускаются через общий запускатель, в том числе
+// одновременно из нескольких стадий. Вход: echo hello | tr a-z A-Z | tr H J. Выход: "JELLO\n".
+TEST_F(LauncherTest, RunsPipelineThroughSharedLauncher) {
+    Launcher::shared().start();
+    std::ostringstream captured;
+    std::streambuf* original = std::cout.rdbuf(captured.rdbuf());
+    {
+        Shell shell;
+        shell.processLine("echo hello | tr a-z A-Z | tr H J");
+    }
+    std::cout.rdbuf(original);
+    Launcher::shared().stop();
+    EXPECT_EQ(captured.str(), "JELLO\n");
+}
@@ -0,0 +1,104 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <streambuf>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "shell/line_arena.hpp"
+#include "shell/shell.hpp"
+
+using namespace shell;
+
+namespace {
+
+// Число обращений к глобальному operator new во всём тестовом бинарнике
+std::atomic<size_t> gAllocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/**
+ * Юнит-тесты для LineArena и выделений памяти при обработке строки.
+ */
+class LineArenaTest : public ::testing::Test {
+protected:
+    // Поток вывода без буфера в куче
+    class NullBuffer : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override {
+            return traits_type::not_eof(c);
+        }
+    };
+
+    NullBuffer null;
+    std::streambuf* originalCout = nullptr;
+
+    void SetUp() override {
+        originalCout = std::cout.rdbuf(&null);
+    }
+
+    void TearDown() override {
+        std::cout.rdbuf(originalCout);
+    }
+
+    // Среднее число выделений в куче на строку в установившемся режиме
+    static double allocationsPerLine(Shell& shell, const std::string& line) {
+        for (int i = 0; i < 10; ++i) {
+            shell.processLine(line);
+        }
+        const int kLines = 200;
+        size_t before = gAllocations.load();
+        for (int i = 0; i < kLines; ++i) {
+            shell.processLine(line);
+        }
+        return static_cast<double>(gAllocations.load() - before) / kLines;
+    }
+};
+
+// Проверяет: после reset() память переиспользуется, а при нехватке буфер растёт до объёма строки.
+// Вход: выделения 100 и 10000 байт в арене на 1 КиБ. Выход: буфер ≥ 10 КиБ, новых выделений нет.
+TEST_F(LineArenaTest, ResetReusesAndGrowsBuffer) {
+    LineArena arena(1024);
+    static_cast<void>(arena.resource()->allocate(100));
+    arena.reset();
+    EXPECT_EQ(arena.capacity(), 1024u);
+
+    static_cast<void>(arena.resource()->allocate(10000));
+    arena.reset();
+    EXPECT_GE(arena.capacity(), 10000u + 1024u);
+
+    size_t before = gAllocations.load();
+    static_cast<void>(arena.resource()->allocate(10000));
+    arena.reset();
+    EXPECT_EQ(gAllocations.load(), before);
+}
+
+// Проверяет: строка, токены, AST и пайплайн берутся из арены, а объект команды вместе с
+// вектором аргументов — из CommandPool, поэтому куча не используется вовсе.
+// Вход: присваивания, команда без аргументов и с аргументами. Выход: 0 выделений.
+TEST_F(LineArenaTest, SteadyStateLinesAvoidHeap) {
+    Shell shell;
+    EXPECT_EQ(allocationsPerLine(shell, "X=value Y=other"), 0.0);
+    EXPECT_EQ(allocationsPerLine(shell, "pwd"), 0.0);
+    EXPECT_EQ(allocationsPerLine(shell, "echo hello \"quoted world\" $X"), 0.0);
+    EXPECT_EQ(allocationsPerLine(shell, "echo a b c d e f g h i j k l m n o p q r s t u v w x y z"),
+              0.0);
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "shell/history.hpp"
+#include "shell/line_editor.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для History (файл истории, навигация, поиск по индексу)
+ * и LineEditor (клавиши, вводимые через канал вместо терминала).
+ */
+class LineEditorTest : public ::testing::Test {
+protected:
+    std::string path = (std::filesystem::temp_directory_path() / "shell_history_test").string();
+
+    void SetUp() override {
+        std::filesystem::remove(path);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    void writeFile(const std::string& content) {
+        std::ofstream(path, std::ios::binary) << content;
+    }
+
+    // Прочитать строку из редактора, передав ему байты keys
+    static bool edit(History& history, const std::string& keys, std::string& line) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            return false;
+        }
+        EXPECT_EQ(write(fds[1], keys.data(), keys.size()), static_cast<ssize_t>(keys.size()));
+        close(fds[1]);
+        std::ostringstream screen;
+        LineEditor editor(fds[0], screen, history);
+        bool ok = editor.readLine("$ ", line);
+        close(fds[0]);
+        return ok;
+    }
+};
+
+// Проверяет: записи файла читаются с конца и по порядку, новые дописываются в файл, даже если
+// последняя строка была без перевода строки. Вход: "a\nbb\nccc" + "dd". Выход: файл из 4 строк.
+TEST_F(LineEditorTest, HistoryNavigatesAndAppends) {
+    writeFile("a\nbb\nccc");
+    {
+        History history(path);
+        std::vector<std::string> older;
+        for (auto pos = history.previous(history.end()); pos; pos = history.previous(*pos)) {
+            older.emplace_back(history.entry(*pos));
+        }
+        EXPECT_EQ(older, (std::vector<std::string>{"ccc", "bb", "a"}));
+
+        history.add("dd");
+        auto last = history.previous(history.end());
+        ASSERT_TRUE(last.has_value());
+        EXPECT_EQ(history.entry(*last), "dd");
+        EXPECT_EQ(history.previous(*last), 5U);
+        EXPECT_EQ(history.next(5), *last);
+        EXPECT_EQ(history.next(*last), history.end());
+    }
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), "a\nbb\nccc\ndd\n");
+}
+
+// Проверяет: повторный поиск по индексу даёт различные записи с подстрокой от новых к старым —
+// как перебор с конца без повторов. Вход: 3000 записей из 40 вариантов. Выход: списки равны.
+TEST_F(LineEditorTest, IndexedSearchMatchesScan) {
+    std::mt19937 gen(5);
+    std::vector<std::string> lines;
+    std::string content;
+    for (int i = 0; i < 3000; ++i) {
+        int variant = static_cast<int>(gen() % 40);
+        lines.push_back("cmd" + std::to_string(variant) + " --opt=" + std::to_string(variant % 7));
+        content += lines.back() + "\n";
+    }
+    writeFile(content);
+    History history(path);
+    history.waitForIndex();
+
+    for (const std::string query : {"cmd1", "=3", "d2 -", "cmd39 --opt=4", "absent"}) {
+        std::vector<std::string> expected;
+        for (auto it = lines.rbegin(); it != lines.rend(); ++it) {
+            if (it->find(query) != std::string::npos &&
+                std::find(expected.begin(), expected.end(), *it) == expected.end()) {
+                expected.push_back(*it);
+            }
+        }
+        std::vector<std::string> found;
+        for (auto pos = history.search(query, history.end()); pos;
+             pos = history.search(query, *pos)) {
+            found.emplace_back(history.entry(*pos));
+        }
+        EXPECT_EQ(found, expected) << query;
+    }
+}
+
+// Проверяет: перемещение курсора и удаление, вызов строки из истории стрелкой вверх.
+// Вход: "hello", ←←, "X", Home, ">", End, "!", Enter; затем ↑, Backspace, Enter.
+// Выход: ">helXlo!", затем ">helXlo"; в истории обе строки.
+TEST_F(LineEditorTest, EditsLineAndRecallsHistory) {
+    History history(path);
+    std::string line;
+    ASSERT_TRUE(edit(history, "hello\x1b[D\x1b[DX\x01>\x1b[F!\r", line));
+    EXPECT_EQ(line, ">helXlo!");
+    ASSERT_TRUE(edit(history, "\x1b[A\x7f\r", line));
+    EXPECT_EQ(line, ">helXlo");
+
+    // Ctrl-W удаляет слово, Ctrl-D на пустой строке — конец ввода
+    ASSERT_TRUE(edit(history, "echo one two\x17\r", line));
+    EXPECT_EQ(line, "echo one ");
+    EXPECT_FALSE(edit(history, "\x04", line));
+}
+
+// Проверяет: Ctrl-R ищет подстроку от новых записей к старым, повторный Ctrl-R — дальше,
+// Ctrl-G отменяет поиск. Вход: история из 3 строк. Выход: "git status", затем "".
+TEST_F(LineEditorTest, ReverseSearch) {
+    writeFile("git status\nls -la\ngit push\n");
+    History history(path);
+    std::string line;
+    ASSERT_TRUE(edit(history, "\x12git\x12\r", line));
+    EXPECT_EQ(line, "git status");
+    ASSERT_TRUE(edit(history, "\x12zzz\x07\r", line));
+    EXPECT_EQ(line, "");
+}
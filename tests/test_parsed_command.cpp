@@ -1,3 +1,6 @@
+#include <utility>
+#include <variant>
+
 #include <gtest/gtest.h>
 
 #include "shell/parsed_command.hpp"
@@ -7,33 +10,32 @@ using namespace shell;
 /**
  * Юнит-тесты для типов AST: ParsedEmpty, ParsedAssignment, ParsedSimpleCommand,
  * ParsedPipeline, ParsedAssignmentList.
- * Проверяют: конструкторы, isAssignment/isPipeline/isEmpty, addCommand/addAssignment.
+ * Проверяют: конструкторы, хранение в ParsedCommand, addCommand/addAssignment.
  */
 
 class ParsedCommandTest : public ::testing::Test {};
 
 // --- ParsedEmpty ---
 
-// Проверяет: ParsedEmpty::isEmpty() возвращает true.
-// Вход: —. Выход: isEmpty() == true, isAssignment() == false, isPipeline() == false.
+// Проверяет: ParsedCommand по умолчанию — пустой узел.
+// Вход: ParsedCommand{}. Выход: хранит ParsedEmpty.
 TEST_F(ParsedCommandTest, ParsedEmptyIsEmpty) {
-    ParsedEmpty empty;
-    EXPECT_TRUE(empty.isEmpty());
-    EXPECT_FALSE(empty.isAssignment());
-    EXPECT_FALSE(empty.isPipeline());
+    ParsedCommand node;
+    EXPECT_TRUE(std::holds_alternative<ParsedEmpty>(node));
 }
 
 // --- ParsedAssignment ---
 
 // Проверяет: конструктор ParsedAssignment сохраняет имя и значение.
-// Вход: "FOO", "bar". Выход: variableName=="FOO", value=="bar", isAssignment()==true.
+// Вход: "FOO", "bar". Выход: variableName=="FOO", value=="bar", узел ParsedAssignment.
 TEST_F(ParsedCommandTest, ParsedAssignmentConstructor) {
     ParsedAssignment a("FOO", "bar");
     EXPECT_EQ(a.variableName, "FOO");
     EXPECT_EQ(a.value, "bar");
-    EXPECT_TRUE(a.isAssignment());
-    EXPECT_FALSE(a.isPipeline());
-    EXPECT_FALSE(a.isEmpty());
+
+    ParsedCommand node = std::move(a);
+    EXPECT_TRUE(std::holds_alternative<ParsedAssignment>(node));
+    EXPECT_EQ(std::get<ParsedAssignment>(node).variableName, "FOO");
 }
 
 // Проверяет: пустое значение допустимо.
@@ -66,14 +68,12 @@ TEST_F(ParsedCommandTest, ParsedSimpleCommandDefault) {
 
 // --- ParsedPipeline ---
 
-// Проверяет: addCommand и isPipeline.
+// Проверяет: addCommand.
 // Вход: addCommand(ParsedSimpleCommand("echo", {"x"})). Выход: commands.size()==1,
 // commandName=="echo".
 TEST_F(ParsedCommandTest, ParsedPipelineAddCommand) {
     ParsedPipeline pipeline;
     EXPECT_TRUE(pipeline.commands.empty());
-    EXPECT_TRUE(pipeline.isPipeline());
-    EXPECT_FALSE(pipeline.isAssignment());
 
     pipeline.addCommand(ParsedSimpleCommand("echo", {"x"}));
     ASSERT_EQ(pipeline.commands.size(), 1u);
@@ -95,13 +95,10 @@ TEST_F(ParsedCommandTest, ParsedPipelineMultipleCommands) {
 
 // --- ParsedAssignmentList ---
 
-// Проверяет: addAssignment и isAssignment.
+// Проверяет: addAssignment.
 // Вход: addAssignment(ParsedAssignment("x","1")). Выход: assignments.size()==1, variableName=="x".
 TEST_F(ParsedCommandTest, ParsedAssignmentListAddAssignment) {
     ParsedAssignmentList list;
-    EXPECT_TRUE(list.isAssignment());
-    EXPECT_FALSE(list.isPipeline());
-
     list.addAssignment(ParsedAssignment("x", "1"));
     ASSERT_EQ(list.assignments.size(), 1u);
     EXPECT_EQ(list.assignments[0].variableName, "x");
@@ -1,3 +1,5 @@
+#include <variant>
+
 #include <gtest/gtest.h>
 
 #include "shell/lexer.hpp"
@@ -8,19 +10,18 @@ using namespace shell;
 /**
  * Юнит-тесты для Parser.
  * Проверяют: разбор токенов в AST — пустая строка, простая команда, пайплайн, присваивание.
- * Вход: vector<Token>. Выход: unique_ptr<ParsedCommand>.
+ * Вход: vector<Token>. Выход: ParsedCommand (std::variant узлов AST).
  */
 class ParserTest : public ::testing::Test {};
 
-// Проверяет: пустой ввод → ParsedEmpty. Вход: токены от "". Выход: result->isEmpty().
+// Проверяет: пустой ввод → ParsedEmpty. Вход: токены от "". Выход: узел ParsedEmpty.
 TEST_F(ParserTest, EmptyInput) {
     Lexer lexer("");
     auto tokens = lexer.tokenize();
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    ASSERT_NE(result, nullptr);
-    EXPECT_TRUE(result->isEmpty());
+    EXPECT_TRUE(std::holds_alternative<ParsedEmpty>(result));
 }
 
 TEST_F(ParserTest, SimpleCommand) {
@@ -29,10 +30,7 @@ TEST_F(ParserTest, SimpleCommand) {
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    ASSERT_NE(result, nullptr);
-    EXPECT_TRUE(result->isPipeline());
-
-    auto* pipeline = dynamic_cast<ParsedPipeline*>(result.get());
+    auto* pipeline = std::get_if<ParsedPipeline>(&result);
     ASSERT_NE(pipeline, nullptr);
     ASSERT_EQ(pipeline->commands.size(), 1);
     EXPECT_EQ(pipeline->commands[0].commandName, "echo");
@@ -46,7 +44,7 @@ TEST_F(ParserTest, CommandWithMultipleArgs) {
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    auto* pipeline = dynamic_cast<ParsedPipeline*>(result.get());
+    auto* pipeline = std::get_if<ParsedPipeline>(&result);
 
     ASSERT_NE(pipeline, nullptr);
     ASSERT_EQ(pipeline->commands.size(), 1);
@@ -62,7 +60,7 @@ TEST_F(ParserTest, PipelineOfTwo) {
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    auto* pipeline = dynamic_cast<ParsedPipeline*>(result.get());
+    auto* pipeline = std::get_if<ParsedPipeline>(&result);
 
     ASSERT_NE(pipeline, nullptr);
     ASSERT_EQ(pipeline->commands.size(), 2);
@@ -81,7 +79,7 @@ TEST_F(ParserTest, PipelineOfThree) {
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    auto* pipeline = dynamic_cast<ParsedPipeline*>(result.get());
+    auto* pipeline = std::get_if<ParsedPipeline>(&result);
 
     ASSERT_NE(pipeline, nullptr);
     ASSERT_EQ(pipeline->commands.size(), 3);
@@ -97,10 +95,7 @@ TEST_F(ParserTest, SimpleAssignment) {
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    ASSERT_NE(result, nullptr);
-    EXPECT_TRUE(result->isAssignment());
-
-    auto* assignment = dynamic_cast<ParsedAssignment*>(result.get());
+    auto* assignment = std::get_if<ParsedAssignment>(&result);
     ASSERT_NE(assignment, nullptr);
     EXPECT_EQ(assignment->variableName, "FOO");
     EXPECT_EQ(assignment->value, "bar");
@@ -112,10 +107,7 @@ TEST_F(ParserTest, MultipleAssignments) {
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    ASSERT_NE(result, nullptr);
-    EXPECT_TRUE(result->isAssignment());
-
-    auto* list = dynamic_cast<ParsedAssignmentList*>(result.get());
+    auto* list = std::get_if<ParsedAssignmentList>(&result);
     ASSERT_NE(list, nullptr);
     ASSERT_EQ(list->assignments.size(), 2);
     EXPECT_EQ(list->assignments[0].variableName, "x");
@@ -130,7 +122,7 @@ TEST_F(ParserTest, AssignmentWithEmptyValue) {
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    auto* assignment = dynamic_cast<ParsedAssignment*>(result.get());
+    auto* assignment = std::get_if<ParsedAssignment>(&result);
 
     ASSERT_NE(assignment, nullptr);
     EXPECT_EQ(assignment->variableName, "FOO");
@@ -143,7 +135,7 @@ TEST_F(ParserTest, CommandNoArgs) {
     Parser parser(std::move(tokens));
 
     auto result = parser.parse();
-    auto* pipeline = dynamic_cast<ParsedPipeline*>(result.get());
+    auto* pipeline = std::get_if<ParsedPipeline>(&result);
 
     ASSERT_NE(pipeline, nullptr);
     ASSERT_EQ(pipeline->commands.size(), 1);
@@ -0,0 +1,226 @@
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/commands/hash_command.hpp"
+#include "shell/environment.hpp"
+#include "shell/path_cache.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для PathCache и команды hash.
+ * Проверяют: разрешение имён через PATH, отрицательный кэш, инвалидацию
+ * при смене PATH и изменении директории, управление кэшем через hash.
+ */
+class PathCacheTest : public ::testing::Test {
+protected:
+    Environment env;
+    std::string dir;
+
+    void SetUp() override {
+        char pattern[] = "/tmp/shell_path_cache_XXXXXX";
+        ASSERT_NE(mkdtemp(pattern), nullptr);
+        dir = pattern;
+        env.set("PATH", dir);
+    }
+
+    void TearDown() override {
+        unlink((dir + "/tool").c_str());
+        rmdir(dir.c_str());
+    }
+
+    void createExecutable(const std::string& name) {
+        std::string path = dir + "/" + name;
+        {
+            std::ofstream f(path);
+            f << "#!/bin/sh\n";
+        }
+        chmod(path.c_str(), 0755);
+    }
+};
+
+// Проверяет: найденная команда возвращает полный путь и учитывает обращения.
+// Вход: tool в директории PATH. Выход: dir/tool, hits == 2.
+TEST_F(PathCacheTest, LookupFindsExecutableAndCountsHits) {
+    createExecutable("tool");
+    PathCache cache(env);
+
+    EXPECT_EQ(cache.lookup("tool"), dir + "/tool");
+    EXPECT_EQ(cache.lookup("tool"), dir + "/tool");
+
+    auto entries = cache.entries();
+    ASSERT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries[0].name, "tool");
+    EXPECT_EQ(entries[0].hits, 2);
+}
+
+// Проверяет: отрицательная запись сбрасывается, когда команда появляется в директории.
+// Вход: lookup до и после создания файла. Выход: nullopt, затем путь.
+TEST_F(PathCacheTest, NegativeEntryInvalidatedWhenDirectoryChanges) {
+    PathCache cache(env);
+    EXPECT_FALSE(cache.lookup("tool").has_value());
+
+    createExecutable("tool");
+
+    EXPECT_EQ(cache.lookup("tool"), dir + "/tool");
+}
+
+// Проверяет: положительная запись сбрасывается после удаления файла.
+// Вход: lookup, unlink, lookup. Выход: путь, затем nullopt.
+TEST_F(PathCacheTest, PositiveEntryInvalidatedWhenFileRemoved) {
+    createExecutable("tool");
+    PathCache cache(env);
+    EXPECT_TRUE(cache.lookup("tool").has_value());
+
+    unlink((dir + "/tool").c_str());
+
+    EXPECT_FALSE(cache.lookup("tool").has_value());
+}
+
+// Проверяет: смена PATH через Environment сбрасывает кэш.
+// Вход: PATH=dir, затем PATH=/nonexistent. Выход: путь, затем nullopt.
+TEST_F(PathCacheTest, PathChangeClearsCache) {
+    createExecutable("tool");
+    PathCache cache(env);
+    EXPECT_TRUE(cache.lookup("tool").has_value());
+
+    env.set("PATH", "/nonexistent_dir_for_path_cache");
+
+    EXPECT_FALSE(cache.lookup("tool").has_value());
+    EXPECT_TRUE(cache.entries().empty());
+}
+
+// Проверяет: отметка директории меняется только при изменении её содержимого или PATH.
+// Вход: два опроса, создание файла, смена PATH. Выход: отметка та же, затем новые.
+TEST_F(PathCacheTest, DirectoryStampsFollowChanges) {
+    PathCache cache(env);
+    auto before = cache.directoryStamps();
+    ASSERT_EQ(before.size(), 1U);
+    EXPECT_EQ(before[0].path, dir);
+    EXPECT_EQ(cache.directoryStamps()[0].stamp, before[0].stamp);
+
+    createExecutable("tool");
+    auto changed = cache.directoryStamps();
+    EXPECT_NE(changed[0].stamp, before[0].stamp);
+
+    env.set("PATH", dir + ":/nonexistent_dir_for_path_cache");
+    auto rebuilt = cache.directoryStamps();
+    ASSERT_EQ(rebuilt.size(), 2U);
+    EXPECT_NE(rebuilt[0].stamp, changed[0].stamp);
+}
+
+// Проверяет: пустой элемент PATH означает текущий каталог, а не корень файловой системы.
+// Вход: PATH=":/bin", текущий каталог с tool. Выход: ./tool, /bin/sh.
+TEST_F(PathCacheTest, EmptyPathElementIsCurrentDirectory) {
+    createExecutable("tool");
+    char* saved = getcwd(nullptr, 0);
+    ASSERT_NE(saved, nullptr);
+    ASSERT_EQ(chdir(dir.c_str()), 0);
+    env.set("PATH", ":/bin");
+
+    PathCache cache(env);
+    EXPECT_EQ(cache.lookup("tool"), "./tool");
+    EXPECT_EQ(cache.lookup("sh"), "/bin/sh");
+    EXPECT_EQ(PathCache::resolve("tool", "/nonexistent_dir_for_path_cache::"), "./tool");
+
+    EXPECT_EQ(chdir(saved), 0);
+    free(saved);
+    EXPECT_FALSE(PathCache::resolve("tool", ":/bin").has_value());
+}
+
+// Проверяет: seed задаёт путь без поиска, remove и clear удаляют записи.
+TEST_F(PathCacheTest, SeedRemoveAndClear) {
+    PathCache cache(env);
+    cache.seed("custom", "/opt/custom/bin/custom");
+
+    EXPECT_EQ(cache.peek("custom"), "/opt/custom/bin/custom");
+    EXPECT_EQ(cache.lookup("custom"), "/opt/custom/bin/custom");
+
+    EXPECT_TRUE(cache.remove("custom"));
+    EXPECT_FALSE(cache.remove("custom"));
+
+    cache.seed("a", "/x/a");
+    cache.clear();
+    EXPECT_TRUE(cache.entries().empty());
+}
+
+// Проверяет: resolve без кэша ищет по переданному PATH.
+TEST_F(PathCacheTest, ResolveWithoutCache) {
+    createExecutable("tool");
+    EXPECT_EQ(PathCache::resolve("tool", "/nonexistent:" + dir), dir + "/tool");
+    EXPECT_FALSE(PathCache::resolve("tool", "/nonexistent").has_value());
+}
+
+// ============== Hash Command ==============
+
+// Проверяет: hash NAME запоминает команду, hash без аргументов выводит таблицу.
+// Вход: hash tool; hash. Выход: таблица с путём.
+TEST_F(PathCacheTest, HashRemembersAndPrints) {
+    createExecutable("tool");
+    PathCache cache(env);
+    std::istringstream in;
+    std::ostringstream out;
+    std::ostringstream err;
+
+    HashCommand remember(cache);
+    remember.setArguments({"tool"});
+    EXPECT_EQ(remember.execute(in, out, err), 0);
+
+    HashCommand list(cache);
+    list.setArguments({});
+    EXPECT_EQ(list.execute(in, out, err), 0);
+    EXPECT_EQ(out.str(), "hits\tcommand\n   0\t" + dir + "/tool\n");
+}
+
+// Проверяет: hash для неизвестной команды — ошибка, пустая таблица — сообщение.
+TEST_F(PathCacheTest, HashNotFoundAndEmptyTable) {
+    PathCache cache(env);
+    std::istringstream in;
+    std::ostringstream out;
+    std::ostringstream err;
+
+    HashCommand cmd(cache);
+    cmd.setArguments({"no_such_tool"});
+    EXPECT_EQ(cmd.execute(in, out, err), 1);
+    EXPECT_NE(err.str().find("not found"), std::string::npos);
+
+    HashCommand list(cache);
+    list.setArguments({});
+    list.execute(in, out, err);
+    EXPECT_EQ(out.str(), "hash: hash table empty\n");
+}
+
+// Проверяет: hash -p задаёт путь, hash -t выводит его, hash -r очищает.
+TEST_F(PathCacheTest, HashSeedPrintAndReset) {
+    PathCache cache(env);
+    std::istringstream in;
+    std::ostringstream out;
+    std::ostringstream err;
+
+    HashCommand seed(cache);
+    seed.setArguments({"-p", "/opt/bin/thing", "thing"});
+    EXPECT_EQ(seed.execute(in, out, err), 0);
+
+    HashCommand print(cache);
+    print.setArguments({"-t", "thing"});
+    EXPECT_EQ(print.execute(in, out, err), 0);
+    EXPECT_EQ(out.str(), "/opt/bin/thing\n");
+
+    HashCommand reset(cache);
+    reset.setArguments({"-r"});
+    EXPECT_EQ(reset.execute(in, out, err), 0);
+    EXPECT_TRUE(cache.entries().empty());
+}
+
+// Проверяет: фабрика регистрирует hash как встроенную команду.
+TEST_F(PathCacheTest, FactoryRegistersHash) {
+    CommandFactory factory(env);
+    EXPECT_TRUE(factory.isBuiltin("hash"));
+    EXPECT_EQ(factory.create("hash")->getName(), "hash");
+}
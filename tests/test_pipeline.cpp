@@ -2,7 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include "shell/builtin_table.hpp"
 #include "shell/command_factory.hpp"
+#include "shell/command_pool.hpp"
 #include "shell/environment.hpp"
 #include "shell/executor.hpp"
 #include "shell/pipeline.hpp"
@@ -124,7 +126,52 @@ TEST_F(PipelineTest, CommandFactoryBuiltins) {
     EXPECT_TRUE(factory.isBuiltin("wc"));
     EXPECT_TRUE(factory.isBuiltin("pwd"));
     EXPECT_TRUE(factory.isBuiltin("exit"));
+    EXPECT_TRUE(factory.isBuiltin("grep"));
 
     EXPECT_FALSE(factory.isBuiltin("ls"));
-    EXPECT_FALSE(factory.isBuiltin("grep"));
+    EXPECT_FALSE(factory.isBuiltin("awk"));
+}
+
+// Проверяет: таблица совершенного хэша находит все встроенные команды и только их.
+// Вход: имена из builtinName, внешние и пустое имя. Выход: исходный BuiltinId / kNone.
+TEST_F(PipelineTest, BuiltinTableLookup) {
+    for (size_t i = 0; i < kBuiltinCount; ++i) {
+        auto id = static_cast<BuiltinId>(i);
+        EXPECT_EQ(lookupBuiltin(builtinName(id)), id);
+    }
+    EXPECT_EQ(lookupBuiltin("ls"), BuiltinId::kNone);
+    EXPECT_EQ(lookupBuiltin("ech"), BuiltinId::kNone);
+    EXPECT_EQ(lookupBuiltin("echoo"), BuiltinId::kNone);
+    EXPECT_EQ(lookupBuiltin(""), BuiltinId::kNone);
+    EXPECT_EQ(ParsedSimpleCommand("wc", {}).builtin, BuiltinId::kWc);
+}
+
+// Проверяет: объект команды после пайплайна возвращается в пул сброшенным и достаётся
+// следующей строке. Вход: echo a b, затем echo без аргументов. Выход: тот же объект, "\n".
+TEST_F(PipelineTest, CommandPoolReusesBuiltins) {
+    CommandFactory factory(env);
+    PipelineBuilder builder(factory);
+    CommandPool& pool = CommandPool::local();
+
+    ParsedPipeline first;
+    first.addCommand(ParsedSimpleCommand("echo", {"a", "b"}));
+    Command* used = nullptr;
+    {
+        Pipeline pipeline = builder.build(first);
+        used = &pipeline.getCommand(0);
+    }
+    size_t available = pool.available(BuiltinId::kEcho);
+    EXPECT_GE(available, 1u);
+
+    ParsedPipeline second;
+    second.addCommand(ParsedSimpleCommand("echo", {}));
+    Pipeline pipeline = builder.build(second);
+    EXPECT_EQ(&pipeline.getCommand(0), used);
+    EXPECT_EQ(pool.available(BuiltinId::kEcho), available - 1);
+
+    std::istringstream in;
+    std::ostringstream out;
+    std::ostringstream err;
+    EXPECT_EQ(pipeline.getCommand(0).execute(in, out, err), 0);
+    EXPECT_EQ(out.str(), "\n");
 }
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/environment.hpp"
+#include "shell/plugin.hpp"
+#include "shell/shell.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для PluginTable и команды enable (пример плагина libtools.so).
+ */
+class PluginTest : public ::testing::Test {
+protected:
+    Environment env;
+    std::ostringstream output;
+    std::ostringstream errors;
+
+    void SetUp() override {
+        env.initFromSystem();
+    }
+
+    int run(CommandFactory& factory, const std::string& name, std::vector<std::string> args,
+            const std::string& input = "") {
+        auto command = factory.create(name);
+        command->setArguments(std::move(args));
+        std::istringstream in(input);
+        return command->execute(in, output, errors);
+    }
+};
+
+// Проверяет: enable -f включает только названные команды плагина; они создаются фабрикой и
+// работают в процессе; enable выводит список, enable -d отключает.
+// Вход: enable -f libtools.so upcase. Выход: upcase — "HELLO, WORLD", rot13 — внешняя команда.
+TEST_F(PluginTest, EnablesNamedCommands) {
+    CommandFactory factory(env);
+    EXPECT_FALSE(factory.isBuiltin("upcase"));
+
+    EXPECT_EQ(run(factory, "enable", {"-f", TOOLS_PLUGIN_PATH, "upcase"}), 0);
+    EXPECT_TRUE(errors.str().empty());
+    EXPECT_TRUE(factory.isBuiltin("upcase"));
+    EXPECT_FALSE(factory.isBuiltin("rot13"));
+
+    EXPECT_EQ(run(factory, "upcase", {}, "Hello, world\n"), 0);
+    EXPECT_EQ(output.str(), "HELLO, WORLD\n");
+
+    output.str("");
+    EXPECT_EQ(run(factory, "enable", {}), 0);
+    EXPECT_EQ(output.str(), std::string("enable -f ") + TOOLS_PLUGIN_PATH + " upcase\n");
+
+    EXPECT_EQ(run(factory, "enable", {"-d", "upcase"}), 0);
+    EXPECT_FALSE(factory.isBuiltin("upcase"));
+}
+
+// Проверяет: ошибки загрузки не меняют таблицу. Вход: несуществующий файл, библиотека без
+// точек входа, имя, которого нет в плагине, отключение незагруженной команды. Выход: коды 1.
+TEST_F(PluginTest, ReportsErrors) {
+    CommandFactory factory(env);
+    EXPECT_EQ(run(factory, "enable", {"-f", "/nonexistent/libnone.so"}), 1);
+    EXPECT_NE(errors.str().find("cannot open shared object"), std::string::npos);
+
+#ifdef __linux__
+    errors.str("");
+    EXPECT_EQ(run(factory, "enable", {"-f", "libm.so.6"}), 1);
+    EXPECT_NE(errors.str().find("not a shell plugin"), std::string::npos);
+#endif
+
+    errors.str("");
+    EXPECT_EQ(run(factory, "enable", {"-f", TOOLS_PLUGIN_PATH, "upcase", "missing"}), 1);
+    EXPECT_NE(errors.str().find("missing: not found"), std::string::npos);
+    EXPECT_FALSE(factory.isBuiltin("upcase"));
+
+    EXPECT_EQ(run(factory, "enable", {"-d", "upcase"}), 1);
+    EXPECT_EQ(run(factory, "enable", {"-x"}), 2);
+}
+
+// Проверяет: плагин, собранный с прежней версией ABI (другой раскладкой vtable Command),
+// не загружается. Вход: enable -f libold_abi_plugin.so. Выход: код 1, сообщение о версии.
+TEST_F(PluginTest, RejectsOldAbiVersion) {
+    CommandFactory factory(env);
+    EXPECT_EQ(run(factory, "enable", {"-f", OLD_ABI_PLUGIN_PATH}), 1);
+    EXPECT_NE(errors.str().find("plugin ABI version " + std::to_string(kPluginAbiVersion - 1)),
+              std::string::npos);
+    EXPECT_FALSE(factory.isBuiltin("old"));
+}
+
+// Проверяет: команды плагина работают внутри пайплайна shell.
+// Вход: enable -f libtools.so; echo Hello | rot13 | upcase. Выход: "URYYB\n".
+TEST_F(PluginTest, RunsInsidePipeline) {
+    std::ostringstream captured;
+    std::streambuf* original = std::cout.rdbuf(captured.rdbuf());
+    {
+        Shell shell;
+        shell.processLine(std::string("enable -f ") + TOOLS_PLUGIN_PATH);
+        shell.processLine("echo Hello | rot13 | upcase");
+    }
+    std::cout.rdbuf(original);
+    EXPECT_EQ(captured.str(), "URYYB\n");
+}
@@ -0,0 +1,118 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "shell/interrupt.hpp"
+#include "shell/process_util.hpp"
+#include "shell/reactor.hpp"
+#include "shell/shell.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для Reactor и выполнения пайплайнов с внешними программами
+ * в цикле событий исполнителя.
+ */
+class ReactorTest : public ::testing::Test {
+protected:
+    std::ostringstream capturedOut;
+    std::ostringstream capturedErr;
+    std::streambuf* oldCout = nullptr;
+    std::streambuf* oldCerr = nullptr;
+
+    void SetUp() override {
+        oldCout = std::cout.rdbuf(capturedOut.rdbuf());
+        oldCerr = std::cerr.rdbuf(capturedErr.rdbuf());
+    }
+
+    void TearDown() override {
+        std::cout.rdbuf(oldCout);
+        std::cerr.rdbuf(oldCerr);
+    }
+
+    std::string run(const std::string& line, int* code = nullptr) {
+        capturedOut.str("");
+        Shell shell;
+        int result = shell.processLine(line);
+        if (code != nullptr) {
+            *code = result;
+        }
+        return capturedOut.str();
+    }
+};
+
+// Проверяет: обработчик вызывается для готового дескриптора и может снять себя; run()
+// возвращается, когда дескрипторов не осталось. Вход: канал с "ping", затем закрытый писатель.
+// Выход: прочитано "ping", затем EOF.
+TEST_F(ReactorTest, DispatchesUntilNoDescriptorsLeft) {
+    Reactor reactor;
+    ASSERT_TRUE(reactor.valid());
+    int fds[2];
+    ASSERT_TRUE(openPipe(fds));
+    ASSERT_TRUE(writeAll(fds[1], "ping", 4));
+    close(fds[1]);
+
+    std::string received;
+    ASSERT_TRUE(reactor.add(fds[0], Reactor::kReadable, [&](uint32_t events) {
+        EXPECT_NE(events & Reactor::kReadable, 0U);
+        char buffer[16];
+        ssize_t size = read(fds[0], buffer, sizeof(buffer));
+        if (size <= 0) {
+            reactor.remove(fds[0]);
+            return;
+        }
+        received.append(buffer, static_cast<size_t>(size));
+    }));
+    reactor.run();
+    close(fds[0]);
+    EXPECT_EQ(received, "ping");
+}
+
+// Проверяет: данные проходят через все виды стыков стадий (встроенная → программа,
+// программа → встроенная, программа → программа), в том числе объём больше буферов каналов,
+// и ранний выход следующей стадии останавливает программу.
+// Вход: смешанные пайплайны. Выход: ожидаемый вывод каждого.
+TEST_F(ReactorTest, MixedPipelinesDeliverOutput) {
+    EXPECT_EQ(run("echo hello world | tr a-z A-Z"), "HELLO WORLD\n");
+    EXPECT_EQ(run("sh -c 'echo one; echo two' | wc -l"), "2\n");
+    EXPECT_EQ(run("sh -c 'echo abc' | tr a-z A-Z | tr A-Z x-z"), "xyz\n");
+    EXPECT_EQ(run("sh -c 'yes | head -n 300000' | tr y z | sort | uniq -c | wc -l"), "1\n");
+    EXPECT_EQ(run("sh -c yes | head -n 2"), "y\ny\n");
+
+    int code = 0;
+    EXPECT_EQ(run("echo x | nonexistent_command_12345 | wc -l", &code), "0\n");
+    EXPECT_EQ(code, 0);
+    EXPECT_NE(capturedErr.str().find("command not found"), std::string::npos);
+}
+
+// Проверяет: пайплайн из программ не создаёт потоков в shell.
+// Вход: одна программа и четыре программы, последняя считает потоки родителя.
+// Выход: одинаковое число потоков.
+TEST_F(ReactorTest, ProgramStagesRunWithoutThreads) {
+    const std::string count = "sh -c 'ls /proc/$PPID/task | wc -l'";
+    std::string alone = run(count);
+    ASSERT_FALSE(alone.empty());
+    EXPECT_EQ(run("true | true | true | " + count), alone);
+}
+
+// Проверяет: запрос прерывания останавливает программы пайплайна через SIGINT.
+// Вход: "sleep 5 | sleep 5", Interrupt::request() через 100 мс. Выход: меньше 3 с, код 130.
+TEST_F(ReactorTest, InterruptStopsPrograms) {
+    Interrupt::clear();
+    std::thread requester([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        Interrupt::request();
+    });
+    auto started = std::chrono::steady_clock::now();
+    int code = 0;
+    run("sleep 5 | sleep 5", &code);
+    requester.join();
+    Interrupt::clear();
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(3));
+    EXPECT_EQ(code, 130);
+}
@@ -0,0 +1,184 @@
+#include <chrono>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "shell/regex.hpp"
+#include "shell/regex_cache.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для Regex, RegexMatcher и RegexCache.
+ */
+class RegexTest : public ::testing::Test {
+protected:
+    static bool matches(const std::string& pattern, const std::string& text,
+                        unsigned flags = Regex::kExtended) {
+        auto regex = Regex::compile(pattern, flags);
+        EXPECT_NE(regex, nullptr) << pattern;
+        if (!regex) {
+            return false;
+        }
+        RegexMatcher matcher(regex);
+        return matcher.search(text);
+    }
+
+    static std::string compileError(const std::string& pattern, unsigned flags = Regex::kExtended) {
+        std::string error;
+        EXPECT_EQ(Regex::compile(pattern, flags, &error), nullptr) << pattern;
+        return error;
+    }
+};
+
+// Проверяет: основные конструкции ERE. Вход: образец и строка. Выход: есть ли совпадение.
+TEST_F(RegexTest, ExtendedSyntax) {
+    EXPECT_TRUE(matches("a.c", "xxabcxx"));
+    EXPECT_FALSE(matches("a.c", "ac"));
+    EXPECT_TRUE(matches("colou?r", "color"));
+    EXPECT_TRUE(matches("colou?r", "colour"));
+    EXPECT_TRUE(matches("ab+c", "abbbc"));
+    EXPECT_FALSE(matches("ab+c", "ac"));
+    EXPECT_TRUE(matches("(cat|dog)s", "hotdogs"));
+    EXPECT_FALSE(matches("(cat|dog)s", "cow"));
+    EXPECT_TRUE(matches("^[0-9]{3}-[0-9]{2,4}$", "123-4567"));
+    EXPECT_FALSE(matches("^[0-9]{3}-[0-9]{2,4}$", "123-45678"));
+    EXPECT_TRUE(matches("[[:alpha:]_][[:alnum:]_]*=", "  FOO_1=bar"));
+    EXPECT_TRUE(matches("[^abc]", "abcd"));
+    EXPECT_FALSE(matches("[^abc]", "abcabc"));
+    EXPECT_TRUE(matches("a{2}", "baab"));
+    EXPECT_TRUE(matches("x{", "x{"));
+    EXPECT_TRUE(matches("\\w+\\s[0-9]", "word 7"));
+}
+
+// Проверяет: в BRE операторы записываются с обратной косой чертой, * в начале — символ.
+TEST_F(RegexTest, BasicSyntax) {
+    EXPECT_TRUE(matches("a\\(b\\|c\\)d", "acd", Regex::kBasic));
+    EXPECT_TRUE(matches("a+b", "a+b", Regex::kBasic));
+    EXPECT_FALSE(matches("a+b", "aab", Regex::kBasic));
+    EXPECT_TRUE(matches("a\\+b", "aab", Regex::kBasic));
+    EXPECT_TRUE(matches("x\\{2,\\}", "axxx", Regex::kBasic));
+    EXPECT_TRUE(matches("*a", "*a", Regex::kBasic));
+    EXPECT_TRUE(matches("a$b", "a$b", Regex::kBasic));
+    EXPECT_TRUE(matches("^ab$", "ab", Regex::kBasic));
+}
+
+// Проверяет: якоря относятся к строкам, find возвращает конец самого раннего совпадения.
+TEST_F(RegexTest, AnchorsAndLines) {
+    auto regex = Regex::compile("^b+$", Regex::kExtended);
+    RegexMatcher matcher(regex);
+    const std::string text = "abb\nbb\nxb";
+    const char* end = matcher.find(text.data(), text.data() + text.size());
+    ASSERT_NE(end, nullptr);
+    EXPECT_EQ(end - text.data(), 6);
+
+    EXPECT_FALSE(matches("a$", "ab\nb"));
+    EXPECT_TRUE(matches("b$", "ab\nb"));
+    EXPECT_TRUE(matches("^$", "a\n\nb"));
+    EXPECT_FALSE(matches("a.b", "a\nb"));
+}
+
+// Проверяет: за завершающим '\n' нет строки, пустое совпадение там не находится.
+// Вход: "^$", "^a*$", "x*" на текстах с переводом строки в конце. Выход: позиция или nullptr.
+TEST_F(RegexTest, NoLineAfterTrailingNewline) {
+    EXPECT_FALSE(matches("^$", "a\nb\n"));
+    EXPECT_FALSE(matches("^a*$", "b\nc\n"));
+    EXPECT_TRUE(matches("^a*$", "b\naa\n"));
+    EXPECT_TRUE(matches("x*", "b\n"));
+
+    auto regex = Regex::compile("^$", Regex::kExtended);
+    RegexMatcher matcher(regex);
+    const std::string text = "a\n\nb\n";
+    const char* end = matcher.find(text.data(), text.data() + text.size());
+    ASSERT_NE(end, nullptr);
+    EXPECT_EQ(end - text.data(), 2);
+    EXPECT_EQ(matcher.find(text.data() + 3, text.data() + text.size()), nullptr);
+}
+
+// Проверяет: '.' и отрицательные множества совпадают с целым символом UTF-8,
+// квантификатор применяется ко всему многобайтному символу.
+TEST_F(RegexTest, Utf8Characters) {
+    EXPECT_TRUE(matches("^.$", "ж"));
+    EXPECT_TRUE(matches("^a.b$", "a€b"));
+    EXPECT_FALSE(matches("^a.b$", "a€€b"));
+    EXPECT_TRUE(matches("^[^x]$", "😀"));
+    EXPECT_TRUE(matches("^ж+$", "жжж"));
+    EXPECT_TRUE(matches("^[аб]в$", "бв"));
+}
+
+// Проверяет: -i, литеральный префикс и работа префильтра на нескольких строках.
+TEST_F(RegexTest, IgnoreCaseAndPrefix) {
+    auto regex = Regex::compile("error: [0-9]+", Regex::kExtended | Regex::kIgnoreCase);
+    ASSERT_NE(regex, nullptr);
+    EXPECT_EQ(regex->literalPrefix(), "error: ");
+
+    RegexMatcher matcher(regex);
+    EXPECT_TRUE(matcher.search("ok\nERROR: x\nError: 42\n"));
+    EXPECT_FALSE(matcher.search("ok\nERROR: x\nerror:\n42\n"));
+
+    EXPECT_EQ(Regex::compile("(ab|ac)d", Regex::kExtended)->literalPrefix(), "");
+    EXPECT_EQ(Regex::compile("abc*", Regex::kExtended)->literalPrefix(), "ab");
+}
+
+// Проверяет: неподдерживаемые и некорректные образцы дают ошибку, а не исключение.
+TEST_F(RegexTest, CompileErrors) {
+    EXPECT_NE(compileError("(a").find("Unmatched"), std::string::npos);
+    EXPECT_NE(compileError("a)").find("Unmatched"), std::string::npos);
+    EXPECT_NE(compileError("[z-a]").find("range"), std::string::npos);
+    EXPECT_NE(compileError("[abc").find("Unmatched"), std::string::npos);
+    EXPECT_NE(compileError("\\(a\\)\\1", Regex::kBasic).find("Back-references"),
+              std::string::npos);
+    EXPECT_NE(compileError("a{5000}").find("too big"), std::string::npos);
+    EXPECT_FALSE(compileError("a\\").empty());
+}
+
+// Проверяет: «катастрофические» для backtracking образцы обрабатываются линейно.
+// Вход: 200 000 байт 'a' и образцы (a*)*b, (a|aa)*c, (x+x+)+y. Выход: нет совпадения, < 2 с.
+TEST_F(RegexTest, HostilePatternsAreLinear) {
+    const std::string text(200000, 'a');
+    auto started = std::chrono::steady_clock::now();
+    EXPECT_FALSE(matches("(a*)*b", text));
+    EXPECT_FALSE(matches("(a|aa)*c", text));
+    EXPECT_FALSE(matches("(x+x+)+y", std::string(200000, 'x')));
+    EXPECT_FALSE(matches("(a|b)*a(a|b){10}c", text));
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 2000);
+}
+
+// Проверяет: при маленьком бюджете кэш DFA сбрасывается, а результат не меняется.
+TEST_F(RegexTest, CacheFlushKeepsResults) {
+    auto regex = Regex::compile("(a|b)*a(a|b){8}$", Regex::kExtended);
+    std::mt19937 gen(9);
+    std::string text;
+    for (int i = 0; i < 20000; ++i) {
+        text += (gen() & 1) != 0 ? 'a' : 'b';
+        if (i % 50 == 49) {
+            text += '\n';
+        }
+    }
+    text += "b\nbbbbabbbbbbbb";
+
+    RegexMatcher unlimited(regex);
+    RegexMatcher tiny(regex, 256);
+    const char* expected = unlimited.find(text.data(), text.data() + text.size());
+    EXPECT_EQ(tiny.find(text.data(), text.data() + text.size()), expected);
+    EXPECT_GT(tiny.flushCount(), 0);
+}
+
+// Проверяет: кэш возвращает то же выражение по образцу и флагам, вытесняет давние.
+TEST_F(RegexTest, SessionCache) {
+    RegexCache cache(2);
+    auto first = cache.get("a+b", Regex::kExtended);
+    EXPECT_EQ(cache.get("a+b", Regex::kExtended), first);
+    EXPECT_NE(cache.get("a+b", Regex::kBasic), first);
+    EXPECT_EQ(cache.hits(), 1);
+
+    cache.get("c+", Regex::kExtended);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_NE(cache.get("a+b", Regex::kExtended), first);
+
+    std::string error;
+    EXPECT_EQ(cache.get("(", Regex::kExtended, &error), nullptr);
+    EXPECT_FALSE(error.empty());
+}
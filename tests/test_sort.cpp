@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/commands/sort_command.hpp"
+#include "shell/environment.hpp"
+#include "shell/external_sorter.hpp"
+#include "shell/thread_pool.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для LineComparator, ExternalSorter и SortCommand.
+ */
+class SortTest : public ::testing::Test {
+protected:
+    std::ostringstream output;
+    std::ostringstream errors;
+
+    int run(const std::vector<std::string>& args, const std::string& input = "") {
+        SortCommand cmd;
+        cmd.setArguments(args);
+        std::istringstream in(input);
+        return cmd.execute(in, output, errors);
+    }
+};
+
+// Проверяет: числовое сравнение -n — знак, ведущие нули, дробная часть, «не число» равно нулю.
+TEST_F(SortTest, NumericCompare) {
+    EXPECT_LT(LineComparator::compareNumeric("9", "10"), 0);
+    EXPECT_LT(LineComparator::compareNumeric("-10", "-9"), 0);
+    EXPECT_LT(LineComparator::compareNumeric("-1", "0"), 0);
+    EXPECT_EQ(LineComparator::compareNumeric("007", "7"), 0);
+    EXPECT_EQ(LineComparator::compareNumeric("1.50", "1.5"), 0);
+    EXPECT_LT(LineComparator::compareNumeric("1.5", "1.51"), 0);
+    EXPECT_EQ(LineComparator::compareNumeric("-0", "abc"), 0);
+    EXPECT_GT(LineComparator::compareNumeric("  12 apples", "3"), 0);
+}
+
+// Проверяет: флаги -n, -r, -u и последняя строка без перевода строки.
+// Вход: строки с числами. Выход: строки в требуемом порядке, каждая с '\n'.
+TEST_F(SortTest, Flags) {
+    EXPECT_EQ(run({}, "banana\napple\ncherry"), 0);
+    EXPECT_EQ(output.str(), "apple\nbanana\ncherry\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-n"}, "10\n9\n-2\n1.5\n"), 0);
+    EXPECT_EQ(output.str(), "-2\n1.5\n9\n10\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-nr"}, "10\n9\n-2\n"), 0);
+    EXPECT_EQ(output.str(), "10\n9\n-2\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-u"}, "b\na\nb\na\n"), 0);
+    EXPECT_EQ(output.str(), "a\nb\n");
+}
+
+// Проверяет: ключи -k с разделителем -t и без него, флаги ключа, -u по ключу оставляет первую
+// строку ввода. Вход: таблица "имя:число". Выход: строки по второму полю.
+TEST_F(SortTest, Keys) {
+    const std::string table = "bob:30\nalice:5\ncarol:30\ndave:100\n";
+    EXPECT_EQ(run({"-t", ":", "-k2n"}, table), 0);
+    EXPECT_EQ(output.str(), "alice:5\nbob:30\ncarol:30\ndave:100\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-t:", "-k", "2,2nr", "-k1,1"}, table), 0);
+    EXPECT_EQ(output.str(), "dave:100\nbob:30\ncarol:30\nalice:5\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-t:", "-u", "-k2,2"}, "carol:30\nbob:30\nalice:5\n"), 0);
+    EXPECT_EQ(output.str(), "carol:30\nalice:5\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-k2"}, "x  b\ny a\n"), 0);
+    EXPECT_EQ(output.str(), "x  b\ny a\n");
+
+    output.str("");
+    EXPECT_EQ(run({"-k", "0"}), 2);
+    EXPECT_NE(errors.str().find("invalid key"), std::string::npos);
+}
+
+// Проверяет: при малом бюджете куски сбрасываются во временные файлы и сливаются (в том числе
+// в несколько проходов), результат совпадает с устойчивой сортировкой в памяти.
+// Вход: 20000 случайных строк "слово число", куски по 512 байт. Выход: тот же порядок, что у
+// std::stable_sort с тем же сравнением.
+TEST_F(SortTest, ExternalSortMatchesInMemory) {
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> letter(0, 3);
+    std::uniform_int_distribution<int> number(-50, 50);
+    std::vector<std::string> lines;
+    std::string input;
+    for (int i = 0; i < 20000; ++i) {
+        std::string line;
+        for (int j = 0; j < 3; ++j) {
+            line += static_cast<char>('a' + letter(gen));
+        }
+        line += " " + std::to_string(number(gen));
+        lines.push_back(line);
+        input += line + "\n";
+    }
+
+    SortOptions options;
+    SortKey key;
+    key.startField = 2;
+    key.numeric = true;
+    options.keys.push_back(key);
+
+    for (bool unique : {false, true}) {
+        options.unique = unique;
+        LineComparator comparator(options);
+        std::vector<std::string> expected = lines;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [&](const std::string& a, const std::string& b) {
+                             return comparator.compare(a, b) < 0;
+                         });
+        if (unique) {
+            expected.erase(std::unique(expected.begin(), expected.end(),
+                                       [&](const std::string& a, const std::string& b) {
+                                           return comparator.compare(a, b) == 0;
+                                       }),
+                           expected.end());
+        }
+        std::string joined;
+        for (const auto& line : expected) {
+            joined += line + "\n";
+        }
+
+        ThreadPool pool(2);
+        ExternalSorter sorter(options, 16 * 1024, std::filesystem::temp_directory_path().string(),
+                              pool, 512);
+        for (size_t pos = 0; pos < input.size(); pos += 1000) {
+            size_t size = std::min<size_t>(1000, input.size() - pos);
+            ASSERT_TRUE(sorter.write(input.data() + pos, size));
+        }
+        std::ostringstream sorted;
+        ASSERT_TRUE(sorter.finish(sorted)) << sorter.error();
+        EXPECT_GT(sorter.spilledRuns(), 128U);
+        EXPECT_EQ(sorted.str(), joined);
+    }
+}
+
+// Проверяет: несколько файлов сортируются вместе, отсутствующий файл — код 2; sort встроен.
+TEST_F(SortTest, FilesAndFactory) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string first = (dir / "shell_sort_test_1.txt").string();
+    std::string second = (dir / "shell_sort_test_2.txt").string();
+    std::ofstream(first) << "pear\napple";
+    std::ofstream(second) << "fig\n";
+
+    EXPECT_EQ(run({first, second}), 0);
+    EXPECT_EQ(output.str(), "apple\nfig\npear\n");
+
+    EXPECT_EQ(run({first, "/nonexistent_sort_input"}), 2);
+    EXPECT_NE(errors.str().find("cannot read"), std::string::npos);
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+
+    Environment env;
+    CommandFactory factory(env);
+    EXPECT_TRUE(factory.isBuiltin("sort"));
+}
@@ -0,0 +1,88 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/command_factory.hpp"
+#include "shell/commands/tee_command.hpp"
+#include "shell/environment.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для TeeCommand.
+ */
+class TeeTest : public ::testing::Test {
+protected:
+    Environment env;
+    std::ostringstream output;
+    std::ostringstream errors;
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+
+    void SetUp() override {
+        env.initFromSystem();
+    }
+
+    int run(const std::vector<std::string>& args, const std::string& input) {
+        TeeCommand cmd(&env);
+        cmd.setArguments(args);
+        std::istringstream in(input);
+        return cmd.execute(in, output, errors);
+    }
+
+    static std::string read(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+};
+
+// Проверяет: копия входа попадает в выход, в несколько файлов и в программу >(...) (путь через
+// tee(2)/splice на Linux); -a дописывает. Вход: 1 МБ случайных байт. Выход: все копии равны входу.
+TEST_F(TeeTest, CopiesToFilesAndPrograms) {
+    std::mt19937 gen(3);
+    std::string input(1 << 20, '\0');
+    for (auto& c : input) {
+        c = static_cast<char>(gen());
+    }
+    std::string first = (dir / "shell_tee_1.bin").string();
+    std::string second = (dir / "shell_tee_2.bin").string();
+    std::string piped = (dir / "shell_tee_3.bin").string();
+
+    EXPECT_EQ(run({first, second, ">(sh", "-c", "cat > " + piped + ")"}, input), 0);
+    EXPECT_EQ(output.str(), input);
+    EXPECT_EQ(read(first), input);
+    EXPECT_EQ(read(second), input);
+    EXPECT_EQ(read(piped), input);
+
+    output.str("");
+    EXPECT_EQ(run({"-a", first}, "tail"), 0);
+    EXPECT_EQ(read(first), input + "tail");
+
+    for (const auto& path : {first, second, piped}) {
+        std::remove(path.c_str());
+    }
+}
+
+// Проверяет: ошибка открытия файла — код 1, остальные приёмники получают данные; ошибки
+// разбора >(...); код завершения программы-приёмника; tee встроен.
+TEST_F(TeeTest, Errors) {
+    std::string file = (dir / "shell_tee_errors.txt").string();
+    EXPECT_EQ(run({"/nonexistent_dir/x", file}, "data\n"), 1);
+    EXPECT_EQ(output.str(), "data\n");
+    EXPECT_EQ(read(file), "data\n");
+    std::remove(file.c_str());
+
+    EXPECT_EQ(run({">(cat"}, "x"), 1);
+    EXPECT_NE(errors.str().find("missing ')'"), std::string::npos);
+    EXPECT_EQ(run({">(sh", "-c", "exit 3)"}, "x"), 3);
+
+    CommandFactory factory(env);
+    EXPECT_TRUE(factory.isBuiltin("tee"));
+}
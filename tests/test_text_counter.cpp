@@ -0,0 +1,142 @@
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "shell/text_counter.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для TextCounter.
+ * Проверяют: векторные ядра совпадают с наивным подсчётом на любых длинах
+ * и смещениях, состояние слова переносится между блоками.
+ */
+class TextCounterTest : public ::testing::Test {
+protected:
+    static TextCounter::Counts naive(const std::string& text) {
+        TextCounter::Counts counts;
+        bool prevSpace = true;
+        for (char c : text) {
+            bool space = TextCounter::isSpace(static_cast<unsigned char>(c));
+            counts.lines += c == '\n' ? 1 : 0;
+            counts.words += (!space && prevSpace) ? 1 : 0;
+            prevSpace = space;
+        }
+        counts.bytes = text.size();
+        return counts;
+    }
+
+    static std::string randomText(size_t size, unsigned seed) {
+        const std::string alphabet = "ab \n\t\r\v\fxyz\x80\xff";
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+        std::string text(size, ' ');
+        for (auto& c : text) {
+            c = alphabet[pick(gen)];
+        }
+        return text;
+    }
+};
+
+// Проверяет: ядра дают тот же результат, что и наивный цикл, для длин 0..300 и смещений.
+TEST_F(TextCounterTest, KernelsMatchNaiveCount) {
+    std::string text = randomText(400, 42);
+    for (size_t offset = 0; offset < 3; ++offset) {
+        for (size_t length = 0; length + offset <= 300; ++length) {
+            std::string slice = text.substr(offset, length);
+            auto expected = naive(slice);
+            EXPECT_EQ(TextCounter::countNewlines(slice.data(), slice.size()), expected.lines);
+            EXPECT_EQ(TextCounter::countWordStarts(slice.data(), slice.size(), true), expected.words);
+        }
+    }
+}
+
+// Проверяет: подсчёт по блокам произвольного размера равен подсчёту целиком.
+// Вход: 1 МиБ случайных данных блоками по 1..4097 байт. Выход: совпадение счётчиков.
+TEST_F(TextCounterTest, BlockwiseUpdateCarriesWordState) {
+    std::string text = randomText(1 << 20, 7);
+    auto expected = naive(text);
+
+    for (size_t block : {1UL, 63UL, 64UL, 65UL, 4097UL}) {
+        TextCounter counter;
+        for (size_t pos = 0; pos < text.size(); pos += block) {
+            counter.update(text.data() + pos, std::min(block, text.size() - pos));
+        }
+        EXPECT_EQ(counter.counts().lines, expected.lines) << "block=" << block;
+        EXPECT_EQ(counter.counts().words, expected.words) << "block=" << block;
+        EXPECT_EQ(counter.counts().bytes, expected.bytes) << "block=" << block;
+    }
+}
+
+// Проверяет: слово на границе блоков считается один раз.
+// Вход: "hel" + "lo world". Выход: 2 слова.
+TEST_F(TextCounterTest, WordSplitAcrossBlocks) {
+    TextCounter counter;
+    counter.update("hel", 3);
+    counter.update("lo world", 8);
+    EXPECT_EQ(counter.counts().words, 2);
+}
+
+// Проверяет: режим только строк не считает слова.
+TEST_F(TextCounterTest, LinesOnlyMode) {
+    TextCounter counter(TextCounter::kLines);
+    counter.update("a b\nc\n", 6);
+    EXPECT_EQ(counter.counts().lines, 2);
+    EXPECT_EQ(counter.counts().words, 0);
+    EXPECT_EQ(counter.counts().bytes, 6);
+}
+
+// Проверяет: символы UTF-8 считаются по байтам, не являющимся продолжением.
+// Вход: "aé€😀" (1+2+3+4 байта) на разных смещениях. Выход: 4 символа на копию.
+TEST_F(TextCounterTest, CharsCountCodePoints) {
+    std::string text;
+    for (int i = 0; i < 50; ++i) {
+        text += "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    }
+    EXPECT_EQ(TextCounter::countChars(text.data(), text.size()), 200);
+    EXPECT_EQ(TextCounter::countChars(text.data() + 1, 9), 3);
+}
+
+// Проверяет: пробелы Unicode разделяют слова, неразрывный пробел — нет, в том числе
+// когда последовательность разрезана между блоками.
+// Вход: "a<U+3000>b<U+00A0>c<U+2029>d". Выход: 3 слова при любом разбиении.
+TEST_F(TextCounterTest, UnicodeSpacesSeparateWords) {
+    const std::string text = "a\xE3\x80\x80" "b\xC2\xA0" "c\xE2\x80\xA9" "d";
+    EXPECT_EQ(TextCounter::countWordStarts(text.data(), text.size(), true), 3);
+
+    for (size_t split = 0; split <= text.size(); ++split) {
+        TextCounter counter;
+        counter.update(text.data(), split);
+        counter.update(text.data() + split, text.size() - split);
+        EXPECT_EQ(counter.counts().words, 3) << "split=" << split;
+    }
+
+    // Длинный текст проходит через векторные окна
+    std::string longText;
+    for (int i = 0; i < 100; ++i) {
+        longText += " word\xE2\x80\x83next\xE2\x80\x99s";
+    }
+    EXPECT_EQ(TextCounter::countWordStarts(longText.data(), longText.size(), true), 200);
+}
+
+// Проверяет: проверка UTF-8 находит некорректные последовательности и их позицию,
+// в том числе обрыв в конце данных. Корректный текст ошибок не даёт.
+TEST_F(TextCounterTest, ValidateUtf8) {
+    auto check = [](const std::string& text) {
+        TextCounter counter(TextCounter::kChars | TextCounter::kValidate);
+        counter.update(text.data(), text.size());
+        return counter.counts();
+    };
+
+    EXPECT_EQ(check(std::string(100, 'x') + "\xD0\xBF\xF0\x9F\x98\x80").invalid, 0);
+
+    auto overlong = check(std::string(40, 'x') + "\xC0\xAF" + "ok");
+    EXPECT_EQ(overlong.invalid, 2);
+    EXPECT_EQ(overlong.firstInvalid, 40);
+
+    EXPECT_EQ(check("\xED\xA0\x80").invalid, 3);  // суррогат
+    auto truncated = check("ab\xE2\x82");
+    EXPECT_EQ(truncated.invalid, 1);
+    EXPECT_EQ(truncated.firstInvalid, 2);
+}
@@ -0,0 +1,177 @@
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shell/text_counter.hpp"
+#include "shell/thread_pool.hpp"
+
+using namespace shell;
+
+/**
+ * Юнит-тесты для ThreadPool и параллельного подсчёта TextCounter.
+ */
+class ThreadPoolTest : public ::testing::Test {};
+
+// Проверяет: все задачи выполняются, результаты возвращаются через future.
+// Вход: 100 задач, возвращающих свой номер. Выход: сумма 0..99.
+TEST_F(ThreadPoolTest, SubmitReturnsResults) {
+    ThreadPool pool(4);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(pool.submit([i]() { return i; }));
+    }
+
+    int sum = 0;
+    for (auto& result : results) {
+        sum += result.get();
+    }
+    EXPECT_EQ(sum, 4950);
+    EXPECT_EQ(pool.size(), 4);
+}
+
+// Проверяет: исключение из задачи пробрасывается через future.
+TEST_F(ThreadPoolTest, ExceptionPropagates) {
+    ThreadPool pool(2);
+    auto result = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+// Проверяет: деструктор дожидается поставленных задач.
+TEST_F(ThreadPoolTest, DestructorDrainsQueue) {
+    std::atomic<int> done{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; ++i) {
+            pool.submit([&done]() { done++; });
+        }
+    }
+    EXPECT_EQ(done.load(), 50);
+}
+
+// Проверяет: задача может ставить подзадачи и ждать их через wait() — ожидающий выполняет
+// их сам, поэтому пул из одного потока не блокируется. Выход: 10 задач × 10 подзадач.
+TEST_F(ThreadPoolTest, NestedWaitDoesNotDeadlock) {
+    ThreadPool pool(1);
+    std::atomic<int> done{0};
+    std::vector<std::future<void>> outer;
+    for (int i = 0; i < 10; ++i) {
+        outer.push_back(pool.submit([&pool, &done]() {
+            std::vector<std::future<void>> inner;
+            for (int j = 0; j < 10; ++j) {
+                inner.push_back(pool.submit([&done]() { done++; }));
+            }
+            for (auto& part : inner) {
+                pool.wait(part);
+            }
+        }));
+    }
+    for (auto& part : outer) {
+        pool.wait(part);
+    }
+    EXPECT_EQ(done.load(), 100);
+    EXPECT_EQ(pool.stats().queued, 0U);
+}
+
+// Проверяет: parallelFor покрывает диапазон ровно один раз, счётчики учитывают задачи.
+// Вход: [5, 10005) кусками по 64. Выход: каждый индекс посещён один раз, executed ≥ 156.
+TEST_F(ThreadPoolTest, ParallelForCoversRangeOnce) {
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> visits(10005);
+    pool.parallelFor(5, visits.size(), 64, [&visits](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            visits[i]++;
+        }
+    });
+    for (size_t i = 0; i < visits.size(); ++i) {
+        ASSERT_EQ(visits[i].load(), i < 5 ? 0 : 1) << "i=" << i;
+    }
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.threads, 3U);
+    EXPECT_EQ(stats.depths.size(), 3U);
+    EXPECT_GE(stats.executed, 156U);
+    EXPECT_THROW(pool.parallelFor(0, 10, 1,
+                                  [](size_t from, size_t) {
+                                      if (from == 7) {
+                                          throw std::runtime_error("boom");
+                                      }
+                                  }),
+                 std::runtime_error);
+}
+
+// Проверяет: размер общего пула задаётся переменной SHELL_THREADS, некорректное значение
+// игнорируется. Вход: "3", "0", "x". Выход: 3, затем размер по числу ядер.
+TEST_F(ThreadPoolTest, DefaultSizeHonoursShellThreads) {
+    unsetenv("SHELL_THREADS");
+    size_t byCpus = ThreadPool::defaultSize();
+    EXPECT_GE(byCpus, 1U);
+
+    setenv("SHELL_THREADS", "3", 1);
+    EXPECT_EQ(ThreadPool::defaultSize(), 3U);
+    for (const char* value : {"0", "x"}) {
+        setenv("SHELL_THREADS", value, 1);
+        EXPECT_EQ(ThreadPool::defaultSize(), byCpus) << value;
+    }
+    unsetenv("SHELL_THREADS");
+
+    // Значение из окружения shell разбирается так же
+    EXPECT_EQ(ThreadPool::sizeFor("5"), 5U);
+    EXPECT_EQ(ThreadPool::sizeFor(""), byCpus);
+    EXPECT_EQ(ThreadPool::sizeFor(nullptr), byCpus);
+}
+
+// Проверяет: подсчёт по кускам совпадает с последовательным, в том числе когда
+// граница куска проходит внутри слова. Вход: 100 КиБ, куски 1..4099 байт.
+TEST_F(ThreadPoolTest, ParallelCountStitchesWordsAtChunkEdges) {
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> pick(0, 5);
+    std::string text(100 * 1024, 'a');
+    for (auto& c : text) {
+        int r = pick(gen);
+        c = r == 0 ? ' ' : (r == 1 ? '\n' : static_cast<char>('a' + r));
+    }
+
+    TextCounter sequential;
+    sequential.update(text.data(), text.size());
+
+    ThreadPool pool(4);
+    for (size_t chunk : {1UL, 7UL, 64UL, 4099UL}) {
+        auto counts =
+            TextCounter::countParallel(text.data(), text.size(), TextCounter::kAll, pool, chunk);
+        EXPECT_EQ(counts.lines, sequential.counts().lines) << "chunk=" << chunk;
+        EXPECT_EQ(counts.words, sequential.counts().words) << "chunk=" << chunk;
+        EXPECT_EQ(counts.bytes, sequential.counts().bytes) << "chunk=" << chunk;
+    }
+}
+
+// Проверяет: границы кусков выравниваются по началу символа UTF-8 — символы, пробелы
+// Unicode и ошибки UTF-8 считаются так же, как при последовательном подсчёте.
+TEST_F(ThreadPoolTest, ParallelCountAlignsUtf8Boundaries) {
+    const std::vector<std::string> pieces = {"a", " ", "\xD0\xBF", "\xE2\x80\x83", "\xE3\x80\x80",
+                                             "\xF0\x9F\x98\x80", "\xC2\xA0", "\x80", "\n"};
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<size_t> pick(0, pieces.size() - 1);
+    std::string text;
+    while (text.size() < 50 * 1024) {
+        text += pieces[pick(gen)];
+    }
+
+    unsigned mode = TextCounter::kAll | TextCounter::kChars | TextCounter::kValidate;
+    TextCounter sequential(mode);
+    sequential.update(text.data(), text.size());
+    auto expected = sequential.counts();
+
+    ThreadPool pool(4);
+    for (size_t chunk : {1UL, 5UL, 333UL}) {
+        auto counts = TextCounter::countParallel(text.data(), text.size(), mode, pool, chunk);
+        EXPECT_EQ(counts.words, expected.words) << "chunk=" << chunk;
+        EXPECT_EQ(counts.chars, expected.chars) << "chunk=" << chunk;
+        EXPECT_EQ(counts.invalid, expected.invalid) << "chunk=" << chunk;
+        EXPECT_EQ(counts.firstInvalid, expected.firstInvalid) << "chunk=" << chunk;
+    }
+}